@@ -0,0 +1,479 @@
+// Standard C++ includes
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+// POSIX includes
+#include <dlfcn.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// CLI11 includes
+#include "../include/genn/third_party/CLI11.hpp"
+
+// GeNN userproject includes
+#include "../userproject/include/fixedNumberTotalPreCalc.h"
+#include "../userproject/include/sharedLibraryModel.h"
+
+//------------------------------------------------------------------------
+// SimulationResults
+//------------------------------------------------------------------------
+//! Results measured by simulation process and sent to driver through pipe
+struct SimulationResults
+{
+    double initTime;
+    double initSparseTime;
+    double neuronUpdateTime;
+    double presynapticUpdateTime;
+    double postsynapticUpdateTime;
+    double synapseDynamicsTime;
+    double simulationTime;
+    long long numSynapticEvents;    // -1 if performance counters aren't supported by backend
+};
+
+//------------------------------------------------------------------------
+// ModelBenchmark
+//------------------------------------------------------------------------
+//! Description of how to build and run one of the userproject models at a given scale
+struct ModelBenchmark
+{
+    //! Name passed to ModelSpec::setName and hence, name of generated code directory
+    std::string name;
+
+    //! Directory containing model, relative to userproject directory
+    std::string modelDirectory;
+
+    //! Model definition file and headers it includes which must be copied alongside generated sizes.h
+    std::vector<std::string> files;
+
+    //! Integration timestep of model [ms]
+    double dt;
+
+    //! Can model be scaled
+    bool scalable;
+
+    //! Write model-specific sizes for scale
+    std::function<void(std::ofstream&, double)> writeSizes;
+
+    //! Host-side initialisation required before model is initialised
+    std::function<void(SharedLibraryModel<float>&, const std::string&, double)> setup;
+};
+
+//------------------------------------------------------------------------
+// Anonymous namespace
+//------------------------------------------------------------------------
+namespace
+{
+const std::vector<ModelBenchmark> modelBenchmarks = {
+    {"IzhSparse", "Izh_sparse_project/model", {"IzhSparse.cc"}, 1.0, true,
+     [](std::ofstream &sizes, double scale)
+     {
+         sizes << "#define _NNeurons " << (unsigned int)std::round(10000.0 * scale) << std::endl;
+         sizes << "#define _NConn 1000" << std::endl;
+         sizes << "#define _GScale 1.0" << std::endl;
+         sizes << "#define _InputFac 1.0" << std::endl;
+     },
+     nullptr},
+    {"MBody1", "MBody1_project/model", {"MBody1.cc"}, 0.1, true,
+     [](std::ofstream &sizes, double scale)
+     {
+         sizes << "#define _NAL " << (unsigned int)std::round(100.0 * scale) << std::endl;
+         sizes << "#define _NKC " << (unsigned int)std::round(1000.0 * scale) << std::endl;
+         sizes << "#define _NLHI " << (unsigned int)std::round(20.0 * scale) << std::endl;
+         sizes << "#define _NDN " << (unsigned int)std::round(100.0 * scale) << std::endl;
+         sizes << "#define _GScale 0.0025" << std::endl;
+     },
+     // Rather than presenting input patterns, drive every projection neuron at 20Hz
+     [](SharedLibraryModel<float> &model, const std::string &precision, double scale)
+     {
+         const unsigned int numAL = (unsigned int)std::round(100.0 * scale);
+         const double firingProb = (20.0 / 1000.0) * 0.1;
+         model.allocateExtraGlobalParam("PN", "firingProb", numAL);
+         if(precision == "float") {
+             std::fill_n(model.getArray<float>("firingProbPN"), numAL, (float)firingProb);
+         }
+         else {
+             std::fill_n(model.getArray<double>("firingProbPN"), numAL, firingProb);
+         }
+         model.pushExtraGlobalParam("PN", "firingProb", numAL);
+     }},
+    {"PoissonIzh", "PoissonIzh_project/model", {"PoissonIzh.cc"}, 1.0, true,
+     [](std::ofstream &sizes, double scale)
+     {
+         sizes << "#define _NPoisson " << (unsigned int)std::round(100.0 * scale) << std::endl;
+         sizes << "#define _NIzh " << (unsigned int)std::round(10.0 * scale) << std::endl;
+         sizes << "#define _PConn 0.5" << std::endl;
+         sizes << "#define _GScale 2.0" << std::endl;
+     },
+     nullptr},
+    {"PotjansMicrocircuit", "PotjansMicrocircuit_project/model", {"PotjansMicrocircuit.cc", "PotjansMicrocircuitParams.h"}, 0.1, true,
+     [](std::ofstream &sizes, double scale)
+     {
+         sizes << "#define _NeuronScale " << (0.5 * scale) << std::endl;
+         sizes << "#define _ConnectivityScale 0.5" << std::endl;
+         sizes << "#define _DurationMs 1000.0" << std::endl;
+     },
+     nullptr},
+    {"SynDelay", "SynDelay_project", {"SynDelay.cc"}, 1.0, false, nullptr, nullptr},
+};
+
+//------------------------------------------------------------------------
+double getElapsed(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+//------------------------------------------------------------------------
+bool makeDirectory(const std::string &path)
+{
+    return (mkdir(path.c_str(), S_IRWXU | S_IRWXG | S_IXOTH) == 0 || errno == EEXIST);
+}
+//------------------------------------------------------------------------
+void copyFile(const std::string &source, const std::string &destination)
+{
+    std::ifstream is(source, std::ios::binary);
+    if(!is.good()) {
+        throw std::runtime_error("Unable to open '" + source + "'");
+    }
+    std::ofstream os(destination, std::ios::binary);
+    os << is.rdbuf();
+}
+//------------------------------------------------------------------------
+// Run command with output redirected to log, returning wall-clock duration or -1 on failure
+double timeCommand(const std::string &command, const std::string &logFilename)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    const int retVal = system((command + " >> " + logFilename + " 2>&1").c_str());
+    return (retVal == 0) ? getElapsed(start) : -1.0;
+}
+//------------------------------------------------------------------------
+// Simulate model in this (child) process and write results to pipe
+void simulate(const ModelBenchmark &benchmark, const std::string &buildDirectory, const std::string &backend,
+              const std::string &precision, double scale, double durationMs, int resultsFD)
+{
+    // **NOTE** scalar type is only used to access t so we use timestep counts instead
+    SharedLibraryModel<float> model(buildDirectory + "/", benchmark.name);
+
+    model.allocateMem();
+
+    // Build row lengths for any synapse populations recorded by the generator as requiring them
+    std::ifstream preCalcRowLengthsFile(buildDirectory + "/preCalcRowLengths.txt");
+    std::string synapsePopName;
+    unsigned int numSrc;
+    unsigned int numTrg;
+    size_t numConnections;
+    std::mt19937 rng;
+    while(preCalcRowLengthsFile >> synapsePopName >> numSrc >> numTrg >> numConnections) {
+        model.allocateExtraGlobalParam(synapsePopName, "preCalcRowLength", numSrc);
+        preCalcRowLengths(numSrc, numTrg, numConnections, model.getArray<unsigned int>("preCalcRowLength" + synapsePopName), rng);
+        model.pushExtraGlobalParam(synapsePopName, "preCalcRowLength", numSrc);
+    }
+
+    if(benchmark.setup) {
+        benchmark.setup(model, precision, scale);
+    }
+    model.initialize();
+    model.initializeSparse();
+
+    // Simulate for fixed number of timesteps
+    const unsigned long long numTimesteps = (unsigned long long)std::round(durationMs / benchmark.dt);
+    const auto start = std::chrono::high_resolution_clock::now();
+    for(unsigned long long i = 0; i < numTimesteps; i++) {
+        model.stepTime();
+    }
+
+    SimulationResults results;
+    results.simulationTime = getElapsed(start);
+    results.initTime = *model.getScalar<double>("initTime");
+    results.initSparseTime = *model.getScalar<double>("initSparseTime");
+    results.neuronUpdateTime = *model.getScalar<double>("neuronUpdateTime");
+    results.presynapticUpdateTime = *model.getScalar<double>("presynapticUpdateTime");
+    results.postsynapticUpdateTime = *model.getScalar<double>("postsynapticUpdateTime");
+    results.synapseDynamicsTime = *model.getScalar<double>("synapseDynamicsTime");
+
+    // If backend supports performance counters, sum synaptic events processed by all synapse populations
+    // **NOTE** counters are summed by library built against generated definitions so their layout can't go out of sync
+    results.numSynapticEvents = -1;
+    if(backend != "CUDA") {
+        void *countersLibrary = dlopen((buildDirectory + "/libbenchmarkCounters.so").c_str(), RTLD_NOW);
+        if(countersLibrary == nullptr) {
+            throw std::runtime_error("Unable to load performance counter library: " + std::string(dlerror()));
+        }
+
+        typedef const void *(*GetPerformanceCountersFunc)(unsigned int*);
+        typedef long long (*SumSynapticEventsFunc)(const void*, unsigned int);
+        auto getPerformanceCounters = (GetPerformanceCountersFunc)model.getSymbol("getPerformanceCounters");
+        auto sumSynapticEvents = (SumSynapticEventsFunc)dlsym(countersLibrary, "sumSynapticEvents");
+        if(sumSynapticEvents == nullptr) {
+            throw std::runtime_error("Unable to find sumSynapticEvents in performance counter library");
+        }
+
+        unsigned int numCounters;
+        const void *counters = getPerformanceCounters(&numCounters);
+        results.numSynapticEvents = sumSynapticEvents(counters, numCounters);
+    }
+
+    if(write(resultsFD, &results, sizeof(SimulationResults)) != sizeof(SimulationResults)) {
+        throw std::runtime_error("Unable to write results");
+    }
+}
+}   // Anonymous namespace
+
+//------------------------------------------------------------------------
+// Entry point
+//------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> models;
+    std::vector<std::string> backends{"SingleThreadedCPU", "MultiThreadedCPU"};
+    std::vector<std::string> precisions{"float", "double"};
+    std::vector<double> scales{0.5, 1.0, 2.0};
+    double durationMs = 100.0;
+    std::string buildDirectory = "build";
+    std::string outputFilename = "benchmark_results.json";
+
+    // If CUDA is available, also benchmark CUDA backend
+    // **NOTE** this matches the logic used to decide whether to build the CUDA backend
+    if(getenv("CUDA_PATH") != nullptr) {
+        backends.push_back("CUDA");
+    }
+
+    CLI::App app{"Build and simulate userproject models, writing timings to JSON"};
+    app.add_option("--models", models, "Models to benchmark (defaults to all)");
+    app.add_option("--backends", backends, "Backends to benchmark", true);
+    app.add_option("--precisions", precisions, "Floating point precisions to benchmark", true);
+    app.add_option("--scales", scales, "Factors to scale default size of each model by", true);
+    app.add_option("--duration", durationMs, "Duration to simulate each model for [ms]", true);
+    app.add_option("--build-dir", buildDirectory, "Directory to build models in", true);
+    app.add_option("--output", outputFilename, "Filename to write results to", true);
+    CLI11_PARSE(app, argc, argv);
+
+    // Get paths to userproject directory and to genn-buildmodel script relative to this executable's directory
+    const std::string executable = argv[0];
+    const std::string executableDirectory = (executable.find('/') == std::string::npos) ? "." : executable.substr(0, executable.rfind('/'));
+    char absolutePath[PATH_MAX];
+    if(realpath(executableDirectory.c_str(), absolutePath) == nullptr) {
+        std::cerr << "Unable to determine location of benchmark executable" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string gennPath = std::string(absolutePath) + "/..";
+    const std::string userprojectPath = gennPath + "/userproject/";
+    const std::string buildModel = gennPath + "/bin/genn-buildmodel.sh";
+
+    if(!makeDirectory(buildDirectory)) {
+        std::cerr << "Unable to create build directory '" << buildDirectory << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::stringstream results;
+    bool first = true;
+    for(const auto &benchmark : modelBenchmarks) {
+        // Skip models which weren't requested
+        if(!models.empty() && std::find(models.cbegin(), models.cend(), benchmark.name) == models.cend()) {
+            continue;
+        }
+
+        // Models which can't be scaled are only benchmarked at their default size
+        const std::vector<double> modelScales = benchmark.scalable ? scales : std::vector<double>{1.0};
+        for(const auto &backend : backends) {
+            for(const auto &precision : precisions) {
+                for(double scale : modelScales) {
+                    std::cout << benchmark.name << " " << backend << " " << precision << " " << scale << "x: " << std::flush;
+
+                    // Create build directory
+                    std::ostringstream configuration;
+                    configuration << benchmark.name << "_" << backend << "_" << precision << "_" << scale;
+                    char configurationBuildDirectory[PATH_MAX];
+                    if(!makeDirectory(buildDirectory + "/" + configuration.str())
+                       || realpath((buildDirectory + "/" + configuration.str()).c_str(), configurationBuildDirectory) == nullptr)
+                    {
+                        std::cerr << "Unable to create build directory for '" << configuration.str() << "'" << std::endl;
+                        return EXIT_FAILURE;
+                    }
+                    const std::string configurationPath = configurationBuildDirectory;
+                    const std::string logFilename = configurationPath + "/benchmark.log";
+                    std::remove(logFilename.c_str());
+
+                    // Copy model alongside sizes.h so model includes it rather than one written by the userproject's generate_run
+                    // **NOTE** model directory is also added to include path so relative includes still resolve
+                    const std::string modelPath = userprojectPath + benchmark.modelDirectory;
+                    for(const auto &f : benchmark.files) {
+                        copyFile(modelPath + "/" + f, configurationPath + "/" + f);
+                    }
+
+                    // Write sizes
+                    {
+                        std::ofstream sizes(configurationPath + "/sizes.h");
+                        sizes << "#pragma once" << std::endl;
+                        sizes << "#define _FTYPE GENN_" << ((precision == "float") ? "FLOAT" : "DOUBLE") << std::endl;
+                        sizes << "#define _TIMING 1" << std::endl;
+                        if(benchmark.writeSizes) {
+                            benchmark.writeSizes(sizes, scale);
+                        }
+                    }
+
+                    // Write model which wraps userproject model and configures it for benchmarking
+                    {
+                        std::ofstream model(configurationPath + "/benchmark.cc");
+                        model << "#define modelDefinition userprojectModelDefinition" << std::endl;
+                        model << "#include \"" << benchmark.files.front() << "\"" << std::endl;
+                        model << "#undef modelDefinition" << std::endl;
+                        model << std::endl;
+                        model << "void modelDefinition(ModelSpec &model)" << std::endl;
+                        model << "{" << std::endl;
+                        model << "    userprojectModelDefinition(model);" << std::endl;
+                        model << "    model.setPrecision(GENN_" << ((precision == "float") ? "FLOAT" : "DOUBLE") << ");" << std::endl;
+                        model << "    model.setTiming(true);" << std::endl;
+                        if(backend != "CUDA") {
+                            model << "    model.setPerformanceCounters(true);" << std::endl;
+                        }
+                        model << std::endl;
+                        model << "    // Record sizes of synapse populations whose row lengths must be calculated on the host" << std::endl;
+                        model << "    std::ofstream preCalcRowLengths(\"preCalcRowLengths.txt\");" << std::endl;
+                        model << "    for(const auto &s : static_cast<ModelSpecInternal&>(model).getSynapseGroups()) {" << std::endl;
+                        model << "        const auto &connectInit = s.second.getConnectivityInitialiser();" << std::endl;
+                        model << "        const auto egps = connectInit.getSnippet()->getExtraGlobalParams();" << std::endl;
+                        model << "        if(std::any_of(egps.cbegin(), egps.cend(), [](const Snippet::Base::EGP &e){ return e.name == \"preCalcRowLength\"; })) {" << std::endl;
+                        model << "            preCalcRowLengths << s.first << \" \" << s.second.getSrcNeuronGroup()->getNumNeurons() << \" \" << s.second.getTrgNeuronGroup()->getNumNeurons();" << std::endl;
+                        model << "            preCalcRowLengths << \" \" << (size_t)connectInit.getParams().at(0) << std::endl;" << std::endl;
+                        model << "        }" << std::endl;
+                        model << "    }" << std::endl;
+                        model << "}" << std::endl;
+                    }
+
+                    // Generate code
+                    std::string buildModelFlags = "";
+                    if(backend == "SingleThreadedCPU") {
+                        buildModelFlags = "-c ";
+                    }
+                    else if(backend == "MultiThreadedCPU") {
+                        buildModelFlags = "-t ";
+                    }
+                    const double codeGenerationTime = timeCommand("cd " + configurationPath + " && " + buildModel + " " + buildModelFlags + "-i " + modelPath + " benchmark.cc",
+                                                                  logFilename);
+
+                    // Compile generated code
+                    const double compileTime = (codeGenerationTime < 0.0) ? -1.0 : timeCommand("make -C " + configurationPath + "/" + benchmark.name + "_CODE", logFilename);
+
+                    // If backend supports performance counters, build library to sum them against the generated definitions
+                    bool countersBuilt = true;
+                    if(compileTime >= 0.0 && backend != "CUDA") {
+                        {
+                            std::ofstream counters(configurationPath + "/benchmarkCounters.cc");
+                            counters << "#include \"" << benchmark.name << "_CODE/definitions.h\"" << std::endl;
+                            counters << std::endl;
+                            counters << "extern \"C\" long long sumSynapticEvents(const PerformanceCounter *counters, unsigned int numCounters)" << std::endl;
+                            counters << "{" << std::endl;
+                            counters << "    long long numSynapticEvents = 0;" << std::endl;
+                            counters << "    for(unsigned int i = 0; i < numCounters; i++) {" << std::endl;
+                            counters << "        numSynapticEvents += counters[i].numSynapticEvents;" << std::endl;
+                            counters << "    }" << std::endl;
+                            counters << "    return numSynapticEvents;" << std::endl;
+                            counters << "}" << std::endl;
+                        }
+
+                        const char *cxx = getenv("CXX");
+                        countersBuilt = (timeCommand(std::string((cxx == nullptr) ? "c++" : cxx) + " -std=c++11 -shared -fPIC " + configurationPath + "/benchmarkCounters.cc -o " + configurationPath + "/libbenchmarkCounters.so",
+                                                     logFilename) >= 0.0);
+                    }
+
+                    // Simulate model in child process so its peak memory usage can be measured in isolation
+                    SimulationResults simulationResults;
+                    struct rusage usage;
+                    bool simulated = false;
+                    if(compileTime >= 0.0 && countersBuilt) {
+                        int resultsPipe[2];
+                        if(pipe(resultsPipe) != 0) {
+                            std::cerr << "Unable to create pipe" << std::endl;
+                            return EXIT_FAILURE;
+                        }
+
+                        const pid_t pid = fork();
+                        if(pid == 0) {
+                            close(resultsPipe[0]);
+                            try {
+                                simulate(benchmark, configurationPath, backend, precision, scale, durationMs, resultsPipe[1]);
+                            }
+                            catch(const std::exception &e) {
+                                std::cerr << e.what() << std::endl;
+                                _exit(EXIT_FAILURE);
+                            }
+                            _exit(EXIT_SUCCESS);
+                        }
+
+                        close(resultsPipe[1]);
+                        const bool received = (read(resultsPipe[0], &simulationResults, sizeof(SimulationResults)) == sizeof(SimulationResults));
+                        close(resultsPipe[0]);
+
+                        int status;
+                        simulated = (wait4(pid, &status, 0, &usage) == pid && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS && received);
+                    }
+
+                    if(!first) {
+                        results << "," << std::endl;
+                    }
+                    first = false;
+                    results << "        {\"model\": \"" << benchmark.name << "\", \"backend\": \"" << backend << "\", \"precision\": \"" << precision << "\", \"scale\": " << scale;
+                    if(simulated) {
+                        // **NOTE** Linux reports maximum resident set size in kilobytes but Mac OS in bytes
+#ifdef __APPLE__
+                        const long long peakRSSBytes = usage.ru_maxrss;
+#else
+                        const long long peakRSSBytes = usage.ru_maxrss * 1024ll;
+#endif
+                        results << ", \"status\": \"ok\"";
+                        results << ", \"codeGenerationTime\": " << codeGenerationTime << ", \"compileTime\": " << compileTime;
+                        results << ", \"initTime\": " << simulationResults.initTime << ", \"initSparseTime\": " << simulationResults.initSparseTime;
+                        results << ", \"neuronUpdateTime\": " << simulationResults.neuronUpdateTime;
+                        results << ", \"presynapticUpdateTime\": " << simulationResults.presynapticUpdateTime;
+                        results << ", \"postsynapticUpdateTime\": " << simulationResults.postsynapticUpdateTime;
+                        results << ", \"synapseDynamicsTime\": " << simulationResults.synapseDynamicsTime;
+                        results << ", \"simulationTime\": " << simulationResults.simulationTime;
+                        if(simulationResults.numSynapticEvents >= 0) {
+                            results << ", \"synapticEvents\": " << simulationResults.numSynapticEvents;
+                            results << ", \"synapticEventsPerSecond\": " << ((double)simulationResults.numSynapticEvents / simulationResults.simulationTime);
+                        }
+                        else {
+                            results << ", \"synapticEvents\": null, \"synapticEventsPerSecond\": null";
+                        }
+                        results << ", \"peakRSS\": " << peakRSSBytes << "}";
+
+                        std::cout << simulationResults.simulationTime << "s" << std::endl;
+                    }
+                    else {
+                        results << ", \"status\": \"failed\", \"log\": \"" << logFilename << "\"}";
+                        std::cout << "failed (see " << logFilename << ")" << std::endl;
+                    }
+                }
+            }
+        }
+    }
+
+    // Write results
+    std::ofstream output(outputFilename);
+    std::ifstream version(gennPath + "/version.txt");
+    std::string gennVersion;
+    std::getline(version, gennVersion);
+    output << "{" << std::endl;
+    output << "    \"gennVersion\": \"" << gennVersion << "\"," << std::endl;
+    output << "    \"duration\": " << durationMs << "," << std::endl;
+    output << "    \"results\": [" << std::endl;
+    output << results.str() << std::endl;
+    output << "    ]" << std::endl;
+    output << "}" << std::endl;
+    return EXIT_SUCCESS;
+}
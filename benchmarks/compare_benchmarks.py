@@ -0,0 +1,57 @@
+import json
+import sys
+from argparse import ArgumentParser
+
+# Per-phase times compared between results files
+_phases = ["simulationTime", "neuronUpdateTime", "presynapticUpdateTime",
+           "postsynapticUpdateTime", "synapseDynamicsTime", "initTime", "initSparseTime"]
+
+def load_results(filename):
+    # Load results, indexing successful runs by configuration
+    with open(filename, "r") as f:
+        data = json.load(f)
+    return data, {(r["model"], r["backend"], r["precision"], r["scale"]): r
+                  for r in data["results"] if r["status"] == "ok"}
+
+parser = ArgumentParser(description="Compare two sets of GeNN benchmark results")
+parser.add_argument("baseline", help="Results file to compare against")
+parser.add_argument("current", help="Results file to check for regressions")
+parser.add_argument("--tolerance", type=float, default=0.1,
+                    help="Fractional slowdown allowed before a phase is treated as a regression")
+parser.add_argument("--min-time", type=float, default=0.01,
+                    help="Phases which take less than this many seconds in the baseline are ignored")
+args = parser.parse_args()
+
+baseline_data, baseline = load_results(args.baseline)
+current_data, current = load_results(args.current)
+print("Comparing GeNN %s (%s) against GeNN %s (%s)" % (current_data["gennVersion"], args.current,
+                                                       baseline_data["gennVersion"], args.baseline))
+
+regressions = 0
+for config, current_result in sorted(current.items()):
+    # Skip configurations not present in baseline
+    if config not in baseline:
+        print("%s %s %s %gx: no baseline" % config)
+        continue
+
+    baseline_result = baseline[config]
+    for p in _phases:
+        # Skip phases too short to time reliably
+        if baseline_result[p] < args.min_time:
+            continue
+
+        # Report regression if phase has slowed down by more than tolerance
+        ratio = current_result[p] / baseline_result[p]
+        if ratio > (1.0 + args.tolerance):
+            print("%s %s %s %gx: %s regressed from %fs to %fs (%.1f%%)"
+                  % (config + (p, baseline_result[p], current_result[p], (ratio - 1.0) * 100.0)))
+            regressions += 1
+
+# Configurations which ran in the baseline but no longer succeed are also regressions
+for config in sorted(set(baseline.keys()) - set(current.keys())):
+    if any(config == (r["model"], r["backend"], r["precision"], r["scale"]) for r in current_data["results"]):
+        print("%s %s %s %gx: failed" % config)
+        regressions += 1
+
+print("%u regressions" % regressions)
+sys.exit(1 if regressions > 0 else 0)
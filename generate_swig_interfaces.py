@@ -487,6 +487,7 @@ def generateConfigs(gennPath, backends):
         pygennSmg.addSwigModuleHeadline()
         with SwigAsIsScope( pygennSmg ):
             pygennSmg.addCppInclude( '<fstream>' )
+            pygennSmg.addCppInclude( '<sstream>' )
             pygennSmg.addCppInclude( '<plog/Appenders/ConsoleAppender.h>' )
             pygennSmg.addCppInclude( '"logging.h"' )
             pygennSmg.addCppInclude( '"variableMode.h"' )
@@ -530,12 +531,14 @@ def generateConfigs(gennPath, backends):
 
             #ifdef _WIN32
                 // Create MSBuild project to compile and link all generated modules
-                std::ofstream makefile((outputPath / "runner.vcxproj").str());
+                std::stringstream makefile;
                 CodeGenerator::generateMSBuild(makefile, backend, "", moduleNames);
+                CodeGenerator::writeFileIfChanged(outputPath / "runner.vcxproj", makefile.str());
             #else
                 // Create makefile to compile and link all generated modules
-                std::ofstream makefile((outputPath / "Makefile").str());
+                std::stringstream makefile;
                 CodeGenerator::generateMakefile(makefile, backend, moduleNames);
+                CodeGenerator::writeFileIfChanged(outputPath / "Makefile", makefile.str());
             #endif
             }
             ''' )
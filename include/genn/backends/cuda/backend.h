@@ -105,6 +105,9 @@ struct Preferences : public PreferencesBase
     unsigned int manualDeviceID = 0;
 
     //! How to select CUDA blocksize
+    /*! BlockSizeSelect::OCCUPANCY (and DeviceSelect::OPTIMAL) build the model with candidate block sizes in the
+        block_size_optimiser subdirectory of the generated code. This is kept so cubins can be reused if the model
+        is unchanged when it is next generated and can be deleted at any time to reclaim disk space */
     BlockSizeSelect blockSizeSelectMethod = BlockSizeSelect::OCCUPANCY;
 
     //! If block size select method is set to BlockSizeSelect::MANUAL, block size to use for each kernel
@@ -128,18 +131,19 @@ public:
     //--------------------------------------------------------------------------
     virtual void genNeuronUpdate(CodeStream &os, const ModelSpecMerged &modelMerged,
                                  NeuronGroupSimHandler simHandler, NeuronGroupMergedHandler wuVarUpdateHandler,
-                                 HostHandler pushEGPHandler) const override;
+                                 HostHandler pushEGPHandler, ShardHandler shardHandler) const override;
 
     virtual void genSynapseUpdate(CodeStream &os, const ModelSpecMerged &modelMerged,
                                   SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
                                   SynapseGroupMergedHandler wumEventHandler, SynapseGroupMergedHandler wumProceduralConnectHandler,
                                   SynapseGroupMergedHandler postLearnHandler, SynapseGroupMergedHandler synapseDynamicsHandler,
-                                  HostHandler pushEGPHandler) const override;
+                                  HostHandler pushEGPHandler, ShardHandler shardHandler) const override;
 
     virtual void genInit(CodeStream &os, const ModelSpecMerged &modelMerged,
                          NeuronGroupMergedHandler localNGHandler, SynapseGroupMergedHandler sgDenseInitHandler, 
                          SynapseGroupMergedHandler sgSparseConnectHandler, SynapseGroupMergedHandler sgSparseInitHandler,
-                         HostHandler initPushEGPHandler, HostHandler initSparsePushEGPHandler) const override;
+                         HostHandler initPushEGPHandler, HostHandler initSparsePushEGPHandler,
+                         ShardHandler shardHandler) const override;
 
     //! Gets the stride used to access synaptic matrix rows, taking into account sparse data structure, padding etc
     virtual size_t getSynapticMatrixRowStride(const SynapseGroupInternal &sg) const override;
@@ -211,6 +215,11 @@ public:
     //! Generate code to return amount of free 'device' memory in bytes
     virtual void genReturnFreeDeviceMemoryBytes(CodeStream &os) const override;
 
+    virtual void genCheckpointDeviceArraySave(CodeStream &os, const std::string &type, const std::string &name, size_t count) const override;
+    virtual void genCheckpointDeviceArrayLoad(CodeStream &os, const std::string &type, const std::string &name, size_t count) const override;
+    virtual void genCheckpointSave(CodeStream &os, const ModelSpecMerged &modelMerged) const override;
+    virtual void genCheckpointLoad(CodeStream &os, const ModelSpecMerged &modelMerged) const override;
+
     virtual void genMakefilePreamble(std::ostream &os) const override;
     virtual void genMakefileLinkRule(std::ostream &os) const override;
     virtual void genMakefileCompileRule(std::ostream &os) const override;
@@ -227,11 +236,18 @@ public:
     virtual bool isGlobalRNGRequired(const ModelSpecMerged &modelMerged) const override;
     virtual bool isPopulationRNGRequired() const override{ return true; }
     virtual bool isSynRemapRequired() const override{ return true; }
-    virtual bool isPostsynapticRemapRequired() const override{ return true; }
+    virtual bool isPostsynapticRemapRequired(const SynapseGroupInternal &sg) const override;
 
     //! Is automatic copy mode enabled in the preferences?
     virtual bool isAutomaticCopyEnabled() const override { return m_Preferences.automaticCopy; }
 
+    //! Can host arrays be replaced by memory-mapped files i.e. does the device access host arrays directly?
+    virtual bool isArrayMappingSupported() const override { return false; }
+    virtual unsigned int getNumWakeQueueBuckets() const override { return 0; }
+
+    //! How should generated code be divided between modules?
+    virtual ModuleLayout getModuleLayout() const override { return m_Preferences.moduleLayout; }
+
     //! How many bytes of memory does 'device' have
     virtual size_t getDeviceMemoryBytes() const override{ return m_ChosenDevice.totalGlobalMem; }
 
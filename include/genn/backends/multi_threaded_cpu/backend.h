@@ -0,0 +1,87 @@
+#pragma once
+
+// Standard C++ includes
+#include <string>
+
+// GeNN includes
+#include "backendExport.h"
+
+// Single-threaded CPU backend includes
+#include "../single_threaded_cpu/backend.h"
+
+//--------------------------------------------------------------------------
+// CodeGenerator::MultiThreadedCPU::Preferences
+//--------------------------------------------------------------------------
+namespace CodeGenerator
+{
+namespace MultiThreadedCPU
+{
+struct Preferences : public SingleThreadedCPU::Preferences
+{
+    //! Number of threads (including the thread calling into the generated code) to simulate model with
+    /*! If this is zero, the number of hardware threads available when generating code is used */
+    unsigned int numThreads = 0;
+};
+
+//--------------------------------------------------------------------------
+// CodeGenerator::MultiThreadedCPU::Backend
+//--------------------------------------------------------------------------
+//! Backend which generates the same code as the single-threaded CPU backend but splits
+//! neuron update, presynaptic update and sparse connectivity and initialisation across a persistent pool of worker threads
+class BACKEND_EXPORT Backend : public SingleThreadedCPU::Backend
+{
+public:
+    Backend(const std::string &scalarType, const Preferences &preferences);
+
+    //--------------------------------------------------------------------------
+    // CodeGenerator::BackendBase virtuals
+    //--------------------------------------------------------------------------
+    virtual void genDefinitionsInternalPreamble(CodeStream &os, const ModelSpecMerged &modelMerged) const override;
+    virtual void genRunnerPreamble(CodeStream &os, const ModelSpecMerged &modelMerged) const override;
+
+    virtual void genMakefilePreamble(std::ostream &os) const override;
+
+    //--------------------------------------------------------------------------
+    // Public API
+    //--------------------------------------------------------------------------
+    //! Gets the number of threads generated code will use
+    unsigned int getNumThreads() const{ return m_NumThreads; }
+
+protected:
+    //--------------------------------------------------------------------------
+    // SingleThreadedCPU::Backend virtuals
+    //--------------------------------------------------------------------------
+    virtual void genNeuronUpdateGroup(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &funcSubs,
+                                      NeuronGroupSimHandler simHandler, NeuronGroupMergedHandler wuVarUpdateHandler) const override;
+
+    virtual void genPresynapticUpdateGroup(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                           SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
+                                           SynapseGroupMergedHandler wumEventHandler, SynapseGroupMergedHandler wumProceduralConnectHandler) const override;
+
+    virtual void genSparseInitGroup(CodeStream &os, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                    SynapseGroupMergedHandler sgSparseInitHandler) const override;
+
+    virtual void genSparseConnectivityInitGroup(CodeStream &os, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                                SynapseGroupMergedHandler sgSparseConnectHandler) const override;
+
+private:
+    //--------------------------------------------------------------------------
+    // Private methods
+    //--------------------------------------------------------------------------
+    void genParallelPresynapticUpdate(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &popSubs,
+                                      bool trueSpike, SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
+                                      SynapseGroupMergedHandler wumProceduralConnectHandler) const;
+
+    //! Is presynaptic update of this synapse group always performed by gathering, making per-thread buffers unnecessary
+    bool isPostSpanAlwaysUsed(const SynapseGroupInternal &sg) const;
+
+    //! Get the size of the per-thread postsynaptic input buffers required to simulate model
+    size_t getInSynThreadBufferStride(const ModelSpecMerged &modelMerged) const;
+
+    //--------------------------------------------------------------------------
+    // Members
+    //--------------------------------------------------------------------------
+    const unsigned int m_NumThreads;
+};
+}   // namespace MultiThreadedCPU
+}   // namespace CodeGenerator
@@ -26,6 +26,21 @@ namespace SingleThreadedCPU
 {
 struct Preferences : public PreferencesBase
 {
+    //! Generate neuron update loops which the compiler can vectorise with SIMD instructions
+    /*! State arrays are allocated aligned and padded to the SIMD width, threshold tests write
+        to a spike mask and spikes are compacted into the spike buffer after each update loop */
+    bool enableSIMDNeuronUpdate = false;
+
+    //! Target architecture passed to -march when enableSIMDNeuronUpdate is set (used for unix based platforms)
+    /*! The default tunes for the machine generating the code so, if the model is built and run on different
+        machines, set this to their common architecture or leave it empty and pass flags via userCxxFlagsGNU */
+    std::string simdTargetArchitecture = "native";
+
+    //! Simulate neurons and build sparse connectivity using counter-based Philox4x32-10 RNG streams rather than the global RNG
+    /*! Neuron streams are keyed on the seed, population, neuron and timestep so neuron groups which require a
+        simulation RNG can be updated in parallel or with SIMD loops and still reproduce the same results.
+        Connectivity streams are keyed on the seed, population and row so rows can be built in any order */
+    bool enableCounterBasedRNG = false;
 };
 
 //--------------------------------------------------------------------------
@@ -44,18 +59,19 @@ public:
     //--------------------------------------------------------------------------
     virtual void genNeuronUpdate(CodeStream &os, const ModelSpecMerged &modelMerged,
                                  NeuronGroupSimHandler simHandler, NeuronGroupMergedHandler wuVarUpdateHandler,
-                                 HostHandler pushEGPHandler) const override;
+                                 HostHandler pushEGPHandler, ShardHandler shardHandler) const override;
 
     virtual void genSynapseUpdate(CodeStream &os, const ModelSpecMerged &modelMerged,
                                   SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
                                   SynapseGroupMergedHandler wumEventHandler, SynapseGroupMergedHandler wumProceduralConnectHandler,
                                   SynapseGroupMergedHandler postLearnHandler, SynapseGroupMergedHandler synapseDynamicsHandler,
-                                  HostHandler pushEGPHandler) const override;
+                                  HostHandler pushEGPHandler, ShardHandler shardHandler) const override;
 
     virtual void genInit(CodeStream &os, const ModelSpecMerged &modelMerged,
                          NeuronGroupMergedHandler localNGHandler, SynapseGroupMergedHandler sgDenseInitHandler, 
                          SynapseGroupMergedHandler sgSparseConnectHandler, SynapseGroupMergedHandler sgSparseInitHandler,
-                         HostHandler initPushEGPHandler, HostHandler initSparsePushEGPHandler) const override;
+                         HostHandler initPushEGPHandler, HostHandler initSparsePushEGPHandler,
+                         ShardHandler shardHandler) const override;
 
     virtual size_t getSynapticMatrixRowStride(const SynapseGroupInternal &sg) const override;
 
@@ -111,6 +127,11 @@ public:
     //! Generate code to return amount of free 'device' memory in bytes
     virtual void genReturnFreeDeviceMemoryBytes(CodeStream &os) const override;
 
+    virtual void genCheckpointDeviceArraySave(CodeStream &os, const std::string &type, const std::string &name, size_t count) const override;
+    virtual void genCheckpointDeviceArrayLoad(CodeStream &os, const std::string &type, const std::string &name, size_t count) const override;
+    virtual void genCheckpointSave(CodeStream &os, const ModelSpecMerged &modelMerged) const override;
+    virtual void genCheckpointLoad(CodeStream &os, const ModelSpecMerged &modelMerged) const override;
+
     virtual void genMakefilePreamble(std::ostream &os) const override;
     virtual void genMakefileLinkRule(std::ostream &os) const override;
     virtual void genMakefileCompileRule(std::ostream &os) const override;
@@ -127,24 +148,160 @@ public:
     virtual bool isGlobalRNGRequired(const ModelSpecMerged &modelMerged) const override;
     virtual bool isPopulationRNGRequired() const override { return false; }
     virtual bool isSynRemapRequired() const override{ return false; }
-    virtual bool isPostsynapticRemapRequired() const override{ return true; }
+    virtual bool isPostsynapticRemapRequired(const SynapseGroupInternal &sg) const override;
 
     //! Is automatic copy mode enabled in the preferences?
     virtual bool isAutomaticCopyEnabled() const override { return m_Preferences.automaticCopy; }
 
+    //! Can host arrays be replaced by memory-mapped files i.e. does the device access host arrays directly?
+    virtual bool isArrayMappingSupported() const override { return true; }
+    virtual unsigned int getNumWakeQueueBuckets() const override { return 256; }
+
+    //! How should generated code be divided between modules?
+    virtual ModuleLayout getModuleLayout() const override { return m_Preferences.moduleLayout; }
+
     //! How many bytes of memory does 'device' have
     virtual size_t getDeviceMemoryBytes() const override{ return 0; }
 
+protected:
+    //--------------------------------------------------------------------------
+    // Protected API
+    //--------------------------------------------------------------------------
+    const Preferences &getPreferences() const{ return m_Preferences; }
+
+    //--------------------------------------------------------------------------
+    // Protected virtuals
+    //--------------------------------------------------------------------------
+    //! Generate code to update all neurons in the current group of a merged neuron update group
+    /*! Code is generated within the scope of the loop over groups so 'group' is available */
+    virtual void genNeuronUpdateGroup(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &funcSubs,
+                                      NeuronGroupSimHandler simHandler, NeuronGroupMergedHandler wuVarUpdateHandler) const;
+
+    //! Generate code to process all presynaptic spikes and spike-like events in the current group of a merged presynaptic update group
+    virtual void genPresynapticUpdateGroup(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                           SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
+                                           SynapseGroupMergedHandler wumEventHandler, SynapseGroupMergedHandler wumProceduralConnectHandler) const;
+
+    //! Generate code to initialise synapse variables and postsynaptic remapping in the current group of a merged sparse init group
+    virtual void genSparseInitGroup(CodeStream &os, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                    SynapseGroupMergedHandler sgSparseInitHandler) const;
+
+    //! Generate code to build the sparse connectivity of the current group of a merged connectivity init group
+    virtual void genSparseConnectivityInitGroup(CodeStream &os, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                                SynapseGroupMergedHandler sgSparseConnectHandler) const;
+
+    //--------------------------------------------------------------------------
+    // Protected methods
+    //--------------------------------------------------------------------------
+    //! Generate the code to process a merged group by calling handler, either in the current scope or,
+    //! if shardHandler is set, in a function called "process<suffix>Group<idx>" with its own module
+    /*! \param params  parameter list of the function
+        \param args    arguments passed to the function by the calling code */
+    void genMergedGroup(CodeStream &os, ShardHandler shardHandler, const std::string &suffix, size_t idx, size_t numGroups,
+                        const std::string &params, const std::string &args, HostHandler handler) const;
+
+    //! Generate code to process the presynaptic spike or spike-like event with index 'i' in the source population's spike buffer
+    /*! \param inSyn   array postsynaptic input should be accumulated into (if dendritic delay isn't required)*/
+    void genPresynapticUpdateSpike(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &popSubs,
+                                   bool trueSpike, const std::string &inSyn, SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
+                                   SynapseGroupMergedHandler wumProceduralConnectHandler) const;
+
+    //! Generate code to add the synapses in row 'i' to the column lengths and postsynaptic remapping
+    void genPostsynapticRemapRow(CodeStream &os, const SynapseGroupMerged &sg) const;
+
+    //! Should presynaptic update of this synapse group ever gather input target-by-target from the presynaptic neurons which spiked
+    bool isPostSpanPresynapticUpdate(const SynapseGroupInternal &sg) const;
+
+    //! Get condition used to choose between gathering and scattering input each timestep or empty string if input is always gathered
+    std::string getPostSpanCondition(const SynapseGroupMerged &sg, const std::string &numSpikes) const;
+
+    //! Generate code to record which of the first numSpikes presynaptic neurons in the source population's
+    //! spike buffer emitted spikes or passed the event threshold in postSpanPreActive and postSpanPreMask
+    void genPostSpanMarkActive(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &popSubs,
+                               bool trueSpike, const std::string &numSpikes, SynapseGroupMergedHandler wumThreshHandler) const;
+
+    //! Generate code to gather input from the presynaptic neurons marked by genPostSpanMarkActive into postsynaptic neurons [begin, end)
+    void genPostSpanGather(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &popSubs,
+                           SynapseGroupMergedHandler wumSimHandler, const std::string &begin, const std::string &end) const;
+
+    //! Generate code to clear the presynaptic neurons marked by genPostSpanMarkActive
+    void genPostSpanReset(CodeStream &os, const SynapseGroupMerged &sg) const;
+
+    //! Get the expression used to access the index of the first synapse in a row of SPARSE or CSR connectivity
+    std::string getSparseRowStart(const SynapseGroupMerged &sg, const std::string &row) const;
+
+    //! Get the expression used to access the length of a row of SPARSE or CSR connectivity
+    std::string getSparseRowLength(const SynapseGroupMerged &sg, const std::string &row) const;
+
+    //! Generate code to record the spikes and spike-like events processed by the current group of a merged
+    //! presynaptic update group and the synapses they processed in its performance counter
+    void genRecordPresynapticPerformanceCounter(CodeStream &os, const SynapseGroupMerged &sg) const;
+
+    //! Generate code to record the postsynaptic spikes processed by the current group of a merged
+    //! postsynaptic update group and the synapses they processed in its performance counter
+    void genRecordPostsynapticPerformanceCounter(CodeStream &os, const SynapseGroupMerged &sg) const;
+
+    //! Generate code to record the synapses processed by the current group of a merged synapse dynamics group in its performance counter
+    void genRecordSynapseDynamicsPerformanceCounter(CodeStream &os, const SynapseGroupMerged &sg) const;
+
+    //! Generate a neuron update loop over [begin, end) which records spikes in a mask rather than the spike buffer
+    void genSIMDNeuronUpdateLoop(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &funcSubs,
+                                 NeuronGroupSimHandler simHandler, const std::string &begin, const std::string &end) const;
+
+    //! Generate code to compact the spikes recorded in the masks by genSIMDNeuronUpdateLoop into the spike buffer
+    void genSIMDSpikeCompaction(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &funcSubs,
+                                NeuronGroupMergedHandler wuVarUpdateHandler) const;
+
+    //! Should neurons in this merged group be updated using genSIMDNeuronUpdateLoop
+    bool isSIMDNeuronUpdate(const NeuronGroupMerged &ng) const;
+
+    //! Add substitutions for the RNG used to simulate neuron subs["id"] and, if it's counter-based, generate code to create it
+    void addNeuronRNGSubstitutions(CodeStream &os, const NeuronGroupMerged &ng, Substitutions &popSubs) const;
+
+    //! Add substitutions for the RNG used to build row 'i' of sparse connectivity and, if it's counter-based, generate code to create it
+    void addConnectivityInitRNGSubstitutions(CodeStream &os, const SynapseGroupMerged &sg, Substitutions &popSubs) const;
+
+    //! Is sparse connectivity of this synapse group built using counter-based RNG streams
+    bool isConnectivityInitCounterRNG(const SynapseGroupInternal &sg) const;
+
+    //! Can rows of this synapse group's sparse connectivity be built in any order
+    /*! This is the case if building rows doesn't require an RNG or each row has its own counter-based RNG stream */
+    bool isConnectivityInitRowIndependent(const SynapseGroupInternal &sg) const;
+
+    //! Generate code to write the spike (or spike-like event) emitted by neuron subs["id"] into the
+    //! current delay slot of the spike buffer at spikeIndex and, if required, update its spike time
+    void genWriteSpike(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &subs, bool trueSpike, const std::string &spikeIndex) const;
+
+    //! Get the expression used to access the spike count in the current delay slot
+    std::string getSpikeCount(const NeuronGroupMerged &ng, bool trueSpike) const;
+
+    //! Get the offset into the spike buffer for the current delay slot
+    std::string getSpikeQueueOffset(const NeuronGroupMerged &ng, bool trueSpike) const;
+
 private:
     //--------------------------------------------------------------------------
     // Private methods
     //--------------------------------------------------------------------------
     void genPresynapticUpdate(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &popSubs,
-                              bool trueSpike, SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler) const;
+                              bool trueSpike, SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
+                              SynapseGroupMergedHandler wumProceduralConnectHandler) const;
 
     void genEmitSpike(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &subs, bool trueSpike) const;
 
-  
+    void genWriteSpikeTime(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &subs) const;
+
+    //! Get the size of the spike masks required to update model using SIMD neuron update loops
+    size_t getSIMDSpikeMaskSize(const ModelSpecMerged &modelMerged) const;
+
+    //! Are any neuron groups simulated using counter-based RNG streams
+    bool isSimCounterRNGRequired(const ModelSpecMerged &modelMerged) const;
+
+    //! Is sparse connectivity of any synapse groups built using counter-based RNG streams
+    bool isConnectivityInitCounterRNGRequired(const ModelSpecMerged &modelMerged) const;
+
+    //! Get the size of the arrays used to mark active presynaptic neurons when gathering input target-by-target
+    size_t getPostSpanScratchSize(const ModelSpecMerged &modelMerged) const;
+
     //--------------------------------------------------------------------------
     // Members
     //--------------------------------------------------------------------------
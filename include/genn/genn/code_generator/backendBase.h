@@ -28,10 +28,21 @@ namespace CodeGenerator
 }
 
 //--------------------------------------------------------------------------
-// CodeGenerator::PreferencesBase
+// CodeGenerator::ModuleLayout
 //--------------------------------------------------------------------------
 namespace CodeGenerator
 {
+//! Methods for dividing generated code between the modules compiled into the runner library
+enum class ModuleLayout
+{
+    STANDARD,   //!< Separate neuron update, synapse update, initialisation and runner modules
+    SHARDED,    //!< Where backend supports it, additionally place the code for each merged group in its own module so modules can be compiled in parallel
+    UNITY,      //!< Compile all generated code as a single module which is typically faster for small models
+};
+
+//--------------------------------------------------------------------------
+// CodeGenerator::PreferencesBase
+//--------------------------------------------------------------------------
 //! Base class for backend preferences - can be accessed via a global in 'classic' C++ code generator
 struct PreferencesBase
 {
@@ -54,6 +65,9 @@ struct PreferencesBase
     //! NVCC compiler options they may want to use for all GPU code (used for unix based platforms)
     std::string userNvccFlagsGNU = "";
 
+    //! How generated code should be divided between modules
+    ModuleLayout moduleLayout = ModuleLayout::STANDARD;
+
     //! Logging level to use for code generation
     plog::Severity logLevel = plog::info;
 };
@@ -117,6 +131,10 @@ public:
     //--------------------------------------------------------------------------
     typedef std::function<void(CodeStream &)> HostHandler;
 
+    //! Callback function type used to place code in a module of its own
+    /*! Called with the name of the module and a callback to write its code to a CodeStream */
+    typedef std::function<void(const std::string &, HostHandler)> ShardHandler;
+
     typedef std::function<void(CodeStream &, Substitutions&)> Handler;
     
     template<typename T>
@@ -143,10 +161,11 @@ public:
     /*! \param os                       CodeStream to write function to
         \param model                    merged model to generate code for
         \param simHandler               callback to write platform-independent code to update an individual NeuronGroup
-        \param wuVarUpdateHandler       callback to write platform-independent code to update pre and postsynaptic weight update model variables when neuron spikes*/
+        \param wuVarUpdateHandler       callback to write platform-independent code to update pre and postsynaptic weight update model variables when neuron spikes
+        \param shardHandler             if set, callback backend can use to place the code for each merged group in a module of its own*/
     virtual void genNeuronUpdate(CodeStream &os, const ModelSpecMerged &modelMerged,
                                  NeuronGroupSimHandler simHandler, NeuronGroupMergedHandler wuVarUpdateHandler,
-                                 HostHandler pushEGPHandler) const = 0;
+                                 HostHandler pushEGPHandler, ShardHandler shardHandler) const = 0;
 
     //! Generate platform-specific function to update the state of all synapses
     /*! \param os                           CodeStream to write function to
@@ -165,17 +184,19 @@ public:
                                             "id_pre", "id_post" and "id_syn" variables will be provided to callback via Substitutions.
         \param synapseDynamicsHandler       callback to write platform-independent code to update time-driven synapse dynamics.
                                             "id_pre", "id_post" and "id_syn" variables; and either "addToInSynDelay" or "addToInSyn" function will be provided
-                                            to callback via Substitutions.*/
+                                            to callback via Substitutions.
+        \param shardHandler                 if set, callback backend can use to place the code for each merged group in a module of its own*/
     virtual void genSynapseUpdate(CodeStream &os, const ModelSpecMerged &modelMerged,
                                   SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
                                   SynapseGroupMergedHandler wumEventHandler, SynapseGroupMergedHandler wumProceduralConnectHandler,
                                   SynapseGroupMergedHandler postLearnHandler, SynapseGroupMergedHandler synapseDynamicsHandler,
-                                  HostHandler pushEGPHandler) const = 0;
+                                  HostHandler pushEGPHandler, ShardHandler shardHandler) const = 0;
 
     virtual void genInit(CodeStream &os, const ModelSpecMerged &modelMerged,
                          NeuronGroupMergedHandler localNGHandler, SynapseGroupMergedHandler sgDenseInitHandler, 
                          SynapseGroupMergedHandler sgSparseConnectHandler, SynapseGroupMergedHandler sgSparseInitHandler,
-                         HostHandler initPushEGPHandler, HostHandler initSparsePushEGPHandler) const = 0;
+                         HostHandler initPushEGPHandler, HostHandler initSparsePushEGPHandler,
+                         ShardHandler shardHandler) const = 0;
 
     //! Gets the stride used to access synaptic matrix rows, taking into account sparse data structure, padding etc
     virtual size_t getSynapticMatrixRowStride(const SynapseGroupInternal &sg) const = 0;
@@ -263,6 +284,19 @@ public:
     //! Generate code to return amount of free 'device' memory in bytes
     virtual void genReturnFreeDeviceMemoryBytes(CodeStream &os) const = 0;
 
+    //! Generate code to write an array which is only located on the 'device' to the checkpoint stream
+    virtual void genCheckpointDeviceArraySave(CodeStream &os, const std::string &type, const std::string &name, size_t count) const = 0;
+
+    //! Generate code to read an array which is only located on the 'device' from the checkpoint stream
+    virtual void genCheckpointDeviceArrayLoad(CodeStream &os, const std::string &type, const std::string &name, size_t count) const = 0;
+
+    //! Generate code to write any backend-specific state, such as RNGs, to the checkpoint stream
+    virtual void genCheckpointSave(CodeStream &os, const ModelSpecMerged &modelMerged) const = 0;
+
+    //! Generate code to read any backend-specific state from the checkpoint stream and
+    //! update any 'device' copies of host scalars which have been restored
+    virtual void genCheckpointLoad(CodeStream &os, const ModelSpecMerged &modelMerged) const = 0;
+
     //! This function can be used to generate a preamble for the GNU makefile used to build
     virtual void genMakefilePreamble(std::ostream &os) const = 0;
 
@@ -302,12 +336,22 @@ public:
     //! Different backends may implement synapse dynamics differently. Does this one require a synapse remapping data structure?
     virtual bool isSynRemapRequired() const = 0;
 
-    //! Different backends may implement synaptic plasticity differently. Does this one require a postsynaptic remapping data structure?
-    virtual bool isPostsynapticRemapRequired() const = 0;
+    //! Different backends may implement synaptic plasticity differently. Does this one require a postsynaptic remapping data structure for this synapse group?
+    virtual bool isPostsynapticRemapRequired(const SynapseGroupInternal &sg) const = 0;
 
     //! Is automatic copy mode enabled in the preferences?
     virtual bool isAutomaticCopyEnabled() const = 0;
 
+    //! Can host arrays be replaced by memory-mapped files i.e. does the device access host arrays directly?
+    virtual bool isArrayMappingSupported() const = 0;
+
+    //! Different backends may wake neurons in event-driven neuron groups differently. How many buckets does this one's calendar
+    //! queue of neurons have or, if it is zero, does it instead check every neuron's wake time every timestep?
+    virtual unsigned int getNumWakeQueueBuckets() const = 0;
+
+    //! How should generated code be divided between modules?
+    virtual ModuleLayout getModuleLayout() const = 0;
+
     //! How many bytes of memory does 'device' have
     virtual size_t getDeviceMemoryBytes() const = 0;
 
@@ -211,4 +211,27 @@ void neuronSubstitutionsInSynapticCode(
     const std::string &preVarSuffix = "",    //!< suffix to be used for presynaptic variable accesses - typically combined with prefix to wrap in function call such as __ldg(&XXX)
     const std::string &postVarPrefix = "",   //!< prefix to be used for postsynaptic variable accesses - typically combined with suffix to wrap in function call such as __ldg(&XXX)
     const std::string &postVarSuffix = "");  //!< suffix to be used for postsynaptic variable accesses - typically combined with prefix to wrap in function call such as __ldg(&XXX)
+
+//-------------------------------------------------------------------------
+/*!
+  \brief Get expression which reads weight update model variable from its storage, widening it to the variable's declared type
+
+  Scales of variables stored in fixed point formats are read from the StorageScale field of the merged group
+*/
+//-------------------------------------------------------------------------
+std::string getWUVarLoad(const SynapseGroupInternal &sg, size_t varIndex, const std::string &storage);
+
+//-------------------------------------------------------------------------
+/*!
+  \brief Get expression which narrows value to the storage type of weight update model variable
+*/
+//-------------------------------------------------------------------------
+std::string getWUVarStore(const SynapseGroupInternal &sg, size_t varIndex, const std::string &value);
+
+//-------------------------------------------------------------------------
+/*!
+  \brief Generate functions used to convert between single-precision and reduced-precision storage formats
+*/
+//-------------------------------------------------------------------------
+void genReducedPrecisionStorageFunctions(CodeStream &os);
 }   // namespace CodeGenerator
@@ -25,5 +25,9 @@ namespace filesystem
 //--------------------------------------------------------------------------
 namespace CodeGenerator
 {
+    //! Write contents to file, unless file already exists with identical contents, returning whether file was written
+    /*! This leaves the timestamps of unchanged files alone so build systems don't needlessly rebuild them */
+    GENN_EXPORT bool writeFileIfChanged(const filesystem::path &path, const std::string &contents);
+
     GENN_EXPORT std::vector<std::string> generateAll(const ModelSpecInternal &model, const BackendBase &backend, const filesystem::path &outputPath, bool standaloneModules=false);
 }
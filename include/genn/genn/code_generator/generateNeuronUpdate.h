@@ -15,5 +15,6 @@ class ModelSpecMerged;
 namespace CodeGenerator
 {
 void generateNeuronUpdate(CodeStream &os, const MergedEGPMap &mergedEGPs, const ModelSpecMerged &modelMerged,
-                          const BackendBase &backend, bool standaloneModules);
+                          const BackendBase &backend, bool standaloneModules,
+                          BackendBase::ShardHandler shardHandler);
 }
@@ -36,28 +36,34 @@ public:
     //------------------------------------------------------------------------
     typedef std::function<std::string(const typename T::GroupInternal &, size_t)> GetFieldValueFunc;
 
-    MergedStructGenerator(const T &mergedGroup) : m_MergedGroup(mergedGroup)
+    MergedStructGenerator(const T &mergedGroup, unsigned int batchSize = 1)
+    :   m_MergedGroup(mergedGroup), m_BatchSize(batchSize)
     {
     }
 
     //------------------------------------------------------------------------
     // Public API
     //------------------------------------------------------------------------
-    void addField(const std::string &type, const std::string &name, GetFieldValueFunc getFieldValue, FieldType fieldType = FieldType::Standard)
+    //! Add field to structure
+    /*! If batchStride is specified, it is an expression (which can refer to other fields via 'group.')
+        for the number of elements each batch of a batched model is offset by within the array this field points to */
+    void addField(const std::string &type, const std::string &name, GetFieldValueFunc getFieldValue,
+                  FieldType fieldType = FieldType::Standard, const std::string &batchStride = "")
     {
-        m_Fields.emplace_back(type, name, getFieldValue, fieldType);
+        m_Fields.emplace_back(type, name, getFieldValue, fieldType, batchStride);
     }
 
-    void addPointerField(const std::string &type, const std::string &name, const std::string &prefix)
+    void addPointerField(const std::string &type, const std::string &name, const std::string &prefix, const std::string &batchStride = "")
     {
         assert(!Utils::isTypePointer(type));
-        addField(type + "*", name, [prefix](const typename T::GroupInternal &g, size_t){ return prefix + g.getName(); });
+        addField(type + "*", name, [prefix](const typename T::GroupInternal &g, size_t){ return prefix + g.getName(); },
+                 FieldType::Standard, batchStride);
     }
 
-    void addVars(const std::vector<Models::Base::Var> &vars, const std::string &prefix)
+    void addVars(const std::vector<Models::Base::Var> &vars, const std::string &prefix, const std::string &batchStride = "")
     {
         for(const auto &v : vars) {
-            addPointerField(v.type, v.name, prefix + v.name);
+            addPointerField(v.type, v.name, prefix + v.name, batchStride);
         }
     }
 
@@ -87,6 +93,20 @@ public:
 
         definitionsInternal << ";" << std::endl;
 
+        // If model is batched, write function to offset pointers in a copy of this struct to a given batch
+        if(m_BatchSize > 1) {
+            definitionsInternal << "inline void batchMerged" << name << "Group" << index << "(Merged" << name << "Group" << index << " &group, unsigned int batch)";
+            {
+                CodeGenerator::CodeStream::Scope b(definitionsInternal);
+                for(const auto &f : m_Fields) {
+                    if(!std::get<4>(f).empty()) {
+                        definitionsInternal << "group." << std::get<1>(f) << " += batch * (" << std::get<4>(f) << ");" << std::endl;
+                    }
+                }
+            }
+            definitionsInternal << std::endl;
+        }
+
         // Write local array of these structs containing individual neuron group pointers etc
         // **NOTE** scope will hopefully reduce stack usage
         {
@@ -133,7 +153,8 @@ private:
     // Members
     //------------------------------------------------------------------------
     const T &m_MergedGroup;
-    std::vector<std::tuple<std::string, std::string, GetFieldValueFunc, FieldType>> m_Fields;
+    const unsigned int m_BatchSize;
+    std::vector<std::tuple<std::string, std::string, GetFieldValueFunc, FieldType, std::string>> m_Fields;
 };
 
 //--------------------------------------------------------------------------
@@ -142,8 +163,8 @@ private:
 class MergedNeuronStructGenerator : public MergedStructGenerator<CodeGenerator::NeuronGroupMerged>
 {
 public:
-    MergedNeuronStructGenerator(const CodeGenerator::NeuronGroupMerged &mergedGroup)
-    :   MergedStructGenerator<CodeGenerator::NeuronGroupMerged>(mergedGroup)
+    MergedNeuronStructGenerator(const CodeGenerator::NeuronGroupMerged &mergedGroup, unsigned int batchSize = 1)
+    :   MergedStructGenerator<CodeGenerator::NeuronGroupMerged>(mergedGroup, batchSize)
     {
     }
 
@@ -151,36 +172,42 @@ public:
     // Public API
     //------------------------------------------------------------------------
     void addMergedInSynPointerField(const std::string &type, const std::string &name, size_t archetypeIndex, const std::string &prefix,
-                                    const std::vector<std::vector<std::pair<SynapseGroupInternal*, std::vector<SynapseGroupInternal*>>>> &sortedMergedInSyns)
+                                    const std::vector<std::vector<std::pair<SynapseGroupInternal*, std::vector<SynapseGroupInternal*>>>> &sortedMergedInSyns,
+                                    const std::string &batchStride = "")
     {
         assert(!Utils::isTypePointer(type));
         addField(type + "*", name + std::to_string(archetypeIndex),
                  [prefix, &sortedMergedInSyns, archetypeIndex](const NeuronGroupInternal&, size_t groupIndex)
                  {
                      return prefix + sortedMergedInSyns.at(groupIndex).at(archetypeIndex).first->getPSModelTargetName();
-                 });
+                 },
+                 FieldType::Standard, batchStride);
     }
 
     void addCurrentSourcePointerField(const std::string &type, const std::string &name, size_t archetypeIndex, const std::string &prefix,
-                                      const std::vector<std::vector<CurrentSourceInternal*>> &sortedCurrentSources)
+                                      const std::vector<std::vector<CurrentSourceInternal*>> &sortedCurrentSources,
+                                      const std::string &batchStride = "")
     {
         assert(!Utils::isTypePointer(type));
         addField(type + "*", name + std::to_string(archetypeIndex),
                  [prefix, &sortedCurrentSources, archetypeIndex](const NeuronGroupInternal&, size_t groupIndex)
                  {
                      return prefix + sortedCurrentSources.at(groupIndex).at(archetypeIndex)->getName();
-                 });
+                 },
+                 FieldType::Standard, batchStride);
     }
 
     void addSynPointerField(const std::string &type, const std::string &name, size_t archetypeIndex, const std::string &prefix,
-                            const std::vector<std::vector<SynapseGroupInternal*>> &sortedSyn)
+                            const std::vector<std::vector<SynapseGroupInternal*>> &sortedSyn,
+                            const std::string &batchStride = "")
     {
         assert(!Utils::isTypePointer(type));
         addField(type + "*", name + std::to_string(archetypeIndex),
                  [prefix, &sortedSyn, archetypeIndex](const NeuronGroupInternal&, size_t groupIndex)
                  {
                      return prefix + sortedSyn.at(groupIndex).at(archetypeIndex)->getName();
-                 });
+                 },
+                 FieldType::Standard, batchStride);
 
     }
 };
@@ -190,30 +217,33 @@ public:
 class MergedSynapseStructGenerator : public MergedStructGenerator<CodeGenerator::SynapseGroupMerged>
 {
 public:
-    MergedSynapseStructGenerator(const CodeGenerator::SynapseGroupMerged &mergedGroup)
-    :   MergedStructGenerator<CodeGenerator::SynapseGroupMerged>(mergedGroup)
+    MergedSynapseStructGenerator(const CodeGenerator::SynapseGroupMerged &mergedGroup, unsigned int batchSize = 1)
+    :   MergedStructGenerator<CodeGenerator::SynapseGroupMerged>(mergedGroup, batchSize)
     {
     }
 
     //------------------------------------------------------------------------
     // Public API
     //------------------------------------------------------------------------
-    void addPSPointerField(const std::string &type, const std::string &name, const std::string &prefix)
+    void addPSPointerField(const std::string &type, const std::string &name, const std::string &prefix, const std::string &batchStride = "")
     {
         assert(!Utils::isTypePointer(type));
-        addField(type + "*", name, [prefix](const SynapseGroupInternal &sg, size_t){ return prefix + sg.getPSModelTargetName(); });
+        addField(type + "*", name, [prefix](const SynapseGroupInternal &sg, size_t){ return prefix + sg.getPSModelTargetName(); },
+                 FieldType::Standard, batchStride);
     }
 
-    void addSrcPointerField(const std::string &type, const std::string &name, const std::string &prefix)
+    void addSrcPointerField(const std::string &type, const std::string &name, const std::string &prefix, const std::string &batchStride = "")
     {
         assert(!Utils::isTypePointer(type));
-        addField(type + "*", name, [prefix](const SynapseGroupInternal &sg, size_t){ return prefix + sg.getSrcNeuronGroup()->getName(); });
+        addField(type + "*", name, [prefix](const SynapseGroupInternal &sg, size_t){ return prefix + sg.getSrcNeuronGroup()->getName(); },
+                 FieldType::Standard, batchStride);
     }
 
-    void addTrgPointerField(const std::string &type, const std::string &name, const std::string &prefix)
+    void addTrgPointerField(const std::string &type, const std::string &name, const std::string &prefix, const std::string &batchStride = "")
     {
         assert(!Utils::isTypePointer(type));
-        addField(type + "*", name, [prefix](const SynapseGroupInternal &sg, size_t){ return prefix + sg.getTrgNeuronGroup()->getName(); });
+        addField(type + "*", name, [prefix](const SynapseGroupInternal &sg, size_t){ return prefix + sg.getTrgNeuronGroup()->getName(); },
+                 FieldType::Standard, batchStride);
     }
 
     void addSrcEGPField(const Snippet::Base::EGP &egp)
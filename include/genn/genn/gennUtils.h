@@ -1,10 +1,12 @@
 #pragma once
 
 // Standard C++ includes
+#include <cstdint>
 #include <iomanip>
 #include <limits>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 // GeNN includes
@@ -41,6 +43,50 @@ GENN_EXPORT bool isTypePointer(const std::string &type);
 //--------------------------------------------------------------------------
 GENN_EXPORT std::string getUnderlyingType(const std::string &type);
 
+//--------------------------------------------------------------------------
+//! \brief Update 64-bit FNV-1a hash with contents of string (starts new hash if none is passed)
+//--------------------------------------------------------------------------
+GENN_EXPORT uint64_t hashString(const std::string &string, uint64_t hash = 14695981039346656037ull);
+
+//--------------------------------------------------------------------------
+//! \brief Update 64-bit FNV-1a hash with raw bytes (starts new hash if none is passed)
+//--------------------------------------------------------------------------
+GENN_EXPORT uint64_t hashBytes(const void *data, size_t size, uint64_t hash = 14695981039346656037ull);
+
+//--------------------------------------------------------------------------
+//! \brief Update 64-bit FNV-1a hash with arithmetic value (starts new hash if none is passed)
+//--------------------------------------------------------------------------
+template<typename T, typename std::enable_if<std::is_arithmetic<T>::value>::type * = nullptr>
+uint64_t hashValue(T value, uint64_t hash = 14695981039346656037ull)
+{
+    // **NOTE** positive and negative zero compare equal so must also hash equally
+    if(value == T{0}) {
+        value = T{0};
+    }
+    return hashBytes(&value, sizeof(T), hash);
+}
+
+//--------------------------------------------------------------------------
+//! \brief Update 64-bit FNV-1a hash with string (starts new hash if none is passed)
+//--------------------------------------------------------------------------
+inline uint64_t hashValue(const std::string &string, uint64_t hash = 14695981039346656037ull)
+{
+    return hashString(string, hash);
+}
+
+//--------------------------------------------------------------------------
+//! \brief Update 64-bit FNV-1a hash with size and contents of vector (starts new hash if none is passed)
+//--------------------------------------------------------------------------
+template<typename T>
+uint64_t hashValue(const std::vector<T> &values, uint64_t hash = 14695981039346656037ull)
+{
+    hash = hashValue(values.size(), hash);
+    for(const T v : values) {
+        hash = hashValue(v, hash);
+    }
+    return hash;
+}
+
 //--------------------------------------------------------------------------
 //! \brief This function writes a floating point value to a stream -setting the precision so no digits are lost
 //--------------------------------------------------------------------------
@@ -142,9 +142,20 @@ public:
     //! Set whether timers and timing commands are to be included
     void setTiming(bool timingEnabled){ m_TimingEnabled = timingEnabled; }
 
+    //! Set whether per-population performance counters are to be included
+    /*! Each update of each population records its duration, the spikes it emitted or processed and the
+        synapses it processed into counters which can be read using getPerformanceCounters() and exported
+        as a Chrome trace using writePerformanceTrace() */
+    void setPerformanceCounters(bool performanceCountersEnabled){ m_PerformanceCountersEnabled = performanceCountersEnabled; }
+
     //! Set the random seed (disables automatic seeding if argument not 0).
     void setSeed(unsigned int rngSeed){ m_Seed = rngSeed; }
 
+    //! Set number of independent instances of the model to simulate in parallel
+    /*! Each neuron and synapse state variable gains a batch dimension while
+        connectivity and extra global parameters are shared between instances */
+    void setBatchSize(unsigned int batchSize);
+
     //! What is the default location for model state variables?
     /*! Historically, everything was allocated on both the host AND device */
     void setDefaultVarLocation(VarLocation loc){ m_DefaultVarLocation = loc; }
@@ -179,9 +190,15 @@ public:
     //! Get the random seed
     unsigned int getSeed() const { return m_Seed; }
 
+    //! Gets the number of independent instances of the model to simulate
+    unsigned int getBatchSize() const { return m_BatchSize; }
+
     //! Are timers and timing commands enabled
     bool isTimingEnabled() const{ return m_TimingEnabled; }
 
+    //! Are per-population performance counters enabled
+    bool isPerformanceCountersEnabled() const{ return m_PerformanceCountersEnabled; }
+
     // PUBLIC NEURON FUNCTIONS
     //========================
     //! How many neurons make up the entire model
@@ -419,6 +436,9 @@ protected:
     //! Are any variables in any populations in this model using zero-copy memory?
     bool zeroCopyInUse() const;
 
+    //! Do any populations in this model record spikes into recording buffers?
+    bool isRecordingInUse() const;
+
     //! Get std::map containing local named NeuronGroup objects in model
     const std::map<std::string, NeuronGroupInternal> &getNeuronGroups() const{ return m_LocalNeuronGroups; }
 
@@ -463,9 +483,15 @@ private:
     //! Whether timing code should be inserted into model
     bool m_TimingEnabled;
 
+    //! Whether per-population performance counters should be inserted into model
+    bool m_PerformanceCountersEnabled;
+
     //! RNG seed
     unsigned int m_Seed;
 
+    //! Number of independent instances of the model to simulate
+    unsigned int m_BatchSize;
+
     //! What is the default location for model state variables? Historically, everything was allocated on both host AND device
     VarLocation m_DefaultVarLocation;
 
@@ -105,6 +105,25 @@ public:
         and only applies to extra global parameters which are pointers. */
     void setExtraGlobalParamLocation(const std::string &paramName, VarLocation loc);
 
+    //! Enables and disable spike recording for this population
+    /*! When enabled, neuron update writes a bitfield of the neurons which spiked each timestep into
+        a ring buffer, allocated using allocateRecordingBuffers, which can be copied to the host in
+        one go using pullRecordingBuffersFromDevice rather than copying spikes every timestep */
+    void setSpikeRecordingEnabled(bool enabled) { m_SpikeRecordingEnabled = enabled; }
+
+    //! Enables and disables event-driven update of this population
+    /*! When enabled, neurons are only updated on timesteps when they receive synaptic input or when the
+        neuron model's quiescent steps code indicates they might reach threshold. Skipped timesteps are
+        applied lazily using the neuron model's catch-up code so, until a neuron is next updated, its
+        state variables reflect the time of its last update rather than the current time.
+        As decaying postsynaptic models such as ExpCurr only reach zero input after a very long time, inSyn values whose
+        magnitude falls below inSynThreshold are flushed to zero so neurons receiving this input can become quiescent. */
+    void setEventDriven(bool eventDriven, double inSynThreshold = 0.0)
+    {
+        m_EventDriven = eventDriven;
+        m_EventDrivenInSynThreshold = inSynThreshold;
+    }
+
     //------------------------------------------------------------------------
     // Public const methods
     //------------------------------------------------------------------------
@@ -150,6 +169,15 @@ public:
     /*! This is only used by extra global parameters which are pointers*/
     VarLocation getExtraGlobalParamLocation(size_t index) const{ return m_ExtraGlobalParamLocation.at(index); }
 
+    //! Is spike recording enabled for this population?
+    bool isSpikeRecordingEnabled() const { return m_SpikeRecordingEnabled; }
+
+    //! Is this population updated in an event-driven manner?
+    bool isEventDriven() const { return m_EventDriven; }
+
+    //! Gets magnitude below which inSyn values of event-driven population are flushed to zero
+    double getEventDrivenInSynThreshold() const { return m_EventDrivenInSynThreshold; }
+
     //! Does this neuron group require an RNG to simulate?
     bool isSimRNGRequired() const;
 
@@ -164,7 +192,8 @@ protected:
         m_Name(name), m_NumNeurons(numNeurons), m_NeuronModel(neuronModel), m_Params(params), m_VarInitialisers(varInitialisers),
         m_NumDelaySlots(1), m_VarQueueRequired(varInitialisers.size(), false), m_SpikeLocation(defaultVarLocation), m_SpikeEventLocation(defaultVarLocation),
         m_SpikeTimeLocation(defaultVarLocation), m_VarLocation(varInitialisers.size(), defaultVarLocation),
-        m_ExtraGlobalParamLocation(neuronModel->getExtraGlobalParams().size(), defaultExtraGlobalParamLocation)
+        m_ExtraGlobalParamLocation(neuronModel->getExtraGlobalParams().size(), defaultExtraGlobalParamLocation),
+        m_SpikeRecordingEnabled(false), m_EventDriven(false), m_EventDrivenInSynThreshold(0.0)
     {
     }
 
@@ -227,6 +256,14 @@ protected:
     /*! NOTE: this can only be called after model is finalized */
     bool canInitBeMerged(const NeuronGroup &other) const;
 
+    //! Get hash digest of the properties canBeMerged compares directly - groups which can be merged always have the same digest
+    /*! NOTE: this can only be called after model is finalized */
+    uint64_t getMergeHashDigest() const;
+
+    //! Get hash digest of the properties canInitBeMerged compares directly - groups whose initialisation can be merged always have the same digest
+    /*! NOTE: this can only be called after model is finalized */
+    uint64_t getInitMergeHashDigest() const;
+
 private:
     //------------------------------------------------------------------------
     // Private methods
@@ -269,4 +306,13 @@ private:
 
     //! Location of extra global parameters
     std::vector<VarLocation> m_ExtraGlobalParamLocation;
+
+    //! Is spike recording enabled for this population?
+    bool m_SpikeRecordingEnabled;
+
+    //! Is this population updated in an event-driven manner?
+    bool m_EventDriven;
+
+    //! Magnitude below which inSyn values of event-driven population are flushed to zero
+    double m_EventDrivenInSynThreshold;
 };
@@ -37,4 +37,6 @@ public:
     using NeuronGroup::isVarQueueRequired;
     using NeuronGroup::canBeMerged;
     using NeuronGroup::canInitBeMerged;
+    using NeuronGroup::getMergeHashDigest;
+    using NeuronGroup::getInitMergeHashDigest;
 };
@@ -22,6 +22,8 @@
 #define SET_SUPPORT_CODE(SUPPORT_CODE) virtual std::string getSupportCode() const override{ return SUPPORT_CODE; }
 #define SET_ADDITIONAL_INPUT_VARS(...) virtual ParamValVec getAdditionalInputVars() const override{ return __VA_ARGS__; }
 #define SET_NEEDS_AUTO_REFRACTORY(AUTO_REFRACTORY_REQUIRED) virtual bool isAutoRefractoryRequired() const override{ return AUTO_REFRACTORY_REQUIRED; }
+#define SET_CATCH_UP_CODE(CATCH_UP_CODE) virtual std::string getCatchUpCode() const override{ return CATCH_UP_CODE; }
+#define SET_QUIESCENT_STEPS_CODE(QUIESCENT_STEPS_CODE) virtual std::string getQuiescentStepsCode() const override{ return QUIESCENT_STEPS_CODE; }
 
 //----------------------------------------------------------------------------
 // NeuronModels::Base
@@ -60,6 +62,16 @@ public:
     //! Does this model require auto-refractory logic?
     virtual bool isAutoRefractoryRequired() const{ return true; }
 
+    //! Gets code which advances the state of the neuron model by $(elapsed) timesteps without input.
+    /*! This is used by event-driven neuron groups to bring neurons which have been skipped up to date
+        before they are next updated and can be empty if skipping timesteps leaves the state unchanged. */
+    virtual std::string getCatchUpCode() const{ return ""; }
+
+    //! Gets code which sets $(quiescentSteps) to a conservative number of timesteps
+    /*! for which the neuron can be skipped, in the absence of input, without missing a spike.
+        This is evaluated after each update of an event-driven neuron group and is required for them to be used. */
+    virtual std::string getQuiescentStepsCode() const{ return ""; }
+
     //----------------------------------------------------------------------------
     // Public API
     //----------------------------------------------------------------------------
@@ -241,6 +253,34 @@ public:
     SET_VARS({{"V", "scalar"}, {"RefracTime", "scalar"}});
 
     SET_NEEDS_AUTO_REFRACTORY(false);
+
+    // Without input, finish refractory period and then decay analytically towards steady state
+    SET_CATCH_UP_CODE(
+        "unsigned int remaining = $(elapsed);\n"
+        "while(remaining > 0 && $(RefracTime) > 0.0) {\n"
+        "  $(RefracTime) -= DT;\n"
+        "  remaining--;\n"
+        "}\n"
+        "if(remaining > 0) {\n"
+        "  const scalar alpha = ($(Ioffset) * $(Rmembrane)) + $(Vrest);\n"
+        "  $(V) = alpha - (pow($(ExpTC), (scalar)remaining) * (alpha - $(V)));\n"
+        "}\n");
+
+    // Neuron can't spike during refractory period or, if steady state is below
+    // threshold, ever; otherwise it can't spike until it has decayed past threshold
+    SET_QUIESCENT_STEPS_CODE(
+        "const scalar alpha = ($(Ioffset) * $(Rmembrane)) + $(Vrest);\n"
+        "const scalar refracSteps = ($(RefracTime) > 0.0) ? floor($(RefracTime) / DT) : 0.0;\n"
+        "if($(V) >= $(Vthresh)) {\n"
+        "  $(quiescentSteps) = 0;\n"
+        "}\n"
+        "else if(alpha < $(Vthresh)) {\n"
+        "  $(quiescentSteps) = 1000000000;\n"
+        "}\n"
+        "else {\n"
+        "  const scalar decaySteps = floor(log((alpha - $(Vthresh)) / (alpha - $(V))) / log($(ExpTC))) - 1.0;\n"
+        "  $(quiescentSteps) = (unsigned int)fmin(refracSteps + fmax(decaySteps, 0.0), 1000000000.0);\n"
+        "}\n");
 };
 
 //----------------------------------------------------------------------------
@@ -256,6 +296,7 @@ public:
 
     SET_THRESHOLD_CONDITION_CODE("0");
     SET_NEEDS_AUTO_REFRACTORY(false);
+    SET_QUIESCENT_STEPS_CODE("$(quiescentSteps) = 1000000000;\n");
 };
 
 //----------------------------------------------------------------------------
@@ -285,6 +326,16 @@ public:
     SET_VARS( {{"startSpike", "unsigned int"}, {"endSpike", "unsigned int", VarAccess::READ_ONLY}} );
     SET_EXTRA_GLOBAL_PARAMS( {{"spikeTimes", "scalar*"}} );
     SET_NEEDS_AUTO_REFRACTORY(false);
+
+    // Neuron can be skipped until the timestep before its next spike
+    SET_QUIESCENT_STEPS_CODE(
+        "if($(startSpike) == $(endSpike)) {\n"
+        "  $(quiescentSteps) = 1000000000;\n"
+        "}\n"
+        "else {\n"
+        "  const scalar steps = floor(($(spikeTimes)[$(startSpike)] - $(t)) / DT) - 1.0;\n"
+        "  $(quiescentSteps) = (unsigned int)fmin(fmax(steps, 0.0), 1000000000.0);\n"
+        "}\n");
 };
 
 //----------------------------------------------------------------------------
@@ -32,7 +32,18 @@ public:
     enum class SpanType
     {
         POSTSYNAPTIC,
-        PRESYNAPTIC
+        PRESYNAPTIC,
+        AUTOMATIC   //!< Backend chooses, defaulting to POSTSYNAPTIC on CUDA
+    };
+
+    //! Formats in which weight update model per-synapse state variables can be stored
+    enum class VarStorage
+    {
+        NATIVE,     //!< Stored using the type the variable is declared with
+        HALF,       //!< Stored as IEEE 754 half-precision floating point
+        BFLOAT16,   //!< Stored as bfloat16 floating point (truncated single-precision)
+        FIXED8,     //!< Stored as 8-bit signed fixed point, multiplied by a per-group scale when read
+        FIXED16,    //!< Stored as 16-bit signed fixed point, multiplied by a per-group scale when read
     };
 
     //------------------------------------------------------------------------
@@ -42,6 +53,12 @@ public:
     /*! This is ignored for simulations on hardware with a single memory space */
     void setWUVarLocation(const std::string &varName, VarLocation loc);
 
+    //! Set format used to store weight update model state variable
+    /*! Reduced-precision formats can only be used for floating point, read-only variables of synapse groups
+        with individual weights. Values are widened to the declared type of the variable whenever they are
+        read and, for fixed point formats, the stored integer is multiplied by scale. */
+    void setWUVarStorage(const std::string &varName, VarStorage storage, double scale = 1.0);
+
     //! Set location of weight update model presynaptic state variable
     /*! This is ignored for simulations on hardware with a single memory space */
     void setWUPreVarLocation(const std::string &varName, VarLocation loc);
@@ -87,12 +104,22 @@ public:
     //! Sets the maximum number of source neurons any target neuron can connect to
     /*! Use with synaptic matrix types with SynapseMatrixConnectivity::SPARSE and postsynaptic learning to optimise CUDA implementation */
     void setMaxSourceConnections(unsigned int maxPostConnections);
+
+    //! Sets the maximum number of synapses in this synapse group
+    /*! Use with synaptic matrix types with SynapseMatrixConnectivity::CSR to size the tightly-packed
+        connectivity and synapse variable arrays. If this is not set, space is allocated for every
+        source neuron to make the maximum number of connections */
+    void setMaxTotalConnections(unsigned int maxTotalConnections);
     
     //! Sets the maximum dendritic delay for synapses in this synapse group
     void setMaxDendriticDelayTimesteps(unsigned int maxDendriticDelay);
     
-    //! Set how CUDA implementation is parallelised
-    /*! with a thread per target neuron (default) or a thread per source spike */
+    //! Set how presynaptic update is parallelised
+    /*! On CUDA, with a thread per target neuron (default) or a thread per source spike.
+        On CPU, POSTSYNAPTIC gathers input target-by-target from the presynaptic neurons which
+        have spiked and PRESYNAPTIC scatters input from each spike. AUTOMATIC (default) scatters
+        unless the group is SPARSE and already has a column-major remap for postsynaptic learning,
+        in which case it chooses between them each timestep based on the spike count and fan-in */
     void setSpanType(SpanType spanType);
 
     //! Set how many threads CUDA implementation uses to process each spike when span type is PRESYNAPTIC
@@ -116,6 +143,7 @@ public:
     unsigned int getBackPropDelaySteps() const{ return m_BackPropDelaySteps; }
     unsigned int getMaxConnections() const{ return m_MaxConnections; }
     unsigned int getMaxSourceConnections() const{ return m_MaxSourceConnections; }
+    unsigned int getMaxTotalConnections() const;
     unsigned int getMaxDendriticDelayTimesteps() const{ return m_MaxDendriticDelayTimesteps; }
     SynapseMatrixType getMatrixType() const{ return m_MatrixType; }
 
@@ -158,6 +186,18 @@ public:
     //! Get location of weight update model per-synapse state variable by index
     VarLocation getWUVarLocation(size_t index) const{ return m_WUVarLocation.at(index); }
 
+    //! Get format used to store weight update model per-synapse state variable by index
+    VarStorage getWUVarStorage(size_t index) const{ return m_WUVarStorage.at(index); }
+
+    //! Get scale applied to weight update model per-synapse state variable stored in fixed point format by index
+    double getWUVarStorageScale(size_t index) const{ return m_WUVarStorageScale.at(index); }
+
+    //! Get type used to store weight update model per-synapse state variable by index
+    std::string getWUVarStorageType(size_t index) const;
+
+    //! Are any weight update model per-synapse state variables stored in reduced-precision formats?
+    bool isWUVarStorageReduced() const;
+
     //! Get location of weight update model presynaptic state variable by name
     VarLocation getWUPreVarLocation(const std::string &var) const;
 
@@ -302,6 +342,18 @@ protected:
     /*! NOTE: this can only be called after model is finalized */
     bool canConnectivityInitBeMerged(const SynapseGroup &other) const;
 
+    //! Get hash digest of the properties canWUBeMerged compares directly - groups which can be merged always have the same digest
+    /*! NOTE: this can only be called after model is finalized */
+    uint64_t getWUMergeHashDigest() const;
+
+    //! Get hash digest of the properties canWUInitBeMerged compares directly - groups whose initialisation can be merged always have the same digest
+    /*! NOTE: this can only be called after model is finalized */
+    uint64_t getWUInitMergeHashDigest() const;
+
+    //! Get hash digest of the properties canConnectivityInitBeMerged compares directly - groups whose connectivity initialisation can be merged always have the same digest
+    /*! NOTE: this can only be called after model is finalized */
+    uint64_t getConnectivityInitMergeHashDigest() const;
+
 private:
     //------------------------------------------------------------------------
     // Members
@@ -327,6 +379,9 @@ private:
     //! Maximum number of source neurons any target neuron can connect to
     unsigned int m_MaxSourceConnections;
 
+    //! Maximum number of synapses in population (zero if this should be calculated from m_MaxConnections)
+    unsigned int m_MaxTotalConnections;
+
     //! Maximum dendritic delay timesteps supported for synapses in this population
     unsigned int m_MaxDendriticDelayTimesteps;
     
@@ -385,6 +440,12 @@ private:
     //! Location of individual per-synapse state variables
     std::vector<VarLocation> m_WUVarLocation;
 
+    //! Format used to store individual per-synapse state variables
+    std::vector<VarStorage> m_WUVarStorage;
+
+    //! Scale applied to individual per-synapse state variables stored in fixed point formats
+    std::vector<double> m_WUVarStorageScale;
+
     //! Location of individual presynaptic state variables
     std::vector<VarLocation> m_WUPreVarLocation;
 
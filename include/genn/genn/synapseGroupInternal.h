@@ -47,4 +47,7 @@ public:
     using SynapseGroup::canWUPostInitBeMerged;
     using SynapseGroup::canPSInitBeMerged;
     using SynapseGroup::canConnectivityInitBeMerged;
+    using SynapseGroup::getWUMergeHashDigest;
+    using SynapseGroup::getWUInitMergeHashDigest;
+    using SynapseGroup::getConnectivityInitMergeHashDigest;
 };
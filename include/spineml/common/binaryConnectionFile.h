@@ -0,0 +1,118 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+// SpineMLCommon::BinaryConnectionFile
+//----------------------------------------------------------------------------
+//! Read-only memory mapping of the binary file used by SpineML connection lists
+/*! Each synapse is stored as a uint32 presynaptic index, a uint32 postsynaptic
+    index and, if the list has explicit delays, a float32 delay in ms */
+namespace SpineMLCommon
+{
+class BinaryConnectionFile
+{
+public:
+    BinaryConnectionFile(const std::string &filename, unsigned int numConnections, bool explicitDelay);
+    ~BinaryConnectionFile();
+
+    BinaryConnectionFile(const BinaryConnectionFile&) = delete;
+    BinaryConnectionFile &operator=(const BinaryConnectionFile&) = delete;
+
+    //------------------------------------------------------------------------
+    // Metadata
+    //------------------------------------------------------------------------
+    //! Properties of connection list which require a complete pass through the file to determine
+    struct Metadata
+    {
+        unsigned int maxRowLength;
+        bool heterogeneousDelay;
+        float maxDelayMs;
+    };
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    unsigned int getNumConnections() const{ return m_NumConnections; }
+    bool hasExplicitDelay() const{ return (m_WordsPerSynapse == 3); }
+
+    uint32_t getPre(size_t i) const{ return m_Words[i * m_WordsPerSynapse]; }
+    uint32_t getPost(size_t i) const{ return m_Words[(i * m_WordsPerSynapse) + 1]; }
+    float getDelay(size_t i) const
+    {
+        float delay;
+        std::memcpy(&delay, &m_Words[(i * m_WordsPerSynapse) + 2], sizeof(float));
+        return delay;
+    }
+
+    //! Scan file (in parallel) to determine its metadata or, if the sidecar
+    //! file written by a previous scan is up to date, read it from there instead
+    Metadata getMetadata(unsigned int numPre) const;
+
+    //------------------------------------------------------------------------
+    // Static API
+    //------------------------------------------------------------------------
+    //! How many threads should be used to process this many connections
+    static unsigned int getNumThreads(size_t numConnections);
+
+    //! Split range of connections evenly between numThreads threads and call func(thread, begin, end) on each
+    template<typename F>
+    static void parallelFor(unsigned int numThreads, size_t numConnections, F func)
+    {
+        if(numThreads == 1) {
+            func(0, 0, numConnections);
+        }
+        else {
+            std::vector<std::thread> threads;
+            threads.reserve(numThreads);
+            const size_t chunkSize = (numConnections + numThreads - 1) / numThreads;
+            for(unsigned int t = 0; t < numThreads; t++) {
+                const size_t begin = std::min(numConnections, t * chunkSize);
+                const size_t end = std::min(numConnections, begin + chunkSize);
+                threads.emplace_back(func, t, begin, end);
+            }
+
+            for(auto &t : threads) {
+                t.join();
+            }
+        }
+    }
+
+private:
+    //------------------------------------------------------------------------
+    // Private methods
+    //------------------------------------------------------------------------
+    std::string getSidecarFilename() const{ return m_Filename + ".meta.xml"; }
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    const std::string m_Filename;
+    const unsigned int m_NumConnections;
+    const unsigned int m_WordsPerSynapse;
+
+    //! Size of file
+    uint64_t m_FileBytes;
+
+    //! Hash of file's identity, used to check whether sidecar is up to date
+    uint64_t m_FileIdentity;
+
+    //! Words of mapped file
+    const uint32_t *m_Words;
+
+    //! Platform-specific handles to mapping
+    void *m_Mapping;
+#ifdef _WIN32
+    void *m_File;
+    void *m_MappingHandle;
+#endif
+};
+}   // namespace SpineMLCommon
@@ -0,0 +1,178 @@
+#pragma once
+
+// Standard C++ includes
+#include <map>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+// SpineMLCommon::ModelCache
+//----------------------------------------------------------------------------
+//! Versioned binary cache of data which is expensive to derive from a SpineML network
+/*! The cache is stored alongside the network XML file and is discarded if the hash of
+    the network's contents changes. Each entry is additionally keyed on a hash of any
+    other inputs it depends upon such as binary data files or experiment overrides.
+
+    Only a table of contents is read when the cache is opened - entries are read directly
+    from the file into their destination when requested. New entries are appended to the
+    end of the file as they are written and superseded entries are only removed once they
+    make up most of the file. */
+namespace SpineMLCommon
+{
+class ModelCache
+{
+public:
+    //! Open cache for network, reading the table of contents of any entries written for the current version of the network
+    ModelCache(const std::string &networkFilename);
+    ~ModelCache();
+
+    ModelCache(const ModelCache&) = delete;
+    ModelCache &operator=(const ModelCache&) = delete;
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Read entry into data, returning false if there is no entry with this name and dependency hash
+    template<typename T>
+    bool read(const std::string &name, uint64_t dependencyHash, std::vector<T> &data) const
+    {
+        const auto *entry = findEntry(name, dependencyHash);
+        if(entry == nullptr || (entry->numBytes % sizeof(T)) != 0) {
+            return false;
+        }
+
+        data.resize((size_t)(entry->numBytes / sizeof(T)));
+        return readEntry(*entry, data.data());
+    }
+
+    //! Read entry into count elements of data, returning false if there is no entry
+    //! with this name and dependency hash or if it contains a different number of elements
+    template<typename T>
+    bool read(const std::string &name, uint64_t dependencyHash, T *data, size_t count) const
+    {
+        const auto *entry = findEntry(name, dependencyHash);
+        if(entry == nullptr || entry->numBytes != (sizeof(T) * count)) {
+            return false;
+        }
+
+        return readEntry(*entry, data);
+    }
+
+    //! Add or replace entry
+    template<typename T>
+    void write(const std::string &name, uint64_t dependencyHash, const T *data, size_t count)
+    {
+        writeEntry(name, dependencyHash, data, sizeof(T) * count);
+    }
+
+    template<typename T>
+    void write(const std::string &name, uint64_t dependencyHash, const std::vector<T> &data)
+    {
+        write(name, dependencyHash, data.data(), data.size());
+    }
+
+    //! Get filename of network this cache belongs to
+    const std::string &getNetworkFilename() const{ return m_NetworkFilename; }
+
+    //------------------------------------------------------------------------
+    // Static API
+    //------------------------------------------------------------------------
+    //! 64-bit FNV-1a hash of bytes, optionally continuing from a previous hash
+    static uint64_t hash(const void *data, size_t numBytes, uint64_t seed = 14695981039346656037ull);
+
+    template<typename T>
+    static uint64_t hashValue(const T &value, uint64_t seed = 14695981039346656037ull)
+    {
+        return hash(&value, sizeof(T), seed);
+    }
+
+    //! Hash contents of file
+    static uint64_t hashFileContents(const std::string &filename);
+
+    //! Hash identity of file i.e. its device, inode, size and nanosecond modification and change times
+    /*! **NOTE** used for large binary data files where reading the entire file would defeat the purpose */
+    static uint64_t hashFileIdentity(const std::string &filename, uint64_t seed = 14695981039346656037ull);
+
+    //! Get name for entry derived from XML node at offset within document
+    /*! **NOTE** offsets are only unique within a document so the document is included */
+    static std::string getNodeEntryName(const std::string &type, const std::string &documentFilename, ptrdiff_t offset);
+
+private:
+    //------------------------------------------------------------------------
+    // Entry
+    //------------------------------------------------------------------------
+    //! Location of an entry's data within the file
+    struct Entry
+    {
+        uint64_t dependencyHash;
+        uint64_t offset;
+        uint64_t numBytes;
+    };
+
+    //------------------------------------------------------------------------
+    // Private methods
+    //------------------------------------------------------------------------
+    //! Get entry with name and dependency hash or nullptr if there isn't one
+    const Entry *findEntry(const std::string &name, uint64_t dependencyHash) const
+    {
+        auto entry = m_Entries.find(name);
+        if(entry == m_Entries.cend() || entry->second.dependencyHash != dependencyHash) {
+            return nullptr;
+        }
+        else {
+            return &entry->second;
+        }
+    }
+
+    //! Read entry's data from file into data
+    bool readEntry(const Entry &entry, void *data) const;
+
+    //! Append entry to file
+    void writeEntry(const std::string &name, uint64_t dependencyHash, const void *data, size_t numBytes);
+
+    //! Read table of contents of entries from offset to the end of the file
+    void readEntries(uint64_t offset);
+
+    //! Open existing file and read its table of contents, returning false if there isn't an up to date one
+    bool open();
+
+    //! Replace file with one containing only header
+    bool create();
+
+    //! Replace file with one containing only current entries
+    void compact();
+
+    //! Close file
+    void closeFile();
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    const std::string m_NetworkFilename;
+    const std::string m_Filename;
+
+    //! Hash of the contents of the network this cache was built from
+    const uint64_t m_NetworkHash;
+
+    //! Entries, indexed by name
+    std::map<std::string, Entry> m_Entries;
+
+    //! Offset of end of last complete entry in file
+    uint64_t m_EndOffset;
+
+    //! Bytes of file occupied by entries which have since been replaced
+    uint64_t m_SupersededBytes;
+
+    //! Platform-specific handle to file or -1/INVALID_HANDLE_VALUE if cache can't be used
+#ifdef _WIN32
+    void *m_File;
+#else
+    int m_File;
+#endif
+};
+}   // namespace SpineMLCommon
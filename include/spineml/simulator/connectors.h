@@ -19,6 +19,11 @@ namespace filesystem
     class path;
 }
 
+namespace SpineMLCommon
+{
+    class ModelCache;
+}
+
 //------------------------------------------------------------------------
 // SpineMLSimulator::Connectors
 //------------------------------------------------------------------------
@@ -28,6 +33,7 @@ namespace Connectors
 {
     unsigned int create(const pugi::xml_node &node, double dt, unsigned int numPre, unsigned int numPost,
                         unsigned int **rowLength, unsigned int **ind, uint8_t **delay, const unsigned int *maxRowLength,
-                        const filesystem::path &basePath, std::vector<unsigned int> &remapIndices);
+                        const filesystem::path &basePath, std::vector<unsigned int> &remapIndices,
+                        SpineMLCommon::ModelCache *modelCache = nullptr);
 }   // namespace Connectors
 }   // namespace SpineMLSimulator
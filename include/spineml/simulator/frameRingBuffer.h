@@ -0,0 +1,80 @@
+#pragma once
+
+// Standard C++ includes
+#include <atomic>
+#include <vector>
+
+//----------------------------------------------------------------------------
+// SpineMLSimulator::FrameRingBuffer
+//----------------------------------------------------------------------------
+//! Lock-free, single-producer, single-consumer ring buffer of fixed-size frames
+//! of doubles, used to pass timesteps' data between the simulation and I/O threads
+namespace SpineMLSimulator
+{
+class FrameRingBuffer
+{
+public:
+    FrameRingBuffer(unsigned int frameSize, unsigned int capacityFrames)
+    :   m_FrameSize(frameSize), m_CapacityFrames(capacityFrames), m_Data((size_t)frameSize * capacityFrames),
+        m_ReadCount(0), m_WriteCount(0)
+    {
+    }
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Get frame to write into or nullptr if buffer is full (producer only)
+    double *getWriteFrame()
+    {
+        const unsigned long long writeCount = m_WriteCount.load(std::memory_order_relaxed);
+        if((writeCount - m_ReadCount.load(std::memory_order_acquire)) == m_CapacityFrames) {
+            return nullptr;
+        }
+        else {
+            return &m_Data[(size_t)(writeCount % m_CapacityFrames) * m_FrameSize];
+        }
+    }
+
+    //! Make frame returned by getWriteFrame available to consumer (producer only)
+    void commitWrite()
+    {
+        m_WriteCount.store(m_WriteCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    //! Get oldest frame or nullptr if buffer is empty (consumer only)
+    const double *getReadFrame() const
+    {
+        const unsigned long long readCount = m_ReadCount.load(std::memory_order_relaxed);
+        if(readCount == m_WriteCount.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        else {
+            return &m_Data[(size_t)(readCount % m_CapacityFrames) * m_FrameSize];
+        }
+    }
+
+    //! Return frame returned by getReadFrame to producer (consumer only)
+    void commitRead()
+    {
+        m_ReadCount.store(m_ReadCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    unsigned int getFrameSize() const{ return m_FrameSize; }
+    unsigned int getCapacityFrames() const{ return m_CapacityFrames; }
+
+private:
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    const unsigned int m_FrameSize;
+    const unsigned int m_CapacityFrames;
+
+    std::vector<double> m_Data;
+
+    //! Total number of frames read and written
+    /*! **NOTE** these are written by different threads so are padded onto separate cache lines */
+    std::atomic<unsigned long long> m_ReadCount;
+    char m_Padding[64];
+    std::atomic<unsigned long long> m_WriteCount;
+};
+}   // namespace SpineMLSimulator
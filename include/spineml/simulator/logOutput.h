@@ -1,12 +1,14 @@
 #pragma once
 
 // Standard C++ includes
+#include <array>
 #include <fstream>
-#include <set>
+#include <memory>
 #include <string>
 #include <vector>
 
 // SpineML simulator includes
+#include "mappedFile.h"
 #include "modelProperty.h"
 #include "networkClient.h"
 
@@ -22,12 +24,25 @@ namespace filesystem
 }
 
 //----------------------------------------------------------------------------
-// SpineMLSimulator::LogOutput::Base
+// SpineMLSimulator::LogOutput::FileFormat
 //----------------------------------------------------------------------------
 namespace SpineMLSimulator
 {
 namespace LogOutput
 {
+//! Formats in which logs can be written to file
+enum class FileFormat
+{
+    Default,    //!< Analogue logs are streamed as binary frames and event logs as CSV
+    Binary,     //!< Analogue logs are copied into a pre-sized memory-mapped file and event logs are written as binary records
+};
+
+//! Read format from logger's optional 'format' attribute, falling back to defaultFormat
+FileFormat readFileFormat(const pugi::xml_node &node, FileFormat defaultFormat);
+
+//----------------------------------------------------------------------------
+// SpineMLSimulator::LogOutput::Base
+//----------------------------------------------------------------------------
 class Base
 {
 public:
@@ -40,6 +55,16 @@ public:
     // Record any data required during this timestep
     virtual void record(double dt, unsigned long long timestep) = 0;
 
+    // Can recording be split into capturing a snapshot on the simulation
+    // thread and writing it out on a separate logging thread?
+    virtual bool isPipelined() const{ return false; }
+
+    // Copy any data required during this timestep into one of two snapshot buffers
+    virtual void captureSnapshot(double, unsigned long long, unsigned int){}
+
+    // Write out data previously captured into snapshot buffer
+    virtual void writeSnapshot(unsigned int){}
+
 protected:
     //----------------------------------------------------------------------------
     // Protected API
@@ -49,6 +74,7 @@ protected:
         return (timestep >= m_StartTimeStep && timestep < m_EndTimeStep);
     }
 
+    unsigned long long getStartTimestep() const{ return m_StartTimeStep; }
     unsigned long long getEndTimestep() const{ return m_EndTimeStep; }
 
 private:
@@ -104,7 +130,8 @@ public:
     AnalogueFile(const pugi::xml_node &node, double dt, unsigned long long numTimeSteps,
                  const std::string &port, unsigned int popSize,
                  const filesystem::path &logPath,
-                 const ModelProperty::Base *modelProperty);
+                 const ModelProperty::Base *modelProperty,
+                 FileFormat defaultFormat = FileFormat::Default);
 
     //----------------------------------------------------------------------------
     // Base virtuals
@@ -112,14 +139,25 @@ public:
     // Record any data required during this timestep
     virtual void record(double dt, unsigned long long timestep) override;
 
+    // **NOTE** frames are copied straight into mapped files so there is nothing left to write
+    virtual bool isPipelined() const override{ return !m_MappedFile; }
+    virtual void captureSnapshot(double dt, unsigned long long timestep, unsigned int buffer) override;
+    virtual void writeSnapshot(unsigned int buffer) override;
+
 private:
     //----------------------------------------------------------------------------
     // Members
     //----------------------------------------------------------------------------
     std::ofstream m_File;
 
-    // Buffer used, if indices are in use, to store contiguous output data
-    std::vector<scalar> m_OutputBuffer;
+    // Pre-sized memory-mapped file frames are copied into when using binary format
+    std::unique_ptr<MappedFile> m_MappedFile;
+
+    // Double-buffered snapshots of contiguous output data
+    std::array<std::vector<scalar>, 2> m_Snapshots;
+
+    // Whether each snapshot contains data to write
+    std::array<bool, 2> m_SnapshotValid;
 };
 
 //----------------------------------------------------------------------------
@@ -195,7 +233,8 @@ public:
           const std::string &port, unsigned int popSize,
           const filesystem::path &logPath, unsigned int *spikeQueuePtr,
           unsigned int *hostSpikeCount, unsigned int *hostSpikes,
-          void (*pullCurrentSpikesFunc)(void));
+          void (*pullCurrentSpikesFunc)(void),
+          FileFormat defaultFormat = FileFormat::Default);
 
     //----------------------------------------------------------------------------
     // Base virtuals
@@ -203,21 +242,38 @@ public:
     // Record any data required during this timestep
     virtual void record(double dt, unsigned long long timestep) override;
 
+    virtual bool isPipelined() const override{ return true; }
+    virtual void captureSnapshot(double dt, unsigned long long timestep, unsigned int buffer) override;
+    virtual void writeSnapshot(unsigned int buffer) override;
+
 private:
     //----------------------------------------------------------------------------
     // Members
     //----------------------------------------------------------------------------
     std::ofstream m_File;
 
+    const FileFormat m_Format;
+
     const unsigned int m_PopSize;
 
+    // Double-buffered snapshots of recorded spike IDs and the time they were emitted
+    std::array<std::vector<unsigned int>, 2> m_Snapshots;
+    std::array<double, 2> m_SnapshotTime;
+
     unsigned int *m_SpikeQueuePtr;
     unsigned int *m_HostSpikeCount;
     unsigned int *m_HostSpikes;
 
     void (*m_PullCurrentSpikesFunc)(void);
 
-    std::set<unsigned int> m_Indices;
+    // Sorted indices of neurons to log (all if empty)
+    std::vector<unsigned int> m_Indices;
+
+    // Dense bitmap of neurons to log, used to filter spikes
+    std::vector<bool> m_IndexMask;
+
+    // Buffer used to build binary records before writing
+    std::vector<char> m_RecordBuffer;
 };
 }   // namespace LogOutput
 }   // namespace SpineMLSimulator
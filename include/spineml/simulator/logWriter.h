@@ -0,0 +1,68 @@
+#pragma once
+
+// Standard C++ includes
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// SpineML simulator includes
+#include "logOutput.h"
+
+//----------------------------------------------------------------------------
+// SpineMLSimulator::LogWriter
+//----------------------------------------------------------------------------
+//! Writes snapshots captured by pipelined loggers on a background thread so
+//! logging of one timestep overlaps with input and simulation of the next
+namespace SpineMLSimulator
+{
+class LogWriter
+{
+public:
+    LogWriter(const std::vector<std::unique_ptr<LogOutput::Base>> &loggers);
+    ~LogWriter();
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Wait for previously submitted snapshot to be written and start writing snapshot buffer
+    void submit(unsigned int buffer);
+
+    //! Wait for all submitted snapshots to be written
+    void flush();
+
+private:
+    //------------------------------------------------------------------------
+    // Private methods
+    //------------------------------------------------------------------------
+    //! Wait for writer thread to go idle, rethrowing any exception it encountered
+    void waitIdle(std::unique_lock<std::mutex> &lock);
+
+    void writerThread();
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    //! Loggers whose snapshots are written by this writer
+    std::vector<LogOutput::Base*> m_Loggers;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+
+    //! Is there a snapshot buffer waiting to be written?
+    bool m_Pending;
+
+    //! Snapshot buffer to write
+    unsigned int m_Buffer;
+
+    //! Should writer thread exit?
+    bool m_Quit;
+
+    //! Exception thrown by writer thread, rethrown on main thread
+    std::exception_ptr m_Exception;
+
+    std::thread m_Thread;
+};
+}   // namespace SpineMLSimulator
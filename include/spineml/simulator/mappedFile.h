@@ -0,0 +1,65 @@
+#pragma once
+
+// Standard C++ includes
+#include <string>
+
+// Standard C includes
+#include <cstddef>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+//----------------------------------------------------------------------------
+// SpineMLSimulator::MappedFile
+//----------------------------------------------------------------------------
+//! Output file which is pre-sized and memory-mapped so data can be written
+//! into it without any system calls. When destroyed, the file is truncated
+//! to the number of bytes which have actually been used
+namespace SpineMLSimulator
+{
+class MappedFile
+{
+public:
+    MappedFile(const std::string &filename, size_t capacityBytes);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile &operator = (const MappedFile&) = delete;
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Get pointer to space for the next numBytes bytes, growing file if required, and mark them as used
+    char *append(size_t numBytes);
+
+    size_t getCapacityBytes() const{ return m_CapacityBytes; }
+    size_t getUsedBytes() const{ return m_UsedBytes; }
+
+private:
+    //------------------------------------------------------------------------
+    // Private methods
+    //------------------------------------------------------------------------
+    //! Resize file to capacityBytes and map it
+    void map(size_t capacityBytes);
+
+    //! Unmap file
+    void unmap();
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    const std::string m_Filename;
+
+#ifdef _WIN32
+    HANDLE m_File;
+    HANDLE m_MappingHandle;
+#else
+    int m_File;
+#endif
+
+    char *m_Mapping;
+    size_t m_CapacityBytes;
+    size_t m_UsedBytes;
+};
+}   // namespace SpineMLSimulator
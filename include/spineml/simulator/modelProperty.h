@@ -5,6 +5,9 @@
 #include <random>
 #include <vector>
 
+// Standard C includes
+#include <cstdint>
+
 // SpineML simulator includes
 #include "stateVar.h"
 
@@ -19,6 +22,11 @@ namespace filesystem
     class path;
 }
 
+namespace SpineMLCommon
+{
+    class ModelCache;
+}
+
 //------------------------------------------------------------------------
 // SpineMLSimulator::ModelProperty::Base
 //------------------------------------------------------------------------
@@ -100,7 +108,8 @@ class ValueList : public Base
 {
 public:
     ValueList(const pugi::xml_node &node, const filesystem::path &basePath, const std::vector<unsigned int> *remapIndices,
-              const StateVar<scalar> &stateVar, unsigned int size);
+              const StateVar<scalar> &stateVar, unsigned int size,
+              SpineMLCommon::ModelCache *modelCache = nullptr, const std::string &cacheDocument = "", uint64_t cacheDependencyHash = 0);
 
     //------------------------------------------------------------------------
     // Public API
@@ -108,6 +117,12 @@ public:
     void setValue(const std::vector<scalar> &values, const std::vector<unsigned int> *remapIndices);
 
 private:
+    //------------------------------------------------------------------------
+    // Private methods
+    //------------------------------------------------------------------------
+    //! Copy values into state variable and push to device
+    void applyValues();
+
     //------------------------------------------------------------------------
     // Members
     //------------------------------------------------------------------------
@@ -183,7 +198,9 @@ private:
 std::unique_ptr<Base> create(const pugi::xml_node &node,
                              const StateVar<scalar> &stateVar, unsigned int size,
                              bool skipGeNNInitialised, const filesystem::path &basePath,
-                             const std::string &valueNamespace, const std::vector<unsigned int> *remapIndices);
+                             const std::string &valueNamespace, const std::vector<unsigned int> *remapIndices,
+                             SpineMLCommon::ModelCache *modelCache = nullptr, const std::string &cacheDocument = "",
+                             uint64_t cacheDependencyHash = 0);
 
 }   // namespace ModelProperty
 }   // namespace SpineMLSimulator
@@ -1,8 +1,13 @@
 #pragma once
 
 // Standard C++ includes
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 // POSIX includes
@@ -14,11 +19,16 @@
     #include <netinet/tcp.h>
     #include <sys/socket.h>
     #include <sys/types.h>
+    #include <sys/un.h>
     #include <unistd.h>
 #endif
 
 // SpineML common includes
 #include "spineMLLogging.h"
+
+// SpineML simulator includes
+#include "frameRingBuffer.h"
+
 //----------------------------------------------------------------------------
 // SpineMLSimulator::NetworkClient
 //----------------------------------------------------------------------------
@@ -44,15 +54,27 @@ public:
     };
     
     NetworkClient();
-    NetworkClient(const std::string &hostname, unsigned int port, unsigned int size, DataType dataType, Mode mode, const std::string &connectionName);
+    NetworkClient(const std::string &hostname, unsigned int port, unsigned int size, DataType dataType, Mode mode, const std::string &connectionName,
+                  unsigned int batchTimesteps = 1, bool async = false);
     ~NetworkClient();
-    
+
     //----------------------------------------------------------------------------
     // Public API
     //----------------------------------------------------------------------------
-    bool connect(const std::string &hostname, unsigned int port, unsigned int size, DataType dataType, Mode mode, const std::string &connectionName);
+    //! Connect to remote host
+    /*! If hostname is of the form unix:PATH, a Unix domain socket at PATH is used rather than TCP.
+        If batchTimesteps is greater than one, the remote host is asked to send or receive data
+        in messages containing up to this many timesteps, prefixed with a uint32 timestep count.
+        If async is true, messages are sent and received on a separate I/O thread, connected to
+        send and receive by a ring buffer, so the simulation doesn't wait for network round-trips */
+    bool connect(const std::string &hostname, unsigned int port, unsigned int size, DataType dataType, Mode mode, const std::string &connectionName,
+                 unsigned int batchTimesteps = 1, bool async = false);
 
+    //! Receive one timestep of data
     bool receive(std::vector<double> &buffer);
+
+    //! Send one timestep of data
+    /*! **NOTE** any timesteps waiting to fill a batch are sent when client is destroyed */
     bool send(const std::vector<double> &buffer);
 
 private:
@@ -66,7 +88,12 @@ private:
         Abort = 43,
         Finished = 44,
     };
-    
+
+    enum class Request : char
+    {
+        Batch = 47,
+    };
+
     //----------------------------------------------------------------------------
     // Private API
     //----------------------------------------------------------------------------
@@ -120,10 +147,68 @@ private:
 
     bool sendRequestReadResponse(const std::string &data, Response &response);
 
+    //! Send a message containing numFrames timesteps of data and wait for response
+    bool sendFrames(const double *data, unsigned int numFrames);
+
+    //! Receive a message containing up to batchTimesteps timesteps of data and acknowledge it
+    bool receiveFrames(double *data, unsigned int &numFrames);
+
+    //! Send all bytes, blocking if required
+    bool sendAll(const char *data, size_t numBytes);
+
+    //! Receive exactly numBytes bytes
+    bool receiveAll(char *data, size_t numBytes);
+
+    //! Stop I/O thread and wait for it to exit
+    void stopIOThread();
+
+    //! Block until predicate, evaluated whenever notify is called, becomes true
+    template<typename Predicate>
+    void wait(Predicate predicate)
+    {
+        std::unique_lock<std::mutex> lock(m_WaitMutex);
+        m_WaitCondition.wait(lock, predicate);
+    }
+
+    //! Wake threads blocked in wait after ring buffer or quit and failure flags have changed
+    void notify();
+
+    void sourceIOThread();
+    void targetIOThread();
+
     //----------------------------------------------------------------------------
     // Private members
     //----------------------------------------------------------------------------
     int m_Socket;
+
+    //! Number of values in each timestep
+    unsigned int m_Size;
+
+    //! Maximum number of timesteps in each message
+    unsigned int m_BatchTimesteps;
+
+    //! Is this client sending or receiving data
+    Mode m_Mode;
+
+    //! Timesteps of data waiting to be sent or which have been received
+    std::vector<double> m_Batch;
+
+    //! Number of timesteps in batch and how many of these have been read
+    unsigned int m_BatchFrames;
+    unsigned int m_BatchFramesRead;
+
+    //! Ring buffer between simulation and I/O thread if client is asynchronous
+    std::unique_ptr<FrameRingBuffer> m_RingBuffer;
+
+    //! Flags used to stop I/O thread and for it to report failure
+    std::atomic<bool> m_Quit;
+    std::atomic<bool> m_Failed;
+
+    //! Mutex and condition variable used to block simulation and I/O threads while they wait for each other
+    std::mutex m_WaitMutex;
+    std::condition_variable m_WaitCondition;
+
+    std::thread m_IOThread;
 };
 
 }   // namespace SpineMLSimulator
@@ -14,6 +14,7 @@
 #include "input.h"
 #include "inputValue.h"
 #include "logOutput.h"
+#include "logWriter.h"
 #include "modelProperty.h"
 
 //----------------------------------------------------------------------------
@@ -37,6 +38,24 @@ public:
     //! Advance simulation by one timestep
     void stepTime();
 
+    //! Enable or disable pipelined logging
+    /*! When enabled, logs which support it are snapshotted at the end of each timestep and
+        written on a separate thread while the inputs and simulation of the next timestep run */
+    void setPipelinedLogging(bool enabled);
+
+    //! Wait for any logs being written by pipelined logging to be completely written
+    void flushLogs();
+
+    //! Set format used by file logs which don't specify one in the experiment
+    /*! **NOTE** must be called before load to take effect */
+    void setDefaultLogFormat(LogOutput::FileFormat format){ m_DefaultLogFormat = format; }
+
+    //! Enable or disable caching of connectivity and property values read from the network
+    /*! When enabled, these are stored in a cache file alongside the network XML and, if the network
+        and any data files it references are unchanged, loaded from it rather than being rebuilt.
+        **NOTE** must be called before load to take effect */
+    void setModelCacheEnabled(bool enabled){ m_ModelCacheEnabled = enabled; }
+
     //! Get an external logger by name
     const LogOutput::AnalogueExternal *getExternalLogger(const std::string &name) const;
 
@@ -102,6 +121,7 @@ private:
     void addPropertiesAndSizes(const filesystem::path &basePath, const pugi::xml_node &node,
                                const pugi::xml_node &modelNode, const std::string &geNNPopName,
                                unsigned int popSize, std::map<std::string, unsigned int> &sizes,
+                               SpineMLCommon::ModelCache *modelCache, const std::string &experimentFilename, uint64_t experimentHash,
                                const std::vector<unsigned int> *remapIndices = nullptr);
 
     //! Create the correct type of input object to simulate node.
@@ -164,6 +184,19 @@ private:
     //! Vector of logging objects, updated at the end of each simulation time step
     std::vector<std::unique_ptr<LogOutput::Base>> m_Loggers;
 
+    //! Should logging be pipelined
+    bool m_PipelinedLogging;
+
+    //! Format used by file logs which don't specify one in the experiment
+    LogOutput::FileFormat m_DefaultLogFormat;
+
+    //! Should connectivity and property values be cached
+    bool m_ModelCacheEnabled;
+
+    //! Writer used to write snapshots of pipelined loggers on a separate thread
+    /*! **NOTE** declared after loggers so it is destroyed first */
+    std::unique_ptr<LogWriter> m_LogWriter;
+
     //! Vector of input objects, updated at the beginning of each simulation time step
     std::vector<std::unique_ptr<Input::Base>> m_Inputs;
 
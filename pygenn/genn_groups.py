@@ -2,11 +2,6 @@
 This module provides classes which automatize model checks and parameter
 convesions for GeNN Groups
 """
-try:
-    xrange
-except NameError:  # Python 3
-    xrange = range
-
 from deprecated import deprecated
 from six import iteritems
 import numpy as np
@@ -14,6 +9,7 @@ from . import genn_wrapper
 from . import model_preprocessor
 from .model_preprocessor import ExtraGlobalVariable, Variable, genn_types
 from .genn_wrapper import (SynapseMatrixConnectivity_SPARSE,
+                          SynapseMatrixConnectivity_CSR,
                           SynapseMatrixConnectivity_BITMASK,
                           SynapseMatrixConnectivity_DENSE,
                           SynapseMatrixWeight_INDIVIDUAL,
@@ -331,13 +327,14 @@ class SynapseGroup(Group):
         self.psm_extra_global_params = {}
         self.connectivity_extra_global_params = {}
         self.connectivity_initialiser = None
+        self._ragged_mask = None
 
     @property
     def num_synapses(self):
         """Number of synapses in group"""
         if self.is_dense:
             return self.trg.size * self.src.size
-        elif self.is_ragged:
+        elif self.is_ragged or self.is_csr:
             return self._num_synapses
 
     @property
@@ -347,6 +344,8 @@ class SynapseGroup(Group):
             return self.trg.size * self.src.size
         elif self.is_ragged:
             return self.max_row_length * self.src.size
+        elif self.is_csr:
+            return self.pop.get_max_total_connections()
 
     @property
     def max_row_length(self):
@@ -423,16 +422,11 @@ class SynapseGroup(Group):
         if self.is_dense:
             return np.copy(var_view)
         elif self.is_ragged:
-            # Create range containing the index where each row starts in ind
-            row_start_idx = xrange(0, self.weight_update_var_size,
-                                   self.max_row_length)
-
-            # Build list of subviews representing each row
-            rows = [var_view[i:i + r]
-                    for i, r in zip(row_start_idx, self.row_lengths)]
-
-            # Stack all rows together into single array
-            return np.hstack(rows)
+            # Gather synapses from padded rows in a single pass
+            return self._get_ragged_view(var_view)[self._get_ragged_mask()]
+        elif self.is_csr:
+            # Synapses are already tightly packed
+            return np.copy(var_view[:self.num_synapses])
         else:
             raise Exception("Matrix format not supported")
 
@@ -455,6 +449,11 @@ class SynapseGroup(Group):
         """Tests whether synaptic connectivity uses Ragged format"""
         return (self._matrix_type & SynapseMatrixConnectivity_SPARSE) != 0
 
+    @property
+    def is_csr(self):
+        """Tests whether synaptic connectivity uses CSR format"""
+        return (self._matrix_type & SynapseMatrixConnectivity_CSR) != 0
+
     @property
     def is_bitmask(self):
         """Tests whether synaptic connectivity uses Bitmask format"""
@@ -477,13 +476,13 @@ class SynapseGroup(Group):
         return (self._matrix_type & SynapseMatrixWeight_INDIVIDUAL_PSM) != 0
 
     def set_sparse_connections(self, pre_indices, post_indices):
-        """Set ragged format connections between two groups of neurons
+        """Set ragged or CSR format connections between two groups of neurons
 
         Args:
         pre_indices     --  ndarray of presynaptic indices
         post_indices    --  ndarray of postsynaptic indices
         """
-        if self.is_ragged:
+        if self.is_ragged or self.is_csr:
             # Lexically sort indices
             self.synapse_order = np.lexsort((post_indices, pre_indices))
 
@@ -498,16 +497,21 @@ class SynapseGroup(Group):
             max_row_length = int(np.amax(row_lengths))
             self.pop.set_max_connections(max_row_length)
 
+            # If connectivity is CSR, only allocate memory for these synapses
+            if self.is_csr:
+                self.pop.set_max_total_connections(self._num_synapses)
+
             # Set ind to sorted postsynaptic indices
             self.ind = post_indices[self.synapse_order]
 
-            # Cache the row lengths
+            # Cache the row lengths and invalidate mask built from previous ones
             self.row_lengths = row_lengths
+            self._ragged_mask = None
 
             assert len(self.row_lengths) == self.src.size
         else:
             raise Exception("set_sparse_connections only supports"
-                            "ragged format sparse connectivity")
+                            "ragged and CSR format sparse connectivity")
 
         self.connections_set = True
 
@@ -518,20 +522,19 @@ class SynapseGroup(Group):
         ndarray of presynaptic indices
         """
 
-        if self.is_ragged:
+        if self.is_ragged or self.is_csr:
             if self.ind is None or self.row_lengths is None:
                 raise Exception("only manually initialised connectivity "
                                 "can currently by accessed")
 
             # Expand row lengths into full array
             # of presynaptic indices and return
-            return np.hstack([np.repeat(i, l)
-                              for i, l in enumerate(self.row_lengths)])
-
+            return np.repeat(np.arange(self.src.size, dtype=np.uint32),
+                             self.row_lengths)
 
         else:
             raise Exception("get_sparse_pre_inds only supports"
-                            "ragged format sparse connectivity")
+                            "ragged and CSR format sparse connectivity")
 
     def get_sparse_post_inds(self):
         """Get postsynaptic indices of synapse group connections
@@ -540,7 +543,7 @@ class SynapseGroup(Group):
         ndarrays of postsynaptic indices
         """
 
-        if self.is_ragged:
+        if self.is_ragged or self.is_csr:
             if self.ind is None or self.row_lengths is None:
                 raise Exception("only manually initialised connectivity "
                                 "can currently by accessed")
@@ -549,7 +552,7 @@ class SynapseGroup(Group):
             return self.ind
         else:
             raise Exception("get_sparse_post_inds only supports"
-                            "ragged format sparse connectivity")
+                            "ragged and CSR format sparse connectivity")
 
 
     def set_connected_populations(self, source, target):
@@ -659,16 +662,24 @@ class SynapseGroup(Group):
                     # Copy in row length
                     row_length[:] = self.row_lengths
 
-                    # Create (x)range containing the index where each row starts in ind
-                    row_start_idx = xrange(0, self.weight_update_var_size,
-                                           self.max_row_length)
+                    # Scatter non-padded indices into padded rows
+                    self._get_ragged_view(ind)[self._get_ragged_mask()] = self.ind
+                elif self.is_csr:
+                    # Get pointers to CSR data structure members
+                    ind = self._assign_ext_ptr_array(slm, scalar, "ind",
+                                                     self.weight_update_var_size,
+                                                     "unsigned int")
+                    row_ptr = self._assign_ext_ptr_array(slm, scalar,
+                                                         "rowPtr",
+                                                         self.src.size + 1,
+                                                         "unsigned int")
+
+                    # Build row pointers from prefix sum of row lengths
+                    row_ptr[0] = 0
+                    np.cumsum(self.row_lengths, out=row_ptr[1:])
 
-                    # Loop through ragged matrix rows
-                    syn = 0
-                    for i, r in zip(row_start_idx, self.row_lengths):
-                        # Copy row from non-padded indices into correct location
-                        ind[i:i + r] = self.ind[syn:syn + r]
-                        syn += r
+                    # Copy in tightly-packed indices
+                    ind[:self.num_synapses] = self.ind
                 else:
                     raise Exception("Matrix format not supported")
             else:
@@ -747,23 +758,31 @@ class SynapseGroup(Group):
             if self.is_dense:
                 var_data.view[:] = var_data.values
             elif self.is_ragged:
-                # Sort variable to match GeNN order
-                sorted_var = var_data.values[self.synapse_order]
-
-                # Create (x)range containing the index
-                # where each row starts in ind
-                row_start_idx = xrange(0, self.weight_update_var_size,
-                                       self.max_row_length)
-
-                # Loop through ragged matrix rows
-                syn = 0
-                for i, r in zip(row_start_idx, self.row_lengths):
-                    # Copy row from non-padded indices into correct location
-                    var_data.view[i:i + r] = sorted_var[syn:syn + r]
-                    syn += r
+                # Sort variable to match GeNN order and
+                # scatter into padded rows in a single pass
+                self._get_ragged_view(var_data.view)[self._get_ragged_mask()] =\
+                    var_data.values[self.synapse_order]
+            elif self.is_csr:
+                # Sort variable to match GeNN order and copy directly into view
+                var_data.view[:self.num_synapses] = var_data.values[self.synapse_order]
             else:
                 raise Exception("Matrix format not supported")
 
+    def _get_ragged_view(self, array):
+        """Get zero-copy 2D view of a padded ragged array with one row per
+        presynaptic neuron"""
+        return array.reshape((self.src.size, self.max_row_length))
+
+    def _get_ragged_mask(self):
+        """Get boolean mask selecting the synapses within padded ragged rows.
+        Because masks select elements in row-major order, this matches the
+        order of synapses sorted by set_sparse_connections"""
+        shape = (self.src.size, self.max_row_length)
+        if self._ragged_mask is None or self._ragged_mask.shape != shape:
+            self._ragged_mask = (np.arange(self.max_row_length)[np.newaxis, :]
+                                 < self.row_lengths[:, np.newaxis])
+        return self._ragged_mask
+
 class CurrentSource(Group):
 
     """Class representing a current injection into a group of neurons"""
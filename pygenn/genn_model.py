@@ -41,6 +41,7 @@ Example:
 # python imports
 from collections import OrderedDict
 from importlib import import_module
+from multiprocessing import cpu_count
 from os import path
 from platform import system
 from subprocess import check_call  # to call make
@@ -401,7 +402,8 @@ class GeNNModel(object):
             check_call(["msbuild", "/p:Configuration=Release", "/m", "/verbosity:minimal",
                         path.join(output_path, "runner.vcxproj")])
         else:
-            check_call(["make", "-C", output_path])
+            # **NOTE** compile modules in parallel as, if modules are sharded, there may be many
+            check_call(["make", "-j", str(cpu_count()), "-C", output_path])
 
         self._built = True
 
@@ -602,6 +604,7 @@ def create_custom_neuron_class(class_name, param_names=None,
                                extra_global_params=None,
                                additional_input_vars=None,
                                is_auto_refractory_required=None,
+                               catch_up_code=None, quiescent_steps_code=None,
                                custom_body=None):
     """This helper function creates a custom NeuronModel class.
     See also:
@@ -635,6 +638,12 @@ def create_custom_neuron_class(class_name, param_names=None,
                                     local input variables
     is_auto_refractory_required --  does this model require auto-refractory
                                     logic to be generated?
+    catch_up_code               --  string with code to advance the state by
+                                    $(elapsed) timesteps without input when
+                                    used in event-driven populations
+    quiescent_steps_code        --  string with code to set $(quiescentSteps)
+                                    to the number of timesteps event-driven
+                                    populations can skip without input
     custom_body                 --  dictionary with additional attributes and
                                     methods of the new class
     """
@@ -670,6 +679,13 @@ def create_custom_neuron_class(class_name, param_names=None,
         body["is_auto_refractory_required"] = \
             lambda self: is_auto_refractory_required
 
+    if catch_up_code is not None:
+        body["get_catch_up_code"] = lambda self: dedent(catch_up_code)
+
+    if quiescent_steps_code is not None:
+        body["get_quiescent_steps_code"] = \
+            lambda self: dedent(quiescent_steps_code)
+
     if custom_body is not None:
         body.update(custom_body)
 
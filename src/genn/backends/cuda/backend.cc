@@ -175,10 +175,22 @@ Backend::Backend(const KernelBlockSize &kernelBlockSizes, const Preferences &pre
 //--------------------------------------------------------------------------
 void Backend::genNeuronUpdate(CodeStream &os, const ModelSpecMerged &modelMerged,
                               NeuronGroupSimHandler simHandler, NeuronGroupMergedHandler wuVarUpdateHandler,
-                              HostHandler pushEGPHandler) const
+                              HostHandler pushEGPHandler, ShardHandler) const
 {
-    // Generate data structure for accessing merged groups
+    // **NOTE** as kernels handle all merged groups, CUDA modules are never sharded
+
+    // Batched models are not currently supported by the CUDA backend
     const ModelSpecInternal &model = modelMerged.getModel();
+    if(model.getBatchSize() > 1) {
+        throw std::runtime_error("The CUDA backend does not currently support batched models.");
+    }
+
+    // Per-population performance counters are not currently supported as kernels update all merged groups together
+    if(model.isPerformanceCountersEnabled()) {
+        throw std::runtime_error("The CUDA backend does not currently support performance counters.");
+    }
+
+    // Generate data structure for accessing merged groups
     genMergedKernelDataStructures(
         os, m_KernelBlockSizes[KernelNeuronUpdate],
         modelMerged.getMergedNeuronUpdateGroups(), "NeuronUpdate",
@@ -218,8 +230,18 @@ void Backend::genNeuronUpdate(CodeStream &os, const ModelSpecMerged &modelMerged
     }
     os << std::endl;
 
+    // Spike recording writes bitfields one word per warp so requires block size to be a multiple of 32
+    const size_t neuronUpdateBlockSize = m_KernelBlockSizes[KernelNeuronUpdate];
+    if(model.isRecordingInUse() && (neuronUpdateBlockSize % 32) != 0) {
+        throw std::runtime_error("Spike recording requires the neuron update kernel block size to be a multiple of 32");
+    }
+
     size_t idStart = 0;
-    os << "extern \"C\" __global__ void " << KernelNames[KernelNeuronUpdate] << "("  << model.getTimePrecision() << " t)" << std::endl;
+    os << "extern \"C\" __global__ void " << KernelNames[KernelNeuronUpdate] << "("  << model.getTimePrecision() << " t";
+    if(model.isRecordingInUse()) {
+        os << ", unsigned int recordingTimestep";
+    }
+    os << ")" << std::endl;
     {
         CodeStream::Scope b(os);
         os << "const unsigned int id = " << m_KernelBlockSizes[KernelNeuronUpdate] << " * blockIdx.x + threadIdx.x; " << std::endl;
@@ -257,13 +279,24 @@ void Backend::genNeuronUpdate(CodeStream &os, const ModelSpecMerged &modelMerged
             }
             os << std::endl;
         }
+
+        // If any neuron groups record spikes, zero shared memory bitfield used to build this block's recording words
+        if(model.isRecordingInUse()) {
+            os << "__shared__ uint32_t shSpkRecord[" << neuronUpdateBlockSize / 32 << "];" << std::endl;
+            os << "if (threadIdx.x < " << neuronUpdateBlockSize / 32 << ")";
+            {
+                CodeStream::Scope b(os);
+                os << "shSpkRecord[threadIdx.x] = 0;" << std::endl;
+            }
+            os << std::endl;
+        }
             
         os << "__syncthreads();" << std::endl;
 
         // Parallelise over neuron groups
         genParallelGroup<NeuronGroupMerged>(os, kernelSubs, modelMerged.getMergedNeuronUpdateGroups(), "NeuronUpdate", idStart,
             [this](const NeuronGroupInternal &ng){ return padSize(ng.getNumNeurons(), getKernelBlockSize(KernelNeuronUpdate)); },
-            [&model, simHandler, wuVarUpdateHandler, this](CodeStream &os, const NeuronGroupMerged &ng, Substitutions &popSubs)
+            [&model, simHandler, wuVarUpdateHandler, neuronUpdateBlockSize, this](CodeStream &os, const NeuronGroupMerged &ng, Substitutions &popSubs)
             {
                 // If axonal delays are required
                 if (ng.getArchetype().isDelayRequired()) {
@@ -286,9 +319,14 @@ void Backend::genNeuronUpdate(CodeStream &os, const ModelSpecMerged &modelMerged
                     CodeStream::Scope b(os);
                     simHandler(os, ng, popSubs,
                         // Emit true spikes
-                        [this](CodeStream &os, const NeuronGroupMerged &, Substitutions &subs)
+                        [this](CodeStream &os, const NeuronGroupMerged &ng, Substitutions &subs)
                         {
                             genEmitSpike(os, subs, "");
+
+                            // If spike recording is enabled, set this neuron's bit in shared memory bitfield
+                            if(ng.getArchetype().isSpikeRecordingEnabled()) {
+                                os << "atomicOr(&shSpkRecord[threadIdx.x / 32], 1u << (threadIdx.x % 32));" << std::endl;
+                            }
                         },
                         // Emit spike-like events
                         [this](CodeStream &os, const NeuronGroupMerged &, Substitutions &subs)
@@ -366,6 +404,22 @@ void Backend::genNeuronUpdate(CodeStream &os, const ModelSpecMerged &modelMerged
                         }
                     }
                 }
+
+                // If spike recording is enabled, copy this block's words of bitfield into recording buffer
+                // **NOTE** every word is written so recording buffer doesn't need zeroing between timesteps
+                if(ng.getArchetype().isSpikeRecordingEnabled()) {
+                    os << "if(group.recordSpk != NULL && threadIdx.x < " << neuronUpdateBlockSize / 32 << ")";
+                    {
+                        CodeStream::Scope b(os);
+                        os << "const unsigned int numRecordingWords = (group.numNeurons + 31) / 32;" << std::endl;
+                        os << "const unsigned int wordIdx = ((" << popSubs["id"] << " - threadIdx.x) / 32) + threadIdx.x;" << std::endl;
+                        os << "if(wordIdx < numRecordingWords)";
+                        {
+                            CodeStream::Scope b(os);
+                            os << "group.recordSpk[(recordingTimestep * numRecordingWords) + wordIdx] = shSpkRecord[threadIdx.x];" << std::endl;
+                        }
+                    }
+                }
             }
         );
     }
@@ -389,7 +443,11 @@ void Backend::genNeuronUpdate(CodeStream &os, const ModelSpecMerged &modelMerged
             Timer t(os, "neuronUpdate", model.isTimingEnabled());
 
             genKernelDimensions(os, KernelNeuronUpdate, idStart);
-            os << KernelNames[KernelNeuronUpdate] << "<<<grid, threads>>>(t);" << std::endl;
+            os << KernelNames[KernelNeuronUpdate] << "<<<grid, threads>>>(t";
+            if(model.isRecordingInUse()) {
+                os << ", (numRecordingTimesteps == 0) ? 0 : (unsigned int)(iT % numRecordingTimesteps)";
+            }
+            os << ");" << std::endl;
             os << "CHECK_CUDA_ERRORS(cudaPeekAtLastError());" << std::endl;
         }
     }
@@ -399,8 +457,15 @@ void Backend::genSynapseUpdate(CodeStream &os, const ModelSpecMerged &modelMerge
                                SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
                                SynapseGroupMergedHandler wumEventHandler, SynapseGroupMergedHandler wumProceduralConnectHandler,
                                SynapseGroupMergedHandler postLearnHandler, SynapseGroupMergedHandler synapseDynamicsHandler,
-                               HostHandler pushEGPHandler) const
+                               HostHandler pushEGPHandler, ShardHandler) const
 {
+    // Check no synapse groups use CSR connectivity
+    for(const auto &s : modelMerged.getModel().getSynapseGroups()) {
+        if(s.second.getMatrixType() & SynapseMatrixConnectivity::CSR) {
+            throw std::runtime_error("The CUDA backend does not currently support CSR connectivity (synapse group '" + s.second.getName() + "').");
+        }
+    }
+
     // Generate data structure for accessing merged groups
     if(!modelMerged.getMergedPresynapticUpdateGroups().empty()) {
         genMergedKernelDataStructures(
@@ -494,7 +559,7 @@ void Backend::genSynapseUpdate(CodeStream &os, const ModelSpecMerged &modelMerge
             if(std::any_of(modelMerged.getMergedPresynapticUpdateGroups().cbegin(), modelMerged.getMergedPresynapticUpdateGroups().cend(),
                            [&model](const SynapseGroupMerged &s)
                            {
-                               return (s.getArchetype().getSpanType() == SynapseGroup::SpanType::POSTSYNAPTIC
+                               return (s.getArchetype().getSpanType() != SynapseGroup::SpanType::PRESYNAPTIC
                                        && (s.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE));
                            }))
             {
@@ -782,7 +847,7 @@ void Backend::genSynapseUpdate(CodeStream &os, const ModelSpecMerged &modelMerge
 void Backend::genInit(CodeStream &os, const ModelSpecMerged &modelMerged,
                       NeuronGroupMergedHandler localNGHandler, SynapseGroupMergedHandler sgDenseInitHandler, 
                       SynapseGroupMergedHandler sgSparseConnectHandler, SynapseGroupMergedHandler sgSparseInitHandler,
-                      HostHandler initPushEGPHandler, HostHandler initSparsePushEGPHandler) const
+                      HostHandler initPushEGPHandler, HostHandler initSparsePushEGPHandler, ShardHandler) const
 {
     os << "#include <iostream>" << std::endl;
     os << "#include <random>" << std::endl;
@@ -1431,6 +1496,43 @@ void Backend::genRunnerPreamble(CodeStream &os, const ModelSpecMerged &) const
         os << "return reinterpret_cast<T*>(devPtr);" << std::endl;
     }
     os << std::endl;
+
+    // Helpers to stream device memory to and from checkpoints via a bounded staging buffer
+    os << "namespace" << std::endl;
+    os << "{" << std::endl;
+    os << "void writeCheckpointDeviceRecord(std::ostream &os, const char *name, const void *d_data, uint64_t bytes)";
+    {
+        CodeStream::Scope b(os);
+        os << "writeCheckpointRecordHeader(os, name, bytes);" << std::endl;
+        os << "std::vector<char> staging((size_t)std::min(checkpointChunkBytes, bytes));" << std::endl;
+        os << "for(uint64_t offset = 0; offset < bytes; offset += staging.size())";
+        {
+            CodeStream::Scope b(os);
+            os << "const uint64_t chunkBytes = std::min((uint64_t)staging.size(), bytes - offset);" << std::endl;
+            os << "CHECK_CUDA_ERRORS(cudaMemcpy(staging.data(), reinterpret_cast<const char*>(d_data) + offset, chunkBytes, cudaMemcpyDeviceToHost));" << std::endl;
+            os << "writeCheckpointRecordData(os, staging.data(), chunkBytes);" << std::endl;
+        }
+    }
+    os << std::endl;
+    os << "void readCheckpointDeviceRecord(std::istream &is, const char *name, void *d_data, uint64_t bytes)";
+    {
+        CodeStream::Scope b(os);
+        os << "if(readCheckpointRecordHeader(is, name) != bytes)";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Checkpoint record '\" + std::string(name) + \"' has incorrect size\");" << std::endl;
+        }
+        os << "std::vector<char> staging((size_t)std::min(checkpointChunkBytes, bytes));" << std::endl;
+        os << "for(uint64_t offset = 0; offset < bytes; offset += staging.size())";
+        {
+            CodeStream::Scope b(os);
+            os << "const uint64_t chunkBytes = std::min((uint64_t)staging.size(), bytes - offset);" << std::endl;
+            os << "readCheckpointRecordData(is, staging.data(), chunkBytes);" << std::endl;
+            os << "CHECK_CUDA_ERRORS(cudaMemcpy(reinterpret_cast<char*>(d_data) + offset, staging.data(), chunkBytes, cudaMemcpyHostToDevice));" << std::endl;
+        }
+    }
+    os << "}   // Anonymous namespace" << std::endl;
+    os << std::endl;
 }
 //--------------------------------------------------------------------------
 void Backend::genAllocateMemPreamble(CodeStream &os, const ModelSpecMerged &modelMerged) const
@@ -1841,6 +1943,64 @@ void Backend::genReturnFreeDeviceMemoryBytes(CodeStream &os) const
     os << "return free;" << std::endl;
 }
 //--------------------------------------------------------------------------
+void Backend::genCheckpointDeviceArraySave(CodeStream &os, const std::string &type, const std::string &name, size_t count) const
+{
+    os << "writeCheckpointDeviceRecord(checkpoint, \"" << name << "\", d_" << name << ", " << count << " * sizeof(" << type << "));" << std::endl;
+}
+//--------------------------------------------------------------------------
+void Backend::genCheckpointDeviceArrayLoad(CodeStream &os, const std::string &type, const std::string &name, size_t count) const
+{
+    os << "readCheckpointDeviceRecord(checkpoint, \"" << name << "\", d_" << name << ", " << count << " * sizeof(" << type << "));" << std::endl;
+}
+//--------------------------------------------------------------------------
+void Backend::genCheckpointSave(CodeStream &os, const ModelSpecMerged &modelMerged) const
+{
+    // Copy global RNG state from device symbol
+    if(isGlobalRNGRequired(modelMerged)) {
+        CodeStream::Scope b(os);
+        os << "curandStatePhilox4_32_10_t rngState;" << std::endl;
+        os << "CHECK_CUDA_ERRORS(cudaMemcpyFromSymbol(&rngState, d_rng, sizeof(curandStatePhilox4_32_10_t)));" << std::endl;
+        os << "writeCheckpointRecord(checkpoint, \"rng\", &rngState, sizeof(curandStatePhilox4_32_10_t));" << std::endl;
+    }
+
+    // Stream population RNGs from device
+    for(const auto &n : modelMerged.getModel().getNeuronGroups()) {
+        if(n.second.isSimRNGRequired()) {
+            genCheckpointDeviceArraySave(os, "curandState", "rng" + n.first, n.second.getNumNeurons());
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genCheckpointLoad(CodeStream &os, const ModelSpecMerged &modelMerged) const
+{
+    if(isGlobalRNGRequired(modelMerged)) {
+        CodeStream::Scope b(os);
+        os << "curandStatePhilox4_32_10_t rngState;" << std::endl;
+        os << "readCheckpointRecord(checkpoint, \"rng\", &rngState, sizeof(curandStatePhilox4_32_10_t));" << std::endl;
+        os << "CHECK_CUDA_ERRORS(cudaMemcpyToSymbol(d_rng, &rngState, sizeof(curandStatePhilox4_32_10_t)));" << std::endl;
+    }
+
+    for(const auto &n : modelMerged.getModel().getNeuronGroups()) {
+        if(n.second.isSimRNGRequired()) {
+            genCheckpointDeviceArrayLoad(os, "curandState", "rng" + n.first, n.second.getNumNeurons());
+        }
+    }
+
+    // Copy restored spike queue and dendritic delay pointers to their device symbols
+    for(const auto &n : modelMerged.getModel().getNeuronGroups()) {
+        if(n.second.isDelayRequired()) {
+            os << "CHECK_CUDA_ERRORS(cudaMemcpyToSymbol(" << getScalarPrefix() << "spkQuePtr" << n.first << ", &spkQuePtr" << n.first << ", sizeof(unsigned int)));" << std::endl;
+        }
+
+        for(const auto &m : n.second.getMergedInSyn()) {
+            if(m.first->isDendriticDelayRequired()) {
+                const std::string name = "denDelayPtr" + m.first->getPSModelTargetName();
+                os << "CHECK_CUDA_ERRORS(cudaMemcpyToSymbol(" << getScalarPrefix() << name << ", &" << name << ", sizeof(unsigned int)));" << std::endl;
+            }
+        }
+    }
+}
+//--------------------------------------------------------------------------
 void Backend::genMakefilePreamble(std::ostream &os) const
 {
     const std::string architecture = "sm_" + std::to_string(getChosenCUDADevice().major) + std::to_string(getChosenCUDADevice().minor);
@@ -1965,6 +2125,12 @@ bool Backend::isGlobalRNGRequired(const ModelSpecMerged &modelMerged) const
     return false;
 }
 //--------------------------------------------------------------------------
+bool Backend::isPostsynapticRemapRequired(const SynapseGroupInternal &sg) const
+{
+    // Remapping is only used to implement postsynaptic learning
+    return !sg.getWUModel()->getLearnPostCode().empty();
+}
+//--------------------------------------------------------------------------
 std::string Backend::getNVCCFlags() const
 {
     const std::string architecture = "sm_" + std::to_string(getChosenCUDADevice().major) + std::to_string(getChosenCUDADevice().minor);
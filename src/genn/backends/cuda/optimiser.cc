@@ -2,7 +2,9 @@
 
 // Standard C++ includes
 #include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <numeric>
 
@@ -20,6 +22,7 @@
 #include "path.h"
 
 // GeNN includes
+#include "gennUtils.h"
 #include "logging.h"
 #include "modelSpecInternal.h"
 
@@ -36,6 +39,13 @@ namespace
 {
 typedef std::map<unsigned int, std::pair<bool, size_t>> KernelOptimisationOutput;
 
+//--------------------------------------------------------------------------
+std::string readFile(const filesystem::path &path)
+{
+    std::ifstream stream(path.str(), std::ios::binary);
+    return std::string{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+
 void getDeviceArchitectureProperties(const cudaDeviceProp &deviceProps, size_t &warpAllocGran, size_t &regAllocGran,
                                      size_t &smemAllocGran, size_t &maxBlocksPerSM)
 {
@@ -176,6 +186,11 @@ KernelOptimisationOutput optimizeBlockSize(int deviceID, const cudaDeviceProp &d
         throw std::runtime_error("CUDA_PATH environment variable not set - ");
     }
     
+    // Create single cache directory to generate code for each candidate kernel size into
+    // **NOTE** this is kept between runs so cubins built from unchanged code can be reused
+    const filesystem::path cachePath = outputPath / "block_size_optimiser";
+    filesystem::create_directory(cachePath);
+
     // Do two repititions with different candidate kernel size
     const size_t warpSize = 32;
     const size_t repBlockSizes[2] = {warpSize, warpSize * 2};
@@ -189,8 +204,9 @@ KernelOptimisationOutput optimizeBlockSize(int deviceID, const cudaDeviceProp &d
         // Create backend
         Backend backend(blockSize, preferences, model.getPrecision(), deviceID);
 
-        // Generate code
-        const auto moduleNames = generateAll(model, backend, outputPath, true);
+        // Generate code into separate cache subdirectory for each repetition so the cubins built from them can be reused
+        const filesystem::path repOutputPath = cachePath / std::to_string(repBlockSizes[r]);
+        const auto moduleNames = generateAll(model, backend, repOutputPath, true);
 
         // Set context
         // **NOTE** CUDA calls in code generation seem to lose driver context
@@ -199,7 +215,7 @@ KernelOptimisationOutput optimizeBlockSize(int deviceID, const cudaDeviceProp &d
         // Loop through generated modules
         for(const auto &m : moduleNames) {
             // Build module
-            const std::string modulePath = (outputPath / m).str();
+            const std::string modulePath = (repOutputPath / m).str();
             
 #ifdef _WIN32
             // **YUCK** extra outer quotes required to workaround gross windowsness https://stackoverflow.com/questions/9964865/c-system-not-working-when-there-are-spaces-in-two-different-parameters
@@ -207,8 +223,26 @@ KernelOptimisationOutput optimizeBlockSize(int deviceID, const cudaDeviceProp &d
 #else
             const std::string nvccCommand = "\"" + nvccPath.str() + "\" -cubin " + backend.getNVCCFlags() + " -DBUILDING_GENERATED_CODE -o \"" + modulePath + ".cubin\" \"" + modulePath + ".cc\"";
  #endif
-            if(system(nvccCommand.c_str()) != 0) {
-                throw std::runtime_error("optimizeBlockSize: NVCC failed");
+
+            // Hash NVCC command and all of the code it will compile
+            const std::string files[] = {"definitions.h", "definitionsInternal.h", "supportCode.h", "runner.cc", m + ".cc"};
+            uint64_t hash = Utils::hashString(nvccCommand);
+            for(const auto &f : files) {
+                hash = Utils::hashString(readFile(repOutputPath / f), hash);
+            }
+
+            // If cubin wasn't previously built from identical code, build it and record hash
+            const filesystem::path hashPath(modulePath + ".cubin.hash");
+            if(!filesystem::path(modulePath + ".cubin").exists() || readFile(hashPath) != std::to_string(hash)) {
+                if(system(nvccCommand.c_str()) != 0) {
+                    throw std::runtime_error("optimizeBlockSize: NVCC failed");
+                }
+
+                std::ofstream hashStream(hashPath.str());
+                hashStream << hash;
+            }
+            else {
+                LOGD_BACKEND << "\tReusing previously built '" << modulePath << ".cubin'";
             }
 
             // Load compiled module
@@ -238,12 +272,8 @@ KernelOptimisationOutput optimizeBlockSize(int deviceID, const cudaDeviceProp &d
             }
 
             // Unload module
+            // **NOTE** cubin file is kept so it can be reused if model is rebuilt without changes
             CHECK_CU_ERRORS(cuModuleUnload(module));
-
-            // Remove tempory cubin file
-            if(std::remove((modulePath + ".cubin").c_str())) {
-                LOGW_BACKEND << "Cannot remove dry-run cubin file";
-            }
         }
     }
 
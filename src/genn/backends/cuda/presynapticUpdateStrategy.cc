@@ -262,8 +262,8 @@ size_t PostSpan::getSynapticMatrixRowStride(const SynapseGroupInternal &sg) cons
 //----------------------------------------------------------------------------
 bool PostSpan::isCompatible(const SynapseGroupInternal &sg, const cudaDeviceProp &, const Preferences &) const
 {
-    // Postsynatic parallelism can be used when synapse groups request it
-    return ((sg.getSpanType() == SynapseGroup::SpanType::POSTSYNAPTIC)
+    // Postsynatic parallelism can be used when synapse groups request it or leave the choice to the backend
+    return ((sg.getSpanType() != SynapseGroup::SpanType::PRESYNAPTIC)
             && !(sg.getMatrixType() & SynapseMatrixConnectivity::PROCEDURAL));
 }
 //----------------------------------------------------------------------------
@@ -678,7 +678,7 @@ bool PostSpanBitmask::isCompatible(const SynapseGroupInternal &sg, const cudaDev
     // Postsynaptic bitmask parallelism can be used if bitmask optimisations are enabled and
     // if synapse groups with bitmask connectivity and no dendritic delays request postsynaptic parallelism
     return (preferences.enableBitmaskOptimisations
-            && (sg.getSpanType() == SynapseGroup::SpanType::POSTSYNAPTIC)
+            && (sg.getSpanType() != SynapseGroup::SpanType::PRESYNAPTIC)
             && (sg.getMatrixType() & SynapseMatrixConnectivity::BITMASK)
             && !sg.isDendriticDelayRequired());
 }
@@ -0,0 +1,727 @@
+#include "backend.h"
+
+// Standard C++ includes
+#include <algorithm>
+#include <thread>
+
+// GeNN includes
+#include "gennUtils.h"
+
+// GeNN code generator includes
+#include "code_generator/codeStream.h"
+#include "code_generator/modelSpecMerged.h"
+#include "code_generator/substitutions.h"
+
+//--------------------------------------------------------------------------
+// Anonymous namespace
+//--------------------------------------------------------------------------
+namespace
+{
+// Minimum number of neurons updated by each task
+const unsigned int neuronChunkSize = 256;
+
+// Minimum number of presynaptic spikes processed by each task
+const unsigned int spikeChunkSize = 16;
+
+// Minimum number of postsynaptic neurons whose per-thread input is summed by each task
+const unsigned int inSynChunkSize = 256;
+
+// Minimum number of synaptic matrix rows initialised by each task
+const unsigned int rowChunkSize = 32;
+
+// Minimum number of postsynaptic neurons whose column of the postsynaptic remapping is allocated by each task
+const unsigned int colChunkSize = 256;
+
+unsigned int getPreferredNumThreads(const CodeGenerator::MultiThreadedCPU::Preferences &preferences)
+{
+    // If number of threads is specified in preferences, use it
+    if(preferences.numThreads > 0) {
+        return preferences.numThreads;
+    }
+    // Otherwise, use the number of hardware threads, falling back to a single thread if this cannot be determined
+    else {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+}
+
+//--------------------------------------------------------------------------
+// CodeGenerator::MultiThreadedCPU::Backend
+//--------------------------------------------------------------------------
+namespace CodeGenerator
+{
+namespace MultiThreadedCPU
+{
+Backend::Backend(const std::string &scalarType, const Preferences &preferences)
+:   SingleThreadedCPU::Backend(scalarType, preferences), m_NumThreads(getPreferredNumThreads(preferences))
+{
+}
+//--------------------------------------------------------------------------
+void Backend::genDefinitionsInternalPreamble(CodeStream &os, const ModelSpecMerged &modelMerged) const
+{
+    // Generate single-threaded preamble
+    SingleThreadedCPU::Backend::genDefinitionsInternalPreamble(os, modelMerged);
+
+    os << "// Standard C++ includes" << std::endl;
+    os << "#include <functional>" << std::endl;
+    os << "#include <vector>" << std::endl;
+    os << std::endl;
+
+    os << "// ------------------------------------------------------------------------" << std::endl;
+    os << "// thread pool" << std::endl;
+    os << "// ------------------------------------------------------------------------" << std::endl;
+    os << "//! Get the number of items in each chunk when [0, count) is split across " << m_NumThreads << " threads" << std::endl;
+    os << "unsigned int getChunkSize(unsigned int count, unsigned int minChunkSize);" << std::endl;
+    os << std::endl;
+    os << "//! Split [0, count) into contiguous chunks of at least minChunkSize items and call func(chunkBegin, chunkEnd, chunk)" << std::endl;
+    os << "//! for each chunk on the thread pool. Returns the number of chunks used" << std::endl;
+    os << "unsigned int parallelFor(unsigned int count, unsigned int minChunkSize, const std::function<void(unsigned int, unsigned int, unsigned int)> &func);" << std::endl;
+    os << std::endl;
+
+    // If any presynaptic updates are parallelised, declare buffer to accumulate per-thread postsynaptic input into
+    if(getInSynThreadBufferStride(modelMerged) > 0) {
+        os << "extern std::vector<" << modelMerged.getModel().getPrecision() << "> inSynThreadBuffer;" << std::endl;
+        os << std::endl;
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genRunnerPreamble(CodeStream &os, const ModelSpecMerged &modelMerged) const
+{
+    // Generate single-threaded preamble
+    SingleThreadedCPU::Backend::genRunnerPreamble(os, modelMerged);
+
+    os << "// Standard C++ includes" << std::endl;
+    os << "#include <atomic>" << std::endl;
+    os << "#include <condition_variable>" << std::endl;
+    os << "#include <mutex>" << std::endl;
+    os << "#include <thread>" << std::endl;
+    os << std::endl;
+
+    os << "// ------------------------------------------------------------------------" << std::endl;
+    os << "// thread pool" << std::endl;
+    os << "// ------------------------------------------------------------------------" << std::endl;
+    os << "namespace";
+    {
+        CodeStream::Scope b(os);
+        os << "//! Persistent pool of worker threads which, alongside the calling thread, execute numbered tasks" << std::endl;
+        os << "class ParallelForThreadPool" << std::endl;
+        {
+            CodeStream::Scope b(os);
+            os << "public:" << std::endl;
+            os << "ParallelForThreadPool(unsigned int numWorkers) : m_Generation(0), m_Active(0), m_Stop(false), m_Task(nullptr), m_NumTasks(0), m_NextTask(0), m_PendingTasks(0)";
+            {
+                CodeStream::Scope b(os);
+                os << "for(unsigned int i = 0; i < numWorkers; i++)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "m_Workers.emplace_back(&ParallelForThreadPool::workerThread, this);" << std::endl;
+                }
+            }
+            os << std::endl;
+            os << "~ParallelForThreadPool()";
+            {
+                CodeStream::Scope b(os);
+                {
+                    CodeStream::Scope b(os);
+                    os << "std::lock_guard<std::mutex> lock(m_Mutex);" << std::endl;
+                    os << "m_Stop = true;" << std::endl;
+                }
+                os << "m_StartCV.notify_all();" << std::endl;
+                os << "for(auto &w : m_Workers)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "w.join();" << std::endl;
+                }
+            }
+            os << std::endl;
+            os << "//! Execute task(0) ... task(numTasks - 1) and wait for them all to complete" << std::endl;
+            os << "void run(unsigned int numTasks, const std::function<void(unsigned int)> &task)";
+            {
+                CodeStream::Scope b(os);
+                {
+                    CodeStream::Scope b(os);
+                    os << "// Wait for any workers still leaving the previous run" << std::endl;
+                    os << "std::unique_lock<std::mutex> lock(m_Mutex);" << std::endl;
+                    os << "m_DoneCV.wait(lock, [this](){ return (m_Active == 0); });" << std::endl;
+                    os << std::endl;
+                    os << "// Publish new tasks and advance generation to wake workers" << std::endl;
+                    os << "m_Task = &task;" << std::endl;
+                    os << "m_NumTasks = numTasks;" << std::endl;
+                    os << "m_NextTask = 0;" << std::endl;
+                    os << "m_PendingTasks = numTasks;" << std::endl;
+                    os << "m_Generation++;" << std::endl;
+                }
+                os << "m_StartCV.notify_all();" << std::endl;
+                os << std::endl;
+                os << "// Process tasks on this thread too" << std::endl;
+                os << "runTasks(task, numTasks);" << std::endl;
+                os << std::endl;
+                os << "// Wait for tasks being processed by workers to complete" << std::endl;
+                os << "std::unique_lock<std::mutex> lock(m_Mutex);" << std::endl;
+                os << "m_DoneCV.wait(lock, [this](){ return (m_PendingTasks == 0); });" << std::endl;
+            }
+            os << std::endl;
+            os << "private:" << std::endl;
+            os << "void runTasks(const std::function<void(unsigned int)> &task, unsigned int numTasks)";
+            {
+                CodeStream::Scope b(os);
+                os << "for(unsigned int t = m_NextTask++; t < numTasks; t = m_NextTask++)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "task(t);" << std::endl;
+                    os << "if(--m_PendingTasks == 0)";
+                    {
+                        CodeStream::Scope b(os);
+                        os << "std::lock_guard<std::mutex> lock(m_Mutex);" << std::endl;
+                        os << "m_DoneCV.notify_all();" << std::endl;
+                    }
+                }
+            }
+            os << std::endl;
+            os << "void workerThread()";
+            {
+                CodeStream::Scope b(os);
+                os << "unsigned long long generation = 0;" << std::endl;
+                os << "while(true)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "const std::function<void(unsigned int)> *task;" << std::endl;
+                    os << "unsigned int numTasks;" << std::endl;
+                    {
+                        CodeStream::Scope b(os);
+                        os << "std::unique_lock<std::mutex> lock(m_Mutex);" << std::endl;
+                        os << "m_StartCV.wait(lock, [this, generation](){ return (m_Stop || m_Generation != generation); });" << std::endl;
+                        os << "if(m_Stop)";
+                        {
+                            CodeStream::Scope b(os);
+                            os << "return;" << std::endl;
+                        }
+                        os << std::endl;
+                        os << "// Take snapshot of run and register as active so it can't be replaced until we leave" << std::endl;
+                        os << "generation = m_Generation;" << std::endl;
+                        os << "task = m_Task;" << std::endl;
+                        os << "numTasks = m_NumTasks;" << std::endl;
+                        os << "m_Active++;" << std::endl;
+                    }
+                    os << "runTasks(*task, numTasks);" << std::endl;
+                    {
+                        CodeStream::Scope b(os);
+                        os << "std::lock_guard<std::mutex> lock(m_Mutex);" << std::endl;
+                        os << "m_Active--;" << std::endl;
+                    }
+                    os << "m_DoneCV.notify_all();" << std::endl;
+                }
+            }
+            os << std::endl;
+            os << "std::vector<std::thread> m_Workers;" << std::endl;
+            os << "std::mutex m_Mutex;" << std::endl;
+            os << "std::condition_variable m_StartCV;" << std::endl;
+            os << "std::condition_variable m_DoneCV;" << std::endl;
+            os << "unsigned long long m_Generation;" << std::endl;
+            os << "unsigned int m_Active;" << std::endl;
+            os << "bool m_Stop;" << std::endl;
+            os << "const std::function<void(unsigned int)> *m_Task;" << std::endl;
+            os << "unsigned int m_NumTasks;" << std::endl;
+            os << "std::atomic<unsigned int> m_NextTask;" << std::endl;
+            os << "std::atomic<unsigned int> m_PendingTasks;" << std::endl;
+        }
+        os << ";" << std::endl;
+        os << std::endl;
+        os << "// Calling thread participates in parallel work so one fewer worker thread is required" << std::endl;
+        os << "ParallelForThreadPool parallelForThreadPool(" << (m_NumThreads - 1) << ");" << std::endl;
+    }
+    os << std::endl;
+
+    os << "unsigned int getChunkSize(unsigned int count, unsigned int minChunkSize)";
+    {
+        CodeStream::Scope b(os);
+        os << "return std::max(minChunkSize, (count + " << m_NumThreads << " - 1) / " << m_NumThreads << ");" << std::endl;
+    }
+    os << std::endl;
+
+    os << "unsigned int parallelFor(unsigned int count, unsigned int minChunkSize, const std::function<void(unsigned int, unsigned int, unsigned int)> &func)";
+    {
+        CodeStream::Scope b(os);
+        os << "const unsigned int chunkSize = getChunkSize(count, minChunkSize);" << std::endl;
+        os << "const unsigned int numChunks = (count + chunkSize - 1) / chunkSize;" << std::endl;
+        os << std::endl;
+        os << "// If there's only a single chunk, process it directly" << std::endl;
+        os << "if(numChunks == 1)";
+        {
+            CodeStream::Scope b(os);
+            os << "func(0, count, 0);" << std::endl;
+        }
+        os << "// Otherwise, process chunks on thread pool" << std::endl;
+        os << "else if(numChunks > 1)";
+        {
+            CodeStream::Scope b(os);
+            os << "parallelForThreadPool.run(numChunks, [chunkSize, count, &func](unsigned int c){ func(c * chunkSize, std::min(count, (c + 1) * chunkSize), c); });" << std::endl;
+        }
+        os << "return numChunks;" << std::endl;
+    }
+    os << std::endl;
+
+    // If any presynaptic updates are parallelised, allocate buffer to accumulate per-thread postsynaptic input into
+    const size_t inSynThreadBufferStride = getInSynThreadBufferStride(modelMerged);
+    if(inSynThreadBufferStride > 0) {
+        os << "std::vector<" << modelMerged.getModel().getPrecision() << "> inSynThreadBuffer(" << (m_NumThreads * inSynThreadBufferStride) << ");" << std::endl;
+        os << std::endl;
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genMakefilePreamble(std::ostream &os) const
+{
+    // Generate single-threaded preamble
+    SingleThreadedCPU::Backend::genMakefilePreamble(os);
+
+    // Add flags required to build with threads
+    os << "CXXFLAGS += -pthread" << std::endl;
+    os << "LINKFLAGS += -pthread" << std::endl;
+    os << std::endl;
+}
+//--------------------------------------------------------------------------
+void Backend::genNeuronUpdateGroup(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &funcSubs,
+                                   NeuronGroupSimHandler simHandler, NeuronGroupMergedHandler wuVarUpdateHandler) const
+{
+    // If neuron group requires a simulation RNG and counter-based RNGs aren't enabled, update it serially as the global
+    // RNG cannot be shared between threads. Similarly, update event-driven neuron groups serially by walking their calendar queue
+    if((ng.getArchetype().isSimRNGRequired() && !getPreferences().enableCounterBasedRNG) || ng.getArchetype().isEventDriven()) {
+        SingleThreadedCPU::Backend::genNeuronUpdateGroup(os, ng, funcSubs, simHandler, wuVarUpdateHandler);
+        return;
+    }
+
+    // If axonal delays are required
+    if(ng.getArchetype().isDelayRequired()) {
+        // We should READ from delay slot before spkQuePtr
+        os << "const unsigned int readDelayOffset = " << ng.getPrevQueueOffset() << ";" << std::endl;
+
+        // And we should WRITE to delay slot pointed to be spkQuePtr
+        os << "const unsigned int writeDelayOffset = " << ng.getCurrentQueueOffset() << ";" << std::endl;
+    }
+    os << std::endl;
+
+    // If neurons can be updated using vectorisable loop, update chunks in parallel then compact spikes serially
+    if(isSIMDNeuronUpdate(ng)) {
+        os << "parallelFor(group.numNeurons, " << neuronChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int)";
+        {
+            CodeStream::Scope b(os);
+            genSIMDNeuronUpdateLoop(os, ng, funcSubs, simHandler, "chunkBegin", "chunkEnd");
+        }
+        os << ");" << std::endl;
+        genSIMDSpikeCompaction(os, ng, funcSubs, wuVarUpdateHandler);
+        return;
+    }
+
+    // Each chunk writes its spikes to the start of its own section of the spike buffer and counts them
+    const bool spikeEventRequired = ng.getArchetype().isSpikeEventRequired();
+    os << "unsigned int chunkNumSpikes[" << m_NumThreads << "];" << std::endl;
+    if(spikeEventRequired) {
+        os << "unsigned int chunkNumSpikeEvents[" << m_NumThreads << "];" << std::endl;
+    }
+    os << "const unsigned int numChunks = parallelFor(group.numNeurons, " << neuronChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int chunk)";
+    {
+        CodeStream::Scope b(os);
+        os << "unsigned int numSpikes = 0;" << std::endl;
+        if(spikeEventRequired) {
+            os << "unsigned int numSpikeEvents = 0;" << std::endl;
+        }
+        os << "for(unsigned int i = chunkBegin; i < chunkEnd; i++)";
+        {
+            CodeStream::Scope b(os);
+
+            Substitutions popSubs(&funcSubs);
+            popSubs.addVarSubstitution("id", "i");
+            addNeuronRNGSubstitutions(os, ng, popSubs);
+
+            simHandler(os, ng, popSubs,
+                       // Emit true spikes
+                       [this, wuVarUpdateHandler](CodeStream &os, const NeuronGroupMerged &ng, Substitutions &subs)
+                       {
+                           // Insert code to emit true spikes
+                           genWriteSpike(os, ng, subs, true, "chunkBegin + numSpikes++");
+
+                           // Insert code to update WU vars
+                           wuVarUpdateHandler(os, ng, subs);
+                       },
+                       // Emit spike-like events
+                       [this](CodeStream &os, const NeuronGroupMerged &ng, Substitutions &subs)
+                       {
+                           // Insert code to emit spike-like events
+                           genWriteSpike(os, ng, subs, false, "chunkBegin + numSpikeEvents++");
+                       });
+        }
+        os << "chunkNumSpikes[chunk] = numSpikes;" << std::endl;
+        if(spikeEventRequired) {
+            os << "chunkNumSpikeEvents[chunk] = numSpikeEvents;" << std::endl;
+        }
+    }
+    os << ");" << std::endl;
+    os << std::endl;
+
+    // Concatenate each chunk's spikes in order so spike order matches the single-threaded backend
+    os << "// Concatenate spikes emitted by each chunk" << std::endl;
+    os << "const unsigned int chunkSize = getChunkSize(group.numNeurons, " << neuronChunkSize << ");" << std::endl;
+    os << "for(unsigned int c = 0; c < numChunks; c++)";
+    {
+        CodeStream::Scope b(os);
+        const std::string spikeCount = getSpikeCount(ng, true);
+        const std::string spikeQueueOffset = getSpikeQueueOffset(ng, true);
+        os << "std::memmove(&group.spk[" << spikeQueueOffset << spikeCount << "], &group.spk[" << spikeQueueOffset << "(c * chunkSize)], chunkNumSpikes[c] * sizeof(unsigned int));" << std::endl;
+        os << spikeCount << " += chunkNumSpikes[c];" << std::endl;
+
+        if(spikeEventRequired) {
+            const std::string spikeEventCount = getSpikeCount(ng, false);
+            const std::string spikeEventQueueOffset = getSpikeQueueOffset(ng, false);
+            os << "std::memmove(&group.spkEvnt[" << spikeEventQueueOffset << spikeEventCount << "], &group.spkEvnt[" << spikeEventQueueOffset << "(c * chunkSize)], chunkNumSpikeEvents[c] * sizeof(unsigned int));" << std::endl;
+            os << spikeEventCount << " += chunkNumSpikeEvents[c];" << std::endl;
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genPresynapticUpdateGroup(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                        SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
+                                        SynapseGroupMergedHandler wumEventHandler, SynapseGroupMergedHandler wumProceduralConnectHandler) const
+{
+    // If dendritic delays are required, process spikes serially as per-thread dendritic delay buffers would be prohibitively large.
+    // Similarly, process spikes targetting event-driven neurons serially as the calendar queue used to wake them isn't thread-safe
+    if(sg.getArchetype().isDendriticDelayRequired() || sg.getArchetype().getTrgNeuronGroup()->isEventDriven()) {
+        SingleThreadedCPU::Backend::genPresynapticUpdateGroup(os, modelMerged, sg, funcSubs, wumThreshHandler, wumSimHandler,
+                                                              wumEventHandler, wumProceduralConnectHandler);
+        return;
+    }
+
+    // If presynaptic neuron group has variable queues, calculate offset to read from its variables with axonal delay
+    if(sg.getArchetype().getSrcNeuronGroup()->isDelayRequired()) {
+        os << "const unsigned int preReadDelaySlot = " << sg.getPresynapticAxonalDelaySlot() << ";" << std::endl;
+        os << "const unsigned int preReadDelayOffset = preReadDelaySlot * group.numSrcNeurons;" << std::endl;
+    }
+
+    // If postsynaptic neuron group has variable queues, calculate offset to read from its variables at current time
+    if(sg.getArchetype().getTrgNeuronGroup()->isDelayRequired()) {
+        os << "const unsigned int postReadDelayOffset = " << sg.getPostsynapticBackPropDelaySlot() << " * group.numTrgNeurons;" << std::endl;
+    }
+
+    // If input may be scattered from spikes, count per-thread buffers used
+    const bool scatter = !isPostSpanAlwaysUsed(sg.getArchetype());
+    if(scatter) {
+        os << "unsigned int numInSynThreadBuffers = 0;" << std::endl;
+    }
+
+    // generate the code for processing spike-like events
+    if (sg.getArchetype().isSpikeEventRequired()) {
+        genParallelPresynapticUpdate(os, modelMerged, sg, funcSubs, false, wumThreshHandler, wumEventHandler, wumProceduralConnectHandler);
+    }
+
+    // generate the code for processing true spike events
+    if (sg.getArchetype().isTrueSpikeRequired()) {
+        genParallelPresynapticUpdate(os, modelMerged, sg, funcSubs, true, wumThreshHandler, wumSimHandler, wumProceduralConnectHandler);
+    }
+    os << std::endl;
+
+    // Sum input accumulated by each thread into inSyn in thread order and zero thread buffers ready for next timestep
+    if(scatter) {
+        const size_t inSynThreadBufferStride = getInSynThreadBufferStride(modelMerged);
+        os << "// Sum postsynaptic input accumulated by each thread" << std::endl;
+        os << "if(numInSynThreadBuffers > 0)";
+        {
+            CodeStream::Scope b(os);
+            os << "parallelFor(group.numTrgNeurons, " << inSynChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int)";
+            {
+                CodeStream::Scope b(os);
+                os << "for(unsigned int t = 0; t < numInSynThreadBuffers; t++)";
+                {
+                    CodeStream::Scope b(os);
+                    os << modelMerged.getModel().getPrecision() << " *inSynBuffer = &inSynThreadBuffer[t * " << inSynThreadBufferStride << "];" << std::endl;
+                    os << "for(unsigned int j = chunkBegin; j < chunkEnd; j++)";
+                    {
+                        CodeStream::Scope b(os);
+                        os << "group.inSyn[j] += inSynBuffer[j];" << std::endl;
+                        os << "inSynBuffer[j] = " << modelMerged.getModel().scalarExpr(0.0) << ";" << std::endl;
+                    }
+                }
+            }
+            os << ");" << std::endl;
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genSparseConnectivityInitGroup(CodeStream &os, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                             SynapseGroupMergedHandler sgSparseConnectHandler) const
+{
+    // If rows must be built in order using the global RNG or connectivity is a bitmask
+    // (where the rows of one thread may share words with the next), build connectivity serially
+    const bool csr = (sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::CSR);
+    if(!isConnectivityInitRowIndependent(sg.getArchetype())
+       || (!csr && !(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE)))
+    {
+        SingleThreadedCPU::Backend::genSparseConnectivityInitGroup(os, sg, funcSubs, sgSparseConnectHandler);
+        return;
+    }
+
+    // Generate code to build a row of connectivity, calling addSynapse for each synapse
+    const auto genBuildRow =
+        [&](const std::string &addSynapse)
+        {
+            Substitutions popSubs(&funcSubs);
+            popSubs.addVarSubstitution("id_pre", "i");
+            popSubs.addVarSubstitution("id_post_begin", "0");
+            popSubs.addVarSubstitution("id_thread", "0");
+            popSubs.addVarSubstitution("num_threads", "1");
+            popSubs.addVarSubstitution("num_post", "group.numTrgNeurons");
+            popSubs.addFuncSubstitution("addSynapse", 1, addSynapse);
+
+            addConnectivityInitRNGSubstitutions(os, sg, popSubs);
+            sgSparseConnectHandler(os, sg, popSubs);
+        };
+
+    // If connectivity is CSR, the position of each row depends on the length of all those before it
+    if(csr) {
+        // Build rows in parallel, only counting their synapses
+        os << "// Count synapses in each row in parallel" << std::endl;
+        os << "parallelFor(group.numSrcNeurons, " << rowChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int)";
+        {
+            CodeStream::Scope b(os);
+            os << "for (unsigned int i = chunkBegin; i < chunkEnd; i++)";
+            {
+                CodeStream::Scope b(os);
+                os << "unsigned int rowLength = 0;" << std::endl;
+                genBuildRow("rowLength++");
+                os << "group.rowPtr[i + 1] = rowLength;" << std::endl;
+            }
+        }
+        os << ");" << std::endl;
+
+        // Sum row lengths to get start of each row
+        os << "// Calculate start of each row from row lengths" << std::endl;
+        os << "group.rowPtr[0] = 0;" << std::endl;
+        os << "for (unsigned int i = 0; i < group.numSrcNeurons; i++)";
+        {
+            CodeStream::Scope b(os);
+            os << "group.rowPtr[i + 1] += group.rowPtr[i];" << std::endl;
+        }
+
+        // Check synapses will fit before inserting any
+        os << "if(group.rowPtr[group.numSrcNeurons] > group.maxTotalConnections)";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Too many synapses generated for CSR connectivity - increase maxTotalConnections\");" << std::endl;
+        }
+
+        // Build rows again in parallel, this time inserting synapses
+        // **NOTE** rows are built independently so each one is identical to when it was counted
+        os << "// Insert synapses into each row in parallel" << std::endl;
+        os << "parallelFor(group.numSrcNeurons, " << rowChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int)";
+        {
+            CodeStream::Scope b(os);
+            os << "for (unsigned int i = chunkBegin; i < chunkEnd; i++)";
+            {
+                CodeStream::Scope b(os);
+                os << "unsigned int synapse = group.rowPtr[i];" << std::endl;
+                genBuildRow("group.ind[synapse++] = $(0)");
+            }
+        }
+        os << ");" << std::endl;
+    }
+    // Otherwise, each row has its own section of ind so build rows in parallel
+    else {
+        os << "// Build rows in parallel" << std::endl;
+        os << "parallelFor(group.numSrcNeurons, " << rowChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int)";
+        {
+            CodeStream::Scope b(os);
+            os << "for (unsigned int i = chunkBegin; i < chunkEnd; i++)";
+            {
+                CodeStream::Scope b(os);
+                os << "group.rowLength[i] = 0;" << std::endl;
+                genBuildRow("group.ind[(i * group.rowStride) + (group.rowLength[i]++)] = $(0)");
+            }
+        }
+        os << ");" << std::endl;
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genSparseInitGroup(CodeStream &os, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                 SynapseGroupMergedHandler sgSparseInitHandler) const
+{
+    if(sg.getArchetype().isWUVarInitRequired()) {
+        const auto genInitRow =
+            [&]()
+            {
+                CodeStream::Scope b(os);
+
+                Substitutions popSubs(&funcSubs);
+                popSubs.addVarSubstitution("id_pre", "i");
+                popSubs.addVarSubstitution("row_len", getSparseRowLength(sg, "i"));
+                sgSparseInitHandler(os, sg, popSubs);
+            };
+
+        // If synapse variable initialisation requires the global RNG, initialise serially
+        if(Utils::isRNGRequired(sg.getArchetype().getWUVarInitialisers())) {
+            os << "// Initialise synapse variables" << std::endl;
+            os << "for (unsigned int i = 0; i < group.numSrcNeurons; i++)";
+            genInitRow();
+        }
+        // Otherwise, rows can be initialised independently so process in parallel
+        else {
+            os << "// Initialise synapse variables in parallel" << std::endl;
+            os << "parallelFor(group.numSrcNeurons, " << rowChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int)";
+            {
+                CodeStream::Scope b(os);
+                os << "for (unsigned int i = chunkBegin; i < chunkEnd; i++)";
+                genInitRow();
+            }
+            os << ");" << std::endl;
+        }
+    }
+
+    // If postsynaptic remapping is required, build it from a histogram of each chunk of rows' postsynaptic targets
+    // **NOTE** each chunk's synapses are inserted after those of the chunks before it so column order matches single-threaded backend
+    if (isPostsynapticRemapRequired(sg.getArchetype())) {
+        os << "const unsigned int remapChunkSize = getChunkSize(group.numSrcNeurons, " << rowChunkSize << ");" << std::endl;
+        os << "const unsigned int numRemapChunks = (group.numSrcNeurons + remapChunkSize - 1) / remapChunkSize;" << std::endl;
+        os << "std::vector<unsigned int> chunkColOffset((size_t)numRemapChunks * group.numTrgNeurons, 0);" << std::endl;
+
+        os << "// Count synapses targetting each postsynaptic neuron from each chunk of rows in parallel" << std::endl;
+        os << "parallelFor(group.numSrcNeurons, " << rowChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int chunk)";
+        {
+            CodeStream::Scope b(os);
+            os << "unsigned int *chunkColLength = &chunkColOffset[(size_t)chunk * group.numTrgNeurons];" << std::endl;
+            os << "for (unsigned int i = chunkBegin; i < chunkEnd; i++)";
+            {
+                CodeStream::Scope b(os);
+                os << "for(unsigned int j = 0; j < " << getSparseRowLength(sg, "i") << "; j++)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "chunkColLength[group.ind[" << getSparseRowStart(sg, "i") << " + j]]++;" << std::endl;
+                }
+            }
+        }
+        os << ");" << std::endl;
+
+        os << "// Sum counts across chunks in parallel to get column lengths and where each chunk's synapses start in each column" << std::endl;
+        os << "parallelFor(group.numTrgNeurons, " << colChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int)";
+        {
+            CodeStream::Scope b(os);
+            os << "for (unsigned int j = chunkBegin; j < chunkEnd; j++)";
+            {
+                CodeStream::Scope b(os);
+                os << "unsigned int colLength = 0;" << std::endl;
+                os << "for(unsigned int c = 0; c < numRemapChunks; c++)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "const unsigned int count = chunkColOffset[((size_t)c * group.numTrgNeurons) + j];" << std::endl;
+                    os << "chunkColOffset[((size_t)c * group.numTrgNeurons) + j] = colLength;" << std::endl;
+                    os << "colLength += count;" << std::endl;
+                }
+                os << "group.colLength[j] = colLength;" << std::endl;
+            }
+        }
+        os << ");" << std::endl;
+
+        os << "// Scatter each chunk of rows' synapses into its section of each column in parallel" << std::endl;
+        os << "parallelFor(group.numSrcNeurons, " << rowChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int chunk)";
+        {
+            CodeStream::Scope b(os);
+            os << "unsigned int *chunkColStart = &chunkColOffset[(size_t)chunk * group.numTrgNeurons];" << std::endl;
+            os << "for (unsigned int i = chunkBegin; i < chunkEnd; i++)";
+            {
+                CodeStream::Scope b(os);
+                os << "for(unsigned int j = 0; j < " << getSparseRowLength(sg, "i") << "; j++)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "const unsigned int rowMajorIndex = " << getSparseRowStart(sg, "i") << " + j;" << std::endl;
+                    os << "const unsigned int postIndex = group.ind[rowMajorIndex];" << std::endl;
+                    os << "group.remap[(postIndex * group.colStride) + (chunkColStart[postIndex]++)] = rowMajorIndex;" << std::endl;
+                }
+            }
+        }
+        os << ");" << std::endl;
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genParallelPresynapticUpdate(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &popSubs,
+                                           bool trueSpike, SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
+                                           SynapseGroupMergedHandler wumProceduralConnectHandler) const
+{
+    // Get suffix based on type of events
+    const std::string eventSuffix = trueSpike ? "" : "Evnt";
+    const std::string spikeCount = "group.srcSpkCnt" + eventSuffix + (sg.getArchetype().getSrcNeuronGroup()->isDelayRequired() ? "[preReadDelaySlot]" : "[0]");
+
+    os << "// process presynaptic events: " << (trueSpike ? "True Spikes" : "Spike type events") << std::endl;
+    const auto genScatter =
+        [&]()
+        {
+            // Distribute spikes between threads, each of which accumulates postsynaptic input into its own buffer
+            os << "numInSynThreadBuffers = std::max(numInSynThreadBuffers, parallelFor(" << spikeCount << ", " << spikeChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int chunk)";
+            {
+                CodeStream::Scope b(os);
+                os << modelMerged.getModel().getPrecision() << " *inSynBuffer = &inSynThreadBuffer[chunk * " << getInSynThreadBufferStride(modelMerged) << "];" << std::endl;
+                os << "for (unsigned int i = chunkBegin; i < chunkEnd; i++)";
+                {
+                    CodeStream::Scope b(os);
+                    genPresynapticUpdateSpike(os, modelMerged, sg, popSubs, trueSpike, "inSynBuffer",
+                                              wumThreshHandler, wumSimHandler, wumProceduralConnectHandler);
+                }
+            }
+            os << "));" << std::endl;
+        };
+
+    // If input can be gathered target-by-target
+    if(isPostSpanPresynapticUpdate(sg.getArchetype())) {
+        CodeStream::Scope b(os);
+        os << "const unsigned int numSpikes = " << spikeCount << ";" << std::endl;
+
+        // If choice between gathering and scattering is made at runtime, generate condition
+        const std::string postSpanCondition = getPostSpanCondition(sg, "numSpikes");
+        if(!postSpanCondition.empty()) {
+            os << "if(" << postSpanCondition << ")";
+        }
+        {
+            CodeStream::Scope b(os);
+
+            // Mark active presynaptic neurons serially and then distribute postsynaptic neurons between threads
+            // **NOTE** as each postsynaptic neuron is only updated by one thread, no buffers are required
+            genPostSpanMarkActive(os, modelMerged, sg, popSubs, trueSpike, "numSpikes", wumThreshHandler);
+            os << "parallelFor(group.numTrgNeurons, " << inSynChunkSize << ", [&](unsigned int chunkBegin, unsigned int chunkEnd, unsigned int)";
+            {
+                CodeStream::Scope b(os);
+                genPostSpanGather(os, modelMerged, sg, popSubs, wumSimHandler, "chunkBegin", "chunkEnd");
+            }
+            os << ");" << std::endl;
+            genPostSpanReset(os, sg);
+        }
+
+        // Otherwise, scatter
+        if(!postSpanCondition.empty()) {
+            os << "else";
+            CodeStream::Scope b(os);
+            genScatter();
+        }
+    }
+    // Otherwise, scatter input from spikes in parallel
+    else {
+        genScatter();
+    }
+}
+//--------------------------------------------------------------------------
+bool Backend::isPostSpanAlwaysUsed(const SynapseGroupInternal &sg) const
+{
+    return (isPostSpanPresynapticUpdate(sg) && (sg.getSpanType() == SynapseGroup::SpanType::POSTSYNAPTIC));
+}
+//--------------------------------------------------------------------------
+size_t Backend::getInSynThreadBufferStride(const ModelSpecMerged &modelMerged) const
+{
+    // Find the largest postsynaptic population targetted by a presynaptic update which is parallelised by scattering spikes
+    size_t stride = 0;
+    for(const auto &s : modelMerged.getMergedPresynapticUpdateGroups()) {
+        if(!s.getArchetype().isDendriticDelayRequired() && !s.getArchetype().getTrgNeuronGroup()->isEventDriven()
+           && !isPostSpanAlwaysUsed(s.getArchetype()))
+        {
+            for(const auto &g : s.getGroups()) {
+                stride = std::max<size_t>(stride, g.get().getTrgNeuronGroup()->getNumNeurons());
+            }
+        }
+    }
+    return stride;
+}
+}   // namespace MultiThreadedCPU
+}   // namespace CodeGenerator
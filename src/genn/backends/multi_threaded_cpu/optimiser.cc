@@ -0,0 +1,35 @@
+#include "optimiser.h"
+
+// GeNN includes
+#include "logging.h"
+#include "modelSpecInternal.h"
+
+//--------------------------------------------------------------------------
+// CodeGenerator::MultiThreadedCPU::Optimiser
+//--------------------------------------------------------------------------
+namespace CodeGenerator
+{
+namespace MultiThreadedCPU
+{
+namespace Optimiser
+{
+Backend createBackend(const ModelSpecInternal &model, const filesystem::path &,
+                      plog::Severity backendLevel, plog::IAppender *backendAppender,
+                      const Preferences &preferences)
+{
+    // If there isn't already a plog instance, initialise one
+    if(plog::get<Logging::CHANNEL_BACKEND>() == nullptr) {
+        plog::init<Logging::CHANNEL_BACKEND>(backendLevel, backendAppender);
+    }
+    // Otherwise, set it's max severity from GeNN preferences
+    else {
+        plog::get<Logging::CHANNEL_BACKEND>()->setMaxSeverity(backendLevel);
+    }
+
+    Backend backend(model.getPrecision(), preferences);
+    LOGI_BACKEND << "Generating code for " << backend.getNumThreads() << " threads";
+    return backend;
+}
+}   // namespace Optimiser
+}   // namespace MultiThreadedCPU
+}   // namespace CodeGenerator
@@ -1,7 +1,9 @@
 #include "backend.h"
 
 // Standard C++ include
+#include <functional>
 #include <random>
+#include <sstream>
 
 // GeNN includes
 #include "gennUtils.h"
@@ -17,6 +19,46 @@
 //--------------------------------------------------------------------------
 namespace
 {
+bool isProceduralRNGRequired(const SynapseGroupInternal &sg)
+{
+    // An RNG is required when building rows of procedural connectivity if the row build
+    // code requires one or if procedural weights are initialised using an RNG
+    return (sg.isProceduralConnectivityRNGRequired()
+            || ((sg.getMatrixType() & SynapseMatrixWeight::PROCEDURAL) && Utils::isRNGRequired(sg.getWUVarInitialisers())));
+}
+//--------------------------------------------------------------------------
+bool isProceduralRNGRequired(const ModelSpecInternal &model)
+{
+    return std::any_of(model.getSynapseGroups().cbegin(), model.getSynapseGroups().cend(),
+                       [](const ModelSpec::SynapseGroupValueType &s){ return isProceduralRNGRequired(s.second); });
+}
+//--------------------------------------------------------------------------
+void genSynapseGroupRNGStreams(CodeGenerator::CodeStream &os, const std::string &name, const ModelSpecInternal &model,
+                               const CodeGenerator::SynapseGroupMerged &sg)
+{
+    // Declare array containing the position of each group in the model
+    const auto &synapseGroups = model.getSynapseGroups();
+    os << "const uint32_t " << name << "[] = {";
+    for(const auto &g : sg.getGroups()) {
+        os << std::distance(synapseGroups.cbegin(), synapseGroups.find(g.get().getName())) << ", ";
+    }
+    os << "};" << std::endl;
+}
+//--------------------------------------------------------------------------
+bool isRaggedConnectivity(const CodeGenerator::SynapseGroupMerged &sg)
+{
+    // Both SPARSE and CSR connectivity store the indices of postsynaptic targets row-by-row
+    return ((sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE)
+            || (sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::CSR));
+}
+
+// Alignment (in bytes) of arrays when SIMD neuron update is enabled - sufficient for AVX-512
+const size_t simdAlignment = 64;
+
+// Approximate cost of scattering input from a spike to a randomly-accessed postsynaptic neuron,
+// relative to gathering it while processing postsynaptic neurons in order
+const unsigned int postSpanScatterCost = 4;
+
 const std::vector<CodeGenerator::FunctionTemplate> cpuFunctions = {
     {"gennrand_uniform", 0, "standardUniformDistribution($(rng))", "standardUniformDistribution($(rng))"},
     {"gennrand_normal", 0, "standardNormalDistribution($(rng))", "standardNormalDistribution($(rng))"},
@@ -25,6 +67,17 @@ const std::vector<CodeGenerator::FunctionTemplate> cpuFunctions = {
     {"gennrand_gamma", 1, "std::gamma_distribution<double>($(0), 1.0)($(rng))", "std::gamma_distribution<float>($(0), 1.0f)($(rng))"}
 };
 
+// Functions used in place of cpuFunctions when neurons are simulated using counter-based RNG streams
+// **NOTE** these have no shared state so, unlike the standard distributions, can be called from multiple threads.
+// They are also written in terms of scalar so the single and double precision templates are identical
+const std::vector<CodeGenerator::FunctionTemplate> cpuCounterRNGFunctions = {
+    {"gennrand_uniform", 0, "philoxUniform($(rng))", "philoxUniform($(rng))"},
+    {"gennrand_normal", 0, "philoxNormal($(rng))", "philoxNormal($(rng))"},
+    {"gennrand_exponential", 0, "philoxExponential($(rng))", "philoxExponential($(rng))"},
+    {"gennrand_log_normal", 2, "std::exp($(0) + ($(1) * philoxNormal($(rng))))", "std::exp($(0) + ($(1) * philoxNormal($(rng))))"},
+    {"gennrand_gamma", 1, "std::gamma_distribution<scalar>($(0), 1.0)($(rng))", "std::gamma_distribution<scalar>($(0), 1.0)($(rng))"}
+};
+
 //--------------------------------------------------------------------------
 // Timer
 //--------------------------------------------------------------------------
@@ -56,6 +109,234 @@ private:
     const std::string m_Name;
     const bool m_TimingEnabled;
 };
+
+//--------------------------------------------------------------------------
+void genPhilox(CodeGenerator::CodeStream &os)
+{
+    using namespace CodeGenerator;
+
+    os << "// ------------------------------------------------------------------------" << std::endl;
+    os << "// Philox4x32-10 counter-based RNG (Salmon et al. 2011)" << std::endl;
+    os << "// ------------------------------------------------------------------------" << std::endl;
+    os << "class Philox4x32_10" << std::endl;
+    {
+        CodeStream::Scope b(os);
+        os << "public:" << std::endl;
+        os << "typedef uint32_t result_type;" << std::endl;
+        os << std::endl;
+        os << "Philox4x32_10(uint64_t key, uint32_t counter1, uint32_t counter2, uint32_t counter3)";
+        os << " : m_Key{(uint32_t)key, (uint32_t)(key >> 32)}, m_Counter{0, counter1, counter2, counter3}, m_OutputIndex(4)";
+        {
+            CodeStream::Scope b(os);
+        }
+        os << std::endl;
+        os << "static constexpr result_type min(){ return 0; }" << std::endl;
+        os << "static constexpr result_type max(){ return 0xFFFFFFFF; }" << std::endl;
+        os << std::endl;
+        os << "result_type operator()()";
+        {
+            CodeStream::Scope b(os);
+            os << "// If all words of last block have been used, generate next block" << std::endl;
+            os << "if(m_OutputIndex == 4)";
+            {
+                CodeStream::Scope b(os);
+                os << "generateBlock();" << std::endl;
+                os << "m_OutputIndex = 0;" << std::endl;
+            }
+            os << "return m_Output[m_OutputIndex++];" << std::endl;
+        }
+        os << std::endl;
+        os << "private:" << std::endl;
+        os << "void generateBlock()";
+        {
+            CodeStream::Scope b(os);
+            os << "uint32_t key[2] = {m_Key[0], m_Key[1]};" << std::endl;
+            os << "uint32_t ctr[4] = {m_Counter[0], m_Counter[1], m_Counter[2], m_Counter[3]};" << std::endl;
+            os << "for(unsigned int r = 0; r < 10; r++)";
+            {
+                CodeStream::Scope b(os);
+                os << "const uint64_t product0 = (uint64_t)0xD2511F53u * ctr[0];" << std::endl;
+                os << "const uint64_t product1 = (uint64_t)0xCD9E8D57u * ctr[2];" << std::endl;
+                os << "const uint32_t next[4] = {(uint32_t)(product1 >> 32) ^ ctr[1] ^ key[0], (uint32_t)product1," << std::endl;
+                os << "                          (uint32_t)(product0 >> 32) ^ ctr[3] ^ key[1], (uint32_t)product0};" << std::endl;
+                os << "std::copy(std::begin(next), std::end(next), std::begin(ctr));" << std::endl;
+                os << std::endl;
+                os << "// Bump key using Weyl sequence" << std::endl;
+                os << "key[0] += 0x9E3779B9u;" << std::endl;
+                os << "key[1] += 0xBB67AE85u;" << std::endl;
+            }
+            os << "std::copy(std::begin(ctr), std::end(ctr), std::begin(m_Output));" << std::endl;
+            os << std::endl;
+            os << "// Advance counter to next block" << std::endl;
+            os << "m_Counter[0]++;" << std::endl;
+        }
+        os << std::endl;
+        os << "uint32_t m_Key[2];" << std::endl;
+        os << "uint32_t m_Counter[4];" << std::endl;
+        os << "uint32_t m_Output[4];" << std::endl;
+        os << "unsigned int m_OutputIndex;" << std::endl;
+    }
+    os << ";" << std::endl;
+    os << std::endl;
+}
+//--------------------------------------------------------------------------
+void genPhiloxSamplers(CodeGenerator::CodeStream &os, const std::string &precision)
+{
+    using namespace CodeGenerator;
+
+    // **NOTE** each draw from RNG is a separate statement as evaluation order within expressions is unspecified
+    // **NOTE** one bit less than the mantissa is used so that adding 0.5 is exact and the result can never round up to 1
+    os << "// Uniform sample in (0, 1) from Philox stream" << std::endl;
+    os << "inline scalar philoxUniform(Philox4x32_10 &rng)";
+    {
+        CodeStream::Scope b(os);
+        if(precision == "double") {
+            os << "const uint64_t high = rng() >> 6;" << std::endl;
+            os << "const uint64_t low = rng() >> 6;" << std::endl;
+            os << "return ((double)((high << 26) | low) + 0.5) * 2.220446049250313e-16;" << std::endl;
+        }
+        else {
+            os << "return ((float)(rng() >> 9) + 0.5f) * 1.1920928955078125e-7f;" << std::endl;
+        }
+    }
+    os << std::endl;
+    os << "// Standard normal sample from Philox stream using Box-Muller transform" << std::endl;
+    os << "inline scalar philoxNormal(Philox4x32_10 &rng)";
+    {
+        CodeStream::Scope b(os);
+        os << "const scalar u1 = philoxUniform(rng);" << std::endl;
+        os << "const scalar u2 = philoxUniform(rng);" << std::endl;
+        os << "return std::sqrt((scalar)-2.0 * std::log(u1)) * std::cos((scalar)6.283185307179586 * u2);" << std::endl;
+    }
+    os << std::endl;
+    os << "// Standard exponential sample from Philox stream" << std::endl;
+    os << "inline scalar philoxExponential(Philox4x32_10 &rng)";
+    {
+        CodeStream::Scope b(os);
+        os << "return -std::log(philoxUniform(rng));" << std::endl;
+    }
+    os << std::endl;
+}
+//--------------------------------------------------------------------------
+bool isEventDrivenNeuronUpdateRequired(const ModelSpecInternal &model)
+{
+    return std::any_of(model.getNeuronGroups().cbegin(), model.getNeuronGroups().cend(),
+                       [](const ModelSpec::NeuronGroupValueType &n){ return n.second.isEventDriven(); });
+}
+//--------------------------------------------------------------------------
+void genWakeQueue(CodeGenerator::CodeStream &os, unsigned int numBuckets)
+{
+    using namespace CodeGenerator;
+
+    // **NOTE** each neuron in an event-driven group is always linked into the list of the bucket for the timestep
+    // it is next due to be woken. Buckets are reused every numBuckets timesteps so lists can also contain neurons
+    // due to be woken on later passes - these are skipped over rather than moved so scheduling is constant time
+    os << "// Link neuron into calendar queue bucket of timestep it should be woken" << std::endl;
+    os << "inline void wakeQueueInsert(int *head, int *next, int *prev, unsigned long long *step, unsigned int id, unsigned long long wakeStep)";
+    {
+        CodeStream::Scope b(os);
+        os << "int &bucketHead = head[wakeStep % " << numBuckets << "];" << std::endl;
+        os << "step[id] = wakeStep;" << std::endl;
+        os << "prev[id] = -1;" << std::endl;
+        os << "next[id] = bucketHead;" << std::endl;
+        os << "if(bucketHead != -1)";
+        {
+            CodeStream::Scope b(os);
+            os << "prev[bucketHead] = (int)id;" << std::endl;
+        }
+        os << "bucketHead = (int)id;" << std::endl;
+    }
+    os << std::endl;
+    os << "// Unlink neuron from calendar queue bucket" << std::endl;
+    os << "inline void wakeQueueRemove(int *head, int *next, int *prev, const unsigned long long *step, unsigned int id)";
+    {
+        CodeStream::Scope b(os);
+        os << "if(prev[id] == -1)";
+        {
+            CodeStream::Scope b(os);
+            os << "head[step[id] % " << numBuckets << "] = next[id];" << std::endl;
+        }
+        os << "else";
+        {
+            CodeStream::Scope b(os);
+            os << "next[prev[id]] = next[id];" << std::endl;
+        }
+        os << "if(next[id] != -1)";
+        {
+            CodeStream::Scope b(os);
+            os << "prev[next[id]] = prev[id];" << std::endl;
+        }
+    }
+    os << std::endl;
+    os << "// Move neuron to earlier timestep's bucket if it isn't already due to be woken by then" << std::endl;
+    os << "inline void wakeQueueSchedule(int *head, int *next, int *prev, unsigned long long *step, unsigned int id, unsigned long long wakeStep)";
+    {
+        CodeStream::Scope b(os);
+        os << "if(wakeStep < step[id])";
+        {
+            CodeStream::Scope b(os);
+            os << "wakeQueueRemove(head, next, prev, step, id);" << std::endl;
+            os << "wakeQueueInsert(head, next, prev, step, id, wakeStep);" << std::endl;
+        }
+    }
+    os << std::endl;
+}
+//--------------------------------------------------------------------------
+std::string getWakeQueueArgs(const std::string &prefix)
+{
+    // Neuron update accesses its own group's queue whereas synaptic input accesses that of the target neuron group
+    if(prefix.empty()) {
+        return "group.wakeHead, group.wakeNext, group.wakePrev, group.wakeStep";
+    }
+    else {
+        return "group." + prefix + "WakeHead, group." + prefix + "WakeNext, group." + prefix + "WakePrev, group." + prefix + "WakeStep";
+    }
+}
+//--------------------------------------------------------------------------
+void addToInSynSubstitutions(CodeGenerator::Substitutions &subs, const CodeGenerator::SynapseGroupMerged &sg,
+                             const std::string &inSyn, const std::string &idPost)
+{
+    // If target neurons are event-driven, also schedule them to be woken on the timestep input arrives
+    const bool wake = sg.getArchetype().getTrgNeuronGroup()->isEventDriven();
+    if(sg.getArchetype().isDendriticDelayRequired()) {
+        const std::string add = "group.denDelay[" + sg.getDendriticDelayOffset("$(1)") + idPost + "] += $(0)";
+        subs.addFuncSubstitution("addToInSynDelay", 2,
+                                 wake ? ("(" + add + ", wakeQueueSchedule(" + getWakeQueueArgs("trg") + ", " + idPost + ", iT + $(1)))") : add);
+    }
+    else {
+        const std::string add = inSyn + "[" + idPost + "] += $(0)";
+        subs.addFuncSubstitution("addToInSyn", 1,
+                                 wake ? ("(" + add + ", wakeQueueSchedule(" + getWakeQueueArgs("trg") + ", " + idPost + ", iT))") : add);
+    }
+}
+//-----------------------------------------------------------------------
+void genStartPerformanceCounter(CodeGenerator::CodeStream &os, const ModelSpecInternal &model)
+{
+    // Record start of group's update
+    if(model.isPerformanceCountersEnabled()) {
+        os << "const auto perfStart = std::chrono::high_resolution_clock::now();" << std::endl;
+    }
+}
+//-----------------------------------------------------------------------
+void genMergedGroupBatchLoop(CodeGenerator::CodeStream &os, unsigned int batchSize, const std::string &name, size_t index,
+                             std::function<void()> handler)
+{
+    // If model is batched, loop through batches, offsetting a copy of the merged group's pointers to each one
+    if(batchSize > 1) {
+        os << "for(unsigned int batch = 0; batch < " << batchSize << "; batch++)";
+        {
+            CodeGenerator::CodeStream::Scope b(os);
+            os << "auto group = merged" << name << "Group" << index << "[g];" << std::endl;
+            os << "batchMerged" << name << "Group" << index << "(group, batch);" << std::endl;
+            handler();
+        }
+    }
+    // Otherwise, simply get reference to group
+    else {
+        os << "const auto &group = merged" << name << "Group" << index << "[g]; " << std::endl;
+        handler();
+    }
+}
 }
 
 //--------------------------------------------------------------------------
@@ -67,7 +348,7 @@ namespace SingleThreadedCPU
 {
 void Backend::genNeuronUpdate(CodeStream &os, const ModelSpecMerged &modelMerged, 
                               NeuronGroupSimHandler simHandler, NeuronGroupMergedHandler wuVarUpdateHandler,
-                              HostHandler pushEGPHandler) const
+                              HostHandler pushEGPHandler, ShardHandler shardHandler) const
 {
     const ModelSpecInternal &model = modelMerged.getModel();
     os << "void updateNeurons(" << model.getTimePrecision() << " t)";
@@ -90,74 +371,88 @@ void Backend::genNeuronUpdate(CodeStream &os, const ModelSpecMerged &modelMerged
             {
                 CodeStream::Scope b(os);
 
-                // Get reference to group
-                os << "const auto &group = mergedNeuronSpikeQueueUpdateGroup" << n.getIndex() << "[g]; " << std::endl;
-
-                // Generate spike count reset
-                genMergedGroupSpikeCountReset(os, n);
+                // Loop through batches and get reference to group
+                genMergedGroupBatchLoop(os, model.getBatchSize(), "NeuronSpikeQueueUpdate", n.getIndex(),
+                                        [&]()
+                {
+                    // Generate spike count reset
+                    genMergedGroupSpikeCountReset(os, n);
+                });
             }
             
         }
         // Loop through merged neuron update groups
         for(const auto &n : modelMerged.getMergedNeuronUpdateGroups()) {
-            CodeStream::Scope b(os);
-            os << "// merged neuron update group " << n.getIndex() << std::endl;
-            os << "for(unsigned int g = 0; g < " << n.getGroups().size() << "; g++)";
+            genMergedGroup(os, shardHandler, "NeuronUpdate", n.getIndex(), n.getGroups().size(), model.getTimePrecision() + " t", "t",
+                           [&](CodeStream &os)
             {
-                CodeStream::Scope b(os);
-
-                // Get reference to group
-                os << "const auto &group = mergedNeuronUpdateGroup" << n.getIndex() << "[g]; " << std::endl;
-
-                // If axonal delays are required
-                if(n.getArchetype().isDelayRequired()) {
-                    // We should READ from delay slot before spkQuePtr
-                    os << "const unsigned int readDelayOffset = " << n.getPrevQueueOffset() << ";" << std::endl;
-
-                    // And we should WRITE to delay slot pointed to be spkQuePtr
-                    os << "const unsigned int writeDelayOffset = " << n.getCurrentQueueOffset() << ";" << std::endl;
+                os << "// merged neuron update group " << n.getIndex() << std::endl;
+
+                // If neurons are simulated using counter-based RNGs, give each population a stream ID based on its
+                // position in the model (rather than in the merged group) so streams don't depend on merging
+                if(m_Preferences.enableCounterBasedRNG && n.getArchetype().isSimRNGRequired()) {
+                    const auto &neuronGroups = model.getNeuronGroups();
+                    os << "const uint32_t neuronRNGStream[] = {";
+                    for(const auto &g : n.getGroups()) {
+                        os << std::distance(neuronGroups.cbegin(), neuronGroups.find(g.get().getName())) << ", ";
+                    }
+                    os << "};" << std::endl;
                 }
-                os << std::endl;
-
-                os << "for(unsigned int i = 0; i < group.numNeurons; i++)";
+                os << "for(unsigned int g = 0; g < " << n.getGroups().size() << "; g++)";
                 {
                     CodeStream::Scope b(os);
 
-                    Substitutions popSubs(&funcSubs);
-                    popSubs.addVarSubstitution("id", "i");
+                    // Loop through batches and get reference to group
+                    genMergedGroupBatchLoop(os, model.getBatchSize(), "NeuronUpdate", n.getIndex(),
+                                            [&]()
+                    {
+                        genStartPerformanceCounter(os, model);
 
-                    // If this neuron group requires a simulation RNG, substitute in global RNG
-                    if(n.getArchetype().isSimRNGRequired()) {
-                        popSubs.addVarSubstitution("rng", "rng");
-                    }
+                        // If neurons are simulated using counter-based RNGs, give each batch its own range of neuron streams
+                        if(m_Preferences.enableCounterBasedRNG && n.getArchetype().isSimRNGRequired()) {
+                            os << "const uint32_t neuronRNGOffset = " << ((model.getBatchSize() > 1) ? "batch * group.numNeurons" : "0") << ";" << std::endl;
+                        }
+
+                        genNeuronUpdateGroup(os, n, funcSubs, simHandler, wuVarUpdateHandler);
+
+                        // If spike recording is enabled and recording buffers have been allocated
+                        if(n.getArchetype().isSpikeRecordingEnabled()) {
+                            os << "if(group.recordSpk != nullptr)";
+                            {
+                                CodeStream::Scope b(os);
+
+                                // Get pointer to this timestep's bitfield and zero it
+                                os << "const unsigned int numRecordingWords = (group.numNeurons + 31) / 32;" << std::endl;
+                                os << "uint32_t *recordSpk = &group.recordSpk[(iT % numRecordingTimesteps) * numRecordingWords];" << std::endl;
+                                os << "std::fill_n(recordSpk, numRecordingWords, 0);" << std::endl;
+
+                                // Set bits of neurons which spiked this timestep
+                                const bool spikeDelayRequired = (n.getArchetype().isDelayRequired() && n.getArchetype().isTrueSpikeRequired());
+                                os << "const unsigned int *spk = &group.spk[" << (spikeDelayRequired ? "*group.spkQuePtr * group.numNeurons" : "0") << "];" << std::endl;
+                                os << "for(unsigned int i = 0; i < group.spkCnt[" << (spikeDelayRequired ? "*group.spkQuePtr" : "0") << "]; i++)";
+                                {
+                                    CodeStream::Scope b(os);
+                                    os << "recordSpk[spk[i] / 32] |= (1u << (spk[i] % 32));" << std::endl;
+                                }
+                            }
+                        }
 
-                    simHandler(os, n, popSubs,
-                               // Emit true spikes
-                               [this, wuVarUpdateHandler](CodeStream &os, const NeuronGroupMerged &ng, Substitutions &subs)
-                               {
-                                   // Insert code to emit true spikes
-                                   genEmitSpike(os, ng, subs, true);
-
-                                   // Insert code to update WU vars
-                                   wuVarUpdateHandler(os, ng, subs);
-                               },
-                               // Emit spike-like events
-                                   [this](CodeStream &os, const NeuronGroupMerged &ng, Substitutions &subs)
-                               {
-                                   // Insert code to emit spike-like events
-                                   genEmitSpike(os, ng, subs, false);
-                               });
+                        // Record spikes emitted by neurons in performance counter
+                        if(model.isPerformanceCountersEnabled()) {
+                            os << "recordPerformanceCounter(group.perfCounter, perfStart, " << getSpikeCount(n, true) << ", 0);" << std::endl;
+                        }
+                    });
                 }
-            }
+            });
         }
     }
 }
 //--------------------------------------------------------------------------
 void Backend::genSynapseUpdate(CodeStream &os, const ModelSpecMerged &modelMerged,
                                SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
-                               SynapseGroupMergedHandler wumEventHandler, SynapseGroupMergedHandler,
+                               SynapseGroupMergedHandler wumEventHandler, SynapseGroupMergedHandler wumProceduralConnectHandler,
                                SynapseGroupMergedHandler postLearnHandler, SynapseGroupMergedHandler synapseDynamicsHandler,
-                               HostHandler pushEGPHandler) const
+                               HostHandler pushEGPHandler, ShardHandler shardHandler) const
 {
     const ModelSpecInternal &model = modelMerged.getModel();
     os << "void updateSynapses(" << model.getTimePrecision() << " t)";
@@ -174,72 +469,78 @@ void Backend::genSynapseUpdate(CodeStream &os, const ModelSpecMerged &modelMerge
             // Loop through merged synapse dynamics groups
             Timer t(os, "synapseDynamics", model.isTimingEnabled());
             for(const auto &s : modelMerged.getMergedSynapseDynamicsGroups()) {
-                CodeStream::Scope b(os);
-                os << "// merged synapse dynamics group " << s.getIndex() << std::endl;
-                os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
+                genMergedGroup(os, shardHandler, "SynapseDynamics", s.getIndex(), s.getGroups().size(), model.getTimePrecision() + " t", "t",
+                               [&](CodeStream &os)
                 {
-                    CodeStream::Scope b(os);
-
-                    // Get reference to group
-                    os << "const auto &group = mergedSynapseDynamicsGroup" << s.getIndex() << "[g]; " << std::endl;
-
-                    // If presynaptic neuron group has variable queues, calculate offset to read from its variables with axonal delay
-                    if(s.getArchetype().getSrcNeuronGroup()->isDelayRequired()) {
-                        os << "const unsigned int preReadDelayOffset = " << s.getPresynapticAxonalDelaySlot() << " * group.numSrcNeurons;" << std::endl;
-                    }
-
-                    // If postsynaptic neuron group has variable queues, calculate offset to read from its variables at current time
-                    if(s.getArchetype().getTrgNeuronGroup()->isDelayRequired()) {
-                        os << "const unsigned int postReadDelayOffset = " << s.getPostsynapticBackPropDelaySlot() << " * group.numTrgNeurons;" << std::endl;
-                    }
-
-                    // Loop through presynaptic neurons
-                    os << "for(unsigned int i = 0; i < group.numSrcNeurons; i++)";
+                    os << "// merged synapse dynamics group " << s.getIndex() << std::endl;
+                    os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
                     {
-                        // If this synapse group has sparse connectivity, loop through length of this row
                         CodeStream::Scope b(os);
-                        if(s.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
-                            os << "for(unsigned int s = 0; s < group.rowLength[i]; s++)";
-                        }
-                        // Otherwise, if it's dense, loop through each postsynaptic neuron
-                        else if(s.getArchetype().getMatrixType() & SynapseMatrixConnectivity::DENSE) {
-                            os << "for (unsigned int j = 0; j < group.numTrgNeurons; j++)";
-                        }
-                        else {
-                            throw std::runtime_error("Only DENSE and SPARSE format connectivity can be used for synapse dynamics");
-                        }
-                        {
-                            CodeStream::Scope b(os);
 
-                            Substitutions synSubs(&funcSubs);
-                            if(s.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
-                                // Calculate index of synapse and use it to look up postsynaptic index
-                                os << "const unsigned int n = (i * group.rowStride) + s;" << std::endl;
-                                os << "const unsigned int j = group.ind[n];" << std::endl;
+                        // Loop through batches and get reference to group
+                        genMergedGroupBatchLoop(os, model.getBatchSize(), "SynapseDynamics", s.getIndex(),
+                                                [&]()
+                        {
+                            genStartPerformanceCounter(os, model);
 
-                                synSubs.addVarSubstitution("id_syn", "n");
-                            }
-                            else {
-                                synSubs.addVarSubstitution("id_syn", "(i * group.numTrgNeurons) + j");
+                            // If presynaptic neuron group has variable queues, calculate offset to read from its variables with axonal delay
+                            if(s.getArchetype().getSrcNeuronGroup()->isDelayRequired()) {
+                                os << "const unsigned int preReadDelayOffset = " << s.getPresynapticAxonalDelaySlot() << " * group.numSrcNeurons;" << std::endl;
                             }
 
-                            // Add pre and postsynaptic indices to substitutions
-                            synSubs.addVarSubstitution("id_pre", "i");
-                            synSubs.addVarSubstitution("id_post", "j");
-
-                            // Add correct functions for apply synaptic input
-                            if(s.getArchetype().isDendriticDelayRequired()) {
-                                synSubs.addFuncSubstitution("addToInSynDelay", 2, "group.denDelay[" + s.getDendriticDelayOffset("$(1)") + "j] += $(0)");
+                            // If postsynaptic neuron group has variable queues, calculate offset to read from its variables at current time
+                            if(s.getArchetype().getTrgNeuronGroup()->isDelayRequired()) {
+                                os << "const unsigned int postReadDelayOffset = " << s.getPostsynapticBackPropDelaySlot() << " * group.numTrgNeurons;" << std::endl;
                             }
-                            else {
-                                synSubs.addFuncSubstitution("addToInSyn", 1, "group.inSyn[j] += $(0)");
+
+                            // Loop through presynaptic neurons
+                            os << "for(unsigned int i = 0; i < group.numSrcNeurons; i++)";
+                            {
+                                // If this synapse group has sparse connectivity, loop through length of this row
+                                CodeStream::Scope b(os);
+                                if(isRaggedConnectivity(s)) {
+                                    os << "for(unsigned int s = 0; s < " << getSparseRowLength(s, "i") << "; s++)";
+                                }
+                                // Otherwise, if it's dense, loop through each postsynaptic neuron
+                                else if(s.getArchetype().getMatrixType() & SynapseMatrixConnectivity::DENSE) {
+                                    os << "for (unsigned int j = 0; j < group.numTrgNeurons; j++)";
+                                }
+                                else {
+                                    throw std::runtime_error("Only DENSE, SPARSE and CSR format connectivity can be used for synapse dynamics");
+                                }
+                                {
+                                    CodeStream::Scope b(os);
+
+                                    Substitutions synSubs(&funcSubs);
+                                    if(isRaggedConnectivity(s)) {
+                                        // Calculate index of synapse and use it to look up postsynaptic index
+                                        os << "const unsigned int n = " << getSparseRowStart(s, "i") << " + s;" << std::endl;
+                                        os << "const unsigned int j = group.ind[n];" << std::endl;
+
+                                        synSubs.addVarSubstitution("id_syn", "n");
+                                    }
+                                    else {
+                                        synSubs.addVarSubstitution("id_syn", "(i * group.numTrgNeurons) + j");
+                                    }
+
+                                    // Add pre and postsynaptic indices to substitutions
+                                    synSubs.addVarSubstitution("id_pre", "i");
+                                    synSubs.addVarSubstitution("id_post", "j");
+
+                                    // Add correct functions for apply synaptic input
+                                    addToInSynSubstitutions(synSubs, s, "group.inSyn", "j");
+
+                                    // Call synapse dynamics handler
+                                    synapseDynamicsHandler(os, s, synSubs);
+                                }
                             }
 
-                            // Call synapse dynamics handler
-                            synapseDynamicsHandler(os, s, synSubs);
-                        }
+                            if(model.isPerformanceCountersEnabled()) {
+                                genRecordSynapseDynamicsPerformanceCounter(os, s);
+                            }
+                        });
                     }
-                }
+                });
             }
         }
 
@@ -247,37 +548,34 @@ void Backend::genSynapseUpdate(CodeStream &os, const ModelSpecMerged &modelMerge
         {
             Timer t(os, "presynapticUpdate", model.isTimingEnabled());
             for(const auto &s : modelMerged.getMergedPresynapticUpdateGroups()) {
-                CodeStream::Scope b(os);
-                os << "// merged presynaptic update group " << s.getIndex() << std::endl;
-                os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
+                genMergedGroup(os, shardHandler, "PresynapticUpdate", s.getIndex(), s.getGroups().size(), model.getTimePrecision() + " t", "t",
+                               [&](CodeStream &os)
                 {
-                    CodeStream::Scope b(os);
-
-                    // Get reference to group
-                    os << "const auto &group = mergedPresynapticUpdateGroup" << s.getIndex() << "[g]; " << std::endl;
-
-                    // If presynaptic neuron group has variable queues, calculate offset to read from its variables with axonal delay
-                    if(s.getArchetype().getSrcNeuronGroup()->isDelayRequired()) {
-                        os << "const unsigned int preReadDelaySlot = " << s.getPresynapticAxonalDelaySlot() << ";" << std::endl;
-                        os << "const unsigned int preReadDelayOffset = preReadDelaySlot * group.numSrcNeurons;" << std::endl;
-                    }
+                    os << "// merged presynaptic update group " << s.getIndex() << std::endl;
 
-                    // If postsynaptic neuron group has variable queues, calculate offset to read from its variables at current time
-                    if(s.getArchetype().getTrgNeuronGroup()->isDelayRequired()) {
-                        os << "const unsigned int postReadDelayOffset = " << s.getPostsynapticBackPropDelaySlot() << " * group.numTrgNeurons;" << std::endl;
+                    // If procedural connectivity or weights are generated using counter-based RNGs, list the stream of each
+                    // group, based on its position in the model (rather than in the merged group) so streams don't depend on merging
+                    if((s.getArchetype().getMatrixType() & SynapseMatrixConnectivity::PROCEDURAL) && isProceduralRNGRequired(s.getArchetype())) {
+                        genSynapseGroupRNGStreams(os, "proceduralRNGStream", model, s);
                     }
+                    os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
+                    {
+                        CodeStream::Scope b(os);
 
-                    // generate the code for processing spike-like events
-                    if (s.getArchetype().isSpikeEventRequired()) {
-                        genPresynapticUpdate(os, modelMerged, s, funcSubs, false, wumThreshHandler, wumEventHandler);
-                    }
+                        // Loop through batches and get reference to group
+                        genMergedGroupBatchLoop(os, model.getBatchSize(), "PresynapticUpdate", s.getIndex(),
+                                                [&]()
+                        {
+                            genStartPerformanceCounter(os, model);
+                            genPresynapticUpdateGroup(os, modelMerged, s, funcSubs, wumThreshHandler, wumSimHandler,
+                                                      wumEventHandler, wumProceduralConnectHandler);
 
-                    // generate the code for processing true spike events
-                    if (s.getArchetype().isTrueSpikeRequired()) {
-                        genPresynapticUpdate(os, modelMerged, s, funcSubs, true, wumThreshHandler, wumSimHandler);
+                            if(model.isPerformanceCountersEnabled()) {
+                                genRecordPresynapticPerformanceCounter(os, s);
+                            }
+                        });
                     }
-                    os << std::endl;
-                }
+                });
             }
         }
 
@@ -285,73 +583,93 @@ void Backend::genSynapseUpdate(CodeStream &os, const ModelSpecMerged &modelMerge
         {
             Timer t(os, "postsynapticUpdate", model.isTimingEnabled());
             for(const auto &s : modelMerged.getMergedPostsynapticUpdateGroups()) {
-                CodeStream::Scope b(os);
-                os << "// merged postsynaptic update group " << s.getIndex() << std::endl;
-                os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
+                genMergedGroup(os, shardHandler, "PostsynapticUpdate", s.getIndex(), s.getGroups().size(), model.getTimePrecision() + " t", "t",
+                               [&](CodeStream &os)
                 {
-                    CodeStream::Scope b(os);
-
-                    // Get reference to group
-                    os << "const auto &group = mergedPostsynapticUpdateGroup" << s.getIndex() << "[g]; " << std::endl;
-
-                    // If presynaptic neuron group has variable queues, calculate offset to read from its variables with axonal delay
-                    if(s.getArchetype().getSrcNeuronGroup()->isDelayRequired()) {
-                        os << "const unsigned int preReadDelayOffset = " << s.getPresynapticAxonalDelaySlot() << " * group.numSrcNeurons;" << std::endl;
-                    }
-
-                    // If postsynaptic neuron group has variable queues, calculate offset to read from its variables at current time
-                    if(s.getArchetype().getTrgNeuronGroup()->isDelayRequired()) {
-                        os << "const unsigned int postReadDelaySlot = " << s.getPostsynapticBackPropDelaySlot() << ";" << std::endl;
-                        os << "const unsigned int postReadDelayOffset = postReadDelaySlot * group.numTrgNeurons;" << std::endl;
-                    }
-
-                    // Get number of postsynaptic spikes
-                    if (s.getArchetype().getTrgNeuronGroup()->isDelayRequired() && s.getArchetype().getTrgNeuronGroup()->isTrueSpikeRequired()) {
-                        os << "const unsigned int numSpikes = group.trgSpkCnt[postReadDelaySlot];" << std::endl;
-                    }
-                    else {
-                        os << "const unsigned int numSpikes = group.trgSpkCnt[0];" << std::endl;
-                    }
-
-                    // Loop through postsynaptic spikes
-                    os << "for (unsigned int j = 0; j < numSpikes; j++)";
+                    os << "// merged postsynaptic update group " << s.getIndex() << std::endl;
+                    os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
                     {
                         CodeStream::Scope b(os);
 
-                        const std::string offsetTrueSpkPost = (s.getArchetype().getTrgNeuronGroup()->isTrueSpikeRequired() && s.getArchetype().getTrgNeuronGroup()->isDelayRequired()) ? "postReadDelayOffset + " : "";
-                        os << "const unsigned int spike = group.trgSpk[" << offsetTrueSpkPost << "j];" << std::endl;
-
-                        // Loop through column of presynaptic neurons
-                        if (s.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
-                            os << "const unsigned int npre = group.colLength[spike];" << std::endl;
-                            os << "for (unsigned int i = 0; i < npre; i++)";
-                        }
-                        else {
-                            os << "for (unsigned int i = 0; i < group.numSrcNeurons; i++)";
-                        }
+                        // Loop through batches and get reference to group
+                        genMergedGroupBatchLoop(os, model.getBatchSize(), "PostsynapticUpdate", s.getIndex(),
+                                                [&]()
                         {
-                            CodeStream::Scope b(os);
+                            genStartPerformanceCounter(os, model);
 
-                            Substitutions synSubs(&funcSubs);
-                            if(s.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
-                                os << "const unsigned int colMajorIndex = (spike * group.colStride) + i;" << std::endl;
-                                os << "const unsigned int rowMajorIndex = group.remap[colMajorIndex];" << std::endl;
+                            // If presynaptic neuron group has variable queues, calculate offset to read from its variables with axonal delay
+                            if(s.getArchetype().getSrcNeuronGroup()->isDelayRequired()) {
+                                os << "const unsigned int preReadDelayOffset = " << s.getPresynapticAxonalDelaySlot() << " * group.numSrcNeurons;" << std::endl;
+                            }
+
+                            // If postsynaptic neuron group has variable queues, calculate offset to read from its variables at current time
+                            if(s.getArchetype().getTrgNeuronGroup()->isDelayRequired()) {
+                                os << "const unsigned int postReadDelaySlot = " << s.getPostsynapticBackPropDelaySlot() << ";" << std::endl;
+                                os << "const unsigned int postReadDelayOffset = postReadDelaySlot * group.numTrgNeurons;" << std::endl;
+                            }
 
-                                // **TODO** fast divide optimisations
-                                synSubs.addVarSubstitution("id_pre", "(rowMajorIndex / group.rowStride)");
-                                synSubs.addVarSubstitution("id_syn", "rowMajorIndex");
+                            // Get number of postsynaptic spikes
+                            if (s.getArchetype().getTrgNeuronGroup()->isDelayRequired() && s.getArchetype().getTrgNeuronGroup()->isTrueSpikeRequired()) {
+                                os << "const unsigned int numSpikes = group.trgSpkCnt[postReadDelaySlot];" << std::endl;
                             }
                             else {
-                                synSubs.addVarSubstitution("id_pre", "i");
-                                synSubs.addVarSubstitution("id_syn", "((group.numTrgNeurons * i) + spike)");
+                                os << "const unsigned int numSpikes = group.trgSpkCnt[0];" << std::endl;
                             }
-                            synSubs.addVarSubstitution("id_post", "spike");
 
-                            postLearnHandler(os, s, synSubs);
-                        }
+                            // Loop through postsynaptic spikes
+                            os << "for (unsigned int j = 0; j < numSpikes; j++)";
+                            {
+                                CodeStream::Scope b(os);
+
+                                const std::string offsetTrueSpkPost = (s.getArchetype().getTrgNeuronGroup()->isTrueSpikeRequired() && s.getArchetype().getTrgNeuronGroup()->isDelayRequired()) ? "postReadDelayOffset + " : "";
+                                os << "const unsigned int spike = group.trgSpk[" << offsetTrueSpkPost << "j];" << std::endl;
+
+                                // Loop through column of presynaptic neurons
+                                if (isRaggedConnectivity(s)) {
+                                    os << "const unsigned int npre = group.colLength[spike];" << std::endl;
+                                    os << "for (unsigned int i = 0; i < npre; i++)";
+                                }
+                                else {
+                                    os << "for (unsigned int i = 0; i < group.numSrcNeurons; i++)";
+                                }
+                                {
+                                    CodeStream::Scope b(os);
+
+                                    Substitutions synSubs(&funcSubs);
+                                    if(isRaggedConnectivity(s)) {
+                                        os << "const unsigned int colMajorIndex = (spike * group.colStride) + i;" << std::endl;
+                                        os << "const unsigned int rowMajorIndex = group.remap[colMajorIndex];" << std::endl;
+
+                                        // If connectivity is CSR, search row pointers for the row containing synapse
+                                        // **NOTE** empty rows share their row pointer with the following row so the last row starting at or before the synapse is used
+                                        if(s.getArchetype().getMatrixType() & SynapseMatrixConnectivity::CSR) {
+                                            os << "const unsigned int ipre = (unsigned int)(std::upper_bound(group.rowPtr, group.rowPtr + group.numSrcNeurons + 1, rowMajorIndex) - group.rowPtr) - 1;" << std::endl;
+                                            synSubs.addVarSubstitution("id_pre", "ipre");
+                                        }
+                                        // Otherwise, rows are evenly strided
+                                        // **TODO** fast divide optimisations
+                                        else {
+                                            synSubs.addVarSubstitution("id_pre", "(rowMajorIndex / group.rowStride)");
+                                        }
+                                        synSubs.addVarSubstitution("id_syn", "rowMajorIndex");
+                                    }
+                                    else {
+                                        synSubs.addVarSubstitution("id_pre", "i");
+                                        synSubs.addVarSubstitution("id_syn", "((group.numTrgNeurons * i) + spike)");
+                                    }
+                                    synSubs.addVarSubstitution("id_post", "spike");
+
+                                    postLearnHandler(os, s, synSubs);
+                                }
+                            }
+                            os << std::endl;
+
+                            if(model.isPerformanceCountersEnabled()) {
+                                genRecordPostsynapticPerformanceCounter(os, s);
+                            }
+                        });
                     }
-                    os << std::endl;
-                }
+                });
             }
         }
     }
@@ -360,7 +678,8 @@ void Backend::genSynapseUpdate(CodeStream &os, const ModelSpecMerged &modelMerge
 void Backend::genInit(CodeStream &os, const ModelSpecMerged &modelMerged,
                       NeuronGroupMergedHandler localNGHandler, SynapseGroupMergedHandler sgDenseInitHandler,
                       SynapseGroupMergedHandler sgSparseConnectHandler, SynapseGroupMergedHandler sgSparseInitHandler,
-                      HostHandler initPushEGPHandler, HostHandler initSparsePushEGPHandler) const
+                      HostHandler initPushEGPHandler, HostHandler initSparsePushEGPHandler,
+                      ShardHandler shardHandler) const
 {
     const ModelSpecInternal &model = modelMerged.getModel();
     os << "void initialize()";
@@ -399,6 +718,24 @@ void Backend::genInit(CodeStream &os, const ModelSpecMerged &modelMerged,
             // Seed RNG from seed sequence
             os << "rng.seed(seeds);" << std::endl;
 
+            // If procedural connectivity requires an RNG, draw key for counter-based RNGs from global RNG
+            if(isProceduralRNGRequired(model)) {
+                os << "proceduralSeed = rng();" << std::endl;
+                os << "proceduralSeed |= ((uint64_t)rng() << 32);" << std::endl;
+            }
+
+            // If neurons are simulated using counter-based RNGs, likewise draw their key from global RNG
+            if(isSimCounterRNGRequired(modelMerged)) {
+                os << "simulationSeed = rng();" << std::endl;
+                os << "simulationSeed |= ((uint64_t)rng() << 32);" << std::endl;
+            }
+
+            // If sparse connectivity is built using counter-based RNGs, likewise draw their key from global RNG
+            if(isConnectivityInitCounterRNGRequired(modelMerged)) {
+                os << "connectivitySeed = rng();" << std::endl;
+                os << "connectivitySeed |= ((uint64_t)rng() << 32);" << std::endl;
+            }
+
             // Add RNG to substitutions
             funcSubs.addVarSubstitution("rng", "rng");
         }
@@ -407,102 +744,70 @@ void Backend::genInit(CodeStream &os, const ModelSpecMerged &modelMerged,
         os << "// ------------------------------------------------------------------------" << std::endl;
         os << "// Local neuron groups" << std::endl;
         for(const auto &n : modelMerged.getMergedNeuronInitGroups()) {
-            CodeStream::Scope b(os);
-            os << "// merged neuron init group " << n.getIndex() << std::endl;
-            os << "for(unsigned int g = 0; g < " << n.getGroups().size() << "; g++)";
+            genMergedGroup(os, shardHandler, "NeuronInit", n.getIndex(), n.getGroups().size(), "", "",
+                           [&](CodeStream &os)
             {
-                CodeStream::Scope b(os);
+                os << "// merged neuron init group " << n.getIndex() << std::endl;
+                os << "for(unsigned int g = 0; g < " << n.getGroups().size() << "; g++)";
+                {
+                    CodeStream::Scope b(os);
 
-                // Get reference to group
-                os << "const auto &group = mergedNeuronInitGroup" << n.getIndex() << "[g]; " << std::endl;
-                Substitutions popSubs(&funcSubs);
-                localNGHandler(os, n, popSubs);
-            }
+                    // Loop through batches and get reference to group
+                    genMergedGroupBatchLoop(os, model.getBatchSize(), "NeuronInit", n.getIndex(),
+                                            [&]()
+                    {
+                        Substitutions popSubs(&funcSubs);
+                        localNGHandler(os, n, popSubs);
+                    });
+                }
+            });
         }
 
         os << "// ------------------------------------------------------------------------" << std::endl;
         os << "// Synapse groups with dense connectivity" << std::endl;
         for(const auto &s : modelMerged.getMergedSynapseDenseInitGroups()) {
-            CodeStream::Scope b(os);
-            os << "// merged synapse dense init group " << s.getIndex() << std::endl;
-            os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
+            genMergedGroup(os, shardHandler, "SynapseDenseInit", s.getIndex(), s.getGroups().size(), "", "",
+                           [&](CodeStream &os)
             {
-                CodeStream::Scope b(os);
+                os << "// merged synapse dense init group " << s.getIndex() << std::endl;
+                os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
+                {
+                    CodeStream::Scope b(os);
 
-                // Get reference to group
-                os << "const auto &group = mergedSynapseDenseInitGroup" << s.getIndex() << "[g]; " << std::endl;
-                Substitutions popSubs(&funcSubs);
-                sgDenseInitHandler(os, s, popSubs);
-            }
+                    // Loop through batches and get reference to group
+                    genMergedGroupBatchLoop(os, model.getBatchSize(), "SynapseDenseInit", s.getIndex(),
+                                            [&]()
+                    {
+                        Substitutions popSubs(&funcSubs);
+                        sgDenseInitHandler(os, s, popSubs);
+                    });
+                }
+            });
         }
 
         os << "// ------------------------------------------------------------------------" << std::endl;
         os << "// Synapse groups with sparse connectivity" << std::endl;
         for(const auto &s : modelMerged.getMergedSynapseConnectivityInitGroups()) {
-            CodeStream::Scope b(os);
-            os << "// merged synapse connectivity init group " << s.getIndex() << std::endl;
-            os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
+            genMergedGroup(os, shardHandler, "SynapseConnectivityInit", s.getIndex(), s.getGroups().size(), "", "",
+                           [&](CodeStream &os)
             {
-                CodeStream::Scope b(os);
-
-                // Get reference to group
-                os << "const auto &group = mergedSynapseConnectivityInitGroup" << s.getIndex() << "[g]; " << std::endl;
-
-                // If matrix connectivity is ragged
-                if(s.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
-                    // Zero row lengths
-                    os << "memset(group.rowLength, 0, group.numSrcNeurons * sizeof(unsigned int));" << std::endl;
-
-                    // Loop through source neurons
-                    os << "for (unsigned int i = 0; i < group.numSrcNeurons; i++)";
-                    {
-                        CodeStream::Scope b(os);
-
-                        Substitutions popSubs(&funcSubs);
-                        popSubs.addVarSubstitution("id_pre", "i");
-                        popSubs.addVarSubstitution("id_post_begin", "0");
-                        popSubs.addVarSubstitution("id_thread", "0");
-                        popSubs.addVarSubstitution("num_threads", "1");
-                        popSubs.addVarSubstitution("num_post", "group.numTrgNeurons");
-                        
-                        // Add function to increment row length and insert synapse into ind array
-                        popSubs.addFuncSubstitution("addSynapse", 1,
-                                                    "group.ind[(i * group.rowStride) + (group.rowLength[i]++)] = $(0)");
-
-                        sgSparseConnectHandler(os, s, popSubs);
-                    }
+                os << "// merged synapse connectivity init group " << s.getIndex() << std::endl;
 
+                // If connectivity is built using counter-based RNGs, list the stream of each group, based on its
+                // position in the model (rather than in the merged group) so streams don't depend on merging
+                if(isConnectivityInitCounterRNG(s.getArchetype())) {
+                    genSynapseGroupRNGStreams(os, "connectivityRNGStream", model, s);
                 }
-                // Otherwise, if matrix connectivity is a bitmask
-                else if(s.getArchetype().getMatrixType() & SynapseMatrixConnectivity::BITMASK) {
-                    // Zero memory before setting sparse bits
-                    os << "const size_t gpSize = ((((size_t)group.numSrcNeurons * (size_t)group.rowStride) + 32 - 1) / 32);" << std::endl;
-                    os << "memset(group.gp, 0, gpSize * sizeof(uint32_t));" << std::endl;
-
-                    // Loop through source neurons
-                    os << "for(unsigned int i = 0; i < group.numSrcNeurons; i++)";
-                    {
-                        // Calculate index of bit at start of this row
-                        CodeStream::Scope b(os);
-                        os << "const int64_t rowStartGID = i * group.rowStride;" << std::endl;
-
-                        // Build function template to set correct bit in bitmask
-                        Substitutions popSubs(&funcSubs);
-                        popSubs.addVarSubstitution("id_pre", "i");
-                        popSubs.addVarSubstitution("id_post_begin", "0");
-                        popSubs.addVarSubstitution("num_post", "group.numTrgNeurons");
+                os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
+                {
+                    CodeStream::Scope b(os);
 
-                        // Add function to increment row length and insert synapse into ind array
-                        popSubs.addFuncSubstitution("addSynapse", 1,
-                                                    "setB(group.gp[(rowStartGID + $(0)) / 32], (rowStartGID + $(0)) & 31)");
+                    // Get reference to group
+                    os << "const auto &group = mergedSynapseConnectivityInitGroup" << s.getIndex() << "[g]; " << std::endl;
 
-                        sgSparseConnectHandler(os, s, popSubs);
-                    }
-                }
-                else {
-                    throw std::runtime_error("Only BITMASK and SPARSE format connectivity can be generated using a connectivity initialiser");
+                    genSparseConnectivityInitGroup(os, s, funcSubs, sgSparseConnectHandler);
                 }
-            }
+            });
         }
     }
     os << std::endl;
@@ -524,65 +829,29 @@ void Backend::genInit(CodeStream &os, const ModelSpecMerged &modelMerged,
         os << "// ------------------------------------------------------------------------" << std::endl;
         os << "// Synapse groups with sparse connectivity" << std::endl;
         for(const auto &s : modelMerged.getMergedSynapseSparseInitGroups()) {
-            CodeStream::Scope b(os);
-            os << "// merged sparse synapse init group " << s.getIndex() << std::endl;
-            os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
+            genMergedGroup(os, shardHandler, "SynapseSparseInit", s.getIndex(), s.getGroups().size(), "", "",
+                           [&](CodeStream &os)
             {
-                CodeStream::Scope b(os);
-
-                // Get reference to group
-                os << "const auto &group = mergedSynapseSparseInitGroup" << s.getIndex() << "[g]; " << std::endl;
-
-                // If postsynaptic learning is required, initially zero column lengths
-                if (!s.getArchetype().getWUModel()->getLearnPostCode().empty()) {
-                    os << "// Zero column lengths" << std::endl;
-                    os << "std::fill_n(group.colLength, group.numTrgNeurons, 0);" << std::endl;
-                }
-
-                os << "// Loop through presynaptic neurons" << std::endl;
-                os << "for (unsigned int i = 0; i < group.numSrcNeurons; i++)" << std::endl;
+                os << "// merged sparse synapse init group " << s.getIndex() << std::endl;
+                os << "for(unsigned int g = 0; g < " << s.getGroups().size() << "; g++)";
                 {
                     CodeStream::Scope b(os);
 
-                    // Generate sparse initialisation code
-                    if(s.getArchetype().isWUVarInitRequired()) {
-                        Substitutions popSubs(&funcSubs);
-                        popSubs.addVarSubstitution("id_pre", "i");
-                        popSubs.addVarSubstitution("row_len", "group.rowLength[i]");
-                        sgSparseInitHandler(os, s, popSubs);
-                    }
-
-                    // If postsynaptic learning is required
-                    if(!s.getArchetype().getWUModel()->getLearnPostCode().empty()) {
-                        os << "// Loop through synapses in corresponding matrix row" << std::endl;
-                        os << "for(unsigned int j = 0; j < group.rowLength[i]; j++)" << std::endl;
-                        {
-                            CodeStream::Scope b(os);
-
-                            // If postsynaptic learning is required, calculate column length and remapping
-                            if(!s.getArchetype().getWUModel()->getLearnPostCode().empty()) {
-                                os << "// Calculate index of this synapse in the row-major matrix" << std::endl;
-                                os << "const unsigned int rowMajorIndex = (i * group.rowStride) + j;" << std::endl;
-                                os << "// Using this, lookup postsynaptic target" << std::endl;
-                                os << "const unsigned int postIndex = group.ind[rowMajorIndex];" << std::endl;
-                                os << "// From this calculate index of this synapse in the column-major matrix" << std::endl;
-                                os << "const unsigned int colMajorIndex = (postIndex * group.colStride) + group.colLength[postIndex];" << std::endl;
-                                os << "// Increment column length corresponding to this postsynaptic neuron" << std::endl;
-                                os << "group.colLength[postIndex]++;" << std::endl;
-                                os << "// Add remapping entry" << std::endl;
-                                os << "group.remap[colMajorIndex] = rowMajorIndex;" << std::endl;
-                            }
-                        }
-                    }
+                    // Loop through batches and get reference to group
+                    genMergedGroupBatchLoop(os, model.getBatchSize(), "SynapseSparseInit", s.getIndex(),
+                                            [&]()
+                    {
+                        genSparseInitGroup(os, s, funcSubs, sgSparseInitHandler);
+                    });
                 }
-            }
+            });
         }
     }
 }
 //--------------------------------------------------------------------------
 size_t Backend::getSynapticMatrixRowStride(const SynapseGroupInternal &sg) const
 {
-    if (sg.getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
+    if ((sg.getMatrixType() & SynapseMatrixConnectivity::SPARSE) || (sg.getMatrixType() & SynapseMatrixConnectivity::CSR)) {
         return sg.getMaxConnections();
     }
     else if(m_Preferences.enableBitmaskOptimisations && (sg.getMatrixType() & SynapseMatrixConnectivity::BITMASK)) {
@@ -617,7 +886,7 @@ void Backend::genDefinitionsPreamble(CodeStream &os, const ModelSpecMerged &mode
     }
 }
 //--------------------------------------------------------------------------
-void Backend::genDefinitionsInternalPreamble(CodeStream &os, const ModelSpecMerged &) const
+void Backend::genDefinitionsInternalPreamble(CodeStream &os, const ModelSpecMerged &modelMerged) const
 {
     os << "#define SUPPORT_CODE_FUNC inline" << std::endl;
 
@@ -645,6 +914,91 @@ void Backend::genDefinitionsInternalPreamble(CodeStream &os, const ModelSpecMerg
     os << "#define gennCLZ __builtin_clz" << std::endl;
 #endif
     os << std::endl;
+
+    // If procedural connectivity or neuron simulation requires counter-based RNGs, define them
+    const bool proceduralRNGRequired = isProceduralRNGRequired(modelMerged.getModel());
+    const bool simCounterRNGRequired = isSimCounterRNGRequired(modelMerged);
+    const bool connectivityInitCounterRNGRequired = isConnectivityInitCounterRNGRequired(modelMerged);
+    if(proceduralRNGRequired || simCounterRNGRequired || connectivityInitCounterRNGRequired) {
+        genPhilox(os);
+    }
+    if(simCounterRNGRequired || connectivityInitCounterRNGRequired) {
+        genPhiloxSamplers(os, modelMerged.getModel().getPrecision());
+    }
+    if(proceduralRNGRequired) {
+        os << "extern uint64_t proceduralSeed;" << std::endl;
+        os << std::endl;
+    }
+    if(simCounterRNGRequired) {
+        os << "extern uint64_t simulationSeed;" << std::endl;
+        os << std::endl;
+    }
+    if(connectivityInitCounterRNGRequired) {
+        os << "extern uint64_t connectivitySeed;" << std::endl;
+        os << std::endl;
+    }
+
+    if(m_Preferences.enableSIMDNeuronUpdate) {
+        // Define macro to tell compiler that iterations of neuron update loops are independent
+#ifdef _WIN32
+        os << "#define GENN_SIMD_LOOP __pragma(loop(ivdep))" << std::endl;
+#else
+        os << "#if defined(__clang__)" << std::endl;
+        os << "#define GENN_SIMD_LOOP _Pragma(\"clang loop vectorize(enable) interleave(enable)\")" << std::endl;
+        os << "#else" << std::endl;
+        os << "#define GENN_SIMD_LOOP _Pragma(\"GCC ivdep\")" << std::endl;
+        os << "#endif" << std::endl;
+#endif
+        os << std::endl;
+
+        // Define functions to allocate and free memory aligned to SIMD width
+        os << "inline void *allocateAligned(size_t size)";
+        {
+            CodeStream::Scope b(os);
+#ifdef _WIN32
+            os << "void *ptr = _aligned_malloc(size, " << simdAlignment << ");" << std::endl;
+            os << "if(ptr == nullptr)";
+#else
+            os << "void *ptr = nullptr;" << std::endl;
+            os << "if(posix_memalign(&ptr, " << simdAlignment << ", size) != 0)";
+#endif
+            {
+                CodeStream::Scope b(os);
+                os << "throw std::bad_alloc();" << std::endl;
+            }
+            os << "return ptr;" << std::endl;
+        }
+        os << std::endl;
+        os << "inline void freeAligned(void *ptr)";
+        {
+            CodeStream::Scope b(os);
+#ifdef _WIN32
+            os << "_aligned_free(ptr);" << std::endl;
+#else
+            os << "free(ptr);" << std::endl;
+#endif
+        }
+        os << std::endl;
+
+        // Declare masks neuron update loops record spikes in
+        if(getSIMDSpikeMaskSize(modelMerged) > 0) {
+            os << "extern uint8_t simdSpikeMask[];" << std::endl;
+            os << "extern uint8_t simdSpikeEventMask[];" << std::endl;
+            os << std::endl;
+        }
+    }
+
+    // If any neuron groups are event-driven, define functions to manipulate calendar queue used to wake neurons
+    if(isEventDrivenNeuronUpdateRequired(modelMerged.getModel())) {
+        genWakeQueue(os, getNumWakeQueueBuckets());
+    }
+
+    // If input to any synapse groups may be gathered target-by-target, declare arrays used to mark active presynaptic neurons
+    if(getPostSpanScratchSize(modelMerged) > 0) {
+        os << "extern unsigned int postSpanPreActive[];" << std::endl;
+        os << "extern uint8_t postSpanPreMask[];" << std::endl;
+        os << std::endl;
+    }
 }
 //--------------------------------------------------------------------------
 void Backend::genRunnerPreamble(CodeStream &os, const ModelSpecMerged &modelMerged) const
@@ -658,6 +1012,38 @@ void Backend::genRunnerPreamble(CodeStream &os, const ModelSpecMerged &modelMerg
         os << "std::exponential_distribution<" << model.getPrecision() << "> standardExponentialDistribution(" << model.scalarExpr(1.0) << ");" << std::endl;
         os << std::endl;
     }
+    // If procedural connectivity requires an RNG, implement key used for counter-based RNGs
+    if(isProceduralRNGRequired(model)) {
+        os << "uint64_t proceduralSeed;" << std::endl;
+        os << std::endl;
+    }
+    // If neurons are simulated using counter-based RNGs, implement their key
+    if(isSimCounterRNGRequired(modelMerged)) {
+        os << "uint64_t simulationSeed;" << std::endl;
+        os << std::endl;
+    }
+    // If sparse connectivity is built using counter-based RNGs, implement their key
+    if(isConnectivityInitCounterRNGRequired(modelMerged)) {
+        os << "uint64_t connectivitySeed;" << std::endl;
+        os << std::endl;
+    }
+
+    // If any neuron groups are updated using SIMD loops, allocate masks to record spikes in
+    const size_t simdSpikeMaskSize = getSIMDSpikeMaskSize(modelMerged);
+    if(simdSpikeMaskSize > 0) {
+        os << "uint8_t simdSpikeMask[" << simdSpikeMaskSize << "];" << std::endl;
+        os << "uint8_t simdSpikeEventMask[" << simdSpikeMaskSize << "];" << std::endl;
+        os << std::endl;
+    }
+
+    // If input to any synapse groups may be gathered target-by-target, allocate arrays to mark active presynaptic neurons in
+    // **NOTE** mask is zero-initialised and cleared after each use
+    const size_t postSpanScratchSize = getPostSpanScratchSize(modelMerged);
+    if(postSpanScratchSize > 0) {
+        os << "unsigned int postSpanPreActive[" << postSpanScratchSize << "];" << std::endl;
+        os << "uint8_t postSpanPreMask[" << postSpanScratchSize << "];" << std::endl;
+        os << std::endl;
+    }
     os << "template<class T>" << std::endl;
     os << "T *getSymbolAddress(T &devSymbol)";
     {
@@ -687,14 +1073,26 @@ void Backend::genVariableImplementation(CodeStream &os, const std::string &type,
 //--------------------------------------------------------------------------
 MemAlloc Backend::genVariableAllocation(CodeStream &os, const std::string &type, const std::string &name, VarLocation, size_t count) const
 {
-    os << name << " = new " << type << "[" << count << "];" << std::endl;
-
-    return MemAlloc::host(count * getSize(type));
+    // If SIMD neuron update is enabled, allocate aligned memory padded so vectorised loops can process whole SIMD words
+    if(m_Preferences.enableSIMDNeuronUpdate) {
+        const size_t sizeBytes = padSize(count * getSize(type), simdAlignment);
+        os << name << " = static_cast<" << type << "*>(allocateAligned(" << sizeBytes << "));" << std::endl;
+        return MemAlloc::host(sizeBytes);
+    }
+    else {
+        os << name << " = new " << type << "[" << count << "];" << std::endl;
+        return MemAlloc::host(count * getSize(type));
+    }
 }
 //--------------------------------------------------------------------------
 void Backend::genVariableFree(CodeStream &os, const std::string &name, VarLocation) const
 {
-    os << "delete[] " << name << ";" << std::endl;
+    if(m_Preferences.enableSIMDNeuronUpdate) {
+        os << "freeAligned(" << name << ");" << std::endl;
+    }
+    else {
+        os << "delete[] " << name << ";" << std::endl;
+    }
 }
 //--------------------------------------------------------------------------
 void Backend::genExtraGlobalParamDefinition(CodeStream &definitions, const std::string &type, const std::string &name, VarLocation) const
@@ -713,7 +1111,12 @@ void Backend::genExtraGlobalParamAllocation(CodeStream &os, const std::string &t
     // **NOTE** could use std::remove_pointer but it seems unnecessarily elaborate
     const std::string underlyingType = Utils::getUnderlyingType(type);
 
-    os << name << " = new " << underlyingType << "[count];" << std::endl;
+    if(m_Preferences.enableSIMDNeuronUpdate) {
+        os << name << " = static_cast<" << type << ">(allocateAligned(count * sizeof(" << underlyingType << ")));" << std::endl;
+    }
+    else {
+        os << name << " = new " << underlyingType << "[count];" << std::endl;
+    }
 }
 //--------------------------------------------------------------------------
 void Backend::genExtraGlobalParamPush(CodeStream &, const std::string &, const std::string &, VarLocation) const
@@ -765,8 +1168,8 @@ void Backend::genVariableInit(CodeStream &os, const std::string &count, const st
 void Backend::genSynapseVariableRowInit(CodeStream &os, const SynapseGroupMerged &sg, 
                                         const Substitutions &kernelSubs, Handler handler) const
 {
-    if(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
-        os << "for (unsigned j = 0; j < group.rowLength[" << kernelSubs["id_pre"] << "]; j++)";
+    if(isRaggedConnectivity(sg)) {
+        os << "for (unsigned j = 0; j < " << getSparseRowLength(sg, kernelSubs["id_pre"]) << "; j++)";
     }
     else {
         os << "for (unsigned j = 0; j < group.numTrgNeurons; j++)";
@@ -775,9 +1178,10 @@ void Backend::genSynapseVariableRowInit(CodeStream &os, const SynapseGroupMerged
         CodeStream::Scope b(os);
 
         Substitutions varSubs(&kernelSubs);
-        if(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
-            varSubs.addVarSubstitution("id_syn", "(" + kernelSubs["id_pre"] + " * group.rowStride) + j");
-            varSubs.addVarSubstitution("id_post", "group.ind[(" + kernelSubs["id_pre"] + " * group.rowStride) + j]");
+        if(isRaggedConnectivity(sg)) {
+            const std::string rowStart = getSparseRowStart(sg, kernelSubs["id_pre"]);
+            varSubs.addVarSubstitution("id_syn", rowStart + " + j");
+            varSubs.addVarSubstitution("id_post", "group.ind[" + rowStart + " + j]");
         }
         else {
             varSubs.addVarSubstitution("id_syn", "(" + kernelSubs["id_pre"] + " * group.rowStride) + j");
@@ -853,10 +1257,71 @@ void Backend::genReturnFreeDeviceMemoryBytes(CodeStream &os) const
     os << "return 0;" << std::endl;
 }
 //--------------------------------------------------------------------------
+void Backend::genCheckpointDeviceArraySave(CodeStream &os, const std::string &type, const std::string &name, size_t count) const
+{
+    // 'Device' arrays are in host memory so can be written directly
+    os << "writeCheckpointRecord(checkpoint, \"" << name << "\", " << name << ", " << count << " * sizeof(" << type << "));" << std::endl;
+}
+//--------------------------------------------------------------------------
+void Backend::genCheckpointDeviceArrayLoad(CodeStream &os, const std::string &type, const std::string &name, size_t count) const
+{
+    // 'Device' arrays are in host memory so can be read directly
+    os << "readCheckpointRecord(checkpoint, \"" << name << "\", " << name << ", " << count << " * sizeof(" << type << "));" << std::endl;
+}
+//--------------------------------------------------------------------------
+void Backend::genCheckpointSave(CodeStream &os, const ModelSpecMerged &modelMerged) const
+{
+    // If a global RNG is required, serialise it and the standard distributions (which may cache values) as text
+    if(isGlobalRNGRequired(modelMerged)) {
+        CodeStream::Scope b(os);
+        os << "std::ostringstream rngStream;" << std::endl;
+        os << "rngStream << rng << \" \" << standardUniformDistribution << \" \" << standardNormalDistribution << \" \" << standardExponentialDistribution;" << std::endl;
+        os << "const std::string rngState = rngStream.str();" << std::endl;
+        os << "writeCheckpointRecord(checkpoint, \"rng\", rngState.data(), rngState.size());" << std::endl;
+    }
+
+    if(isProceduralRNGRequired(modelMerged.getModel())) {
+        os << "writeCheckpointRecord(checkpoint, \"proceduralSeed\", &proceduralSeed, sizeof(uint64_t));" << std::endl;
+    }
+    if(isSimCounterRNGRequired(modelMerged)) {
+        os << "writeCheckpointRecord(checkpoint, \"simulationSeed\", &simulationSeed, sizeof(uint64_t));" << std::endl;
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genCheckpointLoad(CodeStream &os, const ModelSpecMerged &modelMerged) const
+{
+    if(isGlobalRNGRequired(modelMerged)) {
+        CodeStream::Scope b(os);
+        os << "std::string rngState(readCheckpointRecordHeader(checkpoint, \"rng\"), ' ');" << std::endl;
+        os << "readCheckpointRecordData(checkpoint, &rngState[0], rngState.size());" << std::endl;
+        os << "std::istringstream rngStream(rngState);" << std::endl;
+        os << "rngStream >> rng >> standardUniformDistribution >> standardNormalDistribution >> standardExponentialDistribution;" << std::endl;
+        os << "if(rngStream.fail())";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Unable to restore RNG state from checkpoint\");" << std::endl;
+        }
+    }
+
+    if(isProceduralRNGRequired(modelMerged.getModel())) {
+        os << "readCheckpointRecord(checkpoint, \"proceduralSeed\", &proceduralSeed, sizeof(uint64_t));" << std::endl;
+    }
+    if(isSimCounterRNGRequired(modelMerged)) {
+        os << "readCheckpointRecord(checkpoint, \"simulationSeed\", &simulationSeed, sizeof(uint64_t));" << std::endl;
+    }
+
+    // **NOTE** there are no 'device' copies of scalars to update
+}
+//--------------------------------------------------------------------------
 void Backend::genMakefilePreamble(std::ostream &os) const
 {
     std::string linkFlags = "-shared ";
     std::string cxxFlags = "-c -fPIC -std=c++11 -MMD -MP -Wno-return-type-c-linkage";
+
+    // **NOTE** target architecture is added before user flags so they can override it
+    if (m_Preferences.enableSIMDNeuronUpdate && !m_Preferences.simdTargetArchitecture.empty()) {
+        cxxFlags += " -march=" + m_Preferences.simdTargetArchitecture;
+    }
     cxxFlags += " " + m_Preferences.userCxxFlagsGNU;
     if (m_Preferences.optimizeCode) {
         cxxFlags += " -O3 -ffast-math";
@@ -909,6 +1374,7 @@ void Backend::genMSBuildItemDefinitions(std::ostream &os) const
     os << "\t\t\t<PreprocessorDefinitions Condition=\"'$(Configuration)'=='Release'\">WIN32;WIN64;NDEBUG;_CONSOLE;BUILDING_GENERATED_CODE;%(PreprocessorDefinitions)</PreprocessorDefinitions>" << std::endl;
     os << "\t\t\t<PreprocessorDefinitions Condition=\"'$(Configuration)'=='Debug'\">WIN32;WIN64;_DEBUG;_CONSOLE;BUILDING_GENERATED_CODE;%(PreprocessorDefinitions)</PreprocessorDefinitions>" << std::endl;
     os << "\t\t\t<FloatingPointModel>" << (m_Preferences.optimizeCode ? "Fast" : "Precise") << "</FloatingPointModel>" << std::endl;
+    os << "\t\t\t<MultiProcessorCompilation>true</MultiProcessorCompilation>" << std::endl;
     os << "\t\t</ClCompile>" << std::endl;
 
     // Add item definition for linking
@@ -948,7 +1414,7 @@ bool Backend::isGlobalRNGRequired(const ModelSpecMerged &modelMerged) const
     if(std::any_of(model.getSynapseGroups().cbegin(), model.getSynapseGroups().cend(),
         [](const ModelSpec::SynapseGroupValueType &s)
         {
-            return s.second.isWUInitRNGRequired();
+            return (s.second.isWUInitRNGRequired() || isProceduralRNGRequired(s.second));
         }))
     {
         return true;
@@ -957,23 +1423,525 @@ bool Backend::isGlobalRNGRequired(const ModelSpecMerged &modelMerged) const
     return false;
 }
 //--------------------------------------------------------------------------
-void Backend::genPresynapticUpdate(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &popSubs,
-                                   bool trueSpike, SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler) const
+bool Backend::isPostsynapticRemapRequired(const SynapseGroupInternal &sg) const
+{
+    // Remapping is required to implement postsynaptic learning and to gather input into SPARSE synapse groups with a postsynaptic span type
+    return (!sg.getWUModel()->getLearnPostCode().empty()
+            || ((sg.getMatrixType() & SynapseMatrixConnectivity::SPARSE) && (sg.getSpanType() == SynapseGroup::SpanType::POSTSYNAPTIC)));
+}
+//--------------------------------------------------------------------------
+void Backend::genNeuronUpdateGroup(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &funcSubs,
+                                   NeuronGroupSimHandler simHandler, NeuronGroupMergedHandler wuVarUpdateHandler) const
+{
+    // If axonal delays are required
+    if(ng.getArchetype().isDelayRequired()) {
+        // We should READ from delay slot before spkQuePtr
+        os << "const unsigned int readDelayOffset = " << ng.getPrevQueueOffset() << ";" << std::endl;
+
+        // And we should WRITE to delay slot pointed to be spkQuePtr
+        os << "const unsigned int writeDelayOffset = " << ng.getCurrentQueueOffset() << ";" << std::endl;
+    }
+    os << std::endl;
+
+    // If neurons can be updated using vectorisable loop, update then compact spikes
+    if(isSIMDNeuronUpdate(ng)) {
+        genSIMDNeuronUpdateLoop(os, ng, funcSubs, simHandler, "0", "group.numNeurons");
+        genSIMDSpikeCompaction(os, ng, funcSubs, wuVarUpdateHandler);
+        return;
+    }
+
+    // If neuron group is event-driven, only update neurons in the list of this timestep's calendar queue bucket
+    const bool eventDriven = ng.getArchetype().isEventDriven();
+    if(eventDriven) {
+        os << "int nextWake = group.wakeHead[iT % " << getNumWakeQueueBuckets() << "];" << std::endl;
+        os << "while(nextWake != -1)";
+    }
+    else {
+        os << "for(unsigned int i = 0; i < group.numNeurons; i++)";
+    }
+    {
+        CodeStream::Scope b(os);
+
+        // Skip over neurons due to be woken on later passes through the calendar queue
+        // **NOTE** the next neuron is read first as updated neurons are moved to other buckets
+        if(eventDriven) {
+            os << "const unsigned int i = (unsigned int)nextWake;" << std::endl;
+            os << "nextWake = group.wakeNext[i];" << std::endl;
+            os << "if(group.wakeStep[i] != iT)";
+            {
+                CodeStream::Scope b(os);
+                os << "continue;" << std::endl;
+            }
+            os << "wakeQueueRemove(" << getWakeQueueArgs("") << ", i);" << std::endl;
+        }
+
+        Substitutions popSubs(&funcSubs);
+        popSubs.addVarSubstitution("id", "i");
+        addNeuronRNGSubstitutions(os, ng, popSubs);
+
+        simHandler(os, ng, popSubs,
+                   // Emit true spikes
+                   [this, wuVarUpdateHandler](CodeStream &os, const NeuronGroupMerged &ng, Substitutions &subs)
+                   {
+                       // Insert code to emit true spikes
+                       genEmitSpike(os, ng, subs, true);
+
+                       // Insert code to update WU vars
+                       wuVarUpdateHandler(os, ng, subs);
+                   },
+                   // Emit spike-like events
+                   [this](CodeStream &os, const NeuronGroupMerged &ng, Substitutions &subs)
+                   {
+                       // Insert code to emit spike-like events
+                       genEmitSpike(os, ng, subs, false);
+                   });
+
+        // If neuron group is event-driven, schedule neuron to be woken when it might next reach threshold or when pending input arrives
+        // **NOTE** sim handler declares quiescentSteps for event-driven neuron groups
+        if(eventDriven) {
+            os << "unsigned long long wakeStep = iT + 1 + quiescentSteps;" << std::endl;
+            for(size_t j = 0; j < ng.getArchetype().getMergedInSyn().size(); j++) {
+                const auto *sg = ng.getArchetype().getMergedInSyn()[j].first;
+                os << "if(group.inSynInSyn" << j << "[i] != 0)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "wakeStep = iT + 1;" << std::endl;
+                }
+
+                // Find earliest future slot of dendritic delay buffer containing input for this neuron
+                if(sg->isDendriticDelayRequired()) {
+                    const unsigned int maxDelay = sg->getMaxDendriticDelayTimesteps();
+                    os << "for(unsigned int d = 1; d < " << maxDelay << "; d++)";
+                    {
+                        CodeStream::Scope b(os);
+                        os << "if(group.denDelayInSyn" << j << "[(((*group.denDelayPtrInSyn" << j << " + d) % " << maxDelay << ") * group.numNeurons) + i] != 0)";
+                        {
+                            CodeStream::Scope b(os);
+                            os << "wakeStep = std::min(wakeStep, iT + d);" << std::endl;
+                            os << "break;" << std::endl;
+                        }
+                    }
+                }
+            }
+            os << "wakeQueueInsert(" << getWakeQueueArgs("") << ", i, wakeStep);" << std::endl;
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genPresynapticUpdateGroup(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                        SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
+                                        SynapseGroupMergedHandler wumEventHandler, SynapseGroupMergedHandler wumProceduralConnectHandler) const
+{
+    // If presynaptic neuron group has variable queues, calculate offset to read from its variables with axonal delay
+    if(sg.getArchetype().getSrcNeuronGroup()->isDelayRequired()) {
+        os << "const unsigned int preReadDelaySlot = " << sg.getPresynapticAxonalDelaySlot() << ";" << std::endl;
+        os << "const unsigned int preReadDelayOffset = preReadDelaySlot * group.numSrcNeurons;" << std::endl;
+    }
+
+    // If postsynaptic neuron group has variable queues, calculate offset to read from its variables at current time
+    if(sg.getArchetype().getTrgNeuronGroup()->isDelayRequired()) {
+        os << "const unsigned int postReadDelayOffset = " << sg.getPostsynapticBackPropDelaySlot() << " * group.numTrgNeurons;" << std::endl;
+    }
+
+    // generate the code for processing spike-like events
+    if (sg.getArchetype().isSpikeEventRequired()) {
+        genPresynapticUpdate(os, modelMerged, sg, funcSubs, false, wumThreshHandler, wumEventHandler, wumProceduralConnectHandler);
+    }
+
+    // generate the code for processing true spike events
+    if (sg.getArchetype().isTrueSpikeRequired()) {
+        genPresynapticUpdate(os, modelMerged, sg, funcSubs, true, wumThreshHandler, wumSimHandler, wumProceduralConnectHandler);
+    }
+    os << std::endl;
+}
+//--------------------------------------------------------------------------
+void Backend::genSparseInitGroup(CodeStream &os, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                 SynapseGroupMergedHandler sgSparseInitHandler) const
+{
+    // If postsynaptic remapping is required, initially zero column lengths
+    if (isPostsynapticRemapRequired(sg.getArchetype())) {
+        os << "// Zero column lengths" << std::endl;
+        os << "std::fill_n(group.colLength, group.numTrgNeurons, 0);" << std::endl;
+    }
+
+    os << "// Loop through presynaptic neurons" << std::endl;
+    os << "for (unsigned int i = 0; i < group.numSrcNeurons; i++)" << std::endl;
+    {
+        CodeStream::Scope b(os);
+
+        // Generate sparse initialisation code
+        if(sg.getArchetype().isWUVarInitRequired()) {
+            Substitutions popSubs(&funcSubs);
+            popSubs.addVarSubstitution("id_pre", "i");
+            popSubs.addVarSubstitution("row_len", getSparseRowLength(sg, "i"));
+            sgSparseInitHandler(os, sg, popSubs);
+        }
+
+        // If postsynaptic remapping is required
+        if(isPostsynapticRemapRequired(sg.getArchetype())) {
+            genPostsynapticRemapRow(os, sg);
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genSparseConnectivityInitGroup(CodeStream &os, const SynapseGroupMerged &sg, const Substitutions &funcSubs,
+                                             SynapseGroupMergedHandler sgSparseConnectHandler) const
+{
+    // If matrix connectivity is ragged
+    if(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
+        // Zero row lengths
+        os << "memset(group.rowLength, 0, group.numSrcNeurons * sizeof(unsigned int));" << std::endl;
+
+        // Loop through source neurons
+        os << "for (unsigned int i = 0; i < group.numSrcNeurons; i++)";
+        {
+            CodeStream::Scope b(os);
+
+            Substitutions popSubs(&funcSubs);
+            popSubs.addVarSubstitution("id_pre", "i");
+            popSubs.addVarSubstitution("id_post_begin", "0");
+            popSubs.addVarSubstitution("id_thread", "0");
+            popSubs.addVarSubstitution("num_threads", "1");
+            popSubs.addVarSubstitution("num_post", "group.numTrgNeurons");
+            
+            // Add function to increment row length and insert synapse into ind array
+            popSubs.addFuncSubstitution("addSynapse", 1,
+                                        "group.ind[(i * group.rowStride) + (group.rowLength[i]++)] = $(0)");
+
+            addConnectivityInitRNGSubstitutions(os, sg, popSubs);
+            sgSparseConnectHandler(os, sg, popSubs);
+        }
+
+    }
+    // Otherwise, if matrix connectivity is CSR
+    else if(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::CSR) {
+        // First row starts at beginning of ind
+        os << "group.rowPtr[0] = 0;" << std::endl;
+
+        // Loop through source neurons
+        os << "for (unsigned int i = 0; i < group.numSrcNeurons; i++)";
+        {
+            CodeStream::Scope b(os);
+
+            // Start next row where this one starts
+            os << "group.rowPtr[i + 1] = group.rowPtr[i];" << std::endl;
+
+            Substitutions popSubs(&funcSubs);
+            popSubs.addVarSubstitution("id_pre", "i");
+            popSubs.addVarSubstitution("id_post_begin", "0");
+            popSubs.addVarSubstitution("id_thread", "0");
+            popSubs.addVarSubstitution("num_threads", "1");
+            popSubs.addVarSubstitution("num_post", "group.numTrgNeurons");
+
+            // Add function to insert synapse at end of row and advance start of next row
+            // **NOTE** rows are built in order so synapses are tightly packed
+            // **NOTE** total is checked as exceeding it would write past the end of ind and the synapse variables
+            popSubs.addFuncSubstitution("addSynapse", 1,
+                                        "do{ if(group.rowPtr[i + 1] >= group.maxTotalConnections){ throw std::runtime_error(\"Too many synapses generated for CSR connectivity - increase maxTotalConnections\"); } group.ind[group.rowPtr[i + 1]++] = $(0); } while(false)");
+
+            addConnectivityInitRNGSubstitutions(os, sg, popSubs);
+            sgSparseConnectHandler(os, sg, popSubs);
+        }
+    }
+    // Otherwise, if matrix connectivity is a bitmask
+    else if(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::BITMASK) {
+        // Zero memory before setting sparse bits
+        os << "const size_t gpSize = ((((size_t)group.numSrcNeurons * (size_t)group.rowStride) + 32 - 1) / 32);" << std::endl;
+        os << "memset(group.gp, 0, gpSize * sizeof(uint32_t));" << std::endl;
+
+        // Loop through source neurons
+        os << "for(unsigned int i = 0; i < group.numSrcNeurons; i++)";
+        {
+            // Calculate index of bit at start of this row
+            CodeStream::Scope b(os);
+            os << "const int64_t rowStartGID = i * group.rowStride;" << std::endl;
+
+            // Build function template to set correct bit in bitmask
+            Substitutions popSubs(&funcSubs);
+            popSubs.addVarSubstitution("id_pre", "i");
+            popSubs.addVarSubstitution("id_post_begin", "0");
+            popSubs.addVarSubstitution("num_post", "group.numTrgNeurons");
+
+            // Add function to increment row length and insert synapse into ind array
+            popSubs.addFuncSubstitution("addSynapse", 1,
+                                        "setB(group.gp[(rowStartGID + $(0)) / 32], (rowStartGID + $(0)) & 31)");
+
+            addConnectivityInitRNGSubstitutions(os, sg, popSubs);
+            sgSparseConnectHandler(os, sg, popSubs);
+        }
+    }
+    else {
+        throw std::runtime_error("Only BITMASK, SPARSE and CSR format connectivity can be generated using a connectivity initialiser");
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genMergedGroup(CodeStream &os, ShardHandler shardHandler, const std::string &suffix, size_t idx, size_t numGroups,
+                             const std::string &params, const std::string &args, HostHandler handler) const
+{
+    // If modules are being sharded
+    if(shardHandler) {
+        // Generate function in its own module to process merged group
+        const std::string funcName = "process" + suffix + "Group" + std::to_string(idx);
+        shardHandler("merged" + suffix + "Group" + std::to_string(idx),
+                     [&](CodeStream &shard)
+                     {
+                         // Declare merged group array, implemented alongside the function which calls this one
+                         shard << "extern ";
+                         genMergedGroupImplementation(shard, suffix, idx, numGroups);
+                         shard << std::endl;
+
+                         shard << "void " << funcName << "(" << params << ")";
+                         {
+                             CodeStream::Scope b(shard);
+                             handler(shard);
+                         }
+                     });
+
+        // Declare and call function
+        // **NOTE** declaring function in block scope means calling code doesn't need to be generated in two passes
+        os << "void " << funcName << "(" << params << ");" << std::endl;
+        os << funcName << "(" << args << ");" << std::endl;
+    }
+    // Otherwise, generate code to process merged group in its own scope
+    else {
+        CodeStream::Scope b(os);
+        handler(os);
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genEmitSpike(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &subs, bool trueSpike) const
+{
+    genWriteSpike(os, ng, subs, trueSpike, getSpikeCount(ng, trueSpike) + "++");
+}
+//--------------------------------------------------------------------------
+void Backend::genPresynapticUpdateSpike(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &popSubs,
+                                        bool trueSpike, const std::string &inSyn, SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
+                                        SynapseGroupMergedHandler wumProceduralConnectHandler) const
 {
     // Get suffix based on type of events
     const std::string eventSuffix = trueSpike ? "" : "Evnt";
     const auto *wu = sg.getArchetype().getWUModel();
 
-    // Detect spike events or spikes and do the update
-    os << "// process presynaptic events: " << (trueSpike ? "True Spikes" : "Spike type events") << std::endl;
-    if (sg.getArchetype().getSrcNeuronGroup()->isDelayRequired()) {
-        os << "for (unsigned int i = 0; i < group.srcSpkCnt" << eventSuffix << "[preReadDelaySlot]; i++)";
+    if (!wu->getSimSupportCode().empty()) {
+        os << "using namespace " << modelMerged.getPresynapticUpdateSupportCodeNamespace(wu->getSimSupportCode()) <<  ";" << std::endl;
+    }
+
+    const std::string queueOffset = sg.getArchetype().getSrcNeuronGroup()->isDelayRequired() ? "preReadDelayOffset + " : "";
+    os << "const unsigned int ipre = group.srcSpk" << eventSuffix << "[" << queueOffset << "i];" << std::endl;
+
+    // If this is a spike-like event, insert threshold check for this presynaptic neuron
+    if (!trueSpike) {
+        os << "if(";
+
+        Substitutions threshSubs(&popSubs);
+        threshSubs.addVarSubstitution("id_pre", "ipre");
+
+        // Generate weight update threshold condition
+        wumThreshHandler(os, sg, threshSubs);
+
+        os << ")";
+        os << CodeStream::OB(10);
+    }
+
+    Substitutions synSubs(&popSubs);
+    synSubs.addVarSubstitution("id_pre", "ipre");
+    synSubs.addVarSubstitution("id_post", "ipost");
+    synSubs.addVarSubstitution("id_syn", "synAddress");
+
+    addToInSynSubstitutions(synSubs, sg, inSyn, "ipost");
+
+    if (isRaggedConnectivity(sg)) {
+        os << "const unsigned int npost = " << getSparseRowLength(sg, "ipre") << ";" << std::endl;
+        os << "for (unsigned int j = 0; j < npost; j++)";
+        {
+            CodeStream::Scope b(os);
+
+            // **TODO** seperate stride from max connection
+            os << "const unsigned int synAddress = " << getSparseRowStart(sg, "ipre") << " + j;" << std::endl;
+            os << "const unsigned int ipost = group.ind[synAddress];" << std::endl;
+
+            wumSimHandler(os, sg, synSubs);
+        }
+    }
+    else if(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::PROCEDURAL) {
+        const ModelSpecInternal &model = modelMerged.getModel();
+
+        // Create substitution stack for generating procedural connectivity code
+        // **NOTE** the whole row is processed by this thread
+        Substitutions connSubs(&popSubs);
+        connSubs.addVarSubstitution("id_pre", "ipre");
+        connSubs.addVarSubstitution("num_threads", "1");
+        connSubs.addVarSubstitution("id_post_begin", "0");
+        connSubs.addVarSubstitution("id_thread", "0");
+        connSubs.addVarSubstitution("num_post", "group.numTrgNeurons");
+
+        // Create another substitution stack for generating presynaptic simulation code
+        Substitutions presynapticUpdateSubs(&popSubs);
+        presynapticUpdateSubs.addVarSubstitution("id_pre", "ipre");
+
+        // If row building or procedural weights require an RNG
+        if(isProceduralRNGRequired(sg.getArchetype())) {
+            // Create counter-based RNG whose stream is unique to this row of this synapse group so
+            // exactly the same connectivity and weights are regenerated every time the row is processed
+            os << "Philox4x32_10 connectRNG(proceduralSeed, ipre, proceduralRNGStream[g], 0);" << std::endl;
+
+            // Shadow global standard distributions with local ones as std::normal_distribution caches values between calls
+            os << "std::uniform_real_distribution<" << model.getPrecision() << "> standardUniformDistribution(" << model.scalarExpr(0.0) << ", " << model.scalarExpr(1.0) << ");" << std::endl;
+            os << "std::normal_distribution<" << model.getPrecision() << "> standardNormalDistribution(" << model.scalarExpr(0.0) << ", " << model.scalarExpr(1.0) << ");" << std::endl;
+            os << "std::exponential_distribution<" << model.getPrecision() << "> standardExponentialDistribution(" << model.scalarExpr(1.0) << ");" << std::endl;
+
+            connSubs.addVarSubstitution("rng", "connectRNG");
+            presynapticUpdateSubs.addVarSubstitution("rng", "connectRNG");
+        }
+
+        // Replace $(id_post) with first 'function' parameter as simulation code is
+        // going to be, in turn, substituted into procedural connectivity generation code
+        presynapticUpdateSubs.addVarSubstitution("id_post", "$(0)");
+        addToInSynSubstitutions(presynapticUpdateSubs, sg, inSyn, "$(id_post)");
+
+        // Generate presynaptic simulation code into new stringstream-backed code stream
+        std::ostringstream presynapticUpdateStream;
+        CodeStream presynapticUpdate(presynapticUpdateStream);
+        wumSimHandler(presynapticUpdate, sg, presynapticUpdateSubs);
+
+        // When a synapse should be 'added', substitute in presynaptic update code
+        connSubs.addFuncSubstitution("addSynapse", 1, presynapticUpdateStream.str());
+
+        // Generate procedural connectivity code
+        wumProceduralConnectHandler(os, sg, connSubs);
+    }
+    else if(m_Preferences.enableBitmaskOptimisations && (sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::BITMASK)) {
+        // Determine the number of words in each row
+        os << "const unsigned int rowWords = ((group.numTrgNeurons + 32 - 1) / 32);" << std::endl;
+        os << "for(unsigned int w = 0; w < rowWords; w++)";
+        {
+            CodeStream::Scope b(os);
+
+            // Read row word
+            os << "uint32_t connectivityWord = group.gp[(ipre * rowWords) + w];" << std::endl;
+
+            // Set ipost to first synapse in connectivity word
+            os << "unsigned int ipost = w * 32;" << std::endl;
+
+            // While there any bits left
+            os << "while(connectivityWord != 0)";
+            {
+                CodeStream::Scope b(os);
+
+                // Cound leading zeros (as bits are indexed backwards this is index of next synapse)
+                os << "const int numLZ = gennCLZ(connectivityWord);" << std::endl;
+
+                // Shift off zeros and the one just discovered
+                // **NOTE** << 32 appears to result in undefined behaviour
+                os << "connectivityWord = (numLZ == 31) ? 0 : (connectivityWord << (numLZ + 1));" << std::endl;
+
+                // Add to ipost
+                os << "ipost += numLZ;" << std::endl;
+
+                // If we aren't in padding region
+                // **TODO** don't bother checking if there is no padding
+                os << "if(ipost < group.numTrgNeurons)";
+                {
+                    CodeStream::Scope b(os);
+                    wumSimHandler(os, sg, synSubs);
+                }
+
+                // Increment ipost to take into account fact the next CLZ will go from bit AFTER synapse
+                os << "ipost++;" << std::endl;
+            }
+        }
+    }
+    // Otherwise (DENSE or BITMASK)
+    else {
+        os << "for (unsigned int ipost = 0; ipost < group.numTrgNeurons; ipost++)";
+        {
+            CodeStream::Scope b(os);
+
+            if (sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::BITMASK) {
+                os << "const uint64_t gid = (ipre * (uint64_t)group.numTrgNeurons + ipost);" << std::endl;
+                os << "if (B(group.gp[gid / 32], gid & 31))" << CodeStream::OB(20);
+            }
+
+            os << "const unsigned int synAddress = (ipre * group.numTrgNeurons) + ipost;" << std::endl;
+
+            wumSimHandler(os, sg, synSubs);
+
+            if (sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::BITMASK) {
+                os << CodeStream::CB(20);
+            }
+        }
+    }
+    // If this is a spike-like event, close braces around threshold check
+    if (!trueSpike) {
+        os << CodeStream::CB(10);
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genPostsynapticRemapRow(CodeStream &os, const SynapseGroupMerged &sg) const
+{
+    os << "// Loop through synapses in corresponding matrix row" << std::endl;
+    os << "for(unsigned int j = 0; j < " << getSparseRowLength(sg, "i") << "; j++)" << std::endl;
+    {
+        CodeStream::Scope b(os);
+
+        os << "// Calculate index of this synapse in the row-major matrix" << std::endl;
+        os << "const unsigned int rowMajorIndex = " << getSparseRowStart(sg, "i") << " + j;" << std::endl;
+        os << "// Using this, lookup postsynaptic target" << std::endl;
+        os << "const unsigned int postIndex = group.ind[rowMajorIndex];" << std::endl;
+        os << "// From this calculate index of this synapse in the column-major matrix" << std::endl;
+        os << "const unsigned int colMajorIndex = (postIndex * group.colStride) + group.colLength[postIndex];" << std::endl;
+        os << "// Increment column length corresponding to this postsynaptic neuron" << std::endl;
+        os << "group.colLength[postIndex]++;" << std::endl;
+        os << "// Add remapping entry" << std::endl;
+        os << "group.remap[colMajorIndex] = rowMajorIndex;" << std::endl;
+    }
+}
+//--------------------------------------------------------------------------
+bool Backend::isPostSpanPresynapticUpdate(const SynapseGroupInternal &sg) const
+{
+    if(sg.getSpanType() == SynapseGroup::SpanType::PRESYNAPTIC) {
+        return false;
+    }
+    // Input to SPARSE synapse groups can be gathered using the postsynaptic remapping
+    // **NOTE** if span type is automatic, this is only the case if it's already built for postsynaptic learning
+    else if(sg.getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
+        return isPostsynapticRemapRequired(sg);
+    }
+    // Input to DENSE and BITMASK synapse groups is only gathered if requested as scattered input is accessed in order anyway
+    else if((sg.getMatrixType() & SynapseMatrixConnectivity::DENSE) || (sg.getMatrixType() & SynapseMatrixConnectivity::BITMASK)) {
+        return (sg.getSpanType() == SynapseGroup::SpanType::POSTSYNAPTIC);
+    }
+    // Input to CSR and PROCEDURAL synapse groups is always scattered
+    else {
+        return false;
+    }
+}
+//--------------------------------------------------------------------------
+std::string Backend::getPostSpanCondition(const SynapseGroupMerged &sg, const std::string &numSpikes) const
+{
+    // If span type is automatic, gather if the cost of scattering input from each spike along its row
+    // would exceed that of processing every postsynaptic neuron's column
+    if(sg.getArchetype().getSpanType() == SynapseGroup::SpanType::AUTOMATIC) {
+        return "((uint64_t)" + numSpikes + " * group.rowStride * " + std::to_string(postSpanScatterCost) + ") >= ((uint64_t)group.numTrgNeurons * group.colStride)";
     }
     else {
-        os << "for (unsigned int i = 0; i < group.srcSpkCnt" << eventSuffix << "[0]; i++)";
+        return "";
     }
+}
+//--------------------------------------------------------------------------
+void Backend::genPostSpanMarkActive(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &popSubs,
+                                    bool trueSpike, const std::string &numSpikes, SynapseGroupMergedHandler wumThreshHandler) const
+{
+    const std::string eventSuffix = trueSpike ? "" : "Evnt";
+    const auto *wu = sg.getArchetype().getWUModel();
+    const bool sparse = (sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE);
+
+    os << "// Mark active presynaptic neurons" << std::endl;
+    os << "unsigned int numActive = 0;" << std::endl;
+    os << "for (unsigned int i = 0; i < " << numSpikes << "; i++)";
     {
         CodeStream::Scope b(os);
+
         if (!wu->getSimSupportCode().empty()) {
             os << "using namespace " << modelMerged.getPresynapticUpdateSupportCodeNamespace(wu->getSimSupportCode()) <<  ";" << std::endl;
         }
@@ -981,94 +1949,79 @@ void Backend::genPresynapticUpdate(CodeStream &os, const ModelSpecMerged &modelM
         const std::string queueOffset = sg.getArchetype().getSrcNeuronGroup()->isDelayRequired() ? "preReadDelayOffset + " : "";
         os << "const unsigned int ipre = group.srcSpk" << eventSuffix << "[" << queueOffset << "i];" << std::endl;
 
-        // If this is a spike-like event, insert threshold check for this presynaptic neuron
+        // If this is a spike-like event, only mark presynaptic neurons which pass threshold
         if (!trueSpike) {
             os << "if(";
 
             Substitutions threshSubs(&popSubs);
             threshSubs.addVarSubstitution("id_pre", "ipre");
-
-            // Generate weight update threshold condition
             wumThreshHandler(os, sg, threshSubs);
 
             os << ")";
             os << CodeStream::OB(10);
         }
 
+        os << "postSpanPreActive[numActive++] = ipre;" << std::endl;
+        if(sparse) {
+            os << "postSpanPreMask[ipre] = 1;" << std::endl;
+        }
+
+        if (!trueSpike) {
+            os << CodeStream::CB(10);
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genPostSpanGather(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &popSubs,
+                                SynapseGroupMergedHandler wumSimHandler, const std::string &begin, const std::string &end) const
+{
+    const auto *wu = sg.getArchetype().getWUModel();
+    const bool dendriticDelay = sg.getArchetype().isDendriticDelayRequired();
+
+    os << "// Gather input into postsynaptic neurons" << std::endl;
+    os << "for (unsigned int ipost = " << begin << "; ipost < " << end << "; ipost++)";
+    {
+        CodeStream::Scope b(os);
+
+        if (!wu->getSimSupportCode().empty()) {
+            os << "using namespace " << modelMerged.getPresynapticUpdateSupportCodeNamespace(wu->getSimSupportCode()) <<  ";" << std::endl;
+        }
+
         Substitutions synSubs(&popSubs);
         synSubs.addVarSubstitution("id_pre", "ipre");
         synSubs.addVarSubstitution("id_post", "ipost");
         synSubs.addVarSubstitution("id_syn", "synAddress");
 
-        if(sg.getArchetype().isDendriticDelayRequired()) {
-            synSubs.addFuncSubstitution("addToInSynDelay", 2, "group.denDelay[" + sg.getDendriticDelayOffset("$(1)") + "ipost] += $(0)");
+        // Each postsynaptic neuron is only processed once so input can be accumulated locally or directly into dendritic delay buffer
+        if(dendriticDelay) {
+            addToInSynSubstitutions(synSubs, sg, "", "ipost");
         }
         else {
-            synSubs.addFuncSubstitution("addToInSyn", 1, "group.inSyn[ipost] += $(0)");
+            os << modelMerged.getModel().getPrecision() << " linSyn = " << modelMerged.getModel().scalarExpr(0.0) << ";" << std::endl;
+            synSubs.addFuncSubstitution("addToInSyn", 1, "linSyn += $(0)");
         }
 
-        if (sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
-            os << "const unsigned int npost = group.rowLength[ipre];" << std::endl;
-            os << "for (unsigned int j = 0; j < npost; j++)";
-            {
-                CodeStream::Scope b(os);
-
-                // **TODO** seperate stride from max connection
-                os << "const unsigned int synAddress = (ipre * group.rowStride) + j;" << std::endl;
-                os << "const unsigned int ipost = group.ind[synAddress];" << std::endl;
-
-                wumSimHandler(os, sg, synSubs);
-            }
-        }
-        else if(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::PROCEDURAL) {
-            throw std::runtime_error("The single-threaded CPU backend does not support procedural connectivity.");
-        }
-        else if(m_Preferences.enableBitmaskOptimisations && (sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::BITMASK)) {
-            // Determine the number of words in each row
-            os << "const unsigned int rowWords = ((group.numTrgNeurons + 32 - 1) / 32);" << std::endl;
-            os << "for(unsigned int w = 0; w < rowWords; w++)";
+        // If connectivity is SPARSE, loop through column and process synapses from marked presynaptic neurons
+        if(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
+            os << "const unsigned int npre = group.colLength[ipost];" << std::endl;
+            os << "for (unsigned int j = 0; j < npre; j++)";
             {
                 CodeStream::Scope b(os);
-
-                // Read row word
-                os << "uint32_t connectivityWord = group.gp[(ipre * rowWords) + w];" << std::endl;
-
-                // Set ipost to first synapse in connectivity word
-                os << "unsigned int ipost = w * 32;" << std::endl;
-
-                // While there any bits left
-                os << "while(connectivityWord != 0)";
+                os << "const unsigned int synAddress = group.remap[(ipost * group.colStride) + j];" << std::endl;
+                os << "const unsigned int ipre = synAddress / group.rowStride;" << std::endl;
+                os << "if(postSpanPreMask[ipre])";
                 {
                     CodeStream::Scope b(os);
-
-                    // Cound leading zeros (as bits are indexed backwards this is index of next synapse)
-                    os << "const int numLZ = gennCLZ(connectivityWord);" << std::endl;
-
-                    // Shift off zeros and the one just discovered
-                    // **NOTE** << 32 appears to result in undefined behaviour
-                    os << "connectivityWord = (numLZ == 31) ? 0 : (connectivityWord << (numLZ + 1));" << std::endl;
-
-                    // Add to ipost
-                    os << "ipost += numLZ;" << std::endl;
-
-                    // If we aren't in padding region
-                    // **TODO** don't bother checking if there is no padding
-                    os << "if(ipost < group.numTrgNeurons)";
-                    {
-                        CodeStream::Scope b(os);
-                        wumSimHandler(os, sg, synSubs);
-                    }
-
-                    // Increment ipost to take into account fact the next CLZ will go from bit AFTER synapse
-                    os << "ipost++;" << std::endl;
+                    wumSimHandler(os, sg, synSubs);
                 }
             }
         }
-        // Otherwise (DENSE or BITMASK)
+        // Otherwise (DENSE or BITMASK), loop through active presynaptic neurons
         else {
-            os << "for (unsigned int ipost = 0; ipost < group.numTrgNeurons; ipost++)";
+            os << "for (unsigned int j = 0; j < numActive; j++)";
             {
                 CodeStream::Scope b(os);
+                os << "const unsigned int ipre = postSpanPreActive[j];" << std::endl;
 
                 if (sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::BITMASK) {
                     os << "const uint64_t gid = (ipre * (uint64_t)group.numTrgNeurons + ipost);" << std::endl;
@@ -1076,7 +2029,6 @@ void Backend::genPresynapticUpdate(CodeStream &os, const ModelSpecMerged &modelM
                 }
 
                 os << "const unsigned int synAddress = (ipre * group.numTrgNeurons) + ipost;" << std::endl;
-
                 wumSimHandler(os, sg, synSubs);
 
                 if (sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::BITMASK) {
@@ -1084,34 +2036,393 @@ void Backend::genPresynapticUpdate(CodeStream &os, const ModelSpecMerged &modelM
                 }
             }
         }
-        // If this is a spike-like event, close braces around threshold check
-        if (!trueSpike) {
-            os << CodeStream::CB(10);
+
+        if(!dendriticDelay) {
+            os << "group.inSyn[ipost] += linSyn;" << std::endl;
+
+            // If target neurons are event-driven, schedule any which received input to be woken this timestep
+            if(sg.getArchetype().getTrgNeuronGroup()->isEventDriven()) {
+                os << "if(linSyn != 0)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "wakeQueueSchedule(" << getWakeQueueArgs("trg") << ", ipost, iT);" << std::endl;
+                }
+            }
         }
     }
 }
 //--------------------------------------------------------------------------
-void Backend::genEmitSpike(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &subs, bool trueSpike) const
+void Backend::genPostSpanReset(CodeStream &os, const SynapseGroupMerged &sg) const
+{
+    // Only SPARSE connectivity uses mask
+    if(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
+        os << "// Clear marked presynaptic neurons" << std::endl;
+        os << "for (unsigned int j = 0; j < numActive; j++)";
+        {
+            CodeStream::Scope b(os);
+            os << "postSpanPreMask[postSpanPreActive[j]] = 0;" << std::endl;
+        }
+    }
+}
+//--------------------------------------------------------------------------
+std::string Backend::getSparseRowStart(const SynapseGroupMerged &sg, const std::string &row) const
+{
+    if(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::CSR) {
+        return "group.rowPtr[" + row + "]";
+    }
+    else {
+        return "(" + row + " * group.rowStride)";
+    }
+}
+//--------------------------------------------------------------------------
+std::string Backend::getSparseRowLength(const SynapseGroupMerged &sg, const std::string &row) const
+{
+    if(sg.getArchetype().getMatrixType() & SynapseMatrixConnectivity::CSR) {
+        return "(group.rowPtr[" + row + " + 1] - group.rowPtr[" + row + "])";
+    }
+    else {
+        return "group.rowLength[" + row + "]";
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genRecordPresynapticPerformanceCounter(CodeStream &os, const SynapseGroupMerged &sg) const
+{
+    CodeStream::Scope b(os);
+    os << "unsigned long long perfSpikes = 0;" << std::endl;
+    os << "unsigned long long perfSynapticEvents = 0;" << std::endl;
+
+    // Loop through types of presynaptic event processed by group
+    const bool delay = sg.getArchetype().getSrcNeuronGroup()->isDelayRequired();
+    for(const bool trueSpike : {false, true}) {
+        if((trueSpike && sg.getArchetype().isTrueSpikeRequired()) || (!trueSpike && sg.getArchetype().isSpikeEventRequired())) {
+            CodeStream::Scope b(os);
+            const std::string eventSuffix = trueSpike ? "" : "Evnt";
+            os << "const unsigned int perfSlot = " << (delay ? sg.getPresynapticAxonalDelaySlot() : "0") << ";" << std::endl;
+            os << "const unsigned int perfNumSpikes = group.srcSpkCnt" << eventSuffix << "[perfSlot];" << std::endl;
+            os << "perfSpikes += perfNumSpikes;" << std::endl;
+
+            // With sparse connectivity, each event processes the synapses in its row, otherwise, it processes entire row
+            if(isRaggedConnectivity(sg)) {
+                os << "const unsigned int *perfSpk = &group.srcSpk" << eventSuffix << "[perfSlot * group.numSrcNeurons];" << std::endl;
+                os << "for(unsigned int i = 0; i < perfNumSpikes; i++)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "perfSynapticEvents += " << getSparseRowLength(sg, "perfSpk[i]") << ";" << std::endl;
+                }
+            }
+            else {
+                os << "perfSynapticEvents += (unsigned long long)perfNumSpikes * group.numTrgNeurons;" << std::endl;
+            }
+        }
+    }
+    os << "recordPerformanceCounter(group.perfCounter, perfStart, perfSpikes, perfSynapticEvents);" << std::endl;
+}
+//--------------------------------------------------------------------------
+void Backend::genRecordPostsynapticPerformanceCounter(CodeStream &os, const SynapseGroupMerged &sg) const
+{
+    CodeStream::Scope b(os);
+
+    // Each postsynaptic spike processes the synapses in its column
+    if(isRaggedConnectivity(sg)) {
+        const bool delay = (sg.getArchetype().getTrgNeuronGroup()->isDelayRequired() && sg.getArchetype().getTrgNeuronGroup()->isTrueSpikeRequired());
+        os << "const unsigned int perfSlot = " << (delay ? sg.getPostsynapticBackPropDelaySlot() : "0") << ";" << std::endl;
+        os << "const unsigned int *perfSpk = &group.trgSpk[perfSlot * group.numTrgNeurons];" << std::endl;
+        os << "unsigned long long perfSynapticEvents = 0;" << std::endl;
+        os << "for(unsigned int j = 0; j < group.trgSpkCnt[perfSlot]; j++)";
+        {
+            CodeStream::Scope b(os);
+            os << "perfSynapticEvents += group.colLength[perfSpk[j]];" << std::endl;
+        }
+        os << "recordPerformanceCounter(group.perfCounter, perfStart, group.trgSpkCnt[perfSlot], perfSynapticEvents);" << std::endl;
+    }
+    else {
+        os << "recordPerformanceCounter(group.perfCounter, perfStart, numSpikes, (unsigned long long)numSpikes * group.numSrcNeurons);" << std::endl;
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genRecordSynapseDynamicsPerformanceCounter(CodeStream &os, const SynapseGroupMerged &sg) const
+{
+    CodeStream::Scope b(os);
+
+    // Synapse dynamics processes every synapse
+    if(isRaggedConnectivity(sg)) {
+        os << "unsigned long long perfSynapticEvents = 0;" << std::endl;
+        os << "for(unsigned int i = 0; i < group.numSrcNeurons; i++)";
+        {
+            CodeStream::Scope b(os);
+            os << "perfSynapticEvents += " << getSparseRowLength(sg, "i") << ";" << std::endl;
+        }
+        os << "recordPerformanceCounter(group.perfCounter, perfStart, 0, perfSynapticEvents);" << std::endl;
+    }
+    else {
+        os << "recordPerformanceCounter(group.perfCounter, perfStart, 0, (unsigned long long)group.numSrcNeurons * group.numTrgNeurons);" << std::endl;
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genSIMDNeuronUpdateLoop(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &funcSubs,
+                                      NeuronGroupSimHandler simHandler, const std::string &begin, const std::string &end) const
+{
+    // Rather than appending to the spike buffer, which introduces a dependency between iterations,
+    // record spikes in masks so the compiler can vectorise the loop
+    os << "// Update neurons, recording spikes in masks" << std::endl;
+    os << "GENN_SIMD_LOOP" << std::endl;
+    os << "for(unsigned int i = " << begin << "; i < " << end << "; i++)";
+    {
+        CodeStream::Scope b(os);
+        os << "simdSpikeMask[i] = 0;" << std::endl;
+        if(ng.getArchetype().isSpikeEventRequired()) {
+            os << "simdSpikeEventMask[i] = 0;" << std::endl;
+        }
+
+        Substitutions popSubs(&funcSubs);
+        popSubs.addVarSubstitution("id", "i");
+        addNeuronRNGSubstitutions(os, ng, popSubs);
+
+        simHandler(os, ng, popSubs,
+                   // Emit true spikes
+                   [](CodeStream &os, const NeuronGroupMerged &, Substitutions &)
+                   {
+                       os << "simdSpikeMask[i] = 1;" << std::endl;
+                   },
+                   // Emit spike-like events
+                   [](CodeStream &os, const NeuronGroupMerged &, Substitutions &)
+                   {
+                       os << "simdSpikeEventMask[i] = 1;" << std::endl;
+                   });
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::genSIMDSpikeCompaction(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &funcSubs,
+                                     NeuronGroupMergedHandler wuVarUpdateHandler) const
+{
+    // Compact masks into spike buffers, writing every index and only advancing count if neuron spiked to avoid branches
+    const auto compactMask = [&os, &ng, this](bool trueSpike)
+    {
+        const std::string suffix = trueSpike ? "" : "Evnt";
+        const std::string spikeCount = getSpikeCount(ng, trueSpike);
+        const std::string spikeQueueOffset = getSpikeQueueOffset(ng, trueSpike);
+
+        os << "unsigned int numSpikes" << suffix << " = " << spikeCount << ";" << std::endl;
+        os << "for(unsigned int i = 0; i < group.numNeurons; i++)";
+        {
+            CodeStream::Scope b(os);
+            os << "group.spk" << suffix << "[" << spikeQueueOffset << "numSpikes" << suffix << "] = i;" << std::endl;
+            os << "numSpikes" << suffix << " += simd" << (trueSpike ? "SpikeMask" : "SpikeEventMask") << "[i];" << std::endl;
+        }
+    };
+
+    os << "// Compact spikes recorded in masks" << std::endl;
+    if(ng.getArchetype().isSpikeEventRequired()) {
+        CodeStream::Scope b(os);
+        compactMask(false);
+        os << getSpikeCount(ng, false) << " = numSpikesEvnt;" << std::endl;
+    }
+
+    // If spike times or any weight update model pre or postsynaptic variables need updating, loop through new spikes
+    const bool spikeUpdateRequired = (ng.getArchetype().isSpikeTimeRequired() || !ng.getArchetype().getOutSynWithPreCode().empty()
+                                      || !ng.getArchetype().getInSynWithPostCode().empty());
+    CodeStream::Scope b(os);
+    if(spikeUpdateRequired) {
+        os << "const unsigned int firstSpike = " << getSpikeCount(ng, true) << ";" << std::endl;
+    }
+    compactMask(true);
+    os << getSpikeCount(ng, true) << " = numSpikes;" << std::endl;
+    if(spikeUpdateRequired) {
+        os << "for(unsigned int s = firstSpike; s < numSpikes; s++)";
+        {
+            CodeStream::Scope b(os);
+            os << "const unsigned int i = group.spk[" << getSpikeQueueOffset(ng, true) << "s];" << std::endl;
+
+            Substitutions popSubs(&funcSubs);
+            popSubs.addVarSubstitution("id", "i");
+
+            genWriteSpikeTime(os, ng, popSubs);
+            wuVarUpdateHandler(os, ng, popSubs);
+        }
+    }
+}
+//--------------------------------------------------------------------------
+bool Backend::isSIMDNeuronUpdate(const NeuronGroupMerged &ng) const
+{
+    // Neuron groups which use the global RNG or only update some neurons each timestep can't be vectorised
+    return (m_Preferences.enableSIMDNeuronUpdate && !ng.getArchetype().isEventDriven()
+            && (m_Preferences.enableCounterBasedRNG || !ng.getArchetype().isSimRNGRequired()));
+}
+//--------------------------------------------------------------------------
+void Backend::addNeuronRNGSubstitutions(CodeStream &os, const NeuronGroupMerged &ng, Substitutions &popSubs) const
+{
+    if(ng.getArchetype().isSimRNGRequired()) {
+        // If counter-based RNGs are enabled, create a stream unique to this neuron, population and timestep
+        if(m_Preferences.enableCounterBasedRNG) {
+            os << "Philox4x32_10 neuronRNG(simulationSeed, neuronRNGOffset + " << popSubs["id"] << ", (uint32_t)iT, neuronRNGStream[g]);" << std::endl;
+            popSubs.addVarSubstitution("rng", "neuronRNG");
+
+            // Override standard distributions with ones which sample from the stream
+            for(const auto &f : cpuCounterRNGFunctions) {
+                popSubs.addFuncSubstitution(f.genericName, f.numArguments, f.singlePrecisionTemplate);
+            }
+        }
+        // Otherwise, substitute in global RNG
+        else {
+            popSubs.addVarSubstitution("rng", "rng");
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void Backend::addConnectivityInitRNGSubstitutions(CodeStream &os, const SynapseGroupMerged &sg, Substitutions &popSubs) const
+{
+    // If connectivity is built using counter-based RNGs, create a stream unique to this row and population
+    // **NOTE** otherwise the global RNG is already substituted in by the caller
+    if(isConnectivityInitCounterRNG(sg.getArchetype())) {
+        os << "Philox4x32_10 connectRNG(connectivitySeed, i, connectivityRNGStream[g], 0);" << std::endl;
+        popSubs.addVarSubstitution("rng", "connectRNG");
+
+        // Override standard distributions with ones which sample from the stream
+        for(const auto &f : cpuCounterRNGFunctions) {
+            popSubs.addFuncSubstitution(f.genericName, f.numArguments, f.singlePrecisionTemplate);
+        }
+    }
+}
+//--------------------------------------------------------------------------
+bool Backend::isConnectivityInitCounterRNG(const SynapseGroupInternal &sg) const
+{
+    return (m_Preferences.enableCounterBasedRNG
+            && Utils::isRNGRequired(sg.getConnectivityInitialiser().getSnippet()->getRowBuildCode()));
+}
+//--------------------------------------------------------------------------
+bool Backend::isConnectivityInitRowIndependent(const SynapseGroupInternal &sg) const
+{
+    return (!Utils::isRNGRequired(sg.getConnectivityInitialiser().getSnippet()->getRowBuildCode())
+            || isConnectivityInitCounterRNG(sg));
+}
+//--------------------------------------------------------------------------
+void Backend::genWriteSpike(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &subs, bool trueSpike, const std::string &spikeIndex) const
+{
+    const std::string suffix = trueSpike ? "" : "Evnt";
+    os << "group.spk" << suffix << "[" << getSpikeQueueOffset(ng, trueSpike) << spikeIndex << "] = " << subs["id"] << ";" << std::endl;
+
+    // Reset spike time if this is a true spike
+    if(trueSpike) {
+        genWriteSpikeTime(os, ng, subs);
+    }
+}
+//--------------------------------------------------------------------------
+std::string Backend::getSpikeCount(const NeuronGroupMerged &ng, bool trueSpike) const
+{
+    // Determine if delay is required and thus, which delay slot's spike count should be accessed
+    const bool spikeDelayRequired = trueSpike ? (ng.getArchetype().isDelayRequired() && ng.getArchetype().isTrueSpikeRequired()) : ng.getArchetype().isDelayRequired();
+    const std::string suffix = trueSpike ? "" : "Evnt";
+    return "group.spkCnt" + suffix + (spikeDelayRequired ? "[*group.spkQuePtr]" : "[0]");
+}
+//--------------------------------------------------------------------------
+std::string Backend::getSpikeQueueOffset(const NeuronGroupMerged &ng, bool trueSpike) const
 {
     // Determine if delay is required and thus, at what offset we should write into the spike queue
     const bool spikeDelayRequired = trueSpike ? (ng.getArchetype().isDelayRequired() && ng.getArchetype().isTrueSpikeRequired()) : ng.getArchetype().isDelayRequired();
-    const std::string spikeQueueOffset = spikeDelayRequired ? "writeDelayOffset + " : "";
+    return spikeDelayRequired ? "writeDelayOffset + " : "";
+}
+//--------------------------------------------------------------------------
+void Backend::genPresynapticUpdate(CodeStream &os, const ModelSpecMerged &modelMerged, const SynapseGroupMerged &sg, const Substitutions &popSubs,
+                                   bool trueSpike, SynapseGroupMergedHandler wumThreshHandler, SynapseGroupMergedHandler wumSimHandler,
+                                   SynapseGroupMergedHandler wumProceduralConnectHandler) const
+{
+    // Get suffix based on type of events
+    const std::string eventSuffix = trueSpike ? "" : "Evnt";
+    const std::string spikeCount = "group.srcSpkCnt" + eventSuffix + (sg.getArchetype().getSrcNeuronGroup()->isDelayRequired() ? "[preReadDelaySlot]" : "[0]");
 
-    const std::string suffix = trueSpike ? "" : "Evnt";
-    os << "group.spk" << suffix << "[" << spikeQueueOffset << "group.spkCnt" << suffix;
-    if(spikeDelayRequired) { // WITH DELAY
-        os << "[*group.spkQuePtr]++]";
+    // Detect spike events or spikes and do the update
+    os << "// process presynaptic events: " << (trueSpike ? "True Spikes" : "Spike type events") << std::endl;
+    const auto genScatter =
+        [&]()
+        {
+            os << "for (unsigned int i = 0; i < " << spikeCount << "; i++)";
+            {
+                CodeStream::Scope b(os);
+                genPresynapticUpdateSpike(os, modelMerged, sg, popSubs, trueSpike, "group.inSyn",
+                                          wumThreshHandler, wumSimHandler, wumProceduralConnectHandler);
+            }
+        };
+
+    // If input can be gathered target-by-target
+    if(isPostSpanPresynapticUpdate(sg.getArchetype())) {
+        CodeStream::Scope b(os);
+        os << "const unsigned int numSpikes = " << spikeCount << ";" << std::endl;
+
+        // If choice between gathering and scattering is made at runtime, generate condition
+        const std::string postSpanCondition = getPostSpanCondition(sg, "numSpikes");
+        if(!postSpanCondition.empty()) {
+            os << "if(" << postSpanCondition << ")";
+        }
+        {
+            CodeStream::Scope b(os);
+            genPostSpanMarkActive(os, modelMerged, sg, popSubs, trueSpike, "numSpikes", wumThreshHandler);
+            genPostSpanGather(os, modelMerged, sg, popSubs, wumSimHandler, "0", "group.numTrgNeurons");
+            genPostSpanReset(os, sg);
+        }
+
+        // Otherwise, scatter
+        if(!postSpanCondition.empty()) {
+            os << "else";
+            CodeStream::Scope b(os);
+            genScatter();
+        }
     }
-    else { // NO DELAY
-        os << "[0]++]";
+    // Otherwise, scatter input from each spike
+    else {
+        genScatter();
     }
-    os << " = " << subs["id"] << ";" << std::endl;
-
-    // Reset spike time if this is a true spike and spike time is required
-    if(trueSpike && ng.getArchetype().isSpikeTimeRequired()) {
+}
+//--------------------------------------------------------------------------
+void Backend::genWriteSpikeTime(CodeStream &os, const NeuronGroupMerged &ng, const Substitutions &subs) const
+{
+    // If spike time is required, set it to current time
+    if(ng.getArchetype().isSpikeTimeRequired()) {
         const std::string queueOffset = ng.getArchetype().isDelayRequired() ? "writeDelayOffset + " : "";
         os << "group.sT[" << queueOffset << subs["id"] << "] = " << subs["t"] << ";" << std::endl;
     }
 }
+//--------------------------------------------------------------------------
+bool Backend::isSimCounterRNGRequired(const ModelSpecMerged &modelMerged) const
+{
+    const auto &mergedNeuronUpdateGroups = modelMerged.getMergedNeuronUpdateGroups();
+    return (m_Preferences.enableCounterBasedRNG
+            && std::any_of(mergedNeuronUpdateGroups.cbegin(), mergedNeuronUpdateGroups.cend(),
+                           [](const NeuronGroupMerged &n){ return n.getArchetype().isSimRNGRequired(); }));
+}
+//--------------------------------------------------------------------------
+bool Backend::isConnectivityInitCounterRNGRequired(const ModelSpecMerged &modelMerged) const
+{
+    const auto &mergedConnectivityInitGroups = modelMerged.getMergedSynapseConnectivityInitGroups();
+    return std::any_of(mergedConnectivityInitGroups.cbegin(), mergedConnectivityInitGroups.cend(),
+                       [this](const SynapseGroupMerged &s){ return isConnectivityInitCounterRNG(s.getArchetype()); });
+}
+//--------------------------------------------------------------------------
+size_t Backend::getPostSpanScratchSize(const ModelSpecMerged &modelMerged) const
+{
+    // Find the largest presynaptic population of a synapse group whose input may be gathered
+    size_t size = 0;
+    for(const auto &s : modelMerged.getMergedPresynapticUpdateGroups()) {
+        if(isPostSpanPresynapticUpdate(s.getArchetype())) {
+            for(const auto &g : s.getGroups()) {
+                size = std::max<size_t>(size, g.get().getSrcNeuronGroup()->getNumNeurons());
+            }
+        }
+    }
+    return size;
+}
+//--------------------------------------------------------------------------
+size_t Backend::getSIMDSpikeMaskSize(const ModelSpecMerged &modelMerged) const
+{
+    // Find the largest neuron group updated using SIMD neuron update loops
+    size_t size = 0;
+    for(const auto &n : modelMerged.getMergedNeuronUpdateGroups()) {
+        if(isSIMDNeuronUpdate(n)) {
+            for(const auto &g : n.getGroups()) {
+                size = std::max<size_t>(size, g.get().getNumNeurons());
+            }
+        }
+    }
+    return size;
+}
 }   // namespace SingleThreadedCPU
 }   // namespace CodeGenerator
@@ -1,5 +1,6 @@
 // Standard C++ includes
 #include <fstream>
+#include <sstream>
 
 #ifdef _WIN32
 #include <Objbase.h>
@@ -105,12 +106,15 @@ int main(int argc,     //!< number of arguments; expected to be 2
             LOGI_CODE_GENERATOR << "Using previously generated project GUID:" << projectGUIDString;
         }
         // Create MSBuild project to compile and link all generated modules
-        std::ofstream makefile((outputPath / "runner.vcxproj").str());
+        std::stringstream makefile;
         CodeGenerator::generateMSBuild(makefile, backend, projectGUIDString, moduleNames);
+        CodeGenerator::writeFileIfChanged(outputPath / "runner.vcxproj", makefile.str());
 #else
         // Create makefile to compile and link all generated modules
-        std::ofstream makefile((outputPath / "Makefile").str());
+        // **NOTE** as objects depend on the makefile, they will only be rebuilt if it changes e.g. because compiler flags have changed
+        std::stringstream makefile;
         CodeGenerator::generateMakefile(makefile, backend, moduleNames);
+        CodeGenerator::writeFileIfChanged(outputPath / "Makefile", makefile.str());
 #endif
 
     }
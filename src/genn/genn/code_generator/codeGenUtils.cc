@@ -559,4 +559,157 @@ void neuronSubstitutionsInSynapticCode(
     const std::string postOffset = sg.getTrgNeuronGroup()->isDelayRequired() ? "postReadDelayOffset + " : "";
     neuronSubstitutionsInSynapticCode(substitutions, sg.getTrgNeuronGroup(), postOffset, backPropDelayMs, postIdx, "_post", "Post", postVarPrefix, postVarSuffix);
 }
+
+std::string getWUVarLoad(const SynapseGroupInternal &sg, size_t varIndex, const std::string &storage)
+{
+    const std::string scale = "group." + sg.getWUModel()->getVars().at(varIndex).name + "StorageScale";
+    switch(sg.getWUVarStorage(varIndex)) {
+    case SynapseGroup::VarStorage::HALF:
+        return "gennHalfToFloat(" + storage + ")";
+    case SynapseGroup::VarStorage::BFLOAT16:
+        return "gennBFloat16ToFloat(" + storage + ")";
+    case SynapseGroup::VarStorage::FIXED8:
+    case SynapseGroup::VarStorage::FIXED16:
+        return "(" + scale + " * " + storage + ")";
+    default:
+        return storage;
+    }
+}
+
+std::string getWUVarStore(const SynapseGroupInternal &sg, size_t varIndex, const std::string &value)
+{
+    const std::string scale = "group." + sg.getWUModel()->getVars().at(varIndex).name + "StorageScale";
+    switch(sg.getWUVarStorage(varIndex)) {
+    case SynapseGroup::VarStorage::HALF:
+        return "gennFloatToHalf(" + value + ")";
+    case SynapseGroup::VarStorage::BFLOAT16:
+        return "gennFloatToBFloat16(" + value + ")";
+    case SynapseGroup::VarStorage::FIXED8:
+        return "gennFloatToFixed8(" + value + ", " + scale + ")";
+    case SynapseGroup::VarStorage::FIXED16:
+        return "gennFloatToFixed16(" + value + ", " + scale + ")";
+    default:
+        return value;
+    }
+}
+
+void genReducedPrecisionStorageFunctions(CodeStream &os)
+{
+    // **NOTE** these are defined in definitions.h so they are available to user code filling variables on the host
+    // as well as to generated code and, when compiled with NVCC, are also made available on the device
+    os << "#include <cmath>" << std::endl;
+    os << "#include <cstring>" << std::endl;
+    os << "#ifdef __CUDACC__" << std::endl;
+    os << "#define GENN_STORAGE_FUNC __host__ __device__ inline" << std::endl;
+    os << "#else" << std::endl;
+    os << "#define GENN_STORAGE_FUNC inline" << std::endl;
+    os << "#endif" << std::endl;
+    os << std::endl;
+
+    // Convert half-precision bits to float, handling denormals, infinities and NaNs
+    os << "GENN_STORAGE_FUNC float gennHalfToFloat(uint16_t h)";
+    {
+        CodeStream::Scope b(os);
+        os << "uint32_t bits = ((uint32_t)(h & 0x7FFF)) << 13;" << std::endl;
+        os << "const uint32_t exponent = bits & 0x0F800000u;" << std::endl;
+        os << "bits += (127 - 15) << 23;" << std::endl;
+        os << "float f;" << std::endl;
+        os << "if(exponent == 0x0F800000u)";
+        {
+            CodeStream::Scope b(os);
+            os << "bits += (128 - 16) << 23;" << std::endl;
+            os << "std::memcpy(&f, &bits, sizeof(float));" << std::endl;
+        }
+        os << "else if(exponent == 0)";
+        {
+            CodeStream::Scope b(os);
+            os << "bits += 1 << 23;" << std::endl;
+            os << "std::memcpy(&f, &bits, sizeof(float));" << std::endl;
+            os << "f -= 6.103515625e-05f;" << std::endl;
+        }
+        os << "else";
+        {
+            CodeStream::Scope b(os);
+            os << "std::memcpy(&f, &bits, sizeof(float));" << std::endl;
+        }
+        os << "return (h & 0x8000) ? -f : f;" << std::endl;
+    }
+    os << std::endl;
+
+    // Convert float to half-precision bits with round-to-nearest-even
+    os << "GENN_STORAGE_FUNC uint16_t gennFloatToHalf(float f)";
+    {
+        CodeStream::Scope b(os);
+        os << "uint32_t bits;" << std::endl;
+        os << "std::memcpy(&bits, &f, sizeof(float));" << std::endl;
+        os << "const uint32_t sign = bits & 0x80000000u;" << std::endl;
+        os << "bits ^= sign;" << std::endl;
+        os << "uint16_t h;" << std::endl;
+        os << "if(bits >= (143u << 23))";
+        {
+            CodeStream::Scope b(os);
+            os << "h = (bits > (255u << 23)) ? 0x7E00 : 0x7C00;" << std::endl;
+        }
+        os << "else if(bits < (113u << 23))";
+        {
+            CodeStream::Scope b(os);
+            os << "const uint32_t denormMagicBits = 126u << 23;" << std::endl;
+            os << "float denormMagic;" << std::endl;
+            os << "std::memcpy(&denormMagic, &denormMagicBits, sizeof(float));" << std::endl;
+            os << "std::memcpy(&f, &bits, sizeof(float));" << std::endl;
+            os << "f += denormMagic;" << std::endl;
+            os << "std::memcpy(&bits, &f, sizeof(float));" << std::endl;
+            os << "h = (uint16_t)(bits - denormMagicBits);" << std::endl;
+        }
+        os << "else";
+        {
+            CodeStream::Scope b(os);
+            os << "const uint32_t mantissaOdd = (bits >> 13) & 1;" << std::endl;
+            os << "bits += (uint32_t)((15 - 127) << 23) + 0xFFF + mantissaOdd;" << std::endl;
+            os << "h = (uint16_t)(bits >> 13);" << std::endl;
+        }
+        os << "return h | (uint16_t)(sign >> 16);" << std::endl;
+    }
+    os << std::endl;
+
+    // Convert bfloat16 bits to float by placing them in the upper half of a float
+    os << "GENN_STORAGE_FUNC float gennBFloat16ToFloat(uint16_t b)";
+    {
+        CodeStream::Scope b(os);
+        os << "const uint32_t bits = ((uint32_t)b) << 16;" << std::endl;
+        os << "float f;" << std::endl;
+        os << "std::memcpy(&f, &bits, sizeof(float));" << std::endl;
+        os << "return f;" << std::endl;
+    }
+    os << std::endl;
+
+    // Convert float to bfloat16 bits with round-to-nearest-even, keeping NaNs quiet
+    os << "GENN_STORAGE_FUNC uint16_t gennFloatToBFloat16(float f)";
+    {
+        CodeStream::Scope b(os);
+        os << "uint32_t bits;" << std::endl;
+        os << "std::memcpy(&bits, &f, sizeof(float));" << std::endl;
+        os << "if((bits & 0x7FFFFFFFu) > 0x7F800000u)";
+        {
+            CodeStream::Scope b(os);
+            os << "return (uint16_t)((bits >> 16) | 0x40);" << std::endl;
+        }
+        os << "return (uint16_t)((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);" << std::endl;
+    }
+    os << std::endl;
+
+    // Convert float to fixed point, rounding to nearest and saturating
+    os << "GENN_STORAGE_FUNC int8_t gennFloatToFixed8(float f, float scale)";
+    {
+        CodeStream::Scope b(os);
+        os << "return (int8_t)fminf(fmaxf(roundf(f / scale), -128.0f), 127.0f);" << std::endl;
+    }
+    os << std::endl;
+    os << "GENN_STORAGE_FUNC int16_t gennFloatToFixed16(float f, float scale)";
+    {
+        CodeStream::Scope b(os);
+        os << "return (int16_t)fminf(fmaxf(roundf(f / scale), -32768.0f), 32767.0f);" << std::endl;
+    }
+    os << std::endl;
+}
 }   // namespace CodeGenerator
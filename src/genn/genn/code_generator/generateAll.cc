@@ -1,7 +1,10 @@
 #include "code_generator/generateAll.h"
 
 // Standard C++ includes
+#include <algorithm>
 #include <fstream>
+#include <iterator>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -26,20 +29,38 @@
 //--------------------------------------------------------------------------
 // CodeGenerator
 //--------------------------------------------------------------------------
+bool CodeGenerator::writeFileIfChanged(const filesystem::path &path, const std::string &contents)
+{
+    // If file already exists with identical contents, leave it alone
+    if(path.exists()) {
+        std::ifstream existingStream(path.str(), std::ios::binary);
+        const std::string existing{std::istreambuf_iterator<char>(existingStream), std::istreambuf_iterator<char>()};
+        if(existing == contents) {
+            LOGD_CODE_GEN << "'" << path.str() << "' unchanged";
+            return false;
+        }
+    }
+
+    // Otherwise, (re)write file
+    std::ofstream stream(path.str(), std::ios::binary);
+    stream << contents;
+    return true;
+}
+//--------------------------------------------------------------------------
 std::vector<std::string> CodeGenerator::generateAll(const ModelSpecInternal &model, const BackendBase &backend,
                                                     const filesystem::path &outputPath, bool standaloneModules)
 {
     // Create directory for generated code
     filesystem::create_directory(outputPath);
 
-    // Open output file streams for generated code files
-    std::ofstream definitionsStream((outputPath / "definitions.h").str());
-    std::ofstream definitionsInternalStream((outputPath / "definitionsInternal.h").str());
-    std::ofstream supportCodeStream((outputPath / "supportCode.h").str());
-    std::ofstream neuronUpdateStream((outputPath / "neuronUpdate.cc").str());
-    std::ofstream synapseUpdateStream((outputPath / "synapseUpdate.cc").str());
-    std::ofstream initStream((outputPath / "init.cc").str());
-    std::ofstream runnerStream((outputPath / "runner.cc").str());
+    // Generate code into memory so files are only written, and hence rebuilt, if their contents change
+    std::stringstream definitionsStream;
+    std::stringstream definitionsInternalStream;
+    std::stringstream supportCodeStream;
+    std::stringstream neuronUpdateStream;
+    std::stringstream synapseUpdateStream;
+    std::stringstream initStream;
+    std::stringstream runnerStream;
 
     // Wrap output file streams in CodeStreams for formatting
     CodeStream definitions(definitionsStream);
@@ -53,23 +74,124 @@ std::vector<std::string> CodeGenerator::generateAll(const ModelSpecInternal &mod
     // Create merged model
     ModelSpecMerged modelMerged(model, backend);
 
+    // If modules should be sharded, collect the modules backend places code for individual merged groups in
+    // **NOTE** standalone modules each include the runner so can't be linked with additional modules
+    std::vector<std::pair<std::string, std::string>> shards;
+    BackendBase::ShardHandler shardHandler;
+    if(backend.getModuleLayout() == ModuleLayout::SHARDED && !standaloneModules) {
+        shardHandler =
+            [&shards](const std::string &name, BackendBase::HostHandler handler)
+            {
+                std::stringstream shardStream;
+                CodeStream shard(shardStream);
+                shard << "#include \"definitionsInternal.h\"" << std::endl;
+                shard << "#include \"supportCode.h\"" << std::endl;
+                shard << std::endl;
+                handler(shard);
+                shards.emplace_back(name, shardStream.str());
+            };
+    }
+
     // Generate modules
     MergedEGPMap mergedEGPs;
     auto mem = generateRunner(definitions, definitionsInternal, runner, mergedEGPs, modelMerged, backend);
-    generateNeuronUpdate(neuronUpdate, mergedEGPs, modelMerged, backend, standaloneModules);
-    generateSynapseUpdate(synapseUpdate, mergedEGPs, modelMerged, backend, standaloneModules);
-    generateInit(init, mergedEGPs, modelMerged, backend, standaloneModules);
+    generateNeuronUpdate(neuronUpdate, mergedEGPs, modelMerged, backend, standaloneModules, shardHandler);
+    generateSynapseUpdate(synapseUpdate, mergedEGPs, modelMerged, backend, standaloneModules, shardHandler);
+    generateInit(init, mergedEGPs, modelMerged, backend, standaloneModules, shardHandler);
 
     generateSupportCode(supportCode, modelMerged);
 
+    // Write any generated files which have changed
+    // **NOTE** generated code is a pure function of the merged model and backend so, if no files
+    // have changed, make will consider the previously built library up to date and reuse it
+    const std::pair<std::string, const std::stringstream&> files[] = {
+        {"definitions.h", definitionsStream}, {"definitionsInternal.h", definitionsInternalStream},
+        {"supportCode.h", supportCodeStream}, {"neuronUpdate.cc", neuronUpdateStream},
+        {"synapseUpdate.cc", synapseUpdateStream}, {"init.cc", initStream}, {"runner.cc", runnerStream}};
+    size_t numChanged = 0;
+    for(const auto &f : files) {
+        if(writeFileIfChanged(outputPath / f.first, f.second.str())) {
+            numChanged++;
+        }
+    }
+    for(const auto &s : shards) {
+        if(writeFileIfChanged(outputPath / (s.first + ".cc"), s.second)) {
+            numChanged++;
+        }
+    }
+
+    // Remove any shards written by a previous generation which are no longer required
+    // **NOTE** path.h can't list directories so the shards written are recorded in a manifest
+    auto shardManifestPath = outputPath / "shards.txt";
+    if(shardManifestPath.exists()) {
+        std::ifstream shardManifest(shardManifestPath.str());
+        std::string name;
+        while(std::getline(shardManifest, name)) {
+            if(std::none_of(shards.cbegin(), shards.cend(),
+                            [&name](const std::pair<std::string, std::string> &s){ return (s.first == name); }))
+            {
+                LOGD_CODE_GEN << "Removing stale shard '" << name << "'";
+                for(const auto &e : {".cc", ".o", ".d"}) {
+                    auto stalePath = outputPath / (name + e);
+                    if(stalePath.exists()) {
+                        stalePath.remove_file();
+                    }
+                }
+                numChanged++;
+            }
+        }
+    }
+    if(shards.empty()) {
+        if(shardManifestPath.exists()) {
+            shardManifestPath.remove_file();
+        }
+    }
+    else {
+        std::stringstream shardManifest;
+        for(const auto &s : shards) {
+            shardManifest << s.first << std::endl;
+        }
+        writeFileIfChanged(shardManifestPath, shardManifest.str());
+    }
+
+    // If all generated code should be compiled as a single module, write module which includes all others
+    // **NOTE** anonymous namespaces of the included modules merge so, any helpers
+    // modules define at file scope need names which are unique across all modules
+    const bool unity = (backend.getModuleLayout() == ModuleLayout::UNITY && !standaloneModules);
+    if(unity) {
+        std::stringstream unityStream;
+        for(const auto &m : {"runner", "neuronUpdate", "synapseUpdate", "init"}) {
+            unityStream << "#include \"" << m << ".cc\"" << std::endl;
+        }
+        if(writeFileIfChanged(outputPath / "unity.cc", unityStream.str())) {
+            numChanged++;
+        }
+    }
+
+    if(numChanged == 0) {
+        LOGI_CODE_GEN << "Generated code unchanged - previously built model will be reused";
+    }
+
     // Create basic list of modules
-    std::vector<std::string> modules = {"neuronUpdate", "synapseUpdate", "init"};
+    std::vector<std::string> modules;
+    if(unity) {
+        modules.push_back("unity");
+    }
+    else {
+        modules = {"neuronUpdate", "synapseUpdate", "init"};
+
+        // Add any shards to list of modules
+        std::transform(shards.cbegin(), shards.cend(), std::back_inserter(modules),
+                       [](const std::pair<std::string, std::string> &s){ return s.first; });
+    }
 
     // If we aren't building standalone modules
     if(!standaloneModules) {
         // Because it won't be included in each
         // module, add runner to list of modules
-        modules.push_back("runner");
+        if(!unity) {
+            modules.push_back("runner");
+        }
 
         // **YUCK** this is kinda (ab)using standaloneModules for things it's not intended for but...
         // Show memory usage
@@ -94,6 +216,7 @@ std::vector<std::string> CodeGenerator::generateAll(const ModelSpecInternal &mod
         LOGI << "\t" << modelMerged.getMergedSynapseSparseInitGroups().size() << " merged synapse sparse init groups";
         LOGI << "\t" << modelMerged.getMergedNeuronSpikeQueueUpdateGroups().size() << " merged neuron spike queue update groups";
         LOGI << "\t" << modelMerged.getMergedSynapseDendriticDelayUpdateGroups().size() << " merged synapse dendritic delay update groups";
+        LOGI << "Generated code will be compiled as " << modules.size() << " modules";
     }
 
     // Return list of modules
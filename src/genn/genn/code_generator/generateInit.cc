@@ -172,11 +172,20 @@ void genInitWUVarCode(CodeGenerator::CodeStream &os, const CodeGenerator::Backen
                 [&backend, &vars, &varInit, &sg, &ftype, k]
                 (CodeStream &os, Substitutions &varSubs)
                 {
-                    varSubs.addVarSubstitution("value", "group." + vars[k].name + "[" + varSubs["id_syn"] +  "]");
+                    // If variable is stored in a reduced-precision format, initialise local variable and narrow it afterwards
+                    const bool reduced = (sg.getArchetype().getWUVarStorage(k) != SynapseGroup::VarStorage::NATIVE);
+                    const std::string storage = "group." + vars[k].name + "[" + varSubs["id_syn"] +  "]";
+                    if(reduced) {
+                        os << vars[k].type << " initVal;" << std::endl;
+                    }
+                    varSubs.addVarSubstitution("value", reduced ? "initVal" : storage);
                     varSubs.addParamValueSubstitution(varInit.getSnippet()->getParamNames(), varInit.getParams());
                     varSubs.addVarValueSubstitution(varInit.getSnippet()->getDerivedParams(), varInit.getDerivedParams());
 
                     std::string code = varInit.getSnippet()->getCode();
+                    if(reduced) {
+                        code += "\n" + storage + " = " + getWUVarStore(sg.getArchetype(), k, "initVal") + ";";
+                    }
                     varSubs.applyCheckUnreplaced(code, "initVar : merged" + vars[k].name + std::to_string(sg.getIndex()));
                     code = ensureFtype(code, ftype);
                     os << code << std::endl;
@@ -190,7 +199,8 @@ void genInitWUVarCode(CodeGenerator::CodeStream &os, const CodeGenerator::Backen
 // CodeGenerator
 //--------------------------------------------------------------------------
 void CodeGenerator::generateInit(CodeStream &os, const MergedEGPMap &mergedEGPs, const ModelSpecMerged &modelMerged,
-                                 const BackendBase &backend, bool standaloneModules)
+                                 const BackendBase &backend, bool standaloneModules,
+                                 BackendBase::ShardHandler shardHandler)
 {
     if(standaloneModules) {
         os << "#include \"runner.cc\"" << std::endl;
@@ -238,6 +248,34 @@ void CodeGenerator::generateInit(CodeStream &os, const MergedEGPMap &mergedEGPs,
                     });
             }
 
+            // If neuron group is event-driven, mark all neurons as awake and last updated the timestep before simulation starts
+            if(ng.getArchetype().isEventDriven()) {
+                const unsigned int numWakeQueueBuckets = backend.getNumWakeQueueBuckets();
+                backend.genVariableInit(os, "group.numNeurons", "id", popSubs,
+                    [numWakeQueueBuckets](CodeStream &os, Substitutions &varSubs)
+                    {
+                        os << "group.updT[" << varSubs["id"] << "] = -DT;" << std::endl;
+
+                        // If backend wakes neurons using a calendar queue, link all neurons into a list in the current timestep's bucket
+                        if(numWakeQueueBuckets > 0) {
+                            os << "group.wakePrev[" << varSubs["id"] << "] = (int)" << varSubs["id"] << " - 1;" << std::endl;
+                            os << "group.wakeNext[" << varSubs["id"] << "] = ((" << varSubs["id"] << " + 1) < group.numNeurons) ? (int)(" << varSubs["id"] << " + 1) : -1;" << std::endl;
+                            os << "group.wakeStep[" << varSubs["id"] << "] = iT;" << std::endl;
+                        }
+                        else {
+                            os << "group.wakeT[" << varSubs["id"] << "] = -TIME_MAX;" << std::endl;
+                        }
+                    });
+
+                if(numWakeQueueBuckets > 0) {
+                    backend.genVariableInit(os, std::to_string(numWakeQueueBuckets), "id", popSubs,
+                        [numWakeQueueBuckets](CodeStream &os, Substitutions &varSubs)
+                        {
+                            os << "group.wakeHead[" << varSubs["id"] << "] = (" << varSubs["id"] << " == (iT % " << numWakeQueueBuckets << ")) ? 0 : -1;" << std::endl;
+                        });
+                }
+            }
+
             // Initialise neuron variables
             genInitNeuronVarCode(os, backend, popSubs, ng.getArchetype().getNeuronModel()->getVars(), "", "numNeurons",
                                  ng.getArchetype().getNumDelaySlots(), ng.getIndex(), model.getPrecision(),
@@ -377,5 +415,6 @@ void CodeGenerator::generateInit(CodeStream &os, const MergedEGPMap &mergedEGPs,
         [&backend, &mergedEGPs](CodeStream &os)
         {
             genScalarEGPPush(os, mergedEGPs, "SynapseSparseInit", backend);
-        });
+        },
+        shardHandler);
 }
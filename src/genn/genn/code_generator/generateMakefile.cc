@@ -56,6 +56,10 @@ void CodeGenerator::generateMakefile(std::ostream &os, const BackendBase &backen
     backend.genMakefileCompileRule(os);
     os << std::endl;
 
+    // Rebuild objects if makefile (and hence compiler flags) change
+    os << "$(OBJECTS): Makefile" << std::endl;
+    os << std::endl;
+
     // Add dummy rule to handle missing .d files on first build
     os << "%.d: ;" << std::endl;
     os << std::endl;
@@ -38,7 +38,8 @@ void addNeuronModelSubstitutions(CodeGenerator::Substitutions &substitution, con
 // CodeGenerator
 //--------------------------------------------------------------------------
 void CodeGenerator::generateNeuronUpdate(CodeStream &os, const MergedEGPMap &mergedEGPs, const ModelSpecMerged &modelMerged,
-                                         const BackendBase &backend, bool standaloneModules)
+                                         const BackendBase &backend, bool standaloneModules,
+                                         BackendBase::ShardHandler shardHandler)
 {
     if(standaloneModules) {
         os << "#include \"runner.cc\"" << std::endl;
@@ -64,6 +65,21 @@ void CodeGenerator::generateNeuronUpdate(CodeStream &os, const MergedEGPMap &mer
             const ModelSpecInternal &model = modelMerged.getModel();
             const NeuronModels::Base *nm = ng.getArchetype().getNeuronModel();
 
+            // If neuron group is event-driven and backend doesn't wake neurons using a calendar
+            // queue, only update neurons with incoming synaptic input or which are due to wake
+            const bool wakeTimeCheck = (ng.getArchetype().isEventDriven() && backend.getNumWakeQueueBuckets() == 0);
+            if(wakeTimeCheck) {
+                os << "if(";
+                for(size_t i = 0; i < ng.getArchetype().getMergedInSyn().size(); i++) {
+                    os << "group.inSynInSyn" << i << "[" << popSubs["id"] << "] != 0 || ";
+                    if(ng.getArchetype().getMergedInSyn()[i].first->isDendriticDelayRequired()) {
+                        os << "group.denDelayInSyn" << i << "[(*group.denDelayPtrInSyn" << i << " * group.numNeurons) + " << popSubs["id"] << "] != 0 || ";
+                    }
+                }
+                os << popSubs["t"] << " >= group.wakeT[" << popSubs["id"] << "])";
+                os << CodeStream::OB(30);
+            }
+
             // Generate code to copy neuron state into local variable
             for(const auto &v : nm->getVars()) {
                 if(v.access == VarAccess::READ_ONLY) {
@@ -106,6 +122,23 @@ void CodeGenerator::generateNeuronUpdate(CodeStream &os, const MergedEGPMap &mer
             neuronSubs.addVarNameSubstitution(nm->getAdditionalInputVars());
             addNeuronModelSubstitutions(neuronSubs, ng.getArchetype());
 
+            // If neuron group is event-driven, apply any timesteps skipped since neuron was last updated
+            std::string cCode = nm->getCatchUpCode();
+            if(ng.getArchetype().isEventDriven() && !cCode.empty()) {
+                os << "const unsigned int elapsed = (unsigned int)(((" << popSubs["t"] << " - group.updT[" << popSubs["id"] << "]) / DT) - 0.5);" << std::endl;
+
+                Substitutions catchUpSubs(&neuronSubs);
+                catchUpSubs.addVarSubstitution("elapsed", "elapsed");
+                catchUpSubs.applyCheckUnreplaced(cCode, "catchUpCode : merged" + std::to_string(ng.getIndex()));
+                cCode = ensureFtype(cCode, model.getPrecision());
+
+                os << "if(elapsed > 0)";
+                {
+                    CodeStream::Scope b(os);
+                    os << cCode << std::endl;
+                }
+            }
+
             // Initialise any additional input variables supported by neuron model
             for (const auto &a : nm->getAdditionalInputVars()) {
                 // Apply substitutions to value
@@ -186,6 +219,15 @@ void CodeGenerator::generateNeuronUpdate(CodeStream &os, const MergedEGPMap &mer
                     os << CodeStream::CB(29) << " // namespace bracket closed" << std::endl;
                 }
 
+                // If neuron group is event-driven, flush small inSyn values to zero so neurons can become quiescent
+                if(ng.getArchetype().isEventDriven()) {
+                    os << "if(fabs(linSyn) < group.inSynThreshold)";
+                    {
+                        CodeStream::Scope b(os);
+                        os << "linSyn = " << model.scalarExpr(0.0) << ";" << std::endl;
+                    }
+                }
+
                 // Write back linSyn
                 os << "group.inSynInSyn"  << i << "[" << inSynSubs["id"] << "] = linSyn;" << std::endl;
 
@@ -395,6 +437,29 @@ void CodeGenerator::generateNeuronUpdate(CodeStream &os, const MergedEGPMap &mer
                     os << popSubs["id"] << "] = l" << v.name << ";" << std::endl;
                 }
             }
+
+            // If neuron group is event-driven, record update time and calculate how many timesteps neuron can be skipped for
+            // **NOTE** backends which wake neurons using a calendar queue use quiescentSteps to schedule the neuron after this code
+            if(ng.getArchetype().isEventDriven()) {
+                os << "unsigned int quiescentSteps = 0;" << std::endl;
+                {
+                    CodeStream::Scope b(os);
+                    Substitutions quiescentSubs(&neuronSubs);
+                    quiescentSubs.addVarSubstitution("quiescentSteps", "quiescentSteps");
+
+                    std::string qCode = nm->getQuiescentStepsCode();
+                    quiescentSubs.applyCheckUnreplaced(qCode, "quiescentStepsCode : merged" + std::to_string(ng.getIndex()));
+                    qCode = ensureFtype(qCode, model.getPrecision());
+                    os << qCode << std::endl;
+                }
+                os << "group.updT[" << popSubs["id"] << "] = " << popSubs["t"] << ";" << std::endl;
+
+                // **NOTE** wake time is half a timestep early so rounding of t cannot cause a timestep to be missed
+                if(wakeTimeCheck) {
+                    os << "group.wakeT[" << popSubs["id"] << "] = " << popSubs["t"] << " + (DT * (quiescentSteps + 0.5));" << std::endl;
+                    os << CodeStream::CB(30);
+                }
+            }
         },
         // WU var update handler
         [&backend, &modelMerged](CodeStream &os, const NeuronGroupMerged &ng, Substitutions &popSubs)
@@ -499,5 +564,6 @@ void CodeGenerator::generateNeuronUpdate(CodeStream &os, const MergedEGPMap &mer
         [&backend, &mergedEGPs](CodeStream &os)
         {
             genScalarEGPPush(os, mergedEGPs, "NeuronUpdate", backend);
-        });
+        },
+        shardHandler);
 }
@@ -3,6 +3,8 @@
 // Standard C++ includes
 #include <sstream>
 #include <string>
+#include <tuple>
+#include <vector>
 
 // GeNN includes
 #include "gennUtils.h"
@@ -23,6 +25,12 @@ using namespace CodeGenerator;
 //--------------------------------------------------------------------------
 namespace
 {
+// Version of the checkpoint file format written by saveState
+const unsigned int checkpointVersion = 1;
+
+// Version of the connectivity file format read by loadConnectivityFromFile
+const unsigned int connectivityFileVersion = 1;
+
 enum class MergedSynapseStruct
 {
     PresynapticUpdate,
@@ -31,6 +39,9 @@ enum class MergedSynapseStruct
     DenseInit,
     SparseInit,
 };
+
+//! Population name, type of update and merged group index of each performance counter
+typedef std::vector<std::tuple<std::string, std::string, size_t>> PerformanceCounters;
 void genTypeRange(CodeStream &os, const std::string &precision, const std::string &prefix)
 {
     os << "#define " << prefix << "_MIN ";
@@ -144,23 +155,61 @@ void orderNeuronGroupChildren(const NeuronGroupMerged &m, std::vector<std::vecto
     orderNeuronGroupChildren(m, archetypeChildren, sortedGroupChildren, getVectorFunc, isCompatibleFunc);
 }
 
+//-------------------------------------------------------------------------
+template<typename T>
+void addPerformanceCounterField(MergedStructGenerator<T> &gen, const T &m, const std::string &type, PerformanceCounters *perfCounters)
+{
+    if(perfCounters != nullptr) {
+        // Give each group in merged group the index of the next performance counter
+        const size_t firstCounter = perfCounters->size();
+        gen.addField("unsigned int", "perfCounter",
+                     [firstCounter](const typename T::GroupInternal&, size_t i){ return std::to_string(firstCounter + i); });
+
+        // Add counters
+        for(const auto &g : m.getGroups()) {
+            perfCounters->emplace_back(g.get().getName(), type, m.getIndex());
+        }
+    }
+}
+//-------------------------------------------------------------------------
+void addSparseConnectivityFields(MergedSynapseStructGenerator &gen, const SynapseGroupMerged &m, const BackendBase &backend)
+{
+    // **NOTE** if backend accesses host arrays directly, these are treated like pointer EGPs
+    // so loadConnectivityFromFile can replace them with memory-mapped connectivity files
+    const auto fieldType = backend.isArrayMappingSupported() ? MergedSynapseStructGenerator::FieldType::PointerEGP
+                                                             : MergedSynapseStructGenerator::FieldType::Standard;
+    gen.addField("unsigned int*", "rowLength",
+                 [&backend](const SynapseGroupInternal &sg, size_t){ return backend.getArrayPrefix() + "rowLength" + sg.getName(); },
+                 fieldType);
+    gen.addField(m.getArchetype().getSparseIndType() + "*", "ind",
+                 [&backend](const SynapseGroupInternal &sg, size_t){ return backend.getArrayPrefix() + "ind" + sg.getName(); },
+                 fieldType);
+}
 //-------------------------------------------------------------------------
 void genMergedNeuronStruct(const BackendBase &backend, CodeStream &definitionsInternal,
                            CodeStream &definitionsInternalFunc, CodeStream &runnerVarAlloc,
                            MergedEGPMap &mergedEGPs, const NeuronGroupMerged &m,
-                           const std::string &precision, const std::string &timePrecision, bool init)
+                           const std::string &precision, const std::string &timePrecision, unsigned int batchSize, bool init,
+                           PerformanceCounters *perfCounters = nullptr)
 {
-    MergedNeuronStructGenerator gen(m);
+    MergedNeuronStructGenerator gen(m, batchSize);
+    addPerformanceCounterField(gen, m, "neuronUpdate", perfCounters);
 
     gen.addField("unsigned int", "numNeurons",
                  [](const NeuronGroupInternal &ng, size_t){ return std::to_string(ng.getNumNeurons()); });
 
-    gen.addPointerField("unsigned int", "spkCnt", backend.getArrayPrefix() + "glbSpkCnt");
-    gen.addPointerField("unsigned int", "spk", backend.getArrayPrefix() + "glbSpk");
+    // Get strides between batches of arrays with and without delay slots
+    const std::string numDelaySlots = std::to_string(m.getArchetype().getNumDelaySlots());
+    const std::string neuronStride = "group.numNeurons";
+    const std::string delayedNeuronStride = "group.numNeurons * " + numDelaySlots;
+
+    const bool trueSpikeDelay = m.getArchetype().isTrueSpikeRequired();
+    gen.addPointerField("unsigned int", "spkCnt", backend.getArrayPrefix() + "glbSpkCnt", trueSpikeDelay ? numDelaySlots : "1");
+    gen.addPointerField("unsigned int", "spk", backend.getArrayPrefix() + "glbSpk", trueSpikeDelay ? delayedNeuronStride : neuronStride);
 
     if(m.getArchetype().isSpikeEventRequired()) {
-        gen.addPointerField("unsigned int", "spkCntEvnt", backend.getArrayPrefix() + "glbSpkCntEvnt");
-        gen.addPointerField("unsigned int", "spkEvnt", backend.getArrayPrefix() + "glbSpkEvnt");
+        gen.addPointerField("unsigned int", "spkCntEvnt", backend.getArrayPrefix() + "glbSpkCntEvnt", numDelaySlots);
+        gen.addPointerField("unsigned int", "spkEvnt", backend.getArrayPrefix() + "glbSpkEvnt", delayedNeuronStride);
     }
 
     if(m.getArchetype().isDelayRequired()) {
@@ -172,20 +221,56 @@ void genMergedNeuronStruct(const BackendBase &backend, CodeStream &definitionsIn
     }
 
     if(m.getArchetype().isSpikeTimeRequired()) {
-        gen.addPointerField(timePrecision, "sT", backend.getArrayPrefix() + "sT");
+        gen.addPointerField(timePrecision, "sT", backend.getArrayPrefix() + "sT", delayedNeuronStride);
+    }
+
+    if(m.getArchetype().isEventDriven()) {
+        gen.addPointerField(timePrecision, "updT", backend.getArrayPrefix() + "updT", neuronStride);
+
+        // If backend supports it, add pointers to calendar queue used to wake neurons, otherwise to neurons' wake times
+        if(backend.getNumWakeQueueBuckets() > 0) {
+            gen.addPointerField("int", "wakeHead", backend.getArrayPrefix() + "wakeHead", std::to_string(backend.getNumWakeQueueBuckets()));
+            gen.addPointerField("int", "wakeNext", backend.getArrayPrefix() + "wakeNext", neuronStride);
+            gen.addPointerField("int", "wakePrev", backend.getArrayPrefix() + "wakePrev", neuronStride);
+            gen.addPointerField("unsigned long long", "wakeStep", backend.getArrayPrefix() + "wakeStep", neuronStride);
+        }
+        else {
+            gen.addPointerField(timePrecision, "wakeT", backend.getArrayPrefix() + "wakeT", neuronStride);
+        }
+
+        if(!init) {
+            gen.addField(precision, "inSynThreshold",
+                         [](const NeuronGroupInternal &ng, size_t){ return Utils::writePreciseString(ng.getEventDrivenInSynThreshold()); });
+        }
     }
 
     if(backend.isPopulationRNGRequired() && m.getArchetype().isSimRNGRequired()) {
-        gen.addPointerField("curandState", "rng", backend.getArrayPrefix() + "rng");
+        gen.addPointerField("curandState", "rng", backend.getArrayPrefix() + "rng", neuronStride);
     }
 
     // Add pointers to variables
     const NeuronModels::Base *nm = m.getArchetype().getNeuronModel();
-    gen.addVars(nm->getVars(), backend.getArrayPrefix());
+    const auto vars = nm->getVars();
+    for(size_t i = 0; i < vars.size(); i++) {
+        gen.addPointerField(vars[i].type, vars[i].name, backend.getArrayPrefix() + vars[i].name,
+                            m.getArchetype().isVarQueueRequired(i) ? delayedNeuronStride : neuronStride);
+    }
 
     // Extra global parameters are not required for init
     if(!init) {
         gen.addEGPs(nm->getExtraGlobalParams());
+
+        // If spike recording is enabled, add pointer to recording buffer
+        // **NOTE** this is treated like a pointer EGP as buffers are only allocated when allocateRecordingBuffers is called
+        if(m.getArchetype().isSpikeRecordingEnabled()) {
+            gen.addField("uint32_t*", "recordSpk",
+                         [&backend](const NeuronGroupInternal &ng, size_t)
+                         {
+                             return backend.getArrayPrefix() + "recordSpk" + ng.getName();
+                         },
+                         MergedNeuronStructGenerator::FieldType::PointerEGP,
+                         "numRecordingTimesteps * ((group.numNeurons + 31) / 32)");
+        }
     }
 
     // Build vector of vectors containin each child group's merged in syns, ordered to match those of the archetype group
@@ -203,11 +288,12 @@ void genMergedNeuronStruct(const BackendBase &backend, CodeStream &definitionsIn
         const SynapseGroupInternal *sg = m.getArchetype().getMergedInSyn()[i].first;
 
         // Add pointer to insyn
-        gen.addMergedInSynPointerField(precision, "inSynInSyn", i, backend.getArrayPrefix() + "inSyn", sortedMergedInSyns);
+        gen.addMergedInSynPointerField(precision, "inSynInSyn", i, backend.getArrayPrefix() + "inSyn", sortedMergedInSyns, neuronStride);
 
         // Add pointer to dendritic delay buffer if required
         if (sg->isDendriticDelayRequired()) {
-            gen.addMergedInSynPointerField(precision, "denDelayInSyn", i, backend.getArrayPrefix() + "denDelay", sortedMergedInSyns);
+            gen.addMergedInSynPointerField(precision, "denDelayInSyn", i, backend.getArrayPrefix() + "denDelay", sortedMergedInSyns,
+                                           std::to_string(sg->getMaxDendriticDelayTimesteps()) + " * group.numNeurons");
 
             gen.addField("volatile unsigned int*", "denDelayPtrInSyn" + std::to_string(i),
                          [&backend, &sortedMergedInSyns, i](const NeuronGroupInternal&, size_t groupIndex)
@@ -219,7 +305,7 @@ void genMergedNeuronStruct(const BackendBase &backend, CodeStream &definitionsIn
         // Add pointers to state variables
         if (sg->getMatrixType() & SynapseMatrixWeight::INDIVIDUAL_PSM) {
             for(const auto &v : sg->getPSModel()->getVars()) {
-                gen.addMergedInSynPointerField(v.type, v.name + "InSyn", i, backend.getArrayPrefix() + v.name, sortedMergedInSyns);
+                gen.addMergedInSynPointerField(v.type, v.name + "InSyn", i, backend.getArrayPrefix() + v.name, sortedMergedInSyns, neuronStride);
             }
         }
 
@@ -244,7 +330,7 @@ void genMergedNeuronStruct(const BackendBase &backend, CodeStream &definitionsIn
         const auto *cs = m.getArchetype().getCurrentSources()[i];
 
         for(const auto &v : cs->getCurrentSourceModel()->getVars()) {
-            gen.addCurrentSourcePointerField(v.type, v.name + "CS", i, backend.getArrayPrefix() + v.name, sortedCurrentSources);
+            gen.addCurrentSourcePointerField(v.type, v.name + "CS", i, backend.getArrayPrefix() + v.name, sortedCurrentSources, neuronStride);
         }
 
         if(!init) {
@@ -274,8 +360,9 @@ void genMergedNeuronStruct(const BackendBase &backend, CodeStream &definitionsIn
     for(size_t i = 0; i < inSynWithPostCode.size(); i++) {
         const auto *sg = inSynWithPostCode[i];
 
+        const std::string stride = (sg->getBackPropDelaySteps() == NO_DELAY) ? neuronStride : delayedNeuronStride;
         for(const auto &v : sg->getWUModel()->getPostVars()) {
-            gen.addSynPointerField(v.type, v.name + "WUPost", i, backend.getArrayPrefix() + v.name, sortedInSynWithPostCode);
+            gen.addSynPointerField(v.type, v.name + "WUPost", i, backend.getArrayPrefix() + v.name, sortedInSynWithPostCode, stride);
         }
     }
 
@@ -293,8 +380,9 @@ void genMergedNeuronStruct(const BackendBase &backend, CodeStream &definitionsIn
     for(size_t i = 0; i < outSynWithPreCode.size(); i++) {
         const auto *sg = outSynWithPreCode[i];
 
+        const std::string stride = (sg->getDelaySteps() == NO_DELAY) ? neuronStride : delayedNeuronStride;
         for(const auto &v : sg->getWUModel()->getPreVars()) {
-            gen.addSynPointerField(v.type, v.name + "WUPre", i, backend.getArrayPrefix() + v.name, sortedOutSynWithPreCode);
+            gen.addSynPointerField(v.type, v.name + "WUPre", i, backend.getArrayPrefix() + v.name, sortedOutSynWithPreCode, stride);
         }
     }
 
@@ -339,18 +427,41 @@ void genMergedNeuronStruct(const BackendBase &backend, CodeStream &definitionsIn
 void genMergedSynapseStruct(const BackendBase &backend, CodeStream &definitionsInternal,
                             CodeStream &definitionsInternalFunc, CodeStream &runnerVarAlloc,
                             MergedEGPMap &mergedEGPs, const SynapseGroupMerged &m,
-                            const std::string &precision, const std::string &timePrecision, const std::string &name, MergedSynapseStruct role)
+                            const std::string &precision, const std::string &timePrecision, const std::string &name,
+                            MergedSynapseStruct role, unsigned int batchSize, PerformanceCounters *perfCounters = nullptr)
 {
     const bool updateRole = ((role == MergedSynapseStruct::PresynapticUpdate)
                              || (role == MergedSynapseStruct::PostsynapticUpdate)
                              || (role == MergedSynapseStruct::SynapseDynamics));
     const WeightUpdateModels::Base *wum = m.getArchetype().getWUModel();
 
-    MergedSynapseStructGenerator gen(m);
+    MergedSynapseStructGenerator gen(m, batchSize);
+    if(updateRole) {
+        std::string type = "synapseDynamics";
+        if(role == MergedSynapseStruct::PresynapticUpdate) {
+            type = "presynapticUpdate";
+        }
+        else if(role == MergedSynapseStruct::PostsynapticUpdate) {
+            type = "postsynapticUpdate";
+        }
+        addPerformanceCounterField(gen, m, type, perfCounters);
+    }
+
+    // Get strides between batches of source and target neuron arrays with and without delay slots
+    const NeuronGroupInternal *srcNG = m.getArchetype().getSrcNeuronGroup();
+    const NeuronGroupInternal *trgNG = m.getArchetype().getTrgNeuronGroup();
+    const std::string srcDelaySlots = std::to_string(srcNG->getNumDelaySlots());
+    const std::string trgDelaySlots = std::to_string(trgNG->getNumDelaySlots());
+    const std::string srcStride = "group.numSrcNeurons";
+    const std::string trgStride = "group.numTrgNeurons";
+    const std::string srcDelayedStride = "group.numSrcNeurons * " + srcDelaySlots;
+    const std::string trgDelayedStride = "group.numTrgNeurons * " + trgDelaySlots;
 
     gen.addField("unsigned int", "rowStride",
                  [m, &backend](const SynapseGroupInternal &sg, size_t){ return std::to_string(backend.getSynapticMatrixRowStride(sg)); });
-    if(role == MergedSynapseStruct::PostsynapticUpdate || role == MergedSynapseStruct::SparseInit){
+    if(role == MergedSynapseStruct::PostsynapticUpdate || role == MergedSynapseStruct::SparseInit
+       || (role == MergedSynapseStruct::PresynapticUpdate && backend.isPostsynapticRemapRequired(m.getArchetype())))
+    {
         gen.addField("unsigned int", "colStride",
                      [m](const SynapseGroupInternal &sg, size_t) { return std::to_string(sg.getMaxSourceConnections()); });
     }
@@ -363,7 +474,8 @@ void genMergedSynapseStruct(const BackendBase &backend, CodeStream &definitionsI
     // If this role is one where postsynaptic input can be provided
     if(role == MergedSynapseStruct::PresynapticUpdate || role == MergedSynapseStruct::SynapseDynamics) {
         if(m.getArchetype().isDendriticDelayRequired()) {
-            gen.addPSPointerField(precision, "denDelay", backend.getArrayPrefix() + "denDelay");
+            gen.addPSPointerField(precision, "denDelay", backend.getArrayPrefix() + "denDelay",
+                                  std::to_string(m.getArchetype().getMaxDendriticDelayTimesteps()) + " * " + trgStride);
             gen.addField("volatile unsigned int*", "denDelayPtr",
                          [&backend](const SynapseGroupInternal &sg, size_t)
                          { 
@@ -371,24 +483,38 @@ void genMergedSynapseStruct(const BackendBase &backend, CodeStream &definitionsI
                          });
         }
         else {
-            gen.addPSPointerField(precision, "inSyn", backend.getArrayPrefix() + "inSyn");
+            gen.addPSPointerField(precision, "inSyn", backend.getArrayPrefix() + "inSyn", trgStride);
+        }
+
+        // If target neurons are event-driven and woken using a calendar queue, add pointers to it so they can be scheduled when input arrives
+        if(trgNG->isEventDriven() && backend.getNumWakeQueueBuckets() > 0) {
+            gen.addTrgPointerField("int", "trgWakeHead", backend.getArrayPrefix() + "wakeHead", std::to_string(backend.getNumWakeQueueBuckets()));
+            gen.addTrgPointerField("int", "trgWakeNext", backend.getArrayPrefix() + "wakeNext", trgStride);
+            gen.addTrgPointerField("int", "trgWakePrev", backend.getArrayPrefix() + "wakePrev", trgStride);
+            gen.addTrgPointerField("unsigned long long", "trgWakeStep", backend.getArrayPrefix() + "wakeStep", trgStride);
         }
     }
 
     if(role == MergedSynapseStruct::PresynapticUpdate) {
         if(m.getArchetype().isTrueSpikeRequired()) {
-            gen.addSrcPointerField("unsigned int", "srcSpkCnt", backend.getArrayPrefix() + "glbSpkCnt");
-            gen.addSrcPointerField("unsigned int", "srcSpk", backend.getArrayPrefix() + "glbSpk");
+            const bool srcTrueSpikeDelay = srcNG->isTrueSpikeRequired();
+            gen.addSrcPointerField("unsigned int", "srcSpkCnt", backend.getArrayPrefix() + "glbSpkCnt",
+                                   srcTrueSpikeDelay ? srcDelaySlots : "1");
+            gen.addSrcPointerField("unsigned int", "srcSpk", backend.getArrayPrefix() + "glbSpk",
+                                   srcTrueSpikeDelay ? srcDelayedStride : srcStride);
         }
 
         if(m.getArchetype().isSpikeEventRequired()) {
-            gen.addSrcPointerField("unsigned int", "srcSpkCntEvnt", backend.getArrayPrefix() + "glbSpkCntEvnt");
-            gen.addSrcPointerField("unsigned int", "srcSpkEvnt", backend.getArrayPrefix() + "glbSpkEvnt");
+            gen.addSrcPointerField("unsigned int", "srcSpkCntEvnt", backend.getArrayPrefix() + "glbSpkCntEvnt", srcDelaySlots);
+            gen.addSrcPointerField("unsigned int", "srcSpkEvnt", backend.getArrayPrefix() + "glbSpkEvnt", srcDelayedStride);
         }
     }
     else if(role == MergedSynapseStruct::PostsynapticUpdate) {
-        gen.addTrgPointerField("unsigned int", "trgSpkCnt", backend.getArrayPrefix() + "glbSpkCnt");
-        gen.addTrgPointerField("unsigned int", "trgSpk", backend.getArrayPrefix() + "glbSpk");
+        const bool trgTrueSpikeDelay = trgNG->isTrueSpikeRequired();
+        gen.addTrgPointerField("unsigned int", "trgSpkCnt", backend.getArrayPrefix() + "glbSpkCnt",
+                               trgTrueSpikeDelay ? trgDelaySlots : "1");
+        gen.addTrgPointerField("unsigned int", "trgSpk", backend.getArrayPrefix() + "glbSpk",
+                               trgTrueSpikeDelay ? trgDelayedStride : trgStride);
     }
 
     // If this structure is used for updating rather than initializing
@@ -421,7 +547,8 @@ void genMergedSynapseStruct(const BackendBase &backend, CodeStream &definitionsI
         for(const auto &v : preVars) {
             // If variable is referenced in code string, add source pointer
             if(code.find("$(" + v.name + "_pre)") != std::string::npos) {
-                gen.addSrcPointerField(v.type, v.name + "Pre", backend.getArrayPrefix() + v.name);
+                gen.addSrcPointerField(v.type, v.name + "Pre", backend.getArrayPrefix() + v.name,
+                                       srcNG->isVarQueueRequired(v.name) ? srcDelayedStride : srcStride);
             }
         }
 
@@ -430,7 +557,8 @@ void genMergedSynapseStruct(const BackendBase &backend, CodeStream &definitionsI
         for(const auto &v : postVars) {
             // If variable is referenced in code string, add target pointer
             if(code.find("$(" + v.name + "_post)") != std::string::npos) {
-                gen.addTrgPointerField(v.type, v.name + "Post", backend.getArrayPrefix() + v.name);
+                gen.addTrgPointerField(v.type, v.name + "Post", backend.getArrayPrefix() + v.name,
+                                       trgNG->isVarQueueRequired(v.name) ? trgDelayedStride : trgStride);
             }
         }
 
@@ -452,28 +580,41 @@ void genMergedSynapseStruct(const BackendBase &backend, CodeStream &definitionsI
 
         // Add spike times if required
         if(wum->isPreSpikeTimeRequired()) {
-            gen.addSrcPointerField(timePrecision, "sTPre", backend.getArrayPrefix() + "sT");
+            gen.addSrcPointerField(timePrecision, "sTPre", backend.getArrayPrefix() + "sT", srcDelayedStride);
         }
         if(wum->isPostSpikeTimeRequired()) {
-            gen.addTrgPointerField(timePrecision, "sTPost", backend.getArrayPrefix() + "sT");
+            gen.addTrgPointerField(timePrecision, "sTPost", backend.getArrayPrefix() + "sT", trgDelayedStride);
         }
 
         // Add pre and postsynaptic variables to struct
-        gen.addVars(wum->getPreVars(), backend.getArrayPrefix());
-        gen.addVars(wum->getPostVars(), backend.getArrayPrefix());
+        gen.addVars(wum->getPreVars(), backend.getArrayPrefix(),
+                    (m.getArchetype().getDelaySteps() == NO_DELAY) ? srcStride : srcDelayedStride);
+        gen.addVars(wum->getPostVars(), backend.getArrayPrefix(),
+                    (m.getArchetype().getBackPropDelaySteps() == NO_DELAY) ? trgStride : trgDelayedStride);
 
         // Add EGPs to struct
         gen.addEGPs(wum->getExtraGlobalParams());
     }
 
     // Add pointers to connectivity data
-    if(m.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
-        gen.addPointerField("unsigned int", "rowLength", backend.getArrayPrefix() + "rowLength");
-        gen.addPointerField(m.getArchetype().getSparseIndType(),"ind", backend.getArrayPrefix() + "ind");
+    if((m.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE)
+       || (m.getArchetype().getMatrixType() & SynapseMatrixConnectivity::CSR))
+    {
+        if(m.getArchetype().getMatrixType() & SynapseMatrixConnectivity::CSR) {
+            gen.addField("unsigned int", "maxTotalConnections",
+                         [](const SynapseGroupInternal &sg, size_t){ return std::to_string(sg.getMaxTotalConnections()); });
+            gen.addPointerField("unsigned int", "rowPtr", backend.getArrayPrefix() + "rowPtr");
+            gen.addPointerField(m.getArchetype().getSparseIndType(),"ind", backend.getArrayPrefix() + "ind");
+        }
+        else {
+            addSparseConnectivityFields(gen, m, backend);
+        }
 
         // Add additional structure for postsynaptic access
-        if(backend.isPostsynapticRemapRequired() && !wum->getLearnPostCode().empty()
-           && (role == MergedSynapseStruct::PostsynapticUpdate || role == MergedSynapseStruct::SparseInit))
+        // **NOTE** backends may also use this to gather presynaptic input target-by-target
+        if(backend.isPostsynapticRemapRequired(m.getArchetype())
+           && (role == MergedSynapseStruct::PostsynapticUpdate || role == MergedSynapseStruct::SparseInit
+               || role == MergedSynapseStruct::PresynapticUpdate))
         {
             gen.addPointerField("unsigned int", "colLength", backend.getArrayPrefix() + "colLength");
             gen.addPointerField("unsigned int", "remap", backend.getArrayPrefix() + "remap");
@@ -495,7 +636,19 @@ void genMergedSynapseStruct(const BackendBase &backend, CodeStream &definitionsI
 
     // Add pointers to var pointers to struct
     if(m.getArchetype().getMatrixType() & SynapseMatrixWeight::INDIVIDUAL) {
-        gen.addVars(wum->getVars(), backend.getArrayPrefix());
+        // **NOTE** variables are stored using their storage type which may differ from the declared type
+        const auto vars = wum->getVars();
+        for(size_t i = 0; i < vars.size(); i++) {
+            gen.addPointerField(m.getArchetype().getWUVarStorageType(i), vars[i].name, backend.getArrayPrefix() + vars[i].name,
+                                (m.getArchetype().getMatrixType() & SynapseMatrixConnectivity::CSR) ? "group.maxTotalConnections" : "group.numSrcNeurons * group.rowStride");
+
+            // If variable is stored in a fixed point format, add its scale so groups which only differ in scale can be merged
+            const auto storage = m.getArchetype().getWUVarStorage(i);
+            if(storage == SynapseGroup::VarStorage::FIXED8 || storage == SynapseGroup::VarStorage::FIXED16) {
+                gen.addField(precision, vars[i].name + "StorageScale",
+                             [i](const SynapseGroupInternal &sg, size_t){ return Utils::writePreciseString(sg.getWUVarStorageScale(i)); });
+            }
+        }
     }
 
     // Generate structure definitions and instantiation
@@ -705,6 +858,484 @@ void genExtraGlobalParam(const BackendBase &backend, CodeStream &definitionsVar,
 
     }
 }
+//-------------------------------------------------------------------------
+void genCheckpointRecordHelpers(CodeStream &os)
+{
+    os << "// ------------------------------------------------------------------------" << std::endl;
+    os << "// checkpointing helpers" << std::endl;
+    os << "// ------------------------------------------------------------------------" << std::endl;
+    os << "namespace" << std::endl;
+    os << "{" << std::endl;
+    os << "const char checkpointMagic[8] = {'G', 'E', 'N', 'N', 'C', 'K', 'P', 'T'};" << std::endl;
+    os << "const uint32_t checkpointVersion = " << checkpointVersion << ";" << std::endl;
+    os << std::endl;
+    os << "// Records are streamed in chunks of at most this size" << std::endl;
+    os << "const uint64_t checkpointChunkBytes = 64 * 1024 * 1024;" << std::endl;
+    os << std::endl;
+
+    os << "void writeCheckpointRecordHeader(std::ostream &os, const char *name, uint64_t bytes)";
+    {
+        CodeStream::Scope b(os);
+        os << "const uint32_t nameLength = (uint32_t)strlen(name);" << std::endl;
+        os << "os.write(reinterpret_cast<const char*>(&nameLength), sizeof(uint32_t));" << std::endl;
+        os << "os.write(name, nameLength);" << std::endl;
+        os << "os.write(reinterpret_cast<const char*>(&bytes), sizeof(uint64_t));" << std::endl;
+    }
+    os << std::endl;
+
+    os << "void writeCheckpointRecordData(std::ostream &os, const void *data, uint64_t bytes)";
+    {
+        CodeStream::Scope b(os);
+        os << "const char *dataBytes = reinterpret_cast<const char*>(data);" << std::endl;
+        os << "for(uint64_t offset = 0; offset < bytes; offset += checkpointChunkBytes)";
+        {
+            CodeStream::Scope b(os);
+            os << "os.write(dataBytes + offset, (std::streamsize)std::min(checkpointChunkBytes, bytes - offset));" << std::endl;
+        }
+        os << "if(!os.good())";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Error writing checkpoint\");" << std::endl;
+        }
+    }
+    os << std::endl;
+
+    os << "void writeCheckpointRecord(std::ostream &os, const char *name, const void *data, uint64_t bytes)";
+    {
+        CodeStream::Scope b(os);
+        os << "writeCheckpointRecordHeader(os, name, bytes);" << std::endl;
+        os << "writeCheckpointRecordData(os, data, bytes);" << std::endl;
+    }
+    os << std::endl;
+
+    os << "uint64_t readCheckpointRecordHeader(std::istream &is, const char *name)";
+    {
+        CodeStream::Scope b(os);
+        os << "uint32_t nameLength = 0;" << std::endl;
+        os << "is.read(reinterpret_cast<char*>(&nameLength), sizeof(uint32_t));" << std::endl;
+        os << "std::string recordName(is.good() ? nameLength : 0, '\\0');" << std::endl;
+        os << "is.read(&recordName[0], recordName.size());" << std::endl;
+        os << "uint64_t bytes = 0;" << std::endl;
+        os << "is.read(reinterpret_cast<char*>(&bytes), sizeof(uint64_t));" << std::endl;
+        os << "if(!is.good())";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Unexpected end of checkpoint reading '\" + std::string(name) + \"'\");" << std::endl;
+        }
+        os << "if(recordName != name)";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Checkpoint record '\" + recordName + \"' found where '\" + std::string(name) + \"' expected\");" << std::endl;
+        }
+        os << "return bytes;" << std::endl;
+    }
+    os << std::endl;
+
+    os << "void readCheckpointRecordData(std::istream &is, void *data, uint64_t bytes)";
+    {
+        CodeStream::Scope b(os);
+        os << "char *dataBytes = reinterpret_cast<char*>(data);" << std::endl;
+        os << "for(uint64_t offset = 0; offset < bytes; offset += checkpointChunkBytes)";
+        {
+            CodeStream::Scope b(os);
+            os << "is.read(dataBytes + offset, (std::streamsize)std::min(checkpointChunkBytes, bytes - offset));" << std::endl;
+        }
+        os << "if(!is.good())";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Unexpected end of checkpoint\");" << std::endl;
+        }
+    }
+    os << std::endl;
+
+    os << "void readCheckpointRecord(std::istream &is, const char *name, void *data, uint64_t bytes)";
+    {
+        CodeStream::Scope b(os);
+        os << "if(readCheckpointRecordHeader(is, name) != bytes)";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Checkpoint record '\" + std::string(name) + \"' has incorrect size\");" << std::endl;
+        }
+        os << "readCheckpointRecordData(is, data, bytes);" << std::endl;
+    }
+    os << "}   // Anonymous namespace" << std::endl;
+    os << std::endl;
+}
+//-------------------------------------------------------------------------
+bool isConnectivityFileLoadable(const SynapseGroupInternal &sg)
+{
+    return ((sg.getMatrixType() & SynapseMatrixConnectivity::SPARSE) && (sg.getSparseConnectivityLocation() & VarLocation::HOST));
+}
+//-------------------------------------------------------------------------
+bool isConnectivityFileLoadable(const ModelSpecInternal &model)
+{
+    return std::any_of(model.getSynapseGroups().cbegin(), model.getSynapseGroups().cend(),
+                       [](const ModelSpec::SynapseGroupValueType &s){ return isConnectivityFileLoadable(s.second); });
+}
+//-------------------------------------------------------------------------
+void genConnectivityFileHelpers(CodeStream &os, const BackendBase &backend)
+{
+    os << "// ------------------------------------------------------------------------" << std::endl;
+    os << "// connectivity file helpers" << std::endl;
+    os << "// ------------------------------------------------------------------------" << std::endl;
+
+    // If backend uses host arrays directly, connectivity files are memory-mapped, otherwise they are read into existing arrays
+#ifdef _WIN32
+    const bool mapping = false;
+#else
+    const bool mapping = backend.isArrayMappingSupported();
+#endif
+    if(mapping) {
+        os << "#include <fcntl.h>" << std::endl;
+        os << "#include <sys/mman.h>" << std::endl;
+        os << "#include <sys/stat.h>" << std::endl;
+        os << "#include <unistd.h>" << std::endl;
+        os << std::endl;
+    }
+    os << "namespace" << std::endl;
+    os << "{" << std::endl;
+    os << "// Header of connectivity file, followed by row lengths and padded target indices laid out exactly as in memory" << std::endl;
+    os << "struct ConnectivityFileHeader";
+    {
+        CodeStream::Scope b(os);
+        os << "char magic[4];" << std::endl;
+        os << "uint32_t version;" << std::endl;
+        os << "uint32_t numPre;" << std::endl;
+        os << "uint32_t numPost;" << std::endl;
+        os << "uint32_t maxRowLength;" << std::endl;
+        os << "uint32_t indBytes;" << std::endl;
+        os << "uint64_t reserved;" << std::endl;
+    }
+    os << ";" << std::endl;
+    os << std::endl;
+
+    os << "void checkConnectivityFileHeader(const ConnectivityFileHeader &header, uint64_t fileBytes, const char *path, uint32_t numPre, uint32_t numPost, uint32_t maxRowLength, uint32_t indBytes)";
+    {
+        CodeStream::Scope b(os);
+        os << "const std::string pathString(path);" << std::endl;
+        os << "if(memcmp(header.magic, \"GCON\", 4) != 0 || header.version != " << connectivityFileVersion << ")";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"'\" + pathString + \"' is not a version " << connectivityFileVersion << " GeNN connectivity file\");" << std::endl;
+        }
+        os << "if(header.numPre != numPre || header.numPost != numPost)";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Connectivity in '\" + pathString + \"' connects \" + std::to_string(header.numPre) + \" to \" + std::to_string(header.numPost)";
+            os << " + \" neurons but synapse group connects \" + std::to_string(numPre) + \" to \" + std::to_string(numPost));" << std::endl;
+        }
+        os << "if(header.maxRowLength != maxRowLength)";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Connectivity in '\" + pathString + \"' has maximum row length \" + std::to_string(header.maxRowLength)";
+            os << " + \" but synapse group has maximum row length \" + std::to_string(maxRowLength));" << std::endl;
+        }
+        os << "if(header.indBytes != indBytes)";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Connectivity in '\" + pathString + \"' has \" + std::to_string(header.indBytes)";
+            os << " + \" byte indices but synapse group has \" + std::to_string(indBytes) + \" byte indices\");" << std::endl;
+        }
+        os << "if(fileBytes != (sizeof(ConnectivityFileHeader) + (sizeof(unsigned int) * numPre) + ((uint64_t)indBytes * numPre * maxRowLength)))";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Connectivity file '\" + pathString + \"' is truncated\");" << std::endl;
+        }
+    }
+    os << std::endl;
+
+    // **NOTE** only the header is checked above so a corrupt file could otherwise cause the simulation to access memory out of bounds
+    os << "template<typename I>" << std::endl;
+    os << "void checkConnectivityFileRows(const unsigned int *rowLength, const I *ind, const char *path, uint32_t numPre, uint32_t numPost, uint32_t maxRowLength)";
+    {
+        CodeStream::Scope b(os);
+        os << "for(uint32_t i = 0; i < numPre; i++)";
+        {
+            CodeStream::Scope b(os);
+            os << "if(rowLength[i] > maxRowLength)";
+            {
+                CodeStream::Scope b(os);
+                os << "throw std::runtime_error(\"Row \" + std::to_string(i) + \" in connectivity file '\" + std::string(path) + \"' has length \" + std::to_string(rowLength[i])";
+                os << " + \" but maximum row length is \" + std::to_string(maxRowLength));" << std::endl;
+            }
+            os << "const I *rowInd = ind + ((size_t)i * maxRowLength);" << std::endl;
+            os << "for(uint32_t j = 0; j < rowLength[i]; j++)";
+            {
+                CodeStream::Scope b(os);
+                os << "if(rowInd[j] >= numPost)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "throw std::runtime_error(\"Row \" + std::to_string(i) + \" in connectivity file '\" + std::string(path) + \"' connects to postsynaptic neuron \" + std::to_string(rowInd[j])";
+                    os << " + \" but there are only \" + std::to_string(numPost));" << std::endl;
+                }
+            }
+        }
+    }
+    os << std::endl;
+
+    os << "void checkConnectivityFileContents(const unsigned int *rowLength, const void *ind, const char *path, uint32_t numPre, uint32_t numPost, uint32_t maxRowLength, uint32_t indBytes)";
+    {
+        CodeStream::Scope b(os);
+        os << "switch(indBytes)";
+        {
+            CodeStream::Scope b(os);
+            os << "case 1: checkConnectivityFileRows(rowLength, static_cast<const uint8_t*>(ind), path, numPre, numPost, maxRowLength); break;" << std::endl;
+            os << "case 2: checkConnectivityFileRows(rowLength, static_cast<const uint16_t*>(ind), path, numPre, numPost, maxRowLength); break;" << std::endl;
+            os << "default: checkConnectivityFileRows(rowLength, static_cast<const uint32_t*>(ind), path, numPre, numPost, maxRowLength); break;" << std::endl;
+        }
+    }
+    os << std::endl;
+
+    if(mapping) {
+        os << "void *mapConnectivityFile(const char *path, uint32_t numPre, uint32_t numPost, uint32_t maxRowLength, uint32_t indBytes, bool validate, size_t &mappingBytes)";
+        {
+            CodeStream::Scope b(os);
+            os << "const int fd = open(path, O_RDONLY);" << std::endl;
+            os << "struct stat fileStat;" << std::endl;
+            os << "if(fd == -1 || fstat(fd, &fileStat) == -1 || fileStat.st_size < (off_t)sizeof(ConnectivityFileHeader))";
+            {
+                CodeStream::Scope b(os);
+                os << "if(fd != -1)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "close(fd);" << std::endl;
+                }
+                os << "throw std::runtime_error(\"Unable to open connectivity file '\" + std::string(path) + \"'\");" << std::endl;
+            }
+            os << std::endl;
+            os << "// **NOTE** mapping is private so changes made to connectivity by the simulation are never written back to the file" << std::endl;
+            os << "void *mapping = mmap(nullptr, fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);" << std::endl;
+            os << "close(fd);" << std::endl;
+            os << "if(mapping == MAP_FAILED)";
+            {
+                CodeStream::Scope b(os);
+                os << "throw std::runtime_error(\"Unable to map connectivity file '\" + std::string(path) + \"'\");" << std::endl;
+            }
+            os << "try";
+            {
+                CodeStream::Scope b(os);
+                os << "checkConnectivityFileHeader(*static_cast<const ConnectivityFileHeader*>(mapping), fileStat.st_size, path, numPre, numPost, maxRowLength, indBytes);" << std::endl;
+                os << "if(validate)";
+                {
+                    CodeStream::Scope b(os);
+                    os << "const unsigned int *rowLength = reinterpret_cast<const unsigned int*>(static_cast<const char*>(mapping) + sizeof(ConnectivityFileHeader));" << std::endl;
+                    os << "checkConnectivityFileContents(rowLength, rowLength + numPre, path, numPre, numPost, maxRowLength, indBytes);" << std::endl;
+                }
+            }
+            os << "catch(...)";
+            {
+                CodeStream::Scope b(os);
+                os << "munmap(mapping, fileStat.st_size);" << std::endl;
+                os << "throw;" << std::endl;
+            }
+            os << "mappingBytes = fileStat.st_size;" << std::endl;
+            os << "return mapping;" << std::endl;
+        }
+    }
+    else {
+        os << "void readConnectivityFile(const char *path, uint32_t numPre, uint32_t numPost, uint32_t maxRowLength, uint32_t indBytes, bool validate, unsigned int *rowLength, void *ind)";
+        {
+            CodeStream::Scope b(os);
+            os << "std::ifstream is(path, std::ios::binary | std::ios::ate);" << std::endl;
+            os << "if(!is.good())";
+            {
+                CodeStream::Scope b(os);
+                os << "throw std::runtime_error(\"Unable to open connectivity file '\" + std::string(path) + \"'\");" << std::endl;
+            }
+            os << "const uint64_t fileBytes = (uint64_t)is.tellg();" << std::endl;
+            os << "is.seekg(0);" << std::endl;
+            os << "ConnectivityFileHeader header = {};" << std::endl;
+            os << "is.read(reinterpret_cast<char*>(&header), sizeof(ConnectivityFileHeader));" << std::endl;
+            os << "checkConnectivityFileHeader(header, fileBytes, path, numPre, numPost, maxRowLength, indBytes);" << std::endl;
+            os << "is.read(reinterpret_cast<char*>(rowLength), sizeof(unsigned int) * numPre);" << std::endl;
+            os << "is.read(reinterpret_cast<char*>(ind), (std::streamsize)((uint64_t)indBytes * numPre * maxRowLength));" << std::endl;
+            os << "if(!is.good())";
+            {
+                CodeStream::Scope b(os);
+                os << "throw std::runtime_error(\"Error reading connectivity file '\" + std::string(path) + \"'\");" << std::endl;
+            }
+            os << "if(validate)";
+            {
+                CodeStream::Scope b(os);
+                os << "try";
+                {
+                    CodeStream::Scope b(os);
+                    os << "checkConnectivityFileContents(rowLength, ind, path, numPre, numPost, maxRowLength, indBytes);" << std::endl;
+                }
+                os << "catch(...)";
+                {
+                    // Empty rows so invalid connectivity, which has already been read into arrays, is never used
+                    CodeStream::Scope b(os);
+                    os << "memset(rowLength, 0, sizeof(unsigned int) * numPre);" << std::endl;
+                    os << "throw;" << std::endl;
+                }
+            }
+        }
+    }
+    os << std::endl;
+    os << "}   // Anonymous namespace" << std::endl;
+    os << std::endl;
+}
+//-------------------------------------------------------------------------
+void genPerformanceCounters(CodeStream &os, const PerformanceCounters &perfCounters)
+{
+    os << "// ------------------------------------------------------------------------" << std::endl;
+    os << "// performance counters" << std::endl;
+    os << "// ------------------------------------------------------------------------" << std::endl;
+    os << "namespace" << std::endl;
+    os << "{" << std::endl;
+    os << "// Update of a population recorded while performance tracing is enabled" << std::endl;
+    os << "struct PerformanceTraceEvent";
+    {
+        CodeStream::Scope b(os);
+        os << "unsigned int counter;" << std::endl;
+        os << "unsigned long long timestep;" << std::endl;
+        os << "double start;" << std::endl;
+        os << "double duration;" << std::endl;
+        os << "unsigned long long numSpikes;" << std::endl;
+        os << "unsigned long long numSynapticEvents;" << std::endl;
+    }
+    os << ";" << std::endl;
+    os << std::endl;
+    os << "std::vector<PerformanceCounter> performanceCounters = ";
+    {
+        CodeStream::Scope b(os);
+        for(const auto &c : perfCounters) {
+            os << "{\"" << std::get<0>(c) << "\", \"" << std::get<1>(c) << "\", " << std::get<2>(c) << ", 0.0, 0, 0}," << std::endl;
+        }
+    }
+    os << ";" << std::endl;
+    os << "bool performanceTraceEnabled = false;" << std::endl;
+    os << "std::vector<PerformanceTraceEvent> performanceTrace;" << std::endl;
+    os << "const auto performanceTraceOrigin = std::chrono::high_resolution_clock::now();" << std::endl;
+    os << "}   // Anonymous namespace" << std::endl;
+    os << std::endl;
+
+    os << "void recordPerformanceCounter(unsigned int counter, std::chrono::high_resolution_clock::time_point start, unsigned long long numSpikes, unsigned long long numSynapticEvents)";
+    {
+        CodeStream::Scope b(os);
+        os << "const double duration = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();" << std::endl;
+        os << "PerformanceCounter &performanceCounter = performanceCounters[counter];" << std::endl;
+        os << "performanceCounter.time += duration;" << std::endl;
+        os << "performanceCounter.numSpikes += numSpikes;" << std::endl;
+        os << "performanceCounter.numSynapticEvents += numSynapticEvents;" << std::endl;
+        os << "if(performanceTraceEnabled)";
+        {
+            CodeStream::Scope b(os);
+            os << "performanceTrace.push_back({counter, iT, std::chrono::duration<double>(start - performanceTraceOrigin).count(), duration, numSpikes, numSynapticEvents});" << std::endl;
+        }
+    }
+    os << std::endl;
+
+    os << "const PerformanceCounter *getPerformanceCounters(unsigned int *numCounters)";
+    {
+        CodeStream::Scope b(os);
+        os << "*numCounters = (unsigned int)performanceCounters.size();" << std::endl;
+        os << "return performanceCounters.data();" << std::endl;
+    }
+    os << std::endl;
+
+    os << "void resetPerformanceCounters()";
+    {
+        CodeStream::Scope b(os);
+        os << "for(auto &c : performanceCounters)";
+        {
+            CodeStream::Scope b(os);
+            os << "c.time = 0.0;" << std::endl;
+            os << "c.numSpikes = 0;" << std::endl;
+            os << "c.numSynapticEvents = 0;" << std::endl;
+        }
+        os << "performanceTrace.clear();" << std::endl;
+    }
+    os << std::endl;
+
+    os << "void setPerformanceTraceEnabled(bool enabled)";
+    {
+        CodeStream::Scope b(os);
+        os << "performanceTraceEnabled = enabled;" << std::endl;
+    }
+    os << std::endl;
+
+    // Write trace in Chrome's trace event format with one 'thread' per population update and 'complete' events timed in microseconds
+    // **NOTE** viewers ignore unknown top-level keys so the totals are written alongside the events
+    os << "void writePerformanceTrace(const char *path)";
+    {
+        CodeStream::Scope b(os);
+        os << "std::ofstream os(path);" << std::endl;
+        os << "if(!os.good())";
+        {
+            CodeStream::Scope b(os);
+            os << "throw std::runtime_error(\"Unable to open performance trace '\" + std::string(path) + \"'\");" << std::endl;
+        }
+        os << "os << std::fixed;" << std::endl;
+        os << "os.precision(3);" << std::endl;
+        os << "os << \"{\\\"displayTimeUnit\\\": \\\"ms\\\",\\n\\\"traceEvents\\\": [\\n\";" << std::endl;
+        os << "for(size_t i = 0; i < performanceCounters.size(); i++)";
+        {
+            CodeStream::Scope b(os);
+            os << "const PerformanceCounter &c = performanceCounters[i];" << std::endl;
+            os << "os << \"{\\\"name\\\": \\\"thread_name\\\", \\\"ph\\\": \\\"M\\\", \\\"pid\\\": 0, \\\"tid\\\": \" << i << \", \\\"args\\\": {\\\"name\\\": \\\"\" << c.name << \" \" << c.type << \"\\\"}},\\n\";" << std::endl;
+            os << "os << \"{\\\"name\\\": \\\"thread_sort_index\\\", \\\"ph\\\": \\\"M\\\", \\\"pid\\\": 0, \\\"tid\\\": \" << i << \", \\\"args\\\": {\\\"sort_index\\\": \" << i << \"}}\";" << std::endl;
+            os << "os << (((i + 1) == performanceCounters.size() && performanceTrace.empty()) ? \"\\n\" : \",\\n\");" << std::endl;
+        }
+        os << "for(size_t i = 0; i < performanceTrace.size(); i++)";
+        {
+            CodeStream::Scope b(os);
+            os << "const PerformanceTraceEvent &e = performanceTrace[i];" << std::endl;
+            os << "const PerformanceCounter &c = performanceCounters[e.counter];" << std::endl;
+            os << "os << \"{\\\"name\\\": \\\"\" << c.name << \"\\\", \\\"cat\\\": \\\"\" << c.type << \"\\\", \\\"ph\\\": \\\"X\\\", \\\"pid\\\": 0, \\\"tid\\\": \" << e.counter;" << std::endl;
+            os << "os << \", \\\"ts\\\": \" << (e.start * 1.0E6) << \", \\\"dur\\\": \" << (e.duration * 1.0E6);" << std::endl;
+            os << "os << \", \\\"args\\\": {\\\"timestep\\\": \" << e.timestep << \", \\\"numSpikes\\\": \" << e.numSpikes << \", \\\"numSynapticEvents\\\": \" << e.numSynapticEvents << \"}}\";" << std::endl;
+            os << "os << (((i + 1) == performanceTrace.size()) ? \"\\n\" : \",\\n\");" << std::endl;
+        }
+        os << "os << \"],\\n\\\"performanceCounters\\\": [\\n\";" << std::endl;
+        os << "for(size_t i = 0; i < performanceCounters.size(); i++)";
+        {
+            CodeStream::Scope b(os);
+            os << "const PerformanceCounter &c = performanceCounters[i];" << std::endl;
+            os << "os << \"{\\\"name\\\": \\\"\" << c.name << \"\\\", \\\"type\\\": \\\"\" << c.type << \"\\\", \\\"mergedGroup\\\": \" << c.mergedGroup;" << std::endl;
+            os << "os << \", \\\"time\\\": \" << (c.time * 1.0E6) << \", \\\"numSpikes\\\": \" << c.numSpikes << \", \\\"numSynapticEvents\\\": \" << c.numSynapticEvents << \"}\";" << std::endl;
+            os << "os << (((i + 1) == performanceCounters.size()) ? \"\\n\" : \",\\n\");" << std::endl;
+        }
+        os << "os << \"]}\\n\";" << std::endl;
+    }
+    os << std::endl;
+}
+//-------------------------------------------------------------------------
+void genCheckpointArray(const BackendBase &backend, CodeStream &save, CodeStream &load,
+                        const std::string &type, const std::string &name, VarLocation loc, size_t count)
+{
+    // If array is accessible from the host, stream it directly from host memory
+    // **NOTE** with automatic copy, all arrays are allocated in memory accessible from the host
+    if(backend.isAutomaticCopyEnabled() || (loc & VarLocation::HOST)) {
+        const std::string bytes = std::to_string(count) + " * sizeof(" + type + ")";
+        const bool pushPull = canPushPullVar(loc) && !backend.isAutomaticCopyEnabled();
+
+        // Pull array into host memory before saving
+        if(pushPull) {
+            backend.genVariablePull(save, type, name, loc, count);
+        }
+        save << "writeCheckpointRecord(checkpoint, \"" << name << "\", " << name << ", " << bytes << ");" << std::endl;
+
+        // Push array from host memory after loading
+        load << "readCheckpointRecord(checkpoint, \"" << name << "\", " << name << ", " << bytes << ");" << std::endl;
+        if(pushPull) {
+            backend.genVariablePush(load, type, name, loc, false, count);
+        }
+    }
+    // Otherwise, let backend copy it to and from the device
+    else {
+        backend.genCheckpointDeviceArraySave(save, type, name, count);
+        backend.genCheckpointDeviceArrayLoad(load, type, name, count);
+    }
+}
+//-------------------------------------------------------------------------
+void genCheckpointScalar(CodeStream &save, CodeStream &load, const std::string &type, const std::string &name)
+{
+    // **NOTE** scalars are always updated on the host so copies on the device are restored by the backend
+    save << "writeCheckpointRecord(checkpoint, \"" << name << "\", &" << name << ", sizeof(" << type << "));" << std::endl;
+    load << "readCheckpointRecord(checkpoint, \"" << name << "\", &" << name << ", sizeof(" << type << "));" << std::endl;
+}
 }   // Anonymous namespace
 
 //--------------------------------------------------------------------------
@@ -760,8 +1391,33 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
     definitions << "#define delB(x,i) x= ((x) & (~(0x80000000 >> (i)))) //!< Set the bit at the specified position i in x to 0" << std::endl;
     definitions << std::endl;
 
+    // If any synapse groups store variables in reduced-precision formats, write functions to convert them
+    if(std::any_of(model.getSynapseGroups().cbegin(), model.getSynapseGroups().cend(),
+                   [](const ModelSpec::SynapseGroupValueType &s){ return s.second.isWUVarStorageReduced(); }))
+    {
+        definitions << "// ------------------------------------------------------------------------" << std::endl;
+        definitions << "// reduced-precision storage conversion functions" << std::endl;
+        genReducedPrecisionStorageFunctions(definitions);
+    }
+
     // Write runner preamble
     runner << "#include \"definitionsInternal.h\"" << std::endl << std::endl;
+    runner << "// Standard C++ includes" << std::endl;
+    runner << "#include <algorithm>" << std::endl;
+    runner << "#include <fstream>" << std::endl;
+    runner << "#include <sstream>" << std::endl;
+    runner << "#include <stdexcept>" << std::endl;
+    runner << "#include <string>" << std::endl;
+    runner << "#include <vector>" << std::endl;
+    runner << std::endl;
+    runner << "// Standard C includes" << std::endl;
+    runner << "#include <cstdint>" << std::endl;
+    runner << "#include <cstring>" << std::endl;
+    runner << std::endl;
+    genCheckpointRecordHelpers(runner);
+    if(isConnectivityFileLoadable(model)) {
+        genConnectivityFileHelpers(runner, backend);
+    }
     backend.genRunnerPreamble(runner, modelMerged);
 
     // Create codestreams to generate different sections of runner and definitions
@@ -774,6 +1430,9 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
     std::stringstream runnerPullFuncStream;
     std::stringstream runnerGetterFuncStream;
     std::stringstream runnerStepTimeFinaliseStream;
+    std::stringstream runnerSaveStateStream;
+    std::stringstream runnerLoadStateStream;
+    std::stringstream runnerLoadConnectivityStream;
     std::stringstream definitionsVarStream;
     std::stringstream definitionsFuncStream;
     std::stringstream definitionsInternalVarStream;
@@ -787,6 +1446,9 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
     CodeStream runnerPullFunc(runnerPullFuncStream);
     CodeStream runnerGetterFunc(runnerGetterFuncStream);
     CodeStream runnerStepTimeFinalise(runnerStepTimeFinaliseStream);
+    CodeStream runnerSaveState(runnerSaveStateStream);
+    CodeStream runnerLoadState(runnerLoadStateStream);
+    CodeStream runnerLoadConnectivity(runnerLoadConnectivityStream);
     CodeStream definitionsVar(definitionsVarStream);
     CodeStream definitionsFunc(definitionsFuncStream);
     CodeStream definitionsInternalVar(definitionsInternalVarStream);
@@ -810,6 +1472,12 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
     runnerVarDecl << "unsigned long long iT;" << std::endl;
     runnerVarDecl << model.getTimePrecision() << " t;" << std::endl;
 
+    // If any populations record spikes, define and declare number of timesteps recording buffers hold
+    if(model.isRecordingInUse()) {
+        definitionsVar << "EXPORT_VAR unsigned int numRecordingTimesteps;" << std::endl;
+        runnerVarDecl << "unsigned int numRecordingTimesteps = 0;" << std::endl;
+    }
+
     // If backend requires a global RNG to simulate (or initialize) this model
     if(backend.isGlobalRNGRequired(modelMerged)) {
         mem += backend.genGlobalRNG(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree);
@@ -870,6 +1538,27 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
         allVarStreams << std::endl;
     }
 
+    // If performance counters are enabled, define structure used to return them
+    if(model.isPerformanceCountersEnabled()) {
+        definitionsVar << "// Total duration (in seconds), spikes emitted or processed and synapses processed by updates of population" << std::endl;
+        definitionsVar << "struct PerformanceCounter";
+        {
+            CodeStream::Scope b(definitionsVar);
+            definitionsVar << "const char *name;" << std::endl;
+            definitionsVar << "const char *type;" << std::endl;
+            definitionsVar << "unsigned int mergedGroup;" << std::endl;
+            definitionsVar << "double time;" << std::endl;
+            definitionsVar << "unsigned long long numSpikes;" << std::endl;
+            definitionsVar << "unsigned long long numSynapticEvents;" << std::endl;
+        }
+        definitionsVar << ";" << std::endl;
+        definitionsVar << std::endl;
+    }
+
+    // Performance counters added by update groups
+    PerformanceCounters perfCountersStorage;
+    PerformanceCounters *perfCounters = model.isPerformanceCountersEnabled() ? &perfCountersStorage : nullptr;
+
     definitionsInternal << "// ------------------------------------------------------------------------" << std::endl;
     definitionsInternal << "// merged group structures" << std::endl;
     definitionsInternal << "// ------------------------------------------------------------------------" << std::endl;
@@ -881,14 +1570,14 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
     // Generate merged neuron initialisation groups
     for(const auto &m : modelMerged.getMergedNeuronInitGroups()) {
         genMergedNeuronStruct(backend, definitionsInternal, definitionsInternalFunc, runnerMergedStructAlloc,
-                              mergedEGPs, m, model.getPrecision(), model.getTimePrecision(), true);
+                              mergedEGPs, m, model.getPrecision(), model.getTimePrecision(), model.getBatchSize(), true);
     }
 
     // Loop through merged dense synapse init groups
     for(const auto &m : modelMerged.getMergedSynapseDenseInitGroups()) {
          genMergedSynapseStruct(backend, definitionsInternal, definitionsInternalFunc, runnerMergedStructAlloc,
                                 mergedEGPs, m, model.getPrecision(), model.getTimePrecision(),
-                                "SynapseDenseInit", MergedSynapseStruct::DenseInit);
+                                "SynapseDenseInit", MergedSynapseStruct::DenseInit, model.getBatchSize());
     }
 
     // Loop through merged synapse connectivity initialisation groups
@@ -903,7 +1592,12 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
                      [&backend, m](const SynapseGroupInternal &sg, size_t){ return std::to_string(backend.getSynapticMatrixRowStride(sg)); });
 
         if(m.getArchetype().getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
-            gen.addPointerField("unsigned int", "rowLength", backend.getArrayPrefix() + "rowLength");
+            addSparseConnectivityFields(gen, m, backend);
+        }
+        else if(m.getArchetype().getMatrixType() & SynapseMatrixConnectivity::CSR) {
+            gen.addField("unsigned int", "maxTotalConnections",
+                         [](const SynapseGroupInternal &sg, size_t){ return std::to_string(sg.getMaxTotalConnections()); });
+            gen.addPointerField("unsigned int", "rowPtr", backend.getArrayPrefix() + "rowPtr");
             gen.addPointerField(m.getArchetype().getSparseIndType(), "ind", backend.getArrayPrefix() + "ind");
         }
         else if(m.getArchetype().getMatrixType() & SynapseMatrixConnectivity::BITMASK) {
@@ -921,39 +1615,39 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
     for(const auto &m : modelMerged.getMergedSynapseSparseInitGroups()) {
          genMergedSynapseStruct(backend, definitionsInternal, definitionsInternalFunc, runnerMergedStructAlloc,
                                 mergedEGPs, m, model.getPrecision(), model.getTimePrecision(),
-                                "SynapseSparseInit", MergedSynapseStruct::SparseInit);
+                                "SynapseSparseInit", MergedSynapseStruct::SparseInit, model.getBatchSize());
     }
 
     // Loop through merged neuron update groups
     for(const auto &m : modelMerged.getMergedNeuronUpdateGroups()) {
         genMergedNeuronStruct(backend, definitionsInternal, definitionsInternalFunc, runnerMergedStructAlloc,
-                              mergedEGPs, m, model.getPrecision(), model.getTimePrecision(), false);
+                              mergedEGPs, m, model.getPrecision(), model.getTimePrecision(), model.getBatchSize(), false, perfCounters);
     }
 
     // Loop through merged presynaptic update groups
     for(const auto &m : modelMerged.getMergedPresynapticUpdateGroups()) {
         genMergedSynapseStruct(backend, definitionsInternal, definitionsInternalFunc, runnerMergedStructAlloc,
                                mergedEGPs, m, model.getPrecision(), model.getTimePrecision(),
-                               "PresynapticUpdate", MergedSynapseStruct::PresynapticUpdate);
+                               "PresynapticUpdate", MergedSynapseStruct::PresynapticUpdate, model.getBatchSize(), perfCounters);
     }
 
     // Loop through merged postsynaptic update groups
     for(const auto &m : modelMerged.getMergedPostsynapticUpdateGroups()) {
         genMergedSynapseStruct(backend, definitionsInternal, definitionsInternalFunc, runnerMergedStructAlloc,
                                mergedEGPs, m, model.getPrecision(), model.getTimePrecision(),
-                               "PostsynapticUpdate", MergedSynapseStruct::PostsynapticUpdate);
+                               "PostsynapticUpdate", MergedSynapseStruct::PostsynapticUpdate, model.getBatchSize(), perfCounters);
     }
 
     // Loop through synapse dynamics groups
     for(const auto &m : modelMerged.getMergedSynapseDynamicsGroups()) {
         genMergedSynapseStruct(backend, definitionsInternal, definitionsInternalFunc, runnerMergedStructAlloc,
                                mergedEGPs, m, model.getPrecision(), model.getTimePrecision(),
-                               "SynapseDynamics", MergedSynapseStruct::SynapseDynamics);
+                               "SynapseDynamics", MergedSynapseStruct::SynapseDynamics, model.getBatchSize(), perfCounters);
     }
 
     // Loop through neuron groups whose spike queues need resetting
     for(const auto &m : modelMerged.getMergedNeuronSpikeQueueUpdateGroups()) {
-        MergedNeuronStructGenerator gen(m);
+        MergedNeuronStructGenerator gen(m, model.getBatchSize());
 
         if(m.getArchetype().isDelayRequired()) {
             gen.addField("unsigned int", "numDelaySlots",
@@ -966,10 +1660,12 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
                          });
         }
 
-        gen.addPointerField("unsigned int", "spkCnt", backend.getArrayPrefix() + "glbSpkCnt");
+        const std::string numDelaySlots = std::to_string(m.getArchetype().getNumDelaySlots());
+        gen.addPointerField("unsigned int", "spkCnt", backend.getArrayPrefix() + "glbSpkCnt",
+                            m.getArchetype().isTrueSpikeRequired() ? numDelaySlots : "1");
 
         if(m.getArchetype().isSpikeEventRequired()) {
-            gen.addPointerField("unsigned int", "spkCntEvnt", backend.getArrayPrefix() + "glbSpkCntEvnt");
+            gen.addPointerField("unsigned int", "spkCntEvnt", backend.getArrayPrefix() + "glbSpkCntEvnt", numDelaySlots);
         }
 
 
@@ -997,17 +1693,28 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
     allVarStreams << "// ------------------------------------------------------------------------" << std::endl;
     std::vector<std::string> currentSpikePullFunctions;
     std::vector<std::string> currentSpikeEventPullFunctions;
+    std::stringstream runnerRecordingAllocStream;
+    std::stringstream runnerRecordingPullStream;
+    CodeStream runnerRecordingAlloc(runnerRecordingAllocStream);
+    CodeStream runnerRecordingPull(runnerRecordingPullStream);
+
+    // **NOTE** all state is allocated with an extra batch dimension; connectivity and extra global parameters are shared
+    const size_t batchSize = model.getBatchSize();
     for(const auto &n : model.getNeuronGroups()) {
         // Write convenience macros to access spikes
         genSpikeMacros(definitionsVar, n.second, true);
 
         // True spike variables
-        const size_t numSpikeCounts = n.second.isTrueSpikeRequired() ? n.second.getNumDelaySlots() : 1;
-        const size_t numSpikes = n.second.isTrueSpikeRequired() ? n.second.getNumNeurons() * n.second.getNumDelaySlots() : n.second.getNumNeurons();
+        const size_t numSpikeCounts = batchSize * (n.second.isTrueSpikeRequired() ? n.second.getNumDelaySlots() : 1);
+        const size_t numSpikes = batchSize * (n.second.isTrueSpikeRequired() ? n.second.getNumNeurons() * n.second.getNumDelaySlots() : n.second.getNumNeurons());
         mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                 "unsigned int", "glbSpkCnt" + n.first, n.second.getSpikeLocation(), numSpikeCounts);
         mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                 "unsigned int", "glbSpk" + n.first, n.second.getSpikeLocation(), numSpikes);
+        genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                           "unsigned int", "glbSpkCnt" + n.first, n.second.getSpikeLocation(), numSpikeCounts);
+        genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                           "unsigned int", "glbSpk" + n.first, n.second.getSpikeLocation(), numSpikes);
 
         // True spike push and pull functions
         genVarPushPullScope(definitionsFunc, runnerPushFunc, runnerPullFunc, n.second.getSpikeLocation(),
@@ -1032,18 +1739,71 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
         // Current true spike getter functions
         genSpikeGetters(definitionsFunc, runnerGetterFunc, n.second, true);
 
+        // If spike recording is enabled
+        if(n.second.isSpikeRecordingEnabled()) {
+            // Recording buffer is a ring buffer of numRecordingTimesteps bitfields, each containing one bit per neuron
+            // **NOTE** in batched models, the ring buffers of each batch are stored consecutively
+            const std::string name = "recordSpk" + n.first;
+            const std::string numWords = std::to_string((n.second.getNumNeurons() + 31) / 32);
+            const std::string numBatchedWords = std::to_string(batchSize) + " * " + numWords;
+            backend.genExtraGlobalParamDefinition(definitionsVar, "uint32_t*", name, VarLocation::HOST_DEVICE);
+            backend.genExtraGlobalParamImplementation(runnerVarDecl, "uint32_t*", name, VarLocation::HOST_DEVICE);
+            backend.genVariableFree(runnerVarFree, name, VarLocation::HOST_DEVICE);
+            runnerVarFree << name << " = nullptr;" << std::endl;
+
+            // Allocate buffer and copy pointer to it into merged structures
+            {
+                CodeStream::Scope b(runnerRecordingAlloc);
+
+                // Free any buffer allocated by a previous call e.g. to resize for a longer recording window
+                runnerRecordingAlloc << "if(" << name << " != nullptr)";
+                {
+                    CodeStream::Scope b(runnerRecordingAlloc);
+                    backend.genVariableFree(runnerRecordingAlloc, name, VarLocation::HOST_DEVICE);
+                }
+                runnerRecordingAlloc << "const unsigned int count = timesteps * " << numBatchedWords << ";" << std::endl;
+                backend.genExtraGlobalParamAllocation(runnerRecordingAlloc, "uint32_t*", name, VarLocation::HOST_DEVICE);
+
+                for(const auto &v : mergedEGPs.at(backend.getArrayPrefix() + name)) {
+                    const std::string pushFuncName = "pushMerged" + v.first + std::to_string(v.second.mergedGroupIndex) + v.second.fieldName + std::to_string(v.second.groupIndex) + "ToDevice();";
+                    definitionsInternalFunc << "EXPORT_FUNC void " << pushFuncName << std::endl;
+                    runnerRecordingAlloc << pushFuncName << std::endl;
+                }
+            }
+
+            // Copy whole buffer from device if backend requires it
+            if(!backend.isAutomaticCopyEnabled()) {
+                std::stringstream pullStream;
+                CodeStream pull(pullStream);
+                backend.genExtraGlobalParamPull(pull, "uint32_t*", name, VarLocation::HOST_DEVICE);
+                if(!pullStream.str().empty()) {
+                    CodeStream::Scope b(runnerRecordingPull);
+                    runnerRecordingPull << "const unsigned int count = numRecordingTimesteps * " << numBatchedWords << ";" << std::endl;
+                    runnerRecordingPull << pullStream.str();
+                }
+            }
+        }
+
         // If neuron ngroup eeds to emit spike-like events
         if (n.second.isSpikeEventRequired()) {
             // Write convenience macros to access spike-like events
             genSpikeMacros(definitionsVar, n.second, false);
 
             // Spike-like event variables
+            const size_t numSpikeEventCounts = batchSize * n.second.getNumDelaySlots();
+            const size_t numSpikeEvents = batchSize * n.second.getNumNeurons() * n.second.getNumDelaySlots();
             mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                     "unsigned int", "glbSpkCntEvnt" + n.first, n.second.getSpikeEventLocation(),
-                                    n.second.getNumDelaySlots());
+                                    numSpikeEventCounts);
             mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                     "unsigned int", "glbSpkEvnt" + n.first, n.second.getSpikeEventLocation(),
-                                    n.second.getNumNeurons() * n.second.getNumDelaySlots());
+                                    numSpikeEvents);
+            genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                               "unsigned int", "glbSpkCntEvnt" + n.first, n.second.getSpikeEventLocation(),
+                               numSpikeEventCounts);
+            genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                               "unsigned int", "glbSpkEvnt" + n.first, n.second.getSpikeEventLocation(),
+                               numSpikeEvents);
 
             // Spike-like event push and pull functions
             genVarPushPullScope(definitionsFunc, runnerPushFunc, runnerPullFunc, n.second.getSpikeEventLocation(),
@@ -1051,9 +1811,9 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
                 [&]()
                 {
                     backend.genVariablePushPull(runnerPushFunc, runnerPullFunc,
-                                                "unsigned int", "glbSpkCntEvnt" + n.first, n.second.getSpikeLocation(), true, n.second.getNumDelaySlots());
+                                                "unsigned int", "glbSpkCntEvnt" + n.first, n.second.getSpikeLocation(), true, numSpikeEventCounts);
                     backend.genVariablePushPull(runnerPushFunc, runnerPullFunc,
-                                                "unsigned int", "glbSpkEvnt" + n.first, n.second.getSpikeLocation(), true, n.second.getNumNeurons() * n.second.getNumDelaySlots());
+                                                "unsigned int", "glbSpkEvnt" + n.first, n.second.getSpikeLocation(), true, numSpikeEvents);
                 });
 
             // Current spike-like event push and pull functions
@@ -1072,13 +1832,18 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
         // If neuron group has axonal delays
         if (n.second.isDelayRequired()) {
             backend.genScalar(definitionsVar, definitionsInternalVar, runnerVarDecl, "unsigned int", "spkQuePtr" + n.first, VarLocation::HOST_DEVICE);
+            genCheckpointScalar(runnerSaveState, runnerLoadState, "unsigned int", "spkQuePtr" + n.first);
         }
 
         // If neuron group needs to record its spike times
         if (n.second.isSpikeTimeRequired()) {
+            const size_t numSpikeTimes = batchSize * n.second.getNumNeurons() * n.second.getNumDelaySlots();
             mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                     model.getTimePrecision(), "sT" + n.first, n.second.getSpikeTimeLocation(),
-                                    n.second.getNumNeurons() * n.second.getNumDelaySlots());
+                                    numSpikeTimes);
+            genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                               model.getTimePrecision(), "sT" + n.first, n.second.getSpikeTimeLocation(),
+                               numSpikeTimes);
 
             // Generate push and pull functions
             genVarPushPullScope(definitionsFunc, runnerPushFunc, runnerPullFunc, n.second.getSpikeTimeLocation(),
@@ -1086,13 +1851,36 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
                 [&]()
                 {
                     backend.genVariablePushPull(runnerPushFunc, runnerPullFunc, model.getTimePrecision(),
-                                                "sT" + n.first, n.second.getSpikeTimeLocation(), true, n.second.getNumNeurons() * n.second.getNumDelaySlots());
+                                                "sT" + n.first, n.second.getSpikeTimeLocation(), true, numSpikeTimes);
                 });
         }
 
+        // If neuron group is event-driven, allocate times each neuron was last updated and either the calendar
+        // queue used to wake neurons or, if the backend doesn't support one, the time each neuron should next be woken
+        if(n.second.isEventDriven()) {
+            const size_t numNeurons = batchSize * n.second.getNumNeurons();
+            std::vector<std::tuple<std::string, std::string, size_t>> arrays{std::make_tuple(model.getTimePrecision(), "updT", numNeurons)};
+            if(backend.getNumWakeQueueBuckets() > 0) {
+                arrays.emplace_back("int", "wakeHead", batchSize * backend.getNumWakeQueueBuckets());
+                arrays.emplace_back("int", "wakeNext", numNeurons);
+                arrays.emplace_back("int", "wakePrev", numNeurons);
+                arrays.emplace_back("unsigned long long", "wakeStep", numNeurons);
+            }
+            else {
+                arrays.emplace_back(model.getTimePrecision(), "wakeT", numNeurons);
+            }
+
+            for(const auto &a : arrays) {
+                mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
+                                        std::get<0>(a), std::get<1>(a) + n.first, VarLocation::DEVICE, std::get<2>(a));
+                genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                                   std::get<0>(a), std::get<1>(a) + n.first, VarLocation::DEVICE, std::get<2>(a));
+            }
+        }
+
         // If neuron group needs per-neuron RNGs
         if(n.second.isSimRNGRequired()) {
-            mem += backend.genPopulationRNG(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree, "rng" + n.first, n.second.getNumNeurons());
+            mem += backend.genPopulationRNG(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree, "rng" + n.first, batchSize * n.second.getNumNeurons());
         }
 
         // Neuron state variables
@@ -1100,11 +1888,13 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
         const auto vars = neuronModel->getVars();
         std::vector<std::string> neuronStatePushPullFunctions;
         for(size_t i = 0; i < vars.size(); i++) {
-            const size_t count = n.second.isVarQueueRequired(i) ? n.second.getNumNeurons() * n.second.getNumDelaySlots() : n.second.getNumNeurons();
+            const size_t count = batchSize * (n.second.isVarQueueRequired(i) ? n.second.getNumNeurons() * n.second.getNumDelaySlots() : n.second.getNumNeurons());
             const bool autoInitialized = !n.second.getVarInitialisers()[i].getSnippet()->getCode().empty();
             mem += genVariable(backend, definitionsVar, definitionsFunc, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                runnerPushFunc, runnerPullFunc, vars[i].type, vars[i].name + n.first,
                                n.second.getVarLocation(i), autoInitialized, count, neuronStatePushPullFunctions);
+            genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                               vars[i].type, vars[i].name + n.first, n.second.getVarLocation(i), count);
 
             // Current variable push and pull functions
             genVarPushPullScope(definitionsFunc, runnerPushFunc, runnerPullFunc, n.second.getVarLocation(i),
@@ -1153,7 +1943,9 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
                 const bool autoInitialized = !cs->getVarInitialisers()[i].getSnippet()->getCode().empty();
                 mem += genVariable(backend, definitionsVar, definitionsFunc, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                    runnerPushFunc, runnerPullFunc, csVars[i].type, csVars[i].name + cs->getName(),
-                                   cs->getVarLocation(i), autoInitialized, n.second.getNumNeurons(), currentSourceStatePushPullFunctions);
+                                   cs->getVarLocation(i), autoInitialized, batchSize * n.second.getNumNeurons(), currentSourceStatePushPullFunctions);
+                genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                                   csVars[i].type, csVars[i].name + cs->getName(), cs->getVarLocation(i), batchSize * n.second.getNumNeurons());
             }
 
             // Add helper function to push and pull entire current source state
@@ -1181,20 +1973,30 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
 
             mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                     model.getPrecision(), "inSyn" + sg->getPSModelTargetName(), sg->getInSynLocation(),
-                                    sg->getTrgNeuronGroup()->getNumNeurons());
+                                    batchSize * sg->getTrgNeuronGroup()->getNumNeurons());
+            genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                               model.getPrecision(), "inSyn" + sg->getPSModelTargetName(), sg->getInSynLocation(),
+                               batchSize * sg->getTrgNeuronGroup()->getNumNeurons());
 
             if (sg->isDendriticDelayRequired()) {
                 mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                         model.getPrecision(), "denDelay" + sg->getPSModelTargetName(), sg->getDendriticDelayLocation(),
-                                        sg->getMaxDendriticDelayTimesteps() * sg->getTrgNeuronGroup()->getNumNeurons());
+                                        batchSize * sg->getMaxDendriticDelayTimesteps() * sg->getTrgNeuronGroup()->getNumNeurons());
                 backend.genScalar(definitionsVar, definitionsInternalVar, runnerVarDecl, "unsigned int", "denDelayPtr" + sg->getPSModelTargetName(), VarLocation::HOST_DEVICE);
+                genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                                   model.getPrecision(), "denDelay" + sg->getPSModelTargetName(), sg->getDendriticDelayLocation(),
+                                   batchSize * sg->getMaxDendriticDelayTimesteps() * sg->getTrgNeuronGroup()->getNumNeurons());
+                genCheckpointScalar(runnerSaveState, runnerLoadState, "unsigned int", "denDelayPtr" + sg->getPSModelTargetName());
             }
 
             if (sg->getMatrixType() & SynapseMatrixWeight::INDIVIDUAL_PSM) {
                 for(const auto &v : sg->getPSModel()->getVars()) {
                     mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                             v.type, v.name + sg->getPSModelTargetName(), sg->getPSVarLocation(v.name),
-                                            sg->getTrgNeuronGroup()->getNumNeurons());
+                                            batchSize * sg->getTrgNeuronGroup()->getNumNeurons());
+                    genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                                       v.type, v.name + sg->getPSModelTargetName(), sg->getPSVarLocation(v.name),
+                                       batchSize * sg->getTrgNeuronGroup()->getNumNeurons());
                 }
             }
         }
@@ -1213,23 +2015,111 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
             mem += genVariable(backend, definitionsVar, definitionsFunc, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                             runnerPushFunc, runnerPullFunc, "uint32_t", "gp" + s.second.getName(),
                             s.second.getSparseConnectivityLocation(), autoInitialized, gpSize, connectivityPushPullFunctions);
+            genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                               "uint32_t", "gp" + s.second.getName(), s.second.getSparseConnectivityLocation(), gpSize);
 
         }
-        else if(s.second.getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
+        else if((s.second.getMatrixType() & SynapseMatrixConnectivity::SPARSE)
+                || (s.second.getMatrixType() & SynapseMatrixConnectivity::CSR))
+        {
             const VarLocation varLoc = s.second.getSparseConnectivityLocation();
-            const size_t size = s.second.getSrcNeuronGroup()->getNumNeurons() * backend.getSynapticMatrixRowStride(s.second);
+            const bool csr = (s.second.getMatrixType() & SynapseMatrixConnectivity::CSR);
+
+            // CSR connectivity is tightly packed and indexed using the prefix sum of the row lengths
+            // whereas SPARSE connectivity is padded so each row has the same stride
+            const std::string rowArrayName = (csr ? "rowPtr" : "rowLength") + s.second.getName();
+            const size_t rowArraySize = s.second.getSrcNeuronGroup()->getNumNeurons() + (csr ? 1 : 0);
+            const size_t size = csr ? s.second.getMaxTotalConnections() : (s.second.getSrcNeuronGroup()->getNumNeurons() * backend.getSynapticMatrixRowStride(s.second));
+
+            // Maximum row length or total connections constant
+            if(csr) {
+                definitionsVar << "EXPORT_VAR const unsigned int maxTotalConnections" << s.second.getName() << ";" << std::endl;
+                runnerVarDecl << "const unsigned int maxTotalConnections" << s.second.getName() << " = " << size << ";" << std::endl;
+            }
+            else {
+                definitionsVar << "EXPORT_VAR const unsigned int maxRowLength" << s.second.getName() << ";" << std::endl;
+                runnerVarDecl << "const unsigned int maxRowLength" << s.second.getName() << " = " << backend.getSynapticMatrixRowStride(s.second) << ";" << std::endl;
+            }
 
-            // Maximum row length constant
-            definitionsVar << "EXPORT_VAR const unsigned int maxRowLength" << s.second.getName() << ";" << std::endl;
-            runnerVarDecl << "const unsigned int maxRowLength" << s.second.getName() << " = " << backend.getSynapticMatrixRowStride(s.second) << ";" << std::endl;
+            // If connectivity can be loaded from file
+            const std::string indArrayName = "ind" + s.second.getName();
+            if(isConnectivityFileLoadable(s.second)) {
+                const std::string dimensions = std::to_string(s.second.getSrcNeuronGroup()->getNumNeurons()) + ", " + std::to_string(s.second.getTrgNeuronGroup()->getNumNeurons()) + ", "
+                    + std::to_string(backend.getSynapticMatrixRowStride(s.second)) + ", sizeof(" + s.second.getSparseIndType() + ")";
+
+                runnerLoadConnectivity << "if(strcmp(group, \"" << s.second.getName() << "\") == 0)";
+                {
+                    CodeStream::Scope b(runnerLoadConnectivity);
+#ifndef _WIN32
+                    // If backend uses host arrays directly, replace them with memory-mapped file
+                    if(backend.isArrayMappingSupported()) {
+                        const std::string mappingName = "connectivityMapping" + s.second.getName();
+                        runnerVarDecl << "void *" << mappingName << " = nullptr;" << std::endl;
+                        runnerVarDecl << "size_t " << mappingName << "Bytes = 0;" << std::endl;
+
+                        // Unmap any previously loaded file rather than freeing arrays
+                        runnerVarFree << "if(" << mappingName << " != nullptr)";
+                        {
+                            CodeStream::Scope b(runnerVarFree);
+                            runnerVarFree << "munmap(" << mappingName << ", " << mappingName << "Bytes);" << std::endl;
+                            runnerVarFree << mappingName << " = nullptr;" << std::endl;
+                            runnerVarFree << rowArrayName << " = nullptr;" << std::endl;
+                            runnerVarFree << indArrayName << " = nullptr;" << std::endl;
+                        }
+
+                        runnerLoadConnectivity << "size_t mappingBytes;" << std::endl;
+                        runnerLoadConnectivity << "void *mapping = mapConnectivityFile(path, " << dimensions << ", validate, mappingBytes);" << std::endl;
+                        runnerLoadConnectivity << "if(" << mappingName << " == nullptr)";
+                        {
+                            CodeStream::Scope b(runnerLoadConnectivity);
+                            backend.genVariableFree(runnerLoadConnectivity, rowArrayName, varLoc);
+                            backend.genVariableFree(runnerLoadConnectivity, indArrayName, varLoc);
+                        }
+                        runnerLoadConnectivity << "else";
+                        {
+                            CodeStream::Scope b(runnerLoadConnectivity);
+                            runnerLoadConnectivity << "munmap(" << mappingName << ", " << mappingName << "Bytes);" << std::endl;
+                        }
+                        runnerLoadConnectivity << mappingName << " = mapping;" << std::endl;
+                        runnerLoadConnectivity << mappingName << "Bytes = mappingBytes;" << std::endl;
+
+                        // Point arrays at row lengths and indices which follow header
+                        runnerLoadConnectivity << rowArrayName << " = reinterpret_cast<unsigned int*>(static_cast<char*>(mapping) + sizeof(ConnectivityFileHeader));" << std::endl;
+                        runnerLoadConnectivity << indArrayName << " = reinterpret_cast<" << s.second.getSparseIndType() << "*>(" << rowArrayName << " + " << rowArraySize << ");" << std::endl;
+
+                        // Update pointers in merged structures
+                        for(const auto &a : {rowArrayName, indArrayName}) {
+                            const auto mergedDestinations = mergedEGPs.find(backend.getArrayPrefix() + a);
+                            if(mergedDestinations != mergedEGPs.cend()) {
+                                for(const auto &v : mergedDestinations->second) {
+                                    const std::string pushFuncName = "pushMerged" + v.first + std::to_string(v.second.mergedGroupIndex) + v.second.fieldName + std::to_string(v.second.groupIndex) + "ToDevice();";
+                                    definitionsInternalFunc << "EXPORT_FUNC void " << pushFuncName << std::endl;
+                                    runnerLoadConnectivity << pushFuncName << std::endl;
+                                }
+                            }
+                        }
+                    }
+                    // Otherwise, read file into existing arrays
+                    else
+#endif
+                    {
+                        runnerLoadConnectivity << "readConnectivityFile(path, " << dimensions << ", validate, " << rowArrayName << ", " << indArrayName << ");" << std::endl;
+                    }
+                    runnerLoadConnectivity << "return;" << std::endl;
+                }
+            }
 
-            // Row lengths
+            // Row lengths or pointers
             mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
-                                    "unsigned int", "rowLength" + s.second.getName(), varLoc, s.second.getSrcNeuronGroup()->getNumNeurons());
+                                    "unsigned int", rowArrayName, varLoc, rowArraySize);
 
             // Target indices
             mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                     s.second.getSparseIndType(), "ind" + s.second.getName(), varLoc, size);
+            genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                               "unsigned int", rowArrayName, varLoc, rowArraySize);
+            genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                               s.second.getSparseIndType(), "ind" + s.second.getName(), varLoc, size);
 
             // **TODO** remap is not always required
             if(backend.isSynRemapRequired() && !s.second.getWUModel()->getSynapseDynamicsCode().empty()) {
@@ -1237,10 +2127,12 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
                 // **THINK** this is over-allocating
                 mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                         "unsigned int", "synRemap" + s.second.getName(), VarLocation::DEVICE, size + 1);
+                genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                                   "unsigned int", "synRemap" + s.second.getName(), VarLocation::DEVICE, size + 1);
             }
 
             // **TODO** remap is not always required
-            if(backend.isPostsynapticRemapRequired() && !s.second.getWUModel()->getLearnPostCode().empty()) {
+            if(backend.isPostsynapticRemapRequired(s.second)) {
                 const size_t postSize = (size_t)s.second.getTrgNeuronGroup()->getNumNeurons() * (size_t)s.second.getMaxSourceConnections();
 
                 // Allocate column lengths
@@ -1250,6 +2142,10 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
                 // Allocate remap
                 mem += backend.genArray(definitionsVar, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                                         "unsigned int", "remap" + s.second.getName(), VarLocation::DEVICE, postSize);
+                genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                                   "unsigned int", "colLength" + s.second.getName(), VarLocation::DEVICE, s.second.getTrgNeuronGroup()->getNumNeurons());
+                genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                                   "unsigned int", "remap" + s.second.getName(), VarLocation::DEVICE, postSize);
             }
 
             // Generate push and pull functions for sparse connectivity
@@ -1257,9 +2153,9 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
                                 backend.isAutomaticCopyEnabled(), s.second.getName() + "Connectivity", connectivityPushPullFunctions,
                 [&]()
                 {
-                    // Row lengths
+                    // Row lengths or pointers
                     backend.genVariablePushPull(runnerPushFunc, runnerPullFunc,
-                                                "unsigned int", "rowLength" + s.second.getName(), s.second.getSparseConnectivityLocation(), autoInitialized, s.second.getSrcNeuronGroup()->getNumNeurons());
+                                                "unsigned int", rowArrayName, s.second.getSparseConnectivityLocation(), autoInitialized, rowArraySize);
 
                     // Target indices
                     backend.genVariablePushPull(runnerPushFunc, runnerPullFunc,
@@ -1279,39 +2175,47 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
         // If weight update variables should be individual
         std::vector<std::string> synapseGroupStatePushPullFunctions;
         if (s.second.getMatrixType() & SynapseMatrixWeight::INDIVIDUAL) {
-            const size_t size = s.second.getSrcNeuronGroup()->getNumNeurons() * backend.getSynapticMatrixRowStride(s.second);
+            const size_t size = batchSize * ((s.second.getMatrixType() & SynapseMatrixConnectivity::CSR)
+                                             ? s.second.getMaxTotalConnections()
+                                             : (s.second.getSrcNeuronGroup()->getNumNeurons() * backend.getSynapticMatrixRowStride(s.second)));
 
             const auto wuVars = wu->getVars();
             for(size_t i = 0; i < wuVars.size(); i++) {
                 const bool autoInitialized = !s.second.getWUVarInitialisers()[i].getSnippet()->getCode().empty();
                 mem += genVariable(backend, definitionsVar, definitionsFunc, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
-                                runnerPushFunc, runnerPullFunc, wuVars[i].type, wuVars[i].name + s.second.getName(),
+                                runnerPushFunc, runnerPullFunc, s.second.getWUVarStorageType(i), wuVars[i].name + s.second.getName(),
                                 s.second.getWUVarLocation(i), autoInitialized, size, synapseGroupStatePushPullFunctions);
+                genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                                   s.second.getWUVarStorageType(i), wuVars[i].name + s.second.getName(), s.second.getWUVarLocation(i), size);
             }
         }
 
         // Presynaptic W.U.M. variables
-        const size_t preSize = (s.second.getDelaySteps() == NO_DELAY)
+        const size_t preSize = batchSize * ((s.second.getDelaySteps() == NO_DELAY)
                 ? s.second.getSrcNeuronGroup()->getNumNeurons()
-                : s.second.getSrcNeuronGroup()->getNumNeurons() * s.second.getSrcNeuronGroup()->getNumDelaySlots();
+                : s.second.getSrcNeuronGroup()->getNumNeurons() * s.second.getSrcNeuronGroup()->getNumDelaySlots());
         const auto wuPreVars = wu->getPreVars();
         for(size_t i = 0; i < wuPreVars.size(); i++) {
             const bool autoInitialized = !s.second.getWUPreVarInitialisers()[i].getSnippet()->getCode().empty();
             mem += genVariable(backend, definitionsVar, definitionsFunc, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                             runnerPushFunc, runnerPullFunc, wuPreVars[i].type, wuPreVars[i].name + s.second.getName(),
                             s.second.getWUPreVarLocation(i), autoInitialized, preSize, synapseGroupStatePushPullFunctions);
+            genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                               wuPreVars[i].type, wuPreVars[i].name + s.second.getName(), s.second.getWUPreVarLocation(i), preSize);
         }
 
         // Postsynaptic W.U.M. variables
-        const size_t postSize = (s.second.getBackPropDelaySteps() == NO_DELAY)
+        const size_t postSize = batchSize * ((s.second.getBackPropDelaySteps() == NO_DELAY)
                 ? s.second.getTrgNeuronGroup()->getNumNeurons()
-                : s.second.getTrgNeuronGroup()->getNumNeurons() * s.second.getTrgNeuronGroup()->getNumDelaySlots();
+                : s.second.getTrgNeuronGroup()->getNumNeurons() * s.second.getTrgNeuronGroup()->getNumDelaySlots());
         const auto wuPostVars = wu->getPostVars();
         for(size_t i = 0; i < wuPostVars.size(); i++) {
             const bool autoInitialized = !s.second.getWUPostVarInitialisers()[i].getSnippet()->getCode().empty();
             mem += genVariable(backend, definitionsVar, definitionsFunc, definitionsInternalVar, runnerVarDecl, runnerVarAlloc, runnerVarFree,
                             runnerPushFunc, runnerPullFunc, wuPostVars[i].type, wuPostVars[i].name + s.second.getName(),
                             s.second.getWUPostVarLocation(i), autoInitialized, postSize, synapseGroupStatePushPullFunctions);
+            genCheckpointArray(backend, runnerSaveState, runnerLoadState,
+                               wuPostVars[i].type, wuPostVars[i].name + s.second.getName(), s.second.getWUPostVarLocation(i), postSize);
         }
 
         // If this synapse group's postsynaptic models hasn't been merged (which makes pulling them somewhat ambiguous)
@@ -1323,7 +2227,7 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
                 [&]()
                 {
                     backend.genVariablePushPull(runnerPushFunc, runnerPullFunc, model.getPrecision(), "inSyn" + s.second.getName(), s.second.getInSynLocation(),
-                                                true, s.second.getTrgNeuronGroup()->getNumNeurons());
+                                                true, batchSize * s.second.getTrgNeuronGroup()->getNumNeurons());
                 });
 
             // If this synapse group has individual postsynaptic model variables
@@ -1336,7 +2240,7 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
                         [&]()
                         {
                             backend.genVariablePushPull(runnerPushFunc, runnerPullFunc, psmVars[i].type, psmVars[i].name + s.second.getName(), s.second.getPSVarLocation(i),
-                                                        autoInitialized, s.second.getTrgNeuronGroup()->getNumNeurons());
+                                                        autoInitialized, batchSize * s.second.getTrgNeuronGroup()->getNumNeurons());
                         });
                 }
             }
@@ -1402,6 +2306,10 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
     runner << runnerGetterFuncStream.str();
     runner << std::endl;
 
+    if(model.isPerformanceCountersEnabled()) {
+        genPerformanceCounters(runner, perfCountersStorage);
+    }
+
     if(!backend.isAutomaticCopyEnabled()) {
         // ---------------------------------------------------------------------
         // Function for copying all state to device
@@ -1494,6 +2402,115 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
     }
     runner << std::endl;
 
+    // ------------------------------------------------------------------------
+    // Functions to allocate and copy spike recording buffers
+    if(model.isRecordingInUse()) {
+        runner << "void allocateRecordingBuffers(unsigned int timesteps)";
+        {
+            CodeStream::Scope b(runner);
+            runner << "numRecordingTimesteps = timesteps;" << std::endl;
+            runner << runnerRecordingAllocStream.str();
+        }
+        runner << std::endl;
+
+        runner << "void pullRecordingBuffersFromDevice()";
+        {
+            CodeStream::Scope b(runner);
+            runner << runnerRecordingPullStream.str();
+        }
+        runner << std::endl;
+    }
+
+    // ------------------------------------------------------------------------
+    // Function to write entire simulation state to checkpoint file
+    runner << "void saveState(const char *path)";
+    {
+        CodeStream::Scope b(runner);
+        runner << "std::ofstream checkpoint(path, std::ios::binary);" << std::endl;
+        runner << "if(!checkpoint.good())";
+        {
+            CodeStream::Scope b(runner);
+            runner << "throw std::runtime_error(\"Unable to open checkpoint '\" + std::string(path) + \"' for writing\");" << std::endl;
+        }
+
+        // Write header containing format version and name of model
+        runner << "checkpoint.write(checkpointMagic, sizeof(checkpointMagic));" << std::endl;
+        runner << "checkpoint.write(reinterpret_cast<const char*>(&checkpointVersion), sizeof(uint32_t));" << std::endl;
+        runner << "writeCheckpointRecord(checkpoint, \"model\", \"" << model.getName() << "\", " << model.getName().size() << ");" << std::endl;
+
+        // Write time
+        runner << "writeCheckpointRecord(checkpoint, \"iT\", &iT, sizeof(unsigned long long));" << std::endl;
+        runner << "writeCheckpointRecord(checkpoint, \"t\", &t, sizeof(" << model.getTimePrecision() << "));" << std::endl;
+
+        // Write arrays and scalars followed by backend-specific state
+        runner << runnerSaveStateStream.str();
+        backend.genCheckpointSave(runner, modelMerged);
+        runner << "checkpoint.flush();" << std::endl;
+        runner << "if(!checkpoint.good())";
+        {
+            CodeStream::Scope b(runner);
+            runner << "throw std::runtime_error(\"Error writing checkpoint '\" + std::string(path) + \"'\");" << std::endl;
+        }
+    }
+    runner << std::endl;
+
+    // ------------------------------------------------------------------------
+    // Function to restore entire simulation state from checkpoint file
+    runner << "void loadState(const char *path)";
+    {
+        CodeStream::Scope b(runner);
+        runner << "std::ifstream checkpoint(path, std::ios::binary);" << std::endl;
+        runner << "if(!checkpoint.good())";
+        {
+            CodeStream::Scope b(runner);
+            runner << "throw std::runtime_error(\"Unable to open checkpoint '\" + std::string(path) + \"' for reading\");" << std::endl;
+        }
+
+        // Check header
+        runner << "char magic[sizeof(checkpointMagic)];" << std::endl;
+        runner << "uint32_t version = 0;" << std::endl;
+        runner << "checkpoint.read(magic, sizeof(checkpointMagic));" << std::endl;
+        runner << "checkpoint.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));" << std::endl;
+        runner << "if(!checkpoint.good() || memcmp(magic, checkpointMagic, sizeof(checkpointMagic)) != 0)";
+        {
+            CodeStream::Scope b(runner);
+            runner << "throw std::runtime_error(\"'\" + std::string(path) + \"' is not a GeNN checkpoint\");" << std::endl;
+        }
+        runner << "if(version != checkpointVersion)";
+        {
+            CodeStream::Scope b(runner);
+            runner << "throw std::runtime_error(\"Checkpoint '\" + std::string(path) + \"' has unsupported version \" + std::to_string(version));" << std::endl;
+        }
+        runner << "std::string modelName(readCheckpointRecordHeader(checkpoint, \"model\"), '\\0');" << std::endl;
+        runner << "readCheckpointRecordData(checkpoint, &modelName[0], modelName.size());" << std::endl;
+        runner << "if(modelName != \"" << model.getName() << "\")";
+        {
+            CodeStream::Scope b(runner);
+            runner << "throw std::runtime_error(\"Checkpoint '\" + std::string(path) + \"' was saved from model '\" + modelName + \"'\");" << std::endl;
+        }
+
+        // Read time
+        runner << "readCheckpointRecord(checkpoint, \"iT\", &iT, sizeof(unsigned long long));" << std::endl;
+        runner << "readCheckpointRecord(checkpoint, \"t\", &t, sizeof(" << model.getTimePrecision() << "));" << std::endl;
+
+        // Read arrays and scalars followed by backend-specific state
+        runner << runnerLoadStateStream.str();
+        backend.genCheckpointLoad(runner, modelMerged);
+    }
+    runner << std::endl;
+
+    // ------------------------------------------------------------------------
+    // Function to load sparse connectivity from connectivity file
+    if(isConnectivityFileLoadable(model)) {
+        runner << "void loadConnectivityFromFile(const char *group, const char *path, bool validate)";
+        {
+            CodeStream::Scope b(runner);
+            runner << runnerLoadConnectivityStream.str();
+            runner << "throw std::runtime_error(\"No synapse group '\" + std::string(group) + \"' with sparse connectivity to load\");" << std::endl;
+        }
+        runner << std::endl;
+    }
+
     // ------------------------------------------------------------------------
     // Function to free all global memory structures
     runner << "void freeMem()";
@@ -1573,8 +2590,26 @@ MemAlloc CodeGenerator::generateRunner(CodeStream &definitions, CodeStream &defi
     }
     definitions << "EXPORT_FUNC void allocateMem();" << std::endl;
     definitions << "EXPORT_FUNC void freeMem();" << std::endl;
+    if(model.isRecordingInUse()) {
+        definitions << "EXPORT_FUNC void allocateRecordingBuffers(unsigned int timesteps);" << std::endl;
+        definitions << "EXPORT_FUNC void pullRecordingBuffersFromDevice();" << std::endl;
+    }
+    definitions << "EXPORT_FUNC void saveState(const char *path);" << std::endl;
+    definitions << "EXPORT_FUNC void loadState(const char *path);" << std::endl;
+    if(isConnectivityFileLoadable(model)) {
+        definitions << "// **NOTE** validating checks every row length and index in file so can be skipped for trusted files" << std::endl;
+        definitions << "EXPORT_FUNC void loadConnectivityFromFile(const char *group, const char *path, bool validate = true);" << std::endl;
+    }
     definitions << "EXPORT_FUNC size_t getFreeDeviceMemBytes();" << std::endl;
     definitions << "EXPORT_FUNC void stepTime();" << std::endl;
+    if(model.isPerformanceCountersEnabled()) {
+        definitions << "EXPORT_FUNC const PerformanceCounter *getPerformanceCounters(unsigned int *numCounters);" << std::endl;
+        definitions << "EXPORT_FUNC void resetPerformanceCounters();" << std::endl;
+        definitions << "EXPORT_FUNC void setPerformanceTraceEnabled(bool enabled);" << std::endl;
+        definitions << "EXPORT_FUNC void writePerformanceTrace(const char *path);" << std::endl;
+
+        definitionsInternal << "EXPORT_FUNC void recordPerformanceCounter(unsigned int counter, std::chrono::high_resolution_clock::time_point start, unsigned long long numSpikes, unsigned long long numSynapticEvents);" << std::endl;
+    }
     definitions << std::endl;
     definitions << "// Functions generated by backend" << std::endl;
     definitions << "EXPORT_FUNC void updateNeurons(" << model.getTimePrecision() << " t);" << std::endl;
@@ -39,9 +39,13 @@ void applySynapseSubstitutions(CodeGenerator::CodeStream &os, std::string code,
                                        "[" + delayedPostIdx + "]");
 
     // If weights are individual, substitute variables for values stored in global memory
+    // **NOTE** variables stored in reduced-precision formats are widened as they are read
     if (sg.getMatrixType() & SynapseMatrixWeight::INDIVIDUAL) {
-        synapseSubs.addVarNameSubstitution(wu->getVars(), "", "group.",
-                                           "[" + synapseSubs["id_syn"] + "]");
+        const auto vars = wu->getVars();
+        for(size_t i = 0; i < vars.size(); i++) {
+            synapseSubs.addVarSubstitution(vars[i].name,
+                                           CodeGenerator::getWUVarLoad(sg, i, "group." + vars[i].name + "[" + synapseSubs["id_syn"] + "]"));
+        }
     }
     // Otherwise, if weights are procedual
     else if (sg.getMatrixType() & SynapseMatrixWeight::PROCEDURAL) {
@@ -93,7 +97,7 @@ void applySynapseSubstitutions(CodeGenerator::CodeStream &os, std::string code,
 // CodeGenerator
 //--------------------------------------------------------------------------
 void CodeGenerator::generateSynapseUpdate(CodeStream &os, const MergedEGPMap &mergedEGPs, const ModelSpecMerged &modelMerged, const BackendBase &backend,
-                                          bool standaloneModules)
+                                          bool standaloneModules, BackendBase::ShardHandler shardHandler)
 {
     if(standaloneModules) {
         os << "#include \"runner.cc\"" << std::endl;
@@ -208,5 +212,6 @@ void CodeGenerator::generateSynapseUpdate(CodeStream &os, const MergedEGPMap &me
             genScalarEGPPush(os, mergedEGPs, "PresynapticUpdate", backend);
             genScalarEGPPush(os, mergedEGPs, "PostsynapticUpdate", backend);
             genScalarEGPPush(os, mergedEGPs, "SynapseDynamics", backend);
-        });
+        },
+        shardHandler);
 }
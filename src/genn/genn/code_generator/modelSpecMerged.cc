@@ -1,5 +1,9 @@
 #include "code_generator/modelSpecMerged.h"
 
+// Standard C++ includes
+#include <algorithm>
+#include <unordered_map>
+
 // PLOG includes
 #include <plog/Log.h>
 
@@ -14,47 +18,54 @@
 //----------------------------------------------------------------------------
 namespace
 {
-template<typename Group, typename MergedGroup, typename M>
-void createMergedGroups(std::vector<std::reference_wrapper<const Group>> &unmergedGroups,
-                        std::vector<MergedGroup> &mergedGroups, M canMerge)
+template<typename Group, typename MergedGroup, typename H, typename M>
+void createMergedGroups(const std::vector<std::reference_wrapper<const Group>> &unmergedGroups,
+                        std::vector<MergedGroup> &mergedGroups, H getHashDigest, M canMerge)
 {
-    // Loop through un-merged  groups
-    while(!unmergedGroups.empty()) {
-        // Remove last group from vector
-        const Group &group = unmergedGroups.back().get();
-        unmergedGroups.pop_back();
-
-        // Start vector of groups that can be merged
-        std::vector<std::reference_wrapper<const Group>> mergeTargets{group};
-
-        // Loop through other remaining unmerged groups
-        for(auto otherGroup = unmergedGroups.begin(); otherGroup != unmergedGroups.end();) {
-            // If this 'other' group can be merged with original
-            if(canMerge(group, otherGroup->get())) {
-                LOGD << "\tMerging group '" << otherGroup->get().getName() << "' with '" << group.getName() << "'";
-
-                // Add to list of merge targets
-                mergeTargets.push_back(otherGroup->get());
-
-                // Remove from unmerged list
-                otherGroup = unmergedGroups.erase(otherGroup);
-            }
-            // Otherwise, advance to next group
-            else {
-                LOGD << "\tUnable to merge group '" << otherGroup->get().getName() << "' with '" << group.getName() << "'";
-                ++otherGroup;
-            }
+    // Groups which can be merged are guaranteed to have the same hash digest so, by bucketing groups by their digests,
+    // each group only needs testing for mergability against the archetypes of merged groups with the same digest
+    std::vector<std::vector<std::reference_wrapper<const Group>>> mergeTargets;
+    std::unordered_map<uint64_t, std::vector<size_t>> digestMergeTargets;
+
+    // Loop through un-merged groups **backwards** so merged groups are created in the same order as they
+    // would be if each group was instead compared with the last remaining group until all are merged
+    for(auto g = unmergedGroups.crbegin(); g != unmergedGroups.crend(); ++g) {
+        const Group &group = g->get();
+        auto &bucket = digestMergeTargets[getHashDigest(group)];
+
+        // Search bucket for merged group whose archetype this group can be merged with
+        const auto target = std::find_if(bucket.cbegin(), bucket.cend(),
+                                         [&canMerge, &group, &mergeTargets](size_t t)
+                                         {
+                                             return canMerge(mergeTargets[t].front().get(), group);
+                                         });
+
+        // If one was found, add group to its merge targets
+        if(target != bucket.cend()) {
+            LOGD << "\tMerging group '" << group.getName() << "' with '" << mergeTargets[*target].front().get().getName() << "'";
+            mergeTargets[*target].push_back(group);
+        }
+        // Otherwise, start new merged group with this group as the archetype
+        else {
+            bucket.push_back(mergeTargets.size());
+            mergeTargets.emplace_back();
+            mergeTargets.back().push_back(group);
         }
+    }
 
-        // A new merged neuron group to model
-        mergedGroups.emplace_back(mergedGroups.size(), mergeTargets);
+    // Loop through merge targets
+    for(auto &m : mergeTargets) {
+        // Restore original order of groups merged with archetype
+        std::reverse(m.begin() + 1, m.end());
 
+        // A new merged group to model
+        mergedGroups.emplace_back(mergedGroups.size(), m);
     }
 }
 //----------------------------------------------------------------------------
-template<typename Group, typename MergedGroup, typename F, typename M>
+template<typename Group, typename MergedGroup, typename F, typename H, typename M>
 void createMergedGroups(const std::map<std::string, Group> &groups, std::vector<MergedGroup> &mergedGroups,
-                        F filter, M canMerge)
+                        F filter, H getHashDigest, M canMerge)
 {
     // Build temporary vector of references to groups that pass filter
     std::vector<std::reference_wrapper<const Group>> unmergedGroups;
@@ -65,7 +76,7 @@ void createMergedGroups(const std::map<std::string, Group> &groups, std::vector<
     }
 
     // Merge filtered vector
-    createMergedGroups(unmergedGroups, mergedGroups, canMerge);
+    createMergedGroups(unmergedGroups, mergedGroups, getHashDigest, canMerge);
 }
 }   // Anonymous namespace
 
@@ -80,26 +91,31 @@ CodeGenerator::ModelSpecMerged::ModelSpecMerged(const ModelSpecInternal &model,
     LOGD << "Merging neuron update groups:";
     createMergedGroups(model.getNeuronGroups(), m_MergedNeuronUpdateGroups,
                        [](const NeuronGroupInternal &){ return true; },
+                       [](const NeuronGroupInternal &ng){ return ng.getMergeHashDigest(); },
                        [](const NeuronGroupInternal &a, const NeuronGroupInternal &b){ return a.canBeMerged(b); });
 
     LOGD << "Merging presynaptic update groups:";
     createMergedGroups(model.getSynapseGroups(), m_MergedPresynapticUpdateGroups,
                        [](const SynapseGroupInternal &sg){ return (sg.isSpikeEventRequired() || sg.isTrueSpikeRequired()); },
+                       [](const SynapseGroupInternal &sg){ return sg.getWUMergeHashDigest(); },
                        [](const SynapseGroupInternal &a, const SynapseGroupInternal &b){ return a.canWUBeMerged(b); });
 
     LOGD << "Merging postsynaptic update groups:";
     createMergedGroups(model.getSynapseGroups(), m_MergedPostsynapticUpdateGroups,
                        [](const SynapseGroupInternal &sg){ return !sg.getWUModel()->getLearnPostCode().empty(); },
+                       [](const SynapseGroupInternal &sg){ return sg.getWUMergeHashDigest(); },
                        [](const SynapseGroupInternal &a, const SynapseGroupInternal &b){ return a.canWUBeMerged(b); });
 
     LOGD << "Merging synapse dynamics update groups:";
     createMergedGroups(model.getSynapseGroups(), m_MergedSynapseDynamicsGroups,
                        [](const SynapseGroupInternal &sg){ return !sg.getWUModel()->getSynapseDynamicsCode().empty(); },
+                       [](const SynapseGroupInternal &sg){ return sg.getWUMergeHashDigest(); },
                        [](const SynapseGroupInternal &a, const SynapseGroupInternal &b){ return a.canWUBeMerged(b); });
 
     LOGD << "Merging neuron initialization groups:";
     createMergedGroups(model.getNeuronGroups(), m_MergedNeuronInitGroups,
                        [](const NeuronGroupInternal &){ return true; },
+                       [](const NeuronGroupInternal &ng){ return ng.getInitMergeHashDigest(); },
                        [](const NeuronGroupInternal &a, const NeuronGroupInternal &b){ return a.canInitBeMerged(b); });
 
     LOGD << "Merging synapse dense initialization groups:";
@@ -108,27 +124,44 @@ CodeGenerator::ModelSpecMerged::ModelSpecMerged(const ModelSpecInternal &model,
                        {
                            return ((sg.getMatrixType() & SynapseMatrixConnectivity::DENSE) && sg.isWUVarInitRequired());
                        },
+                       [](const SynapseGroupInternal &sg){ return sg.getWUInitMergeHashDigest(); },
                        [](const SynapseGroupInternal &a, const SynapseGroupInternal &b){ return a.canWUInitBeMerged(b); });
 
     LOGD << "Merging synapse connectivity initialisation groups:";
     createMergedGroups(model.getSynapseGroups(), m_MergedSynapseConnectivityInitGroups,
                        [](const SynapseGroupInternal &sg){ return sg.isSparseConnectivityInitRequired(); },
+                       [](const SynapseGroupInternal &sg){ return sg.getConnectivityInitMergeHashDigest(); },
                        [](const SynapseGroupInternal &a, const SynapseGroupInternal &b){ return a.canConnectivityInitBeMerged(b); });
 
     LOGD << "Merging synapse sparse initialization groups:";
     createMergedGroups(model.getSynapseGroups(), m_MergedSynapseSparseInitGroups,
                        [&backend](const SynapseGroupInternal &sg)
                        {
-                           return ((sg.getMatrixType() & SynapseMatrixConnectivity::SPARSE) && 
+                           return (((sg.getMatrixType() & SynapseMatrixConnectivity::SPARSE) || (sg.getMatrixType() & SynapseMatrixConnectivity::CSR)) &&
                                    (sg.isWUVarInitRequired()
                                     || (backend.isSynRemapRequired() && !sg.getWUModel()->getSynapseDynamicsCode().empty())
-                                    || (backend.isPostsynapticRemapRequired() && !sg.getWUModel()->getLearnPostCode().empty())));
+                                    || backend.isPostsynapticRemapRequired(sg)));
                        },
-                       [](const SynapseGroupInternal &a, const SynapseGroupInternal &b){ return a.canWUInitBeMerged(b); });
+                       [&backend](const SynapseGroupInternal &sg)
+                       {
+                           // **NOTE** whether postsynaptic remap is built depends on backend so can't be included in group's own digest
+                           return Utils::hashValue(backend.isPostsynapticRemapRequired(sg), sg.getWUInitMergeHashDigest());
+                       },
+                       [&backend](const SynapseGroupInternal &a, const SynapseGroupInternal &b)
+                       {
+                           return (a.canWUInitBeMerged(b)
+                                   && (backend.isPostsynapticRemapRequired(a) == backend.isPostsynapticRemapRequired(b)));
+                       });
 
     LOGD << "Merging neuron groups which require their spike queues updating:";
     createMergedGroups(model.getNeuronGroups(), m_MergedNeuronSpikeQueueUpdateGroups,
                        [](const NeuronGroupInternal &){ return true; },
+                       [](const NeuronGroupInternal &ng)
+                       {
+                           uint64_t hash = Utils::hashValue(ng.getNumDelaySlots());
+                           hash = Utils::hashValue(ng.isSpikeEventRequired(), hash);
+                           return Utils::hashValue(ng.isTrueSpikeRequired(), hash);
+                       },
                        [](const NeuronGroupInternal &a, const NeuronGroupInternal &b)
                        {
                            return ((a.getNumDelaySlots() == b.getNumDelaySlots())
@@ -147,6 +180,7 @@ CodeGenerator::ModelSpecMerged::ModelSpecMerged(const ModelSpecInternal &model,
     }
     LOGD << "Merging synapse groups which require their dendritic delay updating:";
     createMergedGroups(synapseGroupsWithDendriticDelay, m_MergedSynapseDendriticDelayUpdateGroups,
+                       [](const SynapseGroupInternal &sg){ return Utils::hashValue(sg.getMaxDendriticDelayTimesteps()); },
                        [](const SynapseGroupInternal &a, const SynapseGroupInternal &b)
                        {
                            return (a.getMaxDendriticDelayTimesteps() == b.getMaxDendriticDelayTimesteps());
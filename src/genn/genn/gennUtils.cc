@@ -81,4 +81,19 @@ std::string getUnderlyingType(const std::string &type)
     // Return string without last character
     return type.substr(0, type.length() - 1);
 }
+//--------------------------------------------------------------------------
+uint64_t hashString(const std::string &string, uint64_t hash)
+{
+    return hashBytes(string.data(), string.size(), hash);
+}
+//--------------------------------------------------------------------------
+uint64_t hashBytes(const void *data, size_t size, uint64_t hash)
+{
+    const uint8_t *bytes = static_cast<const uint8_t*>(data);
+    for(size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
 }   // namespace utils
@@ -34,7 +34,7 @@
 // ------------------------------------------------------------------------
 // class ModelSpec for specifying a neuronal network model
 ModelSpec::ModelSpec()
-:   m_TimePrecision(TimePrecision::DEFAULT), m_DT(0.5), m_TimingEnabled(false), m_Seed(0),
+:   m_TimePrecision(TimePrecision::DEFAULT), m_DT(0.5), m_TimingEnabled(false), m_PerformanceCountersEnabled(false), m_Seed(0), m_BatchSize(1),
     m_DefaultVarLocation(VarLocation::HOST_DEVICE), m_DefaultExtraGlobalParamLocation(VarLocation::HOST_DEVICE),
     m_DefaultSparseConnectivityLocation(VarLocation::HOST_DEVICE), m_DefaultNarrowSparseIndEnabled(false),
     m_ShouldMergePostsynapticModels(false)
@@ -122,6 +122,14 @@ void ModelSpec::setPrecision(FloatType floattype /**<  */)
     }
 }
 
+void ModelSpec::setBatchSize(unsigned int batchSize)
+{
+    if(batchSize == 0) {
+        throw std::runtime_error("Batch size must be at least 1.");
+    }
+    m_BatchSize = batchSize;
+}
+
 
 void ModelSpec::finalize()
 {
@@ -207,6 +215,45 @@ void ModelSpec::finalize()
             }
         }
     }
+
+    // Check event-driven neuron groups only use features which don't require updating every timestep
+    for(const auto &n : m_LocalNeuronGroups) {
+        if(n.second.isEventDriven()) {
+            const std::string prefix = "Event-driven neuron group '" + n.first + "'";
+            if(n.second.getNeuronModel()->getQuiescentStepsCode().empty()) {
+                throw std::runtime_error(prefix + " requires a neuron model with quiescent steps code");
+            }
+            if(!n.second.getCurrentSources().empty()) {
+                throw std::runtime_error(prefix + " cannot have current sources");
+            }
+            if(n.second.isSpikeEventRequired()) {
+                throw std::runtime_error(prefix + " cannot emit spike-like events");
+            }
+            if(m_BatchSize > 1) {
+                throw std::runtime_error(prefix + " cannot be simulated in batches");
+            }
+
+            // Delayed copies of state must be written every timestep
+            for(size_t i = 0; i < n.second.getNeuronModel()->getVars().size(); i++) {
+                if(n.second.isVarQueueRequired(i)) {
+                    throw std::runtime_error(prefix + " cannot have state variables accessed with delay");
+                }
+            }
+            if(n.second.isDelayRequired() && (n.second.isSpikeTimeRequired()
+                                              || !n.second.getOutSynWithPreCode().empty()
+                                              || !n.second.getInSynWithPostCode().empty()))
+            {
+                throw std::runtime_error(prefix + " cannot have delayed spike times or weight update model variables");
+            }
+
+            // Postsynaptic models with state may provide input even when inSyn is zero
+            for(const auto &m : n.second.getMergedInSyn()) {
+                if(!m.first->getPSModel()->getVars().empty()) {
+                    throw std::runtime_error(prefix + " cannot have incoming synapse groups whose postsynaptic models have variables");
+                }
+            }
+        }
+    }
 }
 
 std::string ModelSpec::scalarExpr(double val) const
@@ -242,6 +289,13 @@ bool ModelSpec::zeroCopyInUse() const
     return false;
 }
 
+bool ModelSpec::isRecordingInUse() const
+{
+    // Return true if any neuron groups record spikes
+    return any_of(begin(m_LocalNeuronGroups), end(m_LocalNeuronGroups),
+                  [](const NeuronGroupValueType &n){ return n.second.isSpikeRecordingEnabled(); });
+}
+
 NeuronGroupInternal *ModelSpec::findNeuronGroupInternal(const std::string &name)
 {
     // If a matching local neuron group is found, return it
@@ -326,6 +326,8 @@ bool NeuronGroup::canBeMerged(const NeuronGroup &other) const
        && (isSpikeTimeRequired() == other.isSpikeTimeRequired())
        && (getSpikeEventCondition() == other.getSpikeEventCondition())
        && (isSpikeEventRequired() == other.isSpikeEventRequired())
+       && (isSpikeRecordingEnabled() == other.isSpikeRecordingEnabled())
+       && (isEventDriven() == other.isEventDriven())
        && (getNumDelaySlots() == other.getNumDelaySlots())
        && (m_VarQueueRequired == other.m_VarQueueRequired))
     {
@@ -385,6 +387,7 @@ bool NeuronGroup::canInitBeMerged(const NeuronGroup &other) const
 {
     if((isSpikeTimeRequired() == other.isSpikeTimeRequired())
        && (isSpikeEventRequired() == other.isSpikeEventRequired())
+       && (isEventDriven() == other.isEventDriven())
        && (getNumDelaySlots() == other.getNumDelaySlots())
        && (m_VarQueueRequired == other.m_VarQueueRequired)
        && (getNeuronModel()->getVars() == other.getNeuronModel()->getVars()))
@@ -448,6 +451,64 @@ bool NeuronGroup::canInitBeMerged(const NeuronGroup &other) const
     return false;
 }
 //----------------------------------------------------------------------------
+uint64_t NeuronGroup::getMergeHashDigest() const
+{
+    // Hash neuron model code
+    uint64_t hash = Utils::hashString(getNeuronModel()->getSimCode());
+    hash = Utils::hashString(getNeuronModel()->getThresholdConditionCode(), hash);
+    hash = Utils::hashString(getNeuronModel()->getResetCode(), hash);
+    hash = Utils::hashString(getNeuronModel()->getSupportCode(), hash);
+    hash = Utils::hashString(getNeuronModel()->getCatchUpCode(), hash);
+    hash = Utils::hashString(getNeuronModel()->getQuiescentStepsCode(), hash);
+
+    // Hash parameters and properties which must match exactly
+    hash = Utils::hashValue(getParams(), hash);
+    hash = Utils::hashValue(getDerivedParams(), hash);
+    hash = Utils::hashValue(isSpikeTimeRequired(), hash);
+    hash = Utils::hashValue(isSpikeEventRequired(), hash);
+    hash = Utils::hashValue(isSpikeRecordingEnabled(), hash);
+    hash = Utils::hashValue(isEventDriven(), hash);
+    hash = Utils::hashValue(getNumDelaySlots(), hash);
+    hash = Utils::hashValue(m_VarQueueRequired, hash);
+
+    // Hash code of spike event conditions (these are compared in order)
+    for(const auto &s : getSpikeEventCondition()) {
+        hash = Utils::hashString(s.eventThresholdCode, hash);
+        hash = Utils::hashString(s.supportCode, hash);
+    }
+
+    // Child groups are compared unordered so only their number can be hashed
+    hash = Utils::hashValue(getCurrentSources().size(), hash);
+    hash = Utils::hashValue(getInSynWithPostCode().size(), hash);
+    hash = Utils::hashValue(getOutSynWithPreCode().size(), hash);
+    return Utils::hashValue(getMergedInSyn().size(), hash);
+}
+//----------------------------------------------------------------------------
+uint64_t NeuronGroup::getInitMergeHashDigest() const
+{
+    uint64_t hash = Utils::hashValue(isSpikeTimeRequired());
+    hash = Utils::hashValue(isSpikeEventRequired(), hash);
+    hash = Utils::hashValue(isEventDriven(), hash);
+    hash = Utils::hashValue(getNumDelaySlots(), hash);
+    hash = Utils::hashValue(m_VarQueueRequired, hash);
+
+    // Hash variables and the code used to initialise them
+    // **NOTE** parameters are only compared if they are referenced by the code so can't be hashed
+    const auto vars = getNeuronModel()->getVars();
+    for(size_t i = 0; i < vars.size(); i++) {
+        hash = Utils::hashString(vars[i].name, hash);
+        hash = Utils::hashString(vars[i].type, hash);
+        hash = Utils::hashValue(static_cast<unsigned int>(vars[i].access), hash);
+        hash = Utils::hashString(getVarInitialisers()[i].getSnippet()->getCode(), hash);
+    }
+
+    // Child groups are compared unordered so only their number can be hashed
+    hash = Utils::hashValue(getCurrentSources().size(), hash);
+    hash = Utils::hashValue(getInSynWithPostCode().size(), hash);
+    hash = Utils::hashValue(getOutSynWithPreCode().size(), hash);
+    return Utils::hashValue(getMergedInSyn().size(), hash);
+}
+//----------------------------------------------------------------------------
 void NeuronGroup::updateVarQueues(const std::string &code, const std::string &suffix)
 {
     // Loop through variables
@@ -25,5 +25,7 @@ bool NeuronModels::Base::canBeMerged(const Base *other) const
             && (getResetCode() == other->getResetCode())
             && (getSupportCode() == other->getSupportCode())
             && (isAutoRefractoryRequired() == other->isAutoRefractoryRequired())
+            && (getCatchUpCode() == other->getCatchUpCode())
+            && (getQuiescentStepsCode() == other->getQuiescentStepsCode())
             && (getAdditionalInputVars() == other->getAdditionalInputVars()));
 }
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 
 // GeNN includes
 #include "neuronGroupInternal.h"
@@ -45,6 +46,26 @@ void SynapseGroup::setWUVarLocation(const std::string &varName, VarLocation loc)
     m_WUVarLocation[getWUModel()->getVarIndex(varName)] = loc;
 }
 //----------------------------------------------------------------------------
+void SynapseGroup::setWUVarStorage(const std::string &varName, VarStorage storage, double scale)
+{
+    const size_t varIndex = getWUModel()->getVarIndex(varName);
+    if(storage != VarStorage::NATIVE) {
+        const auto &var = getWUModel()->getVars()[varIndex];
+        if(!(getMatrixType() & SynapseMatrixWeight::INDIVIDUAL)) {
+            throw std::runtime_error("setWUVarStorage: Reduced-precision storage can only be used on synapse groups with individual weights.");
+        }
+        if(var.access != VarAccess::READ_ONLY) {
+            throw std::runtime_error("setWUVarStorage: Reduced-precision storage can only be used for read-only variables.");
+        }
+        if(var.type != "scalar" && var.type != "float" && var.type != "double") {
+            throw std::runtime_error("setWUVarStorage: Reduced-precision storage can only be used for floating point variables.");
+        }
+    }
+
+    m_WUVarStorage[varIndex] = storage;
+    m_WUVarStorageScale[varIndex] = scale;
+}
+//----------------------------------------------------------------------------
 void SynapseGroup::setWUPreVarLocation(const std::string &varName, VarLocation loc)
 {
     m_WUPreVarLocation[getWUModel()->getPreVarIndex(varName)] = loc;
@@ -89,7 +110,7 @@ void SynapseGroup::setSparseConnectivityExtraGlobalParamLocation(const std::stri
 //----------------------------------------------------------------------------
 void SynapseGroup::setMaxConnections(unsigned int maxConnections)
 {
-    if (getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
+    if ((getMatrixType() & SynapseMatrixConnectivity::SPARSE) || (getMatrixType() & SynapseMatrixConnectivity::CSR)) {
         if(m_ConnectivityInitialiser.getSnippet()->getCalcMaxRowLengthFunc()) {
             throw std::runtime_error("setMaxConnections: Synapse group already has max connections defined by connectivity initialisation snippet.");
         }
@@ -103,7 +124,7 @@ void SynapseGroup::setMaxConnections(unsigned int maxConnections)
 //----------------------------------------------------------------------------
 void SynapseGroup::setMaxSourceConnections(unsigned int maxConnections)
 {
-    if (getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
+    if ((getMatrixType() & SynapseMatrixConnectivity::SPARSE) || (getMatrixType() & SynapseMatrixConnectivity::CSR)) {
         if(m_ConnectivityInitialiser.getSnippet()->getCalcMaxColLengthFunc()) {
             throw std::runtime_error("setMaxSourceConnections: Synapse group already has max source connections defined by connectivity initialisation snippet.");
         }
@@ -115,6 +136,16 @@ void SynapseGroup::setMaxSourceConnections(unsigned int maxConnections)
     }
 }
 //----------------------------------------------------------------------------
+void SynapseGroup::setMaxTotalConnections(unsigned int maxTotalConnections)
+{
+    if (getMatrixType() & SynapseMatrixConnectivity::CSR) {
+        m_MaxTotalConnections = maxTotalConnections;
+    }
+    else {
+        throw std::runtime_error("setMaxTotalConnections: This function can only be used on synapse groups with CSR connectivity.");
+    }
+}
+//----------------------------------------------------------------------------
 void SynapseGroup::setMaxDendriticDelayTimesteps(unsigned int maxDendriticDelayTimesteps)
 {
     // **TODO** constraints on this
@@ -123,11 +154,13 @@ void SynapseGroup::setMaxDendriticDelayTimesteps(unsigned int maxDendriticDelayT
 //----------------------------------------------------------------------------
 void SynapseGroup::setSpanType(SpanType spanType)
 {
-    if ((getMatrixType() & SynapseMatrixConnectivity::SPARSE) || (getMatrixType() & SynapseMatrixConnectivity::PROCEDURAL)) {
+    if ((getMatrixType() & SynapseMatrixConnectivity::SPARSE) || (getMatrixType() & SynapseMatrixConnectivity::PROCEDURAL)
+        || (getMatrixType() & SynapseMatrixConnectivity::DENSE) || (getMatrixType() & SynapseMatrixConnectivity::BITMASK))
+    {
         m_SpanType = spanType;
     }
     else {
-        throw std::runtime_error("setSpanType: This function can only be used on synapse groups with sparse or bitmask connectivity.");
+        throw std::runtime_error("setSpanType: This function can only be used on synapse groups with sparse, procedural, dense or bitmask connectivity.");
     }
 }
 //----------------------------------------------------------------------------
@@ -150,7 +183,7 @@ void SynapseGroup::setBackPropDelaySteps(unsigned int timesteps)
 //----------------------------------------------------------------------------
 void SynapseGroup::setNarrowSparseIndEnabled(bool enabled)
 {
-    if (getMatrixType() & SynapseMatrixConnectivity::SPARSE) {
+    if ((getMatrixType() & SynapseMatrixConnectivity::SPARSE) || (getMatrixType() & SynapseMatrixConnectivity::CSR)) {
         m_NarrowSparseIndEnabled = enabled;
     }
     else {
@@ -158,6 +191,25 @@ void SynapseGroup::setNarrowSparseIndEnabled(bool enabled)
     }
 }
 //----------------------------------------------------------------------------
+unsigned int SynapseGroup::getMaxTotalConnections() const
+{
+    // If maximum number of synapses has been set explicitly, use it
+    if(m_MaxTotalConnections != 0) {
+        return m_MaxTotalConnections;
+    }
+
+    // Otherwise, allow every source neuron to make the maximum number of connections
+    // **NOTE** this is calculated in 64-bit as it can easily overflow for large populations
+    const uint64_t maxTotalConnections = (uint64_t)getSrcNeuronGroup()->getNumNeurons() * (uint64_t)getMaxConnections();
+
+    // Check it can be indexed by the unsigned int row pointers
+    if(maxTotalConnections > std::numeric_limits<unsigned int>::max()) {
+        throw std::runtime_error("Synapse group '" + getName() + "' can have up to " + std::to_string(maxTotalConnections)
+                                 + " synapses which cannot be indexed with CSR connectivity - use setMaxTotalConnections to reduce this");
+    }
+    return (unsigned int)maxTotalConnections;
+}
+//----------------------------------------------------------------------------
 bool SynapseGroup::isTrueSpikeRequired() const
 {
     return !getWUModel()->getSimCode().empty();
@@ -216,6 +268,27 @@ VarLocation SynapseGroup::getWUVarLocation(const std::string &var) const
     return m_WUVarLocation[getWUModel()->getVarIndex(var)];
 }
 //----------------------------------------------------------------------------
+std::string SynapseGroup::getWUVarStorageType(size_t index) const
+{
+    switch(getWUVarStorage(index)) {
+    case VarStorage::HALF:
+    case VarStorage::BFLOAT16:
+        return "uint16_t";
+    case VarStorage::FIXED8:
+        return "int8_t";
+    case VarStorage::FIXED16:
+        return "int16_t";
+    default:
+        return getWUModel()->getVars()[index].type;
+    }
+}
+//----------------------------------------------------------------------------
+bool SynapseGroup::isWUVarStorageReduced() const
+{
+    return std::any_of(m_WUVarStorage.cbegin(), m_WUVarStorage.cend(),
+                       [](VarStorage s){ return (s != VarStorage::NATIVE); });
+}
+//----------------------------------------------------------------------------
 VarLocation SynapseGroup::getWUPreVarLocation(const std::string &var) const
 {
     return m_WUPreVarLocation[getWUModel()->getPreVarIndex(var)];
@@ -281,7 +354,8 @@ bool SynapseGroup::isWUInitRNGRequired() const
     }
 
     // Return true if matrix has sparse or bitmask connectivity and an RNG is required to initialise connectivity
-    return (((m_MatrixType & SynapseMatrixConnectivity::SPARSE) || (m_MatrixType & SynapseMatrixConnectivity::BITMASK))
+    return (((m_MatrixType & SynapseMatrixConnectivity::SPARSE) || (m_MatrixType & SynapseMatrixConnectivity::CSR)
+             || (m_MatrixType & SynapseMatrixConnectivity::BITMASK))
             && Utils::isRNGRequired(m_ConnectivityInitialiser.getSnippet()->getRowBuildCode()));
 }
 //----------------------------------------------------------------------------
@@ -300,8 +374,9 @@ bool SynapseGroup::isWUVarInitRequired() const
 //----------------------------------------------------------------------------
 bool SynapseGroup::isSparseConnectivityInitRequired() const
 {
-    // Return true if the matrix type is sparse or bitmask and there is code to initialise sparse connectivity
-    return (((m_MatrixType & SynapseMatrixConnectivity::SPARSE) || (m_MatrixType & SynapseMatrixConnectivity::BITMASK))
+    // Return true if the matrix type is sparse, CSR or bitmask and there is code to initialise sparse connectivity
+    return (((m_MatrixType & SynapseMatrixConnectivity::SPARSE) || (m_MatrixType & SynapseMatrixConnectivity::CSR)
+             || (m_MatrixType & SynapseMatrixConnectivity::BITMASK))
             && !getConnectivityInitialiser().getSnippet()->getRowBuildCode().empty());
 }
 //----------------------------------------------------------------------------
@@ -312,13 +387,14 @@ SynapseGroup::SynapseGroup(const std::string name, SynapseMatrixType matrixType,
                            const InitSparseConnectivitySnippet::Init &connectivityInitialiser,
                            VarLocation defaultVarLocation, VarLocation defaultExtraGlobalParamLocation,
                            VarLocation defaultSparseConnectivityLocation, bool defaultNarrowSparseIndEnabled)
-    :   m_Name(name), m_SpanType(SpanType::POSTSYNAPTIC), m_NumThreadsPerSpike(1), m_DelaySteps(delaySteps), m_BackPropDelaySteps(0),
-        m_MaxDendriticDelayTimesteps(1), m_MatrixType(matrixType),  m_SrcNeuronGroup(srcNeuronGroup), m_TrgNeuronGroup(trgNeuronGroup),
+    :   m_Name(name), m_SpanType(SpanType::AUTOMATIC), m_NumThreadsPerSpike(1), m_DelaySteps(delaySteps), m_BackPropDelaySteps(0),
+        m_MaxTotalConnections(0), m_MaxDendriticDelayTimesteps(1), m_MatrixType(matrixType),  m_SrcNeuronGroup(srcNeuronGroup), m_TrgNeuronGroup(trgNeuronGroup),
         m_EventThresholdReTestRequired(false), m_NarrowSparseIndEnabled(defaultNarrowSparseIndEnabled),
         m_InSynLocation(defaultVarLocation),  m_DendriticDelayLocation(defaultVarLocation),
         m_WUModel(wu), m_WUParams(wuParams), m_WUVarInitialisers(wuVarInitialisers), m_WUPreVarInitialisers(wuPreVarInitialisers), m_WUPostVarInitialisers(wuPostVarInitialisers),
         m_PSModel(ps), m_PSParams(psParams), m_PSVarInitialisers(psVarInitialisers),
-        m_WUVarLocation(wuVarInitialisers.size(), defaultVarLocation), m_WUPreVarLocation(wuPreVarInitialisers.size(), defaultVarLocation),
+        m_WUVarLocation(wuVarInitialisers.size(), defaultVarLocation), m_WUVarStorage(wuVarInitialisers.size(), VarStorage::NATIVE),
+        m_WUVarStorageScale(wuVarInitialisers.size(), 1.0), m_WUPreVarLocation(wuPreVarInitialisers.size(), defaultVarLocation),
         m_WUPostVarLocation(wuPostVarInitialisers.size(), defaultVarLocation), m_WUExtraGlobalParamLocation(wu->getExtraGlobalParams().size(), defaultExtraGlobalParamLocation),
         m_PSVarLocation(psVarInitialisers.size(), defaultVarLocation), m_PSExtraGlobalParamLocation(ps->getExtraGlobalParams().size(), defaultExtraGlobalParamLocation),
         m_ConnectivityInitialiser(connectivityInitialiser), m_SparseConnectivityLocation(defaultSparseConnectivityLocation),
@@ -344,9 +420,9 @@ SynapseGroup::SynapseGroup(const std::string name, SynapseMatrixType matrixType,
     }
 
     // If connectivitity initialisation snippet provides a function to calculate row length, call it
-    // **NOTE** only do this for sparse connectivity as this should not be set for bitmasks
+    // **NOTE** only do this for sparse and CSR connectivity as this should not be set for bitmasks
     auto calcMaxRowLengthFunc = m_ConnectivityInitialiser.getSnippet()->getCalcMaxRowLengthFunc();
-    if(calcMaxRowLengthFunc && (m_MatrixType & SynapseMatrixConnectivity::SPARSE)) {
+    if(calcMaxRowLengthFunc && ((m_MatrixType & SynapseMatrixConnectivity::SPARSE) || (m_MatrixType & SynapseMatrixConnectivity::CSR))) {
         m_MaxConnections = calcMaxRowLengthFunc(srcNeuronGroup->getNumNeurons(), trgNeuronGroup->getNumNeurons(),
                                                 m_ConnectivityInitialiser.getParams());
     }
@@ -356,9 +432,9 @@ SynapseGroup::SynapseGroup(const std::string name, SynapseMatrixType matrixType,
     }
 
     // If connectivitity initialisation snippet provides a function to calculate row length, call it
-    // **NOTE** only do this for sparse connectivity as this should not be set for bitmasks
+    // **NOTE** only do this for sparse and CSR connectivity as this should not be set for bitmasks
     auto calcMaxColLengthFunc = m_ConnectivityInitialiser.getSnippet()->getCalcMaxColLengthFunc();
-    if(calcMaxColLengthFunc && (m_MatrixType & SynapseMatrixConnectivity::SPARSE)) {
+    if(calcMaxColLengthFunc && ((m_MatrixType & SynapseMatrixConnectivity::SPARSE) || (m_MatrixType & SynapseMatrixConnectivity::CSR))) {
         m_MaxSourceConnections = calcMaxColLengthFunc(srcNeuronGroup->getNumNeurons(), trgNeuronGroup->getNumNeurons(),
                                                       m_ConnectivityInitialiser.getParams());
     }
@@ -446,9 +522,11 @@ bool SynapseGroup::canWUBeMerged(const SynapseGroup &other) const
        && (getNumThreadsPerSpike() == other.getNumThreadsPerSpike())
        && (isEventThresholdReTestRequired() == other.isEventThresholdReTestRequired())
        && (getSpanType() == other.getSpanType())
+       && (m_WUVarStorage == other.m_WUVarStorage)
        && (isPSModelMerged() == other.isPSModelMerged())
        && (getSrcNeuronGroup()->getNumDelaySlots() == other.getSrcNeuronGroup()->getNumDelaySlots())
        && (getTrgNeuronGroup()->getNumDelaySlots() == other.getTrgNeuronGroup()->getNumDelaySlots())
+       && (getTrgNeuronGroup()->isEventDriven() == other.getTrgNeuronGroup()->isEventDriven())
        && (getMatrixType() == other.getMatrixType()))
     {
         // If connectivity is either non-procedural or connectivity initialisers can be merged
@@ -534,7 +612,8 @@ bool SynapseGroup::canWUInitBeMerged(const SynapseGroup &other) const
 {
     if((getMatrixType() == other.getMatrixType())
        && (getSparseIndType() == other.getSparseIndType())
-       && (getWUModel()->getVars() == other.getWUModel()->getVars()))
+       && (getWUModel()->getVars() == other.getWUModel()->getVars())
+       && (m_WUVarStorage == other.m_WUVarStorage))
     {
         // if any of the variable's initialisers can't be merged, return false
         for(size_t i = 0; i < getWUVarInitialisers().size(); i++) {
@@ -603,3 +682,59 @@ bool SynapseGroup::canConnectivityInitBeMerged(const SynapseGroup &other) const
             && (getSynapseMatrixConnectivity(getMatrixType()) == getSynapseMatrixConnectivity(other.getMatrixType()))
             && (getSparseIndType() == other.getSparseIndType()));
 }
+//----------------------------------------------------------------------------
+uint64_t SynapseGroup::getWUMergeHashDigest() const
+{
+    // Hash weight update model code
+    uint64_t hash = Utils::hashString(getWUModel()->getSimCode());
+    hash = Utils::hashString(getWUModel()->getEventCode(), hash);
+    hash = Utils::hashString(getWUModel()->getLearnPostCode(), hash);
+    hash = Utils::hashString(getWUModel()->getSynapseDynamicsCode(), hash);
+    hash = Utils::hashString(getWUModel()->getEventThresholdConditionCode(), hash);
+    hash = Utils::hashString(getWUModel()->getPreSpikeCode(), hash);
+    hash = Utils::hashString(getWUModel()->getPostSpikeCode(), hash);
+
+    // Hash parameters and properties which must match exactly
+    hash = Utils::hashValue(getWUParams(), hash);
+    hash = Utils::hashValue(getWUDerivedParams(), hash);
+    hash = Utils::hashValue(getDelaySteps(), hash);
+    hash = Utils::hashValue(getBackPropDelaySteps(), hash);
+    hash = Utils::hashValue(getMaxDendriticDelayTimesteps(), hash);
+    hash = Utils::hashString(getSparseIndType(), hash);
+    hash = Utils::hashValue(getNumThreadsPerSpike(), hash);
+    hash = Utils::hashValue(isEventThresholdReTestRequired(), hash);
+    hash = Utils::hashValue(static_cast<unsigned int>(getSpanType()), hash);
+    for(size_t i = 0; i < m_WUVarStorage.size(); i++) {
+        hash = Utils::hashValue(static_cast<unsigned int>(getWUVarStorage(i)), hash);
+    }
+    hash = Utils::hashValue(isPSModelMerged(), hash);
+    hash = Utils::hashValue(getSrcNeuronGroup()->getNumDelaySlots(), hash);
+    hash = Utils::hashValue(getTrgNeuronGroup()->getNumDelaySlots(), hash);
+    hash = Utils::hashValue(getTrgNeuronGroup()->isEventDriven(), hash);
+    return Utils::hashValue(static_cast<unsigned int>(getMatrixType()), hash);
+}
+//----------------------------------------------------------------------------
+uint64_t SynapseGroup::getWUInitMergeHashDigest() const
+{
+    uint64_t hash = Utils::hashValue(static_cast<unsigned int>(getMatrixType()));
+    hash = Utils::hashString(getSparseIndType(), hash);
+
+    // Hash variables and the code used to initialise them
+    // **NOTE** parameters are only compared if they are referenced by the code so can't be hashed
+    const auto vars = getWUModel()->getVars();
+    for(size_t i = 0; i < vars.size(); i++) {
+        hash = Utils::hashString(vars[i].name, hash);
+        hash = Utils::hashString(vars[i].type, hash);
+        hash = Utils::hashValue(static_cast<unsigned int>(vars[i].access), hash);
+        hash = Utils::hashValue(static_cast<unsigned int>(getWUVarStorage(i)), hash);
+        hash = Utils::hashString(getWUVarInitialisers()[i].getSnippet()->getCode(), hash);
+    }
+    return hash;
+}
+//----------------------------------------------------------------------------
+uint64_t SynapseGroup::getConnectivityInitMergeHashDigest() const
+{
+    uint64_t hash = Utils::hashString(getConnectivityInitialiser().getSnippet()->getRowBuildCode());
+    hash = Utils::hashValue(static_cast<unsigned int>(getSynapseMatrixConnectivity(getMatrixType())), hash);
+    return Utils::hashString(getSparseIndType(), hash);
+}
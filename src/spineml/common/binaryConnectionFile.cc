@@ -0,0 +1,203 @@
+#include "binaryConnectionFile.h"
+
+// Standard C++ includes
+#include <limits>
+#include <stdexcept>
+
+// Standard C includes
+#include <cmath>
+
+// Platform includes
+#ifdef _WIN32
+#include <windows.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// pugixml includes
+#include "pugixml/pugixml.hpp"
+
+// SpineML common includes
+#include "modelCache.h"
+#include "spineMLLogging.h"
+
+//----------------------------------------------------------------------------
+// Anonymous namespace
+//----------------------------------------------------------------------------
+namespace
+{
+// Connections below which it isn't worth processing lists in parallel
+const size_t minConnectionsPerThread = 1 << 16;
+}
+
+//----------------------------------------------------------------------------
+// SpineMLCommon::BinaryConnectionFile
+//----------------------------------------------------------------------------
+SpineMLCommon::BinaryConnectionFile::BinaryConnectionFile(const std::string &filename, unsigned int numConnections, bool explicitDelay)
+:   m_Filename(filename), m_NumConnections(numConnections), m_WordsPerSynapse(explicitDelay ? 3 : 2),
+    m_FileBytes(0), m_FileIdentity(0), m_Words(nullptr), m_Mapping(nullptr)
+{
+    const uint64_t requiredBytes = (uint64_t)numConnections * m_WordsPerSynapse * sizeof(uint32_t);
+#ifdef _WIN32
+    struct _stat64 fileStat;
+    if(_stat64(filename.c_str(), &fileStat) != 0) {
+        throw std::runtime_error("Cannot open binary connection file:" + filename);
+    }
+#else
+    struct stat fileStat;
+    if(stat(filename.c_str(), &fileStat) != 0) {
+        throw std::runtime_error("Cannot open binary connection file:" + filename);
+    }
+#endif
+    m_FileBytes = (uint64_t)fileStat.st_size;
+    m_FileIdentity = ModelCache::hashFileIdentity(filename);
+
+    if(m_FileBytes < requiredBytes) {
+        throw std::runtime_error("Unexpected end of binary connection file");
+    }
+
+    // Empty files can't be mapped
+    if(requiredBytes == 0) {
+        return;
+    }
+
+#ifdef _WIN32
+    m_File = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(m_File == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open binary connection file:" + filename);
+    }
+    m_MappingHandle = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(m_MappingHandle == nullptr) {
+        CloseHandle(m_File);
+        throw std::runtime_error("Cannot map binary connection file:" + filename);
+    }
+    m_Mapping = MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if(m_Mapping == nullptr) {
+        CloseHandle(m_MappingHandle);
+        CloseHandle(m_File);
+        throw std::runtime_error("Cannot map binary connection file:" + filename);
+    }
+#else
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if(fd == -1) {
+        throw std::runtime_error("Cannot open binary connection file:" + filename);
+    }
+    m_Mapping = mmap(nullptr, m_FileBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(m_Mapping == MAP_FAILED) {
+        m_Mapping = nullptr;
+        throw std::runtime_error("Cannot map binary connection file:" + filename);
+    }
+
+    // File will be read sequentially by each thread
+    madvise(m_Mapping, m_FileBytes, MADV_SEQUENTIAL);
+#endif
+    m_Words = static_cast<const uint32_t*>(m_Mapping);
+}
+//----------------------------------------------------------------------------
+SpineMLCommon::BinaryConnectionFile::~BinaryConnectionFile()
+{
+    if(m_Mapping != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_Mapping);
+        CloseHandle(m_MappingHandle);
+        CloseHandle(m_File);
+#else
+        munmap(m_Mapping, m_FileBytes);
+#endif
+    }
+}
+//----------------------------------------------------------------------------
+SpineMLCommon::BinaryConnectionFile::Metadata SpineMLCommon::BinaryConnectionFile::getMetadata(unsigned int numPre) const
+{
+    // If a sidecar file describing this version of the connection file exists, use metadata from it
+    const std::string sidecarFilename = getSidecarFilename();
+    pugi::xml_document sidecarDoc;
+    if(sidecarDoc.load_file(sidecarFilename.c_str())) {
+        auto sidecar = sidecarDoc.child("ConnectionListMetadata");
+        if(sidecar.attribute("file_identity").as_ullong() == m_FileIdentity
+           && sidecar.attribute("num_connections").as_uint() == m_NumConnections
+           && sidecar.attribute("num_pre").as_uint() == numPre
+           && sidecar.attribute("explicit_delay").as_bool() == hasExplicitDelay())
+        {
+            LOGD_SPINEML << "Reading connection list metadata from " << sidecarFilename;
+            return {sidecar.attribute("max_row_length").as_uint(),
+                    sidecar.attribute("heterogeneous_delay").as_bool(),
+                    sidecar.attribute("max_delay").as_float()};
+        }
+    }
+
+    // Build a row length histogram and scan delays in each thread's chunk of the file
+    const unsigned int numThreads = getNumThreads(m_NumConnections);
+    std::vector<std::vector<unsigned int>> threadRowLengths(numThreads);
+    std::vector<float> threadMinDelay(numThreads, std::numeric_limits<float>::max());
+    std::vector<float> threadMaxDelay(numThreads, std::numeric_limits<float>::lowest());
+    std::vector<char> threadInvalid(numThreads, 0);
+    parallelFor(numThreads, m_NumConnections,
+                [&](unsigned int t, size_t begin, size_t end)
+                {
+                    auto &rowLengths = threadRowLengths[t];
+                    rowLengths.resize(numPre, 0);
+                    for(size_t i = begin; i < end; i++) {
+                        const uint32_t pre = getPre(i);
+                        if(pre >= numPre) {
+                            threadInvalid[t] = 1;
+                            return;
+                        }
+                        rowLengths[pre]++;
+
+                        if(hasExplicitDelay()) {
+                            const float delay = getDelay(i);
+                            threadMinDelay[t] = std::min(threadMinDelay[t], delay);
+                            threadMaxDelay[t] = std::max(threadMaxDelay[t], delay);
+                        }
+                    }
+                });
+
+    if(std::find(threadInvalid.cbegin(), threadInvalid.cend(), 1) != threadInvalid.cend()) {
+        throw std::runtime_error("Binary connection file:" + m_Filename + " contains out of range presynaptic index");
+    }
+
+    // Reduce histograms and delays across threads
+    Metadata metadata{0, false, 0.0f};
+    for(unsigned int i = 0; i < numPre; i++) {
+        unsigned int rowLength = 0;
+        for(const auto &r : threadRowLengths) {
+            rowLength += r[i];
+        }
+        metadata.maxRowLength = std::max(metadata.maxRowLength, rowLength);
+    }
+    if(hasExplicitDelay() && m_NumConnections > 0) {
+        const float minDelay = *std::min_element(threadMinDelay.cbegin(), threadMinDelay.cend());
+        metadata.maxDelayMs = *std::max_element(threadMaxDelay.cbegin(), threadMaxDelay.cend());
+        metadata.heterogeneousDelay = (minDelay != metadata.maxDelayMs);
+    }
+
+    // Cache metadata in sidecar file so it doesn't need recalculating
+    // **NOTE** failure to save e.g. because model directory is read-only is not an error
+    sidecarDoc.reset();
+    auto sidecar = sidecarDoc.append_child("ConnectionListMetadata");
+    sidecar.append_attribute("file_identity").set_value((unsigned long long)m_FileIdentity);
+    sidecar.append_attribute("num_connections").set_value(m_NumConnections);
+    sidecar.append_attribute("num_pre").set_value(numPre);
+    sidecar.append_attribute("explicit_delay").set_value(hasExplicitDelay());
+    sidecar.append_attribute("max_row_length").set_value(metadata.maxRowLength);
+    sidecar.append_attribute("heterogeneous_delay").set_value(metadata.heterogeneousDelay);
+    sidecar.append_attribute("max_delay").set_value(metadata.maxDelayMs);
+    if(!sidecarDoc.save_file(sidecarFilename.c_str())) {
+        LOGW_SPINEML << "Unable to write connection list metadata to " << sidecarFilename;
+    }
+    return metadata;
+}
+//----------------------------------------------------------------------------
+unsigned int SpineMLCommon::BinaryConnectionFile::getNumThreads(size_t numConnections)
+{
+    const size_t maxThreads = (numConnections + minConnectionsPerThread - 1) / minConnectionsPerThread;
+    const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    return (unsigned int)std::max<size_t>(1, std::min<size_t>(hardwareThreads, maxThreads));
+}
@@ -0,0 +1,555 @@
+#include "modelCache.h"
+
+// Standard C++ includes
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+// Standard C includes
+#include <cerrno>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// SpineML common includes
+#include "spineMLLogging.h"
+
+//----------------------------------------------------------------------------
+// Anonymous namespace
+//----------------------------------------------------------------------------
+namespace
+{
+const char magic[4] = {'G', 'S', 'M', 'C'};
+const uint32_t version = 2;
+
+// Size of header containing magic, version and network hash
+const uint64_t headerBytes = 4 + sizeof(uint32_t) + sizeof(uint64_t);
+
+// Entries with longer names are assumed to be corrupt
+const uint32_t maxNameLength = 4096;
+
+// Size of blocks used to copy entries when compacting
+const size_t copyBlockBytes = 1024 * 1024;
+
+#ifdef _WIN32
+typedef HANDLE FileHandle;
+const FileHandle invalidFile = INVALID_HANDLE_VALUE;
+#else
+typedef int FileHandle;
+const FileHandle invalidFile = -1;
+#endif
+
+//----------------------------------------------------------------------------
+// Platform-specific file access
+//----------------------------------------------------------------------------
+// Open file, either creating a new file or opening an existing one (read-only if it can't be written)
+FileHandle openFile(const std::string &filename, bool create)
+{
+#ifdef _WIN32
+    const DWORD share = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+    if(create) {
+        return CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, share, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    }
+    else {
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, share, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        return (file == INVALID_HANDLE_VALUE) ? CreateFileA(filename.c_str(), GENERIC_READ, share, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) : file;
+    }
+#else
+    if(create) {
+        return open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    }
+    else {
+        const int file = open(filename.c_str(), O_RDWR);
+        return (file == -1) ? open(filename.c_str(), O_RDONLY) : file;
+    }
+#endif
+}
+
+void closeFile(FileHandle file)
+{
+#ifdef _WIN32
+    CloseHandle(file);
+#else
+    close(file);
+#endif
+}
+
+uint64_t getFileSize(FileHandle file)
+{
+#ifdef _WIN32
+    LARGE_INTEGER size;
+    return GetFileSizeEx(file, &size) ? (uint64_t)size.QuadPart : 0;
+#else
+    struct stat fileStat;
+    return (fstat(file, &fileStat) == 0) ? (uint64_t)fileStat.st_size : 0;
+#endif
+}
+
+bool truncateFile(FileHandle file, uint64_t size)
+{
+#ifdef _WIN32
+    LARGE_INTEGER position;
+    position.QuadPart = (LONGLONG)size;
+    return SetFilePointerEx(file, position, nullptr, FILE_BEGIN) && SetEndOfFile(file);
+#else
+    return (ftruncate(file, (off_t)size) == 0);
+#endif
+}
+
+// Lock file so entries appended by concurrent runs don't interleave
+void lockFile(FileHandle file)
+{
+#ifdef _WIN32
+    OVERLAPPED overlapped = {};
+    LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped);
+#else
+    while(flock(file, LOCK_EX) != 0 && errno == EINTR) {
+    }
+#endif
+}
+
+void unlockFile(FileHandle file)
+{
+#ifdef _WIN32
+    OVERLAPPED overlapped = {};
+    UnlockFileEx(file, 0, MAXDWORD, MAXDWORD, &overlapped);
+#else
+    flock(file, LOCK_UN);
+#endif
+}
+
+bool readAt(FileHandle file, uint64_t offset, void *data, uint64_t numBytes)
+{
+    char *bytes = static_cast<char*>(data);
+    while(numBytes > 0) {
+#ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = (DWORD)offset;
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+        DWORD bytesRead = 0;
+        if(!ReadFile(file, bytes, (DWORD)std::min<uint64_t>(numBytes, 1 << 30), &bytesRead, &overlapped) || bytesRead == 0) {
+            return false;
+        }
+#else
+        const ssize_t bytesRead = pread(file, bytes, (size_t)std::min<uint64_t>(numBytes, 1 << 30), (off_t)offset);
+        if(bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        else if(bytesRead <= 0) {
+            return false;
+        }
+#endif
+        bytes += bytesRead;
+        offset += bytesRead;
+        numBytes -= bytesRead;
+    }
+    return true;
+}
+
+bool writeAt(FileHandle file, uint64_t offset, const void *data, uint64_t numBytes)
+{
+    const char *bytes = static_cast<const char*>(data);
+    while(numBytes > 0) {
+#ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = (DWORD)offset;
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+        DWORD bytesWritten = 0;
+        if(!WriteFile(file, bytes, (DWORD)std::min<uint64_t>(numBytes, 1 << 30), &bytesWritten, &overlapped) || bytesWritten == 0) {
+            return false;
+        }
+#else
+        const ssize_t bytesWritten = pwrite(file, bytes, (size_t)std::min<uint64_t>(numBytes, 1 << 30), (off_t)offset);
+        if(bytesWritten < 0 && errno == EINTR) {
+            continue;
+        }
+        else if(bytesWritten <= 0) {
+            return false;
+        }
+#endif
+        bytes += bytesWritten;
+        offset += bytesWritten;
+        numBytes -= bytesWritten;
+    }
+    return true;
+}
+
+// Replace file with temporary file
+bool replaceFile(const std::string &tempFilename, const std::string &filename)
+{
+#ifdef _WIN32
+    return MoveFileExA(tempFilename.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+    return (std::rename(tempFilename.c_str(), filename.c_str()) == 0);
+#endif
+}
+
+// Get size of entry's header
+uint64_t getEntryHeaderBytes(const std::string &name)
+{
+    return sizeof(uint32_t) + name.size() + sizeof(uint64_t) + sizeof(uint64_t);
+}
+
+// Serialise entry's header
+std::vector<char> getEntryHeader(const std::string &name, uint64_t dependencyHash, uint64_t numBytes)
+{
+    const uint32_t nameLength = (uint32_t)name.size();
+    std::vector<char> header((size_t)getEntryHeaderBytes(name));
+    char *h = header.data();
+    std::memcpy(h, &nameLength, sizeof(uint32_t));
+    h += sizeof(uint32_t);
+    std::memcpy(h, name.data(), name.size());
+    h += name.size();
+    std::memcpy(h, &dependencyHash, sizeof(uint64_t));
+    h += sizeof(uint64_t);
+    std::memcpy(h, &numBytes, sizeof(uint64_t));
+    return header;
+}
+
+// Serialise cache header
+std::vector<char> getHeader(uint64_t networkHash)
+{
+    std::vector<char> header((size_t)headerBytes);
+    std::memcpy(header.data(), magic, 4);
+    std::memcpy(header.data() + 4, &version, sizeof(uint32_t));
+    std::memcpy(header.data() + 4 + sizeof(uint32_t), &networkHash, sizeof(uint64_t));
+    return header;
+}
+}   // anonymous namespace
+
+//----------------------------------------------------------------------------
+// SpineMLCommon::ModelCache
+//----------------------------------------------------------------------------
+SpineMLCommon::ModelCache::ModelCache(const std::string &networkFilename)
+:   m_NetworkFilename(networkFilename), m_Filename(networkFilename + ".cache"), m_NetworkHash(hashFileContents(networkFilename)),
+    m_EndOffset(0), m_SupersededBytes(0), m_File(invalidFile)
+{
+    if(open()) {
+        LOGI_SPINEML << "Found " << m_Entries.size() << " entries in model cache '" << m_Filename << "'";
+    }
+}
+//----------------------------------------------------------------------------
+SpineMLCommon::ModelCache::~ModelCache()
+{
+    closeFile();
+}
+//----------------------------------------------------------------------------
+uint64_t SpineMLCommon::ModelCache::hash(const void *data, size_t numBytes, uint64_t seed)
+{
+    const uint8_t *bytes = static_cast<const uint8_t*>(data);
+    uint64_t h = seed;
+    for(size_t i = 0; i < numBytes; i++) {
+        h ^= bytes[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+//----------------------------------------------------------------------------
+uint64_t SpineMLCommon::ModelCache::hashFileContents(const std::string &filename)
+{
+    std::ifstream is(filename, std::ios::binary);
+    if(!is.good()) {
+        throw std::runtime_error("Unable to open '" + filename + "'");
+    }
+
+    // Hash file in blocks
+    std::vector<char> block(1024 * 1024);
+    uint64_t h = hash(nullptr, 0);
+    while(is) {
+        is.read(block.data(), block.size());
+        h = hash(block.data(), (size_t)is.gcount(), h);
+    }
+    return h;
+}
+//----------------------------------------------------------------------------
+uint64_t SpineMLCommon::ModelCache::hashFileIdentity(const std::string &filename, uint64_t seed)
+{
+    // **NOTE** whole-second modification times can't distinguish files rewritten in quick succession
+    // so nanosecond modification and change times are combined with the device and inode of the file
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    BY_HANDLE_FILE_INFORMATION info;
+    const bool success = (file != INVALID_HANDLE_VALUE && GetFileInformationByHandle(file, &info));
+    if(file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+    }
+    if(!success) {
+        throw std::runtime_error("Unable to open '" + filename + "'");
+    }
+
+    const uint32_t identity[] = {info.dwVolumeSerialNumber, info.nFileIndexHigh, info.nFileIndexLow,
+                                 info.nFileSizeHigh, info.nFileSizeLow,
+                                 info.ftLastWriteTime.dwHighDateTime, info.ftLastWriteTime.dwLowDateTime};
+#else
+    struct stat fileStat;
+    if(stat(filename.c_str(), &fileStat) != 0) {
+        throw std::runtime_error("Unable to open '" + filename + "'");
+    }
+#ifdef __APPLE__
+    const struct timespec &modifiedTime = fileStat.st_mtimespec;
+    const struct timespec &changedTime = fileStat.st_ctimespec;
+#else
+    const struct timespec &modifiedTime = fileStat.st_mtim;
+    const struct timespec &changedTime = fileStat.st_ctim;
+#endif
+    const uint64_t identity[] = {(uint64_t)fileStat.st_dev, (uint64_t)fileStat.st_ino, (uint64_t)fileStat.st_size,
+                                 (uint64_t)modifiedTime.tv_sec, (uint64_t)modifiedTime.tv_nsec,
+                                 (uint64_t)changedTime.tv_sec, (uint64_t)changedTime.tv_nsec};
+#endif
+    return hash(identity, sizeof(identity), seed);
+}
+//----------------------------------------------------------------------------
+std::string SpineMLCommon::ModelCache::getNodeEntryName(const std::string &type, const std::string &documentFilename, ptrdiff_t offset)
+{
+    return type + "@" + documentFilename + ":" + std::to_string(offset);
+}
+//----------------------------------------------------------------------------
+bool SpineMLCommon::ModelCache::readEntry(const Entry &entry, void *data) const
+{
+    if(!readAt(m_File, entry.offset, data, entry.numBytes)) {
+        LOGW_SPINEML << "Unable to read entry from model cache '" << m_Filename << "'";
+        return false;
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+void SpineMLCommon::ModelCache::writeEntry(const std::string &name, uint64_t dependencyHash, const void *data, size_t numBytes)
+{
+    // If there was no up to date cache, open one if another run has since created it or, otherwise, create one
+    if(m_File == invalidFile && !open() && !create()) {
+        return;
+    }
+
+    lockFile(m_File);
+
+    // Add any entries other runs have appended since the table of contents was read
+    // **NOTE** these are complete as runs hold the lock while appending
+    if(getFileSize(m_File) > m_EndOffset) {
+        readEntries(m_EndOffset);
+    }
+
+    // If there is still data beyond the last complete entry, it is left over from a
+    // run which failed while appending so truncate it, then append entry in its place
+    const auto entryHeader = getEntryHeader(name, dependencyHash, numBytes);
+    if((getFileSize(m_File) != m_EndOffset && !truncateFile(m_File, m_EndOffset))
+       || !writeAt(m_File, m_EndOffset, entryHeader.data(), entryHeader.size())
+       || !writeAt(m_File, m_EndOffset + entryHeader.size(), data, numBytes))
+    {
+        LOGW_SPINEML << "Unable to write entry to model cache '" << m_Filename << "'";
+        truncateFile(m_File, m_EndOffset);
+        unlockFile(m_File);
+        return;
+    }
+
+    // Add entry to table of contents, replacing any previous entry with this name
+    const Entry entry{dependencyHash, m_EndOffset + entryHeader.size(), numBytes};
+    auto existing = m_Entries.find(name);
+    if(existing == m_Entries.end()) {
+        m_Entries.emplace(name, entry);
+    }
+    else {
+        m_SupersededBytes += getEntryHeaderBytes(name) + existing->second.numBytes;
+        existing->second = entry;
+    }
+    m_EndOffset += entryHeader.size() + numBytes;
+
+    // If superseded entries make up most of the file, compact it
+    if(m_SupersededBytes > ((m_EndOffset - headerBytes) / 2)) {
+        compact();
+    }
+
+    unlockFile(m_File);
+}
+//----------------------------------------------------------------------------
+void SpineMLCommon::ModelCache::readEntries(uint64_t offset)
+{
+    const uint64_t fileBytes = getFileSize(m_File);
+    while(offset < fileBytes) {
+        // Read entry header, stopping if it is incomplete or corrupt
+        uint32_t nameLength;
+        if(!readAt(m_File, offset, &nameLength, sizeof(uint32_t)) || nameLength > maxNameLength) {
+            break;
+        }
+
+        std::string name(nameLength, '\0');
+        uint64_t entryData[2];
+        if(!readAt(m_File, offset + sizeof(uint32_t), &name[0], nameLength)
+           || !readAt(m_File, offset + sizeof(uint32_t) + nameLength, entryData, sizeof(entryData)))
+        {
+            break;
+        }
+
+        // Stop if entry's data is incomplete
+        const uint64_t dataOffset = offset + getEntryHeaderBytes(name);
+        if(entryData[1] > (fileBytes - dataOffset)) {
+            break;
+        }
+
+        // Add entry to table of contents, replacing any previous entry with this name
+        const Entry entry{entryData[0], dataOffset, entryData[1]};
+        auto existing = m_Entries.find(name);
+        if(existing == m_Entries.end()) {
+            m_Entries.emplace(std::move(name), entry);
+        }
+        else {
+            m_SupersededBytes += getEntryHeaderBytes(name) + existing->second.numBytes;
+            existing->second = entry;
+        }
+
+        offset = dataOffset + entryData[1];
+    }
+
+    m_EndOffset = offset;
+}
+//----------------------------------------------------------------------------
+bool SpineMLCommon::ModelCache::open()
+{
+    // If there's no cache, start with no entries
+    m_File = openFile(m_Filename, false);
+    if(m_File == invalidFile) {
+        LOGD_SPINEML << "No model cache found at '" << m_Filename << "'";
+        return false;
+    }
+
+    // If cache isn't the right version or was built from a different version of the network, ignore it
+    // **NOTE** it will be replaced when the first entry is written
+    std::vector<char> header((size_t)headerBytes);
+    if(!readAt(m_File, 0, header.data(), headerBytes) || header != getHeader(m_NetworkHash)) {
+        LOGD_SPINEML << "Model cache '" << m_Filename << "' is out of date";
+        closeFile();
+        return false;
+    }
+
+    // Read table of contents
+    readEntries(headerBytes);
+    return true;
+}
+//----------------------------------------------------------------------------
+bool SpineMLCommon::ModelCache::create()
+{
+    closeFile();
+    m_Entries.clear();
+    m_SupersededBytes = 0;
+
+    // Write header to a uniquely-named temporary file and replace any existing cache with it
+    // so concurrent runs never see a cache without a valid header
+    std::random_device rd;
+    const std::string tempFilename = m_Filename + "." + std::to_string(rd()) + ".tmp";
+    FileHandle file = openFile(tempFilename, true);
+    const auto header = getHeader(m_NetworkHash);
+    if(file == invalidFile || !writeAt(file, 0, header.data(), header.size())) {
+        LOGW_SPINEML << "Unable to create model cache '" << m_Filename << "'";
+        if(file != invalidFile) {
+            ::closeFile(file);
+            std::remove(tempFilename.c_str());
+        }
+        return false;
+    }
+
+#ifdef _WIN32
+    // **NOTE** Windows can't rename open files
+    ::closeFile(file);
+#endif
+    if(!replaceFile(tempFilename, m_Filename)) {
+        LOGW_SPINEML << "Unable to replace model cache '" << m_Filename << "'";
+#ifndef _WIN32
+        ::closeFile(file);
+#endif
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    file = openFile(m_Filename, false);
+    if(file == invalidFile) {
+        LOGW_SPINEML << "Unable to open model cache '" << m_Filename << "'";
+        return false;
+    }
+#endif
+
+    m_File = file;
+    m_EndOffset = headerBytes;
+    LOGD_SPINEML << "Created model cache '" << m_Filename << "'";
+    return true;
+}
+//----------------------------------------------------------------------------
+void SpineMLCommon::ModelCache::compact()
+{
+    // Copy current entries to a uniquely-named temporary file
+    std::random_device rd;
+    const std::string tempFilename = m_Filename + "." + std::to_string(rd()) + ".tmp";
+    FileHandle file = openFile(tempFilename, true);
+    if(file == invalidFile) {
+        LOGW_SPINEML << "Unable to compact model cache '" << m_Filename << "'";
+        return;
+    }
+
+    const auto header = getHeader(m_NetworkHash);
+    bool success = writeAt(file, 0, header.data(), header.size());
+    uint64_t offset = headerBytes;
+    std::map<std::string, Entry> entries;
+    std::vector<char> block(copyBlockBytes);
+    for(const auto &e : m_Entries) {
+        const auto entryHeader = getEntryHeader(e.first, e.second.dependencyHash, e.second.numBytes);
+        success = success && writeAt(file, offset, entryHeader.data(), entryHeader.size());
+        offset += entryHeader.size();
+        entries.emplace(e.first, Entry{e.second.dependencyHash, offset, e.second.numBytes});
+
+        // Copy entry's data in blocks
+        for(uint64_t i = 0; success && i < e.second.numBytes; i += block.size()) {
+            const uint64_t blockBytes = std::min<uint64_t>(block.size(), e.second.numBytes - i);
+            success = readAt(m_File, e.second.offset + i, block.data(), blockBytes) && writeAt(file, offset + i, block.data(), blockBytes);
+        }
+        offset += e.second.numBytes;
+    }
+
+    // Replace cache with temporary file
+    // **NOTE** the lock on the old file is released when it is closed
+    ::closeFile(file);
+    if(!success) {
+        LOGW_SPINEML << "Unable to compact model cache '" << m_Filename << "'";
+        std::remove(tempFilename.c_str());
+        return;
+    }
+#ifdef _WIN32
+    closeFile();
+#endif
+    if(!replaceFile(tempFilename, m_Filename)) {
+        LOGW_SPINEML << "Unable to replace model cache '" << m_Filename << "'";
+        std::remove(tempFilename.c_str());
+    }
+    else {
+        LOGD_SPINEML << "Compacted model cache '" << m_Filename << "' from " << m_EndOffset << " to " << offset << " bytes";
+        m_Entries = std::move(entries);
+        m_EndOffset = offset;
+        m_SupersededBytes = 0;
+    }
+
+    // Reopen cache and lock it again so caller can unlock it
+    closeFile();
+    m_File = openFile(m_Filename, false);
+    if(m_File == invalidFile) {
+        m_Entries.clear();
+    }
+    else {
+        lockFile(m_File);
+    }
+}
+//----------------------------------------------------------------------------
+void SpineMLCommon::ModelCache::closeFile()
+{
+    if(m_File != invalidFile) {
+        ::closeFile(m_File);
+        m_File = invalidFile;
+    }
+}
@@ -11,6 +11,7 @@
 
 // Standard C includes
 #include <cassert>
+#include <cmath>
 #include <cstdint>
 
 // Filesystem includes
@@ -20,6 +21,8 @@
 #include "pugixml/pugixml.hpp"
 
 // SpineML common includes
+#include "binaryConnectionFile.h"
+#include "modelCache.h"
 #include "spineMLLogging.h"
 
 //------------------------------------------------------------------------
@@ -27,105 +30,213 @@
 //------------------------------------------------------------------------
 namespace
 {
-void createListSparse(const pugi::xml_node &node, double dt, unsigned int numPre, unsigned int,
-                      unsigned int *rowLength, unsigned int *ind, uint8_t **delay, const unsigned int maxRowLength,
-                      const filesystem::path &basePath, std::vector<unsigned int> &remapIndices)
+// Build sorted ragged connectivity from a list of connections using a parallel two-pass counting sort
+// **NOTE** getConnection(i, pre, post, delay) is called concurrently from multiple threads
+template<typename C>
+void buildListSparse(unsigned int numConnections, unsigned int numPre, unsigned int numPost, double dt,
+                     unsigned int *rowLength, unsigned int *ind, uint8_t *delay, const unsigned int maxRowLength,
+                     std::vector<unsigned int> &remapIndices, C getConnection)
 {
-    // Get number of connections, either from BinaryFile
-    // node attribute or by counting Connection children
-    auto binaryFile = node.child("BinaryFile");
-    auto connections = node.children("Connection");
-    const unsigned int numConnections = binaryFile ?
-        binaryFile.attribute("num_connections").as_uint() :
-        std::distance(connections.begin(), connections.end());
-
-    // Zero row lengths
-    std::fill_n(rowLength, numPre, 0);
-
-    // Create array with matching dimensions to ind, initially filled with invalid value
-    std::vector<unsigned int> originalOrder(numPre * maxRowLength,
-                                            std::numeric_limits<unsigned int>::max());
-
-    // If connectivity is specified using a binary file
-    if(binaryFile) {
-        // Create approximately 1Mbyte buffer to hold pre and postsynaptic indices
-        // **NOTE** this is also a multiple of both 2 and 3 so
-        // will hold a whole number of either format of synapse
-        const unsigned int bufferSize = 2 * 3 * 43690;
-        std::vector<uint32_t> connectionBuffer(bufferSize);
+    using SpineMLCommon::BinaryConnectionFile;
+
+    // First pass: build a row length histogram of each thread's chunk of connections
+    const unsigned int numThreads = BinaryConnectionFile::getNumThreads(numConnections);
+    std::vector<std::vector<unsigned int>> threadRowOffsets(numThreads);
+    std::vector<char> threadInvalid(numThreads, 0);
+    BinaryConnectionFile::parallelFor(numThreads, numConnections,
+        [&](unsigned int t, size_t begin, size_t end)
+        {
+            auto &rowOffsets = threadRowOffsets[t];
+            rowOffsets.resize(numPre, 0);
+            for(size_t i = begin; i < end; i++) {
+                unsigned int pre;
+                unsigned int post;
+                float synDelay;
+                getConnection(i, pre, post, synDelay);
+                if(pre >= numPre || post >= numPost) {
+                    threadInvalid[t] = 1;
+                    return;
+                }
+                rowOffsets[pre]++;
+            }
+        });
 
-        // If there are individual delays then each synapse is 3 words rather than 2
-        const bool explicitDelay = (binaryFile.attribute("explicit_delay_flag").as_uint() != 0);
-        const unsigned int wordsPerSynapse = explicitDelay ? 3 : 2;
+    if(std::find(threadInvalid.cbegin(), threadInvalid.cend(), 1) != threadInvalid.cend()) {
+        throw std::runtime_error("List connector contains out of range neuron index");
+    }
 
-        // If this connection has explict delays and no delay array was found, error
-        if(explicitDelay && delay == nullptr) {
-            throw std::runtime_error("Cannot build list connector with explicit delay - delay variable not found");
+    // Sum histograms to get row lengths and convert each thread's histogram into the offset within
+    // each row its synapses start at so synapses from each row remain in their original order
+    // **NOTE** also calculate where each row starts in the tightly-packed list of synapses
+    std::vector<unsigned int> rowStart(numPre);
+    unsigned int totalConnections = 0;
+    for(unsigned int i = 0; i < numPre; i++) {
+        unsigned int length = 0;
+        for(auto &r : threadRowOffsets) {
+            const unsigned int threadLength = r[i];
+            r[i] = length;
+            length += threadLength;
         }
 
-        // Read binary connection filename from node
-        std::string filename = (basePath / binaryFile.attribute("file_name").value()).str();
-
-        // Open file for binary IO
-        std::ifstream input(filename, std::ios::binary);
-        if(!input.good()) {
-            throw std::runtime_error("Cannot open binary connection file:" + filename);
+        if(length > maxRowLength) {
+            throw std::runtime_error("List connector has row of length " + std::to_string(length) + " which exceeds maximum row length " + std::to_string(maxRowLength));
         }
+        rowLength[i] = length;
+        rowStart[i] = totalConnections;
+        totalConnections += length;
+    }
 
-        // Loop through binary words
-        unsigned int i = 0;
-        for(size_t remainingWords = numConnections * wordsPerSynapse; remainingWords > 0;) {
-            // Read a block into buffer
-            const size_t blockWords = std::min<size_t>(bufferSize, remainingWords);
-            input.read(reinterpret_cast<char*>(connectionBuffer.data()), blockWords * sizeof(uint32_t));
-
-            // Check block was read succesfully
-            if((size_t)input.gcount() != (blockWords * sizeof(uint32_t))) {
-                throw std::runtime_error("Unexpected end of binary connection file");
+    // Second pass: scatter postsynaptic indices and delays into ragged structure,
+    // recording each synapse's original index in the tightly-packed list
+    std::vector<unsigned int> originalOrder(numConnections);
+    BinaryConnectionFile::parallelFor(numThreads, numConnections,
+        [&](unsigned int t, size_t begin, size_t end)
+        {
+            auto &rowOffsets = threadRowOffsets[t];
+            for(size_t i = begin; i < end; i++) {
+                unsigned int pre;
+                unsigned int post;
+                float synDelay;
+                getConnection(i, pre, post, synDelay);
+
+                const unsigned int j = rowOffsets[pre]++;
+                const size_t index = ((size_t)pre * maxRowLength) + j;
+                ind[index] = post;
+                if(delay != nullptr) {
+                    delay[index] = (uint8_t)std::round(synDelay / dt);
+                }
+                originalOrder[rowStart[pre] + j] = (unsigned int)i;
             }
+        });
 
-            // Loop through synapses in buffer
-            for(size_t w = 0; w < blockWords; w += wordsPerSynapse) {
-                const unsigned int pre = connectionBuffer[w];
-                const unsigned int post = connectionBuffer[w + 1];
+    // Final pass: sort each row by postsynaptic index and set the remap index in
+    // each synapse's ORIGINAL location to its new index in the ragged array
+    remapIndices.resize(numConnections);
+    const unsigned int numRowThreads = std::min(numThreads, std::max(1u, numPre));
+    BinaryConnectionFile::parallelFor(numRowThreads, numPre,
+        [&](unsigned int, size_t begin, size_t end)
+        {
+            // Create array of row indices to use for sorting each row
+            std::vector<unsigned int> rowOrder(maxRowLength);
+            std::vector<unsigned int> rowIndCopy(maxRowLength);
+            std::vector<uint8_t> rowDelayCopy(maxRowLength);
+
+            for(size_t i = begin; i < end; i++) {
+                // Get pointer to start of row indices
+                unsigned int *rowIndBegin = &ind[i * maxRowLength];
+
+                // Copy row indices into vector
+                // **NOTE** reordering in place is non-trivial
+                std::copy_n(rowIndBegin, rowLength[i], rowIndCopy.begin());
+
+                // Get iterator to end of section of row order to use for this row
+                auto rowOrderEnd = rowOrder.begin();
+                std::advance(rowOrderEnd, rowLength[i]);
+
+                // Fill section with 0, 1, ..., N and stably sort based on postsynaptic indices
+                std::iota(rowOrder.begin(), rowOrderEnd, 0);
+                std::stable_sort(rowOrder.begin(), rowOrderEnd,
+                                 [&rowIndCopy](unsigned int a, unsigned int b)
+                                 {
+                                     return (rowIndCopy[a] < rowIndCopy[b]);
+                                 });
+
+                // Use row order to re-order row indices back into original data structure
+                std::transform(rowOrder.begin(), rowOrderEnd, rowIndBegin,
+                               [&rowIndCopy](unsigned int ord){ return rowIndCopy[ord]; });
+
+                // If a delay array is present
+                if(delay != nullptr) {
+                    // Copy row delays into vector and use row order to re-order them back into original data structure
+                    uint8_t *rowDelayBegin = &delay[i * maxRowLength];
+                    std::copy_n(rowDelayBegin, rowLength[i], rowDelayCopy.begin());
+                    std::transform(rowOrder.begin(), rowOrderEnd, rowDelayBegin,
+                                   [&rowDelayCopy](unsigned int ord){ return rowDelayCopy[ord]; });
+                }
 
-                // Add postsynaptic index to ragged data structure and record creation order
-                const size_t index = (pre * maxRowLength) + rowLength[pre];
-                ind[index] = post;
-                originalOrder[index] = i++;
+                // Loop through synapses in newly reordered row and update remap indices
+                for(unsigned int j = 0; j < rowLength[i]; j++) {
+                    remapIndices[originalOrder[rowStart[i] + rowOrder[j]]] = (unsigned int)((i * maxRowLength) + j);
+                }
+            }
+        });
+}
 
-                // If this file contains explicit delays
-                if(explicitDelay) {
-                    // Cast delay word to float
-                    const float *synDelay = reinterpret_cast<float*>(&connectionBuffer[w + 2]);
+void createListSparse(const pugi::xml_node &node, double dt, unsigned int numPre, unsigned int numPost,
+                      unsigned int *rowLength, unsigned int *ind, uint8_t **delay, const unsigned int maxRowLength,
+                      const filesystem::path &basePath, std::vector<unsigned int> &remapIndices,
+                      SpineMLCommon::ModelCache *modelCache)
+{
+    using SpineMLCommon::ModelCache;
 
-                    // Store in delay array
-                    (*delay)[index] = (uint8_t)std::round(*synDelay / dt);
-                }
+    auto binaryFile = node.child("BinaryFile");
+    const size_t numSynapseSlots = (size_t)numPre * maxRowLength;
+
+    // If there is a cache, key entries on this connection list's position in network, dimensions and any binary file
+    std::string cacheName;
+    uint64_t cacheDependencyHash = 0;
+    if(modelCache != nullptr && node.offset_debug() >= 0) {
+        cacheName = ModelCache::getNodeEntryName("ConnectionList", modelCache->getNetworkFilename(), node.offset_debug());
+        cacheDependencyHash = ModelCache::hashValue(numPre);
+        cacheDependencyHash = ModelCache::hashValue(numPost, cacheDependencyHash);
+        cacheDependencyHash = ModelCache::hashValue(maxRowLength, cacheDependencyHash);
+        cacheDependencyHash = ModelCache::hashValue(dt, cacheDependencyHash);
+        if(binaryFile) {
+            cacheDependencyHash = ModelCache::hashFileIdentity((basePath / binaryFile.attribute("file_name").value()).str(),
+                                                               cacheDependencyHash);
+        }
 
-                // Increment row length
-                rowLength[pre]++;
-                assert(rowLength[pre] <= maxRowLength);
+        // If connectivity is cached, copy it directly into arrays
+        // **NOTE** delay entry is empty if connection list has no explicit delays
+        std::vector<uint8_t> cachedDelay;
+        if(modelCache->read(cacheName + ".rowLength", cacheDependencyHash, rowLength, numPre)
+           && modelCache->read(cacheName + ".ind", cacheDependencyHash, ind, numSynapseSlots)
+           && modelCache->read(cacheName + ".delay", cacheDependencyHash, cachedDelay)
+           && (cachedDelay.empty() || (delay != nullptr && cachedDelay.size() == numSynapseSlots))
+           && modelCache->read(cacheName + ".remapIndices", cacheDependencyHash, remapIndices))
+        {
+            if(!cachedDelay.empty()) {
+                std::copy(cachedDelay.cbegin(), cachedDelay.cend(), *delay);
             }
 
-            // Subtract words in block from totalConnectors
-            remainingWords -= blockWords;
+            LOGD_SPINEML << "\tList connector with " << remapIndices.size() << " sparse synapses (from cache)";
+            return;
         }
+        remapIndices.clear();
     }
-    // Otherwise loop through connections and add to projection
-    else {
-        // Loop through connections
-        unsigned int i = 0;
-        for(auto c : connections) {
-            // Extract pre and postsynaptic index
-            const unsigned int pre = c.attribute("src_neuron").as_uint();
-            const unsigned int post = c.attribute("dst_neuron").as_uint();
-
-            // Add postsynaptic index to ragged data structure and record creation order
-            const size_t index = (pre * maxRowLength) + rowLength[pre];
-            ind[index] = post;
-            originalOrder[index] = i++;
 
+    // If connectivity is specified using a binary file
+    bool explicitDelay = false;
+    if(binaryFile) {
+        // If there are individual delays then each synapse is 3 words rather than 2
+        explicitDelay = (binaryFile.attribute("explicit_delay_flag").as_uint() != 0);
+
+        // If this connection has explict delays and no delay array was found, error
+        if(explicitDelay && delay == nullptr) {
+            throw std::runtime_error("Cannot build list connector with explicit delay - delay variable not found");
+        }
+
+        // Map binary connection file
+        const std::string filename = (basePath / binaryFile.attribute("file_name").value()).str();
+        const SpineMLCommon::BinaryConnectionFile file(filename, binaryFile.attribute("num_connections").as_uint(),
+                                                       explicitDelay);
+
+        // Build connectivity directly from mapped file
+        buildListSparse(file.getNumConnections(), numPre, numPost, dt, rowLength, ind,
+                        explicitDelay ? *delay : nullptr, maxRowLength, remapIndices,
+                        [&file, explicitDelay](size_t i, unsigned int &pre, unsigned int &post, float &synDelay)
+                        {
+                            pre = file.getPre(i);
+                            post = file.getPost(i);
+                            synDelay = explicitDelay ? file.getDelay(i) : 0.0f;
+                        });
+
+        LOGD_SPINEML << "\tList connector with " << file.getNumConnections() << " sparse synapses";
+    }
+    // Otherwise, extract connections from XML
+    else {
+        std::vector<std::tuple<unsigned int, unsigned int, float>> connections;
+        for(auto c : node.children("Connection")) {
             // If this synapse has a delay
             auto delayAttr = c.attribute("delay");
             if(delayAttr) {
@@ -133,73 +244,30 @@ void createListSparse(const pugi::xml_node &node, double dt, unsigned int numPre
                 if(delay == nullptr) {
                     throw std::runtime_error("Cannot build list connector with explicit delay - delay variable not found");
                 }
-
-                // Store in delay array
-                (*delay)[index] = (uint8_t)std::round(delayAttr.as_float() / dt);
+                explicitDelay = true;
             }
 
-            // Increment row length
-            rowLength[pre]++;
-            assert(rowLength[pre] <= maxRowLength);
+            connections.emplace_back(c.attribute("src_neuron").as_uint(), c.attribute("dst_neuron").as_uint(),
+                                     delayAttr.as_float());
         }
-    }
 
-    LOGD_SPINEML << "\tList connector with " << numConnections << " sparse synapses";
+        // Build connectivity from extracted connections
+        buildListSparse((unsigned int)connections.size(), numPre, numPost, dt, rowLength, ind,
+                        explicitDelay ? *delay : nullptr, maxRowLength, remapIndices,
+                        [&connections](size_t i, unsigned int &pre, unsigned int &post, float &synDelay)
+                        {
+                            std::tie(pre, post, synDelay) = connections[i];
+                        });
 
-    // Reserve remap indices array to match number of connections
-    remapIndices.resize(numConnections);
-
-    // Create array of row indices to use for sorting each row
-    std::vector<unsigned int> rowOrder(maxRowLength);
-    std::vector<unsigned int> rowIndCopy(maxRowLength);
-    std::vector<uint8_t> rowDelayCopy(maxRowLength);
-
-    // Loop through rows
-    for(unsigned int i = 0; i < numPre; i++) {
-        // Get pointer to start of row indices
-        unsigned int *rowIndBegin = &ind[i * maxRowLength];
-
-        // Copy row indices into vector
-        // **NOTE** reordering in place is non-trivial
-        std::copy_n(rowIndBegin, rowLength[i], rowIndCopy.begin());
-
-        // Get iterator to end of section of row order to use for this row
-        auto rowOrderEnd = rowOrder.begin();
-        std::advance(rowOrderEnd, rowLength[i]);
-
-        // Fill section with 0, 1, ..., N
-        std::iota(rowOrder.begin(), rowOrderEnd, 0);
-
-        // Sort row order based on postsynaptic indices
-        std::sort(rowOrder.begin(), rowOrderEnd,
-                  [&rowIndCopy](unsigned int a, unsigned int b)
-                  {
-                      return (rowIndCopy[a] < rowIndCopy[b]);
-                  });
-
-        // Use row order to re-order row indices back into original data structure
-        std::transform(rowOrder.cbegin(), rowOrder.cend(), rowIndBegin,
-                       [&rowIndCopy](unsigned int ord){ return rowIndCopy[ord]; });
-
-        // If a delay array is present
-        if(delay) {
-            // Get pointer to start of row delays
-            uint8_t *rowDelayBegin = &(*delay)[i * maxRowLength];
-
-            // Copy row indices into vector
-            // **NOTE** reordering in place is non-trivial
-            std::copy_n(rowDelayBegin, rowLength[i], rowDelayCopy.begin());
-
-            // Use row order to re-order row delays back into original data structure
-            std::transform(rowOrder.cbegin(), rowOrder.cend(), rowDelayBegin,
-                           [&rowDelayCopy](unsigned int ord){ return rowDelayCopy[ord]; });
-        }
+        LOGD_SPINEML << "\tList connector with " << connections.size() << " sparse synapses";
+    }
 
-        // Loop through synapses in newly reorderd row and set the remap index in the 
-        // synapse's ORIGINAL location to its new index in the ragged array
-        for(unsigned int j = 0; j < rowLength[i]; j++) {
-            remapIndices[originalOrder[(i * maxRowLength) + rowOrder[j]]] = (i * maxRowLength) + j;
-        }
+    // Add connectivity to cache
+    if(!cacheName.empty()) {
+        modelCache->write(cacheName + ".rowLength", cacheDependencyHash, rowLength, numPre);
+        modelCache->write(cacheName + ".ind", cacheDependencyHash, ind, numSynapseSlots);
+        modelCache->write(cacheName + ".delay", cacheDependencyHash, explicitDelay ? *delay : nullptr, explicitDelay ? numSynapseSlots : 0);
+        modelCache->write(cacheName + ".remapIndices", cacheDependencyHash, remapIndices);
     }
 }
 }   // anonymous namespace
@@ -209,7 +277,8 @@ void createListSparse(const pugi::xml_node &node, double dt, unsigned int numPre
 //------------------------------------------------------------------------
 unsigned int SpineMLSimulator::Connectors::create(const pugi::xml_node &node, double dt, unsigned int numPre, unsigned int numPost,
                                                   unsigned int **rowLength, unsigned int **ind, uint8_t **delay, const unsigned int *maxRowLength,
-                                                  const filesystem::path &basePath, std::vector<unsigned int> &remapIndices)
+                                                  const filesystem::path &basePath, std::vector<unsigned int> &remapIndices,
+                                                  SpineMLCommon::ModelCache *modelCache)
 {
     // One to one connectors are initialised using sparse connectivity initialisation
     auto oneToOne = node.child("OneToOneConnection");
@@ -263,7 +332,7 @@ unsigned int SpineMLSimulator::Connectors::create(const pugi::xml_node &node, do
     if(connectionList) {
         if(rowLength != nullptr && ind != nullptr && maxRowLength != nullptr) {
             createListSparse(connectionList, dt, numPre, numPost,
-                             *rowLength, *ind, delay, *maxRowLength, basePath, remapIndices);
+                             *rowLength, *ind, delay, *maxRowLength, basePath, remapIndices, modelCache);
 
             return numPre * (*maxRowLength);
         }
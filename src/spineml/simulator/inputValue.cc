@@ -310,11 +310,14 @@ SpineMLSimulator::InputValue::ExternalNetwork::ExternalNetwork(double dt, unsign
     const std::string connectionName = node.attribute("name").value();
     const std::string hostname = node.attribute("host").value();
     const unsigned int port = node.attribute("tcp_port").as_uint();
+    const unsigned int batchTimesteps = node.attribute("batch_timesteps").as_uint(1);
+    const bool async = node.attribute("async").as_bool();
     LOGD_SPINEML << "\tNetwork input '" << connectionName << "' (" << hostname << ":" << port << ")";
+    LOGD_SPINEML << "\tBatch timesteps:" << batchTimesteps << ", async:" << async;
 
     // Attempt to connect network client
     if(!m_Client.connect(hostname, port, getSize(), NetworkClient::DataType::Analogue,
-        NetworkClient::Mode::Target, connectionName))
+        NetworkClient::Mode::Target, connectionName, batchTimesteps, async))
     {
         throw std::runtime_error("Cannot connect network client");
     }
@@ -2,12 +2,15 @@
 
 // Standard C++ includes
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <iostream>
 
 // Standard C includes
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 // Filesystem includes
 #include "path.h"
@@ -48,6 +51,26 @@ const char *SpineMLTypeName<float>::name = "float";
 //const char *SpineMLTypeName<double>::name = "double";
 }
 
+//----------------------------------------------------------------------------
+// SpineMLSimulator::LogOutput
+//----------------------------------------------------------------------------
+SpineMLSimulator::LogOutput::FileFormat SpineMLSimulator::LogOutput::readFileFormat(const pugi::xml_node &node, FileFormat defaultFormat)
+{
+    const std::string format = node.attribute("format").value();
+    if(format.empty()) {
+        return defaultFormat;
+    }
+    else if(format == "binary") {
+        return FileFormat::Binary;
+    }
+    else if(format == "default") {
+        return FileFormat::Default;
+    }
+    else {
+        throw std::runtime_error("Log '" + std::string(node.attribute("name").value()) + "' has unsupported format '" + format + "'");
+    }
+}
+
 //----------------------------------------------------------------------------
 // SpineMLSimulator::Base::Base
 //----------------------------------------------------------------------------
@@ -100,12 +123,14 @@ SpineMLSimulator::LogOutput::AnalogueBase::AnalogueBase(const pugi::xml_node &no
 SpineMLSimulator::LogOutput::AnalogueFile::AnalogueFile(const pugi::xml_node &node, double dt, unsigned long long numTimeSteps,
                                                         const std::string &port, unsigned int popSize,
                                                         const filesystem::path &logPath,
-                                                        const ModelProperty::Base *modelProperty)
-    : AnalogueBase(node, dt, modelProperty)
+                                                        const ModelProperty::Base *modelProperty,
+                                                        FileFormat defaultFormat)
+    : AnalogueBase(node, dt, modelProperty), m_SnapshotValid{{false, false}}
 {
-    // If indices are specified, allocate output buffer to match indices
-    if(!getIndices().empty()) {
-        m_OutputBuffer.resize(getIndices().size());
+    // Allocate snapshot buffers to match indices or whole population
+    const size_t snapshotSize = getIndices().empty() ? getModelPropertySize() : getIndices().size();
+    for(auto &s : m_Snapshots) {
+        s.resize(snapshotSize);
     }
 
     // Combine node target and logger names to get file title
@@ -150,36 +175,63 @@ SpineMLSimulator::LogOutput::AnalogueFile::AnalogueFile(const pugi::xml_node &no
 
     LOGD_SPINEML << "\tAnalogue file log:" << absoluteFileTitle << "_log.bin";
 
-    // Open file for binary writing
-    m_File.open(absoluteFileTitle + "_log.bin", std::ios::binary);
+    // If binary format is requested, create file pre-sized to hold frames from every timestep logged during the experiment
+    // **NOTE** frames are laid out exactly as when they are streamed so the report is the same
+    if(readFileFormat(node, defaultFormat) == FileFormat::Binary) {
+        const unsigned long long endTimestep = std::min(getEndTimestep(), numTimeSteps);
+        const unsigned long long numFrames = (endTimestep > getStartTimestep()) ? (endTimestep - getStartTimestep()) : 0;
+
+        LOGD_SPINEML << "\tMapping " << numFrames << " frames";
+        m_MappedFile.reset(new MappedFile(absoluteFileTitle + "_log.bin", (size_t)(numFrames * snapshotSize * sizeof(scalar))));
+    }
+    // Otherwise, open file for binary writing
+    else {
+        m_File.open(absoluteFileTitle + "_log.bin", std::ios::binary);
+    }
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::LogOutput::AnalogueFile::record(double dt, unsigned long long timestep)
+{
+    captureSnapshot(dt, timestep, 0);
+    writeSnapshot(0);
 }
 //----------------------------------------------------------------------------
-void SpineMLSimulator::LogOutput::AnalogueFile::record(double, unsigned long long timestep)
+void SpineMLSimulator::LogOutput::AnalogueFile::captureSnapshot(double, unsigned long long timestep, unsigned int buffer)
 {
     // If we should be recording this timestep
-    if(shouldRecord(timestep)) {
+    const bool recording = shouldRecord(timestep);
+    m_SnapshotValid[buffer] = (recording && !m_MappedFile);
+    if(recording) {
         // Pull state variable from device
         // **TODO** simple min/max index optimisation
         pullModelPropertyFromDevice();
 
-        // If no indices are specified, directly write out data from model property
+        // Copy frame directly into mapped file if there is one, otherwise into snapshot
+        auto &snapshot = m_Snapshots[buffer];
+        scalar *frame = m_MappedFile ? reinterpret_cast<scalar*>(m_MappedFile->append(sizeof(scalar) * snapshot.size())) : snapshot.data();
+
+        // If no indices are specified, copy all data from model property
         if(getIndices().empty()) {
-            m_File.write(reinterpret_cast<const char*>(getStateVarBegin()), sizeof(scalar) * getModelPropertySize());
+            std::copy(getStateVarBegin(), getStateVarEnd(), frame);
         }
-        // Otherwise
+        // Otherwise, transform indexed variables into frame so they can be written in one call
         else {
-            // Transform indexed variables into output buffer so they can be written in one call
-            std::transform(getIndices().begin(), getIndices().end(), m_OutputBuffer.begin(),
+            std::transform(getIndices().begin(), getIndices().end(), frame,
                            [this](unsigned int i)
                            {
                                return getStateVarBegin()[i];
                            });
-
-            // Write output buffer to file
-            m_File.write(reinterpret_cast<char*>(m_OutputBuffer.data()), sizeof(scalar) * m_OutputBuffer.size());
         }
     }
 }
+//----------------------------------------------------------------------------
+void SpineMLSimulator::LogOutput::AnalogueFile::writeSnapshot(unsigned int buffer)
+{
+    if(m_SnapshotValid[buffer]) {
+        const auto &snapshot = m_Snapshots[buffer];
+        m_File.write(reinterpret_cast<const char*>(snapshot.data()), sizeof(scalar) * snapshot.size());
+    }
+}
 
 //----------------------------------------------------------------------------
 // SpineMLSimulator::LogOutput::AnalogueExternal
@@ -250,12 +302,15 @@ SpineMLSimulator::LogOutput::AnalogueNetwork::AnalogueNetwork(const pugi::xml_no
     const std::string connectionName = node.attribute("name").value();
     const std::string hostname = node.attribute("host").value();
     const unsigned int tcpPort = node.attribute("tcp_port").as_uint();
+    const unsigned int batchTimesteps = node.attribute("batch_timesteps").as_uint(1);
+    const bool async = node.attribute("async").as_bool();
 
     LOGD_SPINEML << "\tAnalogue network log '" << connectionName << "' (" << hostname << ":" << tcpPort << ")";
+    LOGD_SPINEML << "\tBatch timesteps:" << batchTimesteps << ", async:" << async;
 
     // Attempt to connect network client
     if(!m_Client.connect(hostname, tcpPort, size, NetworkClient::DataType::Analogue,
-        NetworkClient::Mode::Source, connectionName))
+        NetworkClient::Mode::Source, connectionName, batchTimesteps, async))
     {
         throw std::runtime_error("Cannot connect network client");
     }
@@ -295,16 +350,30 @@ SpineMLSimulator::LogOutput::Event::Event(const pugi::xml_node &node, double dt,
                                           const std::string &port, unsigned int popSize,
                                           const filesystem::path &logPath, unsigned int *spikeQueuePtr,
                                           unsigned int *hostSpikeCount, unsigned int *hostSpikes,
-                                          void (*pullCurrentSpikesFunc)(void))
-    : Base(node, dt), m_PopSize(popSize), m_SpikeQueuePtr(spikeQueuePtr),
-      m_HostSpikeCount(hostSpikeCount), m_HostSpikes(hostSpikes), m_PullCurrentSpikesFunc(pullCurrentSpikesFunc)
+                                          void (*pullCurrentSpikesFunc)(void), FileFormat defaultFormat)
+    : Base(node, dt), m_Format(readFileFormat(node, defaultFormat)), m_PopSize(popSize), m_SnapshotTime{{0.0, 0.0}},
+      m_SpikeQueuePtr(spikeQueuePtr), m_HostSpikeCount(hostSpikeCount), m_HostSpikes(hostSpikes),
+      m_PullCurrentSpikesFunc(pullCurrentSpikesFunc)
 {
     // If indices are specified
     auto indices = node.attribute("indices");
     if(indices) {
-        // Read indices into set
+        // Read indices into vector and remove duplicates
         SpineMLCommon::SpineMLUtils::readCSVIndices(indices.value(),
-                                                    std::inserter(m_Indices, m_Indices.end()));
+                                                    std::back_inserter(m_Indices));
+        std::sort(m_Indices.begin(), m_Indices.end());
+        m_Indices.erase(std::unique(m_Indices.begin(), m_Indices.end()), m_Indices.end());
+
+        // Set bits in mask corresponding to indices
+        m_IndexMask.resize(popSize, false);
+        for(unsigned int i : m_Indices) {
+            if(i < popSize) {
+                m_IndexMask[i] = true;
+            }
+            else {
+                LOGW_SPINEML << "\tIndex " << i << " is outside of population of " << popSize << " neurons";
+            }
+        }
 
         LOGD_SPINEML << "\tRecording " << m_Indices.size() << " values";
     }
@@ -320,8 +389,10 @@ SpineMLSimulator::LogOutput::Event::Event(const pugi::xml_node &node, double dt,
     auto report = reportDoc.append_child("LogReport").append_child("EventLog");
 
     // Write standard report metadata here
-    report.append_child("LogFile").text().set((fileTitle + "_log.csv").c_str());
-    report.append_child("LogFileType").text().set("csv");
+    const bool binary = (m_Format == FileFormat::Binary);
+    const std::string logFilename = fileTitle + (binary ? "_log.bin" : "_log.csv");
+    report.append_child("LogFile").text().set(logFilename.c_str());
+    report.append_child("LogFileType").text().set(binary ? "binary" : "csv");
     report.append_child("LogPort").text().set(port.c_str());
     report.append_child("LogEndTime").text().set((double)numTimeSteps * dt);
 
@@ -339,13 +410,14 @@ SpineMLSimulator::LogOutput::Event::Event(const pugi::xml_node &node, double dt,
         }
     }
 
-    // Add CSV time column
+    // Add time column
+    // **NOTE** in binary format, each record consists of the columns' values in this order
     auto logColT = report.append_child("LogCol");
     logColT.append_attribute("heading").set_value("t");
     logColT.append_attribute("dims").set_value("ms");
     logColT.append_attribute("type").set_value("double");
 
-    // Add CSV neuron index column
+    // Add neuron index column
     auto logColIndex = report.append_child("LogCol");
     logColIndex.append_attribute("heading").set_value("index");
     logColIndex.append_attribute("dims").set_value("");
@@ -357,39 +429,73 @@ SpineMLSimulator::LogOutput::Event::Event(const pugi::xml_node &node, double dt,
     // Save report
     reportDoc.save_file((absoluteFileTitle + "_logrep.xml").c_str());
 
-    LOGD_SPINEML << "\tEvent log:" << absoluteFileTitle << ".csv";
+    LOGD_SPINEML << "\tEvent log:" << (logPath / logFilename).str();
 
-    // Open CSV file
-    m_File.open(absoluteFileTitle + "_log.csv");
+    // Open log file
+    m_File.open((logPath / logFilename).str(), binary ? std::ios::binary : std::ios::out);
 }
 //----------------------------------------------------------------------------
 void SpineMLSimulator::LogOutput::Event::record(double dt, unsigned long long timestep)
 {
+    captureSnapshot(dt, timestep, 0);
+    writeSnapshot(0);
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::LogOutput::Event::captureSnapshot(double dt, unsigned long long timestep, unsigned int buffer)
+{
+    auto &snapshot = m_Snapshots[buffer];
+    snapshot.clear();
+
     // If we should be recording this timestep
     if(shouldRecord(timestep)) {
         // Determine current spike queue
         const unsigned int spikeQueueIndex = (m_SpikeQueuePtr == nullptr) ? 0 : *m_SpikeQueuePtr;
-        const unsigned int spikeOffset = m_PopSize * spikeQueueIndex;
 
         // Pull current spikes from device
         m_PullCurrentSpikesFunc();
 
-        const double t = dt * (double)timestep;
+        const unsigned int *spikeBegin = &m_HostSpikes[m_PopSize * spikeQueueIndex];
+        const unsigned int *spikeEnd = spikeBegin + m_HostSpikeCount[spikeQueueIndex];
 
+        m_SnapshotTime[buffer] = dt * (double)timestep;
+
+        // Copy spikes, filtering them by indices if specified
         if(m_Indices.empty()) {
-            for(unsigned int i = 0; i < m_HostSpikeCount[spikeQueueIndex]; i++)
-            {
-                m_File << t << "," << m_HostSpikes[spikeOffset + i] << std::endl;
-            }
+            snapshot.assign(spikeBegin, spikeEnd);
         }
         else {
-            for(unsigned int i = 0; i < m_HostSpikeCount[spikeQueueIndex]; i++)
-            {
-                const unsigned int spikeID = m_HostSpikes[spikeOffset + i];
-                if(m_Indices.find(spikeID) != m_Indices.end()) {
-                    m_File << t << "," << spikeID << std::endl;
-                }
-            }
+            std::copy_if(spikeBegin, spikeEnd, std::back_inserter(snapshot),
+                         [this](unsigned int spikeID)
+                         {
+                             return m_IndexMask[spikeID];
+                         });
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::LogOutput::Event::writeSnapshot(unsigned int buffer)
+{
+    const double t = m_SnapshotTime[buffer];
+    const auto &snapshot = m_Snapshots[buffer];
+
+    // If format is binary, build double time and int32 index record for each spike and write in one call
+    if(m_Format == FileFormat::Binary) {
+        const size_t recordBytes = sizeof(double) + sizeof(int32_t);
+        m_RecordBuffer.resize(recordBytes * snapshot.size());
+
+        char *record = m_RecordBuffer.data();
+        for(unsigned int spikeID : snapshot) {
+            const int32_t index = (int32_t)spikeID;
+            memcpy(record, &t, sizeof(double));
+            memcpy(record + sizeof(double), &index, sizeof(int32_t));
+            record += recordBytes;
+        }
+        m_File.write(m_RecordBuffer.data(), m_RecordBuffer.size());
+    }
+    // Otherwise, write CSV line for each spike
+    else {
+        for(unsigned int spikeID : snapshot) {
+            m_File << t << "," << spikeID << std::endl;
         }
     }
 }
@@ -0,0 +1,94 @@
+#include "logWriter.h"
+
+//----------------------------------------------------------------------------
+// SpineMLSimulator::LogWriter
+//----------------------------------------------------------------------------
+SpineMLSimulator::LogWriter::LogWriter(const std::vector<std::unique_ptr<LogOutput::Base>> &loggers)
+:   m_Pending(false), m_Buffer(0), m_Quit(false)
+{
+    // Take pointers to loggers which support pipelining
+    for(const auto &l : loggers) {
+        if(l->isPipelined()) {
+            m_Loggers.push_back(l.get());
+        }
+    }
+
+    m_Thread = std::thread(&LogWriter::writerThread, this);
+}
+//----------------------------------------------------------------------------
+SpineMLSimulator::LogWriter::~LogWriter()
+{
+    // Wait for any pending snapshot to be written and then signal thread to quit
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait(lock, [this](){ return !m_Pending; });
+        m_Quit = true;
+    }
+    m_Condition.notify_all();
+
+    m_Thread.join();
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::LogWriter::submit(unsigned int buffer)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        waitIdle(lock);
+
+        m_Buffer = buffer;
+        m_Pending = true;
+    }
+    m_Condition.notify_all();
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::LogWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    waitIdle(lock);
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::LogWriter::waitIdle(std::unique_lock<std::mutex> &lock)
+{
+    m_Condition.wait(lock, [this](){ return !m_Pending; });
+
+    if(m_Exception) {
+        std::exception_ptr exception = m_Exception;
+        m_Exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::LogWriter::writerThread()
+{
+    while(true) {
+        // Wait for snapshot to write or request to quit
+        unsigned int buffer;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Condition.wait(lock, [this](){ return m_Pending || m_Quit; });
+            if(!m_Pending) {
+                return;
+            }
+            buffer = m_Buffer;
+        }
+
+        // Write snapshot from each logger without holding lock so next timestep can be simulated
+        std::exception_ptr exception;
+        try {
+            for(auto *l : m_Loggers) {
+                l->writeSnapshot(buffer);
+            }
+        }
+        catch(...) {
+            exception = std::current_exception();
+        }
+
+        // Mark snapshot as written
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Pending = false;
+            m_Exception = exception;
+        }
+        m_Condition.notify_all();
+    }
+}
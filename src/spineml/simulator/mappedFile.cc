@@ -0,0 +1,134 @@
+#include "mappedFile.h"
+
+// Standard C++ includes
+#include <algorithm>
+#include <stdexcept>
+
+// Standard C includes
+#include <cstdint>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// SpineML common includes
+#include "spineMLLogging.h"
+
+//----------------------------------------------------------------------------
+// SpineMLSimulator::MappedFile
+//----------------------------------------------------------------------------
+SpineMLSimulator::MappedFile::MappedFile(const std::string &filename, size_t capacityBytes)
+:   m_Filename(filename), m_Mapping(nullptr), m_CapacityBytes(0), m_UsedBytes(0)
+{
+#ifdef _WIN32
+    m_MappingHandle = nullptr;
+    m_File = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(m_File == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open file for writing:" + filename);
+    }
+#else
+    m_File = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(m_File == -1) {
+        throw std::runtime_error("Cannot open file for writing:" + filename);
+    }
+#endif
+
+    try {
+        map(capacityBytes);
+    }
+    catch(...) {
+#ifdef _WIN32
+        CloseHandle(m_File);
+#else
+        close(m_File);
+#endif
+        throw;
+    }
+}
+//----------------------------------------------------------------------------
+SpineMLSimulator::MappedFile::~MappedFile()
+{
+    unmap();
+
+    // Truncate file to the bytes which have actually been written
+#ifdef _WIN32
+    LARGE_INTEGER size;
+    size.QuadPart = (LONGLONG)m_UsedBytes;
+    if(!SetFilePointerEx(m_File, size, nullptr, FILE_BEGIN) || !SetEndOfFile(m_File)) {
+        LOGW_SPINEML << "Unable to truncate '" << m_Filename << "'";
+    }
+    CloseHandle(m_File);
+#else
+    if(ftruncate(m_File, (off_t)m_UsedBytes) != 0) {
+        LOGW_SPINEML << "Unable to truncate '" << m_Filename << "'";
+    }
+    close(m_File);
+#endif
+}
+//----------------------------------------------------------------------------
+char *SpineMLSimulator::MappedFile::append(size_t numBytes)
+{
+    // If there isn't enough space left, remap file with at least double the capacity
+    if((m_UsedBytes + numBytes) > m_CapacityBytes) {
+        LOGD_SPINEML << "Growing mapped file '" << m_Filename << "' beyond " << m_CapacityBytes << " bytes";
+
+        unmap();
+        map(std::max(m_CapacityBytes * 2, m_UsedBytes + numBytes));
+    }
+
+    char *data = m_Mapping + m_UsedBytes;
+    m_UsedBytes += numBytes;
+    return data;
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::MappedFile::map(size_t capacityBytes)
+{
+    // Empty files can't be mapped
+    m_CapacityBytes = capacityBytes;
+    if(capacityBytes == 0) {
+        return;
+    }
+
+#ifdef _WIN32
+    const uint64_t capacity = capacityBytes;
+    m_MappingHandle = CreateFileMappingA(m_File, nullptr, PAGE_READWRITE,
+                                         (DWORD)(capacity >> 32), (DWORD)(capacity & 0xFFFFFFFF), nullptr);
+    if(m_MappingHandle == nullptr) {
+        throw std::runtime_error("Cannot map file:" + m_Filename);
+    }
+    m_Mapping = static_cast<char*>(MapViewOfFile(m_MappingHandle, FILE_MAP_WRITE, 0, 0, 0));
+    if(m_Mapping == nullptr) {
+        CloseHandle(m_MappingHandle);
+        m_MappingHandle = nullptr;
+        throw std::runtime_error("Cannot map file:" + m_Filename);
+    }
+#else
+    if(ftruncate(m_File, (off_t)capacityBytes) != 0) {
+        throw std::runtime_error("Cannot resize file:" + m_Filename);
+    }
+    void *mapping = mmap(nullptr, capacityBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+    if(mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map file:" + m_Filename);
+    }
+    m_Mapping = static_cast<char*>(mapping);
+
+    // File will be written sequentially
+    madvise(m_Mapping, capacityBytes, MADV_SEQUENTIAL);
+#endif
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::MappedFile::unmap()
+{
+    if(m_Mapping != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_Mapping);
+        CloseHandle(m_MappingHandle);
+        m_MappingHandle = nullptr;
+#else
+        munmap(m_Mapping, m_CapacityBytes);
+#endif
+        m_Mapping = nullptr;
+    }
+}
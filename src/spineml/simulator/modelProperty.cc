@@ -16,6 +16,7 @@
 #include "pugixml/pugixml.hpp"
 
 // SpineML common includes
+#include "modelCache.h"
 #include "spineMLLogging.h"
 
 //------------------------------------------------------------------------
@@ -49,9 +50,34 @@ void SpineMLSimulator::ModelProperty::Fixed::setValue(scalar value)
 // SpineMLSimulator::ModelProperty::ValueList
 //------------------------------------------------------------------------
 SpineMLSimulator::ModelProperty::ValueList::ValueList(const pugi::xml_node &node, const filesystem::path &basePath,
-                                                      const std::vector<unsigned int> *remapIndices, const StateVar<scalar> &stateVar, unsigned int size)
+                                                      const std::vector<unsigned int> *remapIndices, const StateVar<scalar> &stateVar, unsigned int size,
+                                                      SpineMLCommon::ModelCache *modelCache, const std::string &cacheDocument,
+                                                      uint64_t cacheDependencyHash)
     : Base(stateVar, size)
 {
+    // If there is a cache, key entry on this node's position in its document, size, remapping and any binary file
+    std::string cacheName;
+    auto binaryFile = node.child("BinaryFile");
+    if(modelCache != nullptr && node.offset_debug() >= 0) {
+        cacheName = SpineMLCommon::ModelCache::getNodeEntryName("ValueList", cacheDocument, node.offset_debug());
+        cacheDependencyHash = SpineMLCommon::ModelCache::hashValue(size, cacheDependencyHash);
+        if(remapIndices != nullptr) {
+            cacheDependencyHash = SpineMLCommon::ModelCache::hash(remapIndices->data(), sizeof(unsigned int) * remapIndices->size(),
+                                                                  cacheDependencyHash);
+        }
+        if(binaryFile) {
+            cacheDependencyHash = SpineMLCommon::ModelCache::hashFileIdentity((basePath / binaryFile.attribute("file_name").value()).str(),
+                                                                              cacheDependencyHash);
+        }
+
+        // If values are cached, apply them directly
+        if(modelCache->read(cacheName, cacheDependencyHash, m_Values) && m_Values.size() == size) {
+            LOGD_SPINEML << "\t\t\tValue list (from cache)";
+            applyValues();
+            return;
+        }
+    }
+
     // Allocate vector to hold values
     // **NOTE** If we're remapping to a padded sparse matrix we want the size of
     // our values to match the number of connections rather than the padded size
@@ -59,7 +85,6 @@ SpineMLSimulator::ModelProperty::ValueList::ValueList(const pugi::xml_node &node
     std::vector<scalar> values(valueSize);
 
     // If there's a binary file
-    auto binaryFile = node.child("BinaryFile");
     if(binaryFile) {
         // Check number of elements matches
         const unsigned int numElements =  binaryFile.attribute("num_elements").as_uint();
@@ -99,6 +124,11 @@ SpineMLSimulator::ModelProperty::ValueList::ValueList(const pugi::xml_node &node
     }
 
     setValue(values, remapIndices);
+
+    // Add remapped values to cache
+    if(!cacheName.empty()) {
+        modelCache->write(cacheName, cacheDependencyHash, m_Values);
+    }
 }
 //------------------------------------------------------------------------
 void SpineMLSimulator::ModelProperty::ValueList::setValue(const std::vector<scalar> &values, const std::vector<unsigned int> *remapIndices)
@@ -119,6 +149,11 @@ void SpineMLSimulator::ModelProperty::ValueList::setValue(const std::vector<scal
         }
     }
 
+    applyValues();
+}
+//------------------------------------------------------------------------
+void SpineMLSimulator::ModelProperty::ValueList::applyValues()
+{
     // Copy vector of values into state variable
     std::copy(m_Values.begin(), m_Values.end(),
               getHostStateVar());
@@ -225,7 +260,9 @@ void SpineMLSimulator::ModelProperty::ExponentialDistribution::setValue(scalar l
 //----------------------------------------------------------------------------
 std::unique_ptr<SpineMLSimulator::ModelProperty::Base> SpineMLSimulator::ModelProperty::create(const pugi::xml_node &node, const StateVar<scalar> &stateVar,
                                                                                                unsigned int size, bool skipGeNNInitialised, const filesystem::path &basePath,
-                                                                                               const std::string &valueNamespace, const std::vector<unsigned int> *remapIndices)
+                                                                                               const std::string &valueNamespace, const std::vector<unsigned int> *remapIndices,
+                                                                                               SpineMLCommon::ModelCache *modelCache, const std::string &cacheDocument,
+                                                                                               uint64_t cacheDependencyHash)
 {
     // Prepend namespace onto names of various types of model property
     const std::string valueListName = valueNamespace + "ValueList";
@@ -239,7 +276,8 @@ std::unique_ptr<SpineMLSimulator::ModelProperty::Base> SpineMLSimulator::ModelPr
     if(valueChild) {
         // If this property is intialised with a list of values - create a value list model property to manually
         if(strcmp(valueChild.name(), valueListName.c_str()) == 0) {
-            return std::unique_ptr<Base>(new ValueList(valueChild, basePath, remapIndices, stateVar, size));
+            return std::unique_ptr<Base>(new ValueList(valueChild, basePath, remapIndices, stateVar, size,
+                                                       modelCache, cacheDocument, cacheDependencyHash));
         }
         // Otherwise if we can skip property types that GeNN can initialise
         else if(skipGeNNInitialised) {
@@ -1,6 +1,7 @@
 #include "networkClient.h"
 
 // Standard C++ includes
+#include <algorithm>
 #include <stdexcept>
 
 // Standard C includes
@@ -9,22 +10,49 @@
 // SpineML common includes
 #include "spineMLLogging.h"
 
+//----------------------------------------------------------------------------
+// Anonymous namespace
+//----------------------------------------------------------------------------
+namespace
+{
+// Don't raise SIGPIPE if remote host disconnects while we are writing
+#ifdef MSG_NOSIGNAL
+const int noSignalFlag = MSG_NOSIGNAL;
+#else
+const int noSignalFlag = 0;
+#endif
+}
+
 //----------------------------------------------------------------------------
 // SpineMLSimulator::NetworkClient
 //----------------------------------------------------------------------------
-SpineMLSimulator::NetworkClient::NetworkClient() : m_Socket(-1)
+SpineMLSimulator::NetworkClient::NetworkClient()
+:   m_Socket(-1), m_Size(0), m_BatchTimesteps(1), m_Mode(Mode::Source), m_BatchFrames(0), m_BatchFramesRead(0),
+    m_Quit(false), m_Failed(false)
 {
 }
 //----------------------------------------------------------------------------
-SpineMLSimulator::NetworkClient::NetworkClient(const std::string &hostname, unsigned int port, unsigned int size, DataType dataType, Mode mode, const std::string &connectionName)
+SpineMLSimulator::NetworkClient::NetworkClient(const std::string &hostname, unsigned int port, unsigned int size, DataType dataType, Mode mode, const std::string &connectionName,
+                                               unsigned int batchTimesteps, bool async)
+:   NetworkClient()
 {
-    if(!connect(hostname, port, size, dataType, mode, connectionName)) {
+    if(!connect(hostname, port, size, dataType, mode, connectionName, batchTimesteps, async)) {
         throw std::runtime_error("Cannot connect network client");
     }
 }
 //----------------------------------------------------------------------------
 SpineMLSimulator::NetworkClient::~NetworkClient()
 {
+    // Stop I/O thread, sending any timesteps it has buffered
+    stopIOThread();
+
+    // If we are a synchronous source with timesteps waiting to fill a batch, send them
+    if(!m_RingBuffer && m_Mode == Mode::Source && m_BatchFrames > 0) {
+        if(!sendFrames(m_Batch.data(), m_BatchFrames)) {
+            LOGE_SPINEML << "Unable to send final batch";
+        }
+    }
+
     // Close socket
     if(m_Socket >= 0) {
 #ifdef _WIN32
@@ -35,34 +63,68 @@ SpineMLSimulator::NetworkClient::~NetworkClient()
     }
 }
 //----------------------------------------------------------------------------
-bool SpineMLSimulator::NetworkClient::connect(const std::string &hostname, unsigned int port, unsigned int size, DataType dataType, Mode mode, const std::string &connectionName)
+bool SpineMLSimulator::NetworkClient::connect(const std::string &hostname, unsigned int port, unsigned int size, DataType dataType, Mode mode, const std::string &connectionName,
+                                              unsigned int batchTimesteps, bool async)
 {
-    // Create socket
-    m_Socket = socket(AF_INET, SOCK_STREAM, 0);
-    if(m_Socket < 0) {
-        LOGE_SPINEML << "Unable to create socket";
+    // If hostname specifies a Unix domain socket
+    if(hostname.compare(0, 5, "unix:") == 0) {
+#ifdef _WIN32
+        LOGE_SPINEML << "Unix domain sockets are not supported on Windows";
         return false;
+#else
+        // Create socket
+        m_Socket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if(m_Socket < 0) {
+            LOGE_SPINEML << "Unable to create socket";
+            return false;
+        }
+
+        // Create address structure
+        const std::string socketPath = hostname.substr(5);
+        sockaddr_un destAddress;
+        memset(&destAddress, 0, sizeof(sockaddr_un));
+        destAddress.sun_family = AF_UNIX;
+        if(socketPath.size() >= sizeof(destAddress.sun_path)) {
+            LOGE_SPINEML << "Unix domain socket path '" << socketPath << "' is too long";
+            return false;
+        }
+        strcpy(destAddress.sun_path, socketPath.c_str());
+
+        // Connect socket
+        if(::connect(m_Socket, reinterpret_cast<sockaddr*>(&destAddress), sizeof(destAddress)) < 0) {
+            LOGE_SPINEML << "Unable to connect to " << hostname;
+            return false;
+        }
+#endif
     }
+    else {
+        // Create socket
+        m_Socket = socket(AF_INET, SOCK_STREAM, 0);
+        if(m_Socket < 0) {
+            LOGE_SPINEML << "Unable to create socket";
+            return false;
+        }
 
-    // Disable Nagle algorithm
-    // **THINK** should we?
-    const int disableNagle = 1;
-    if(setsockopt(m_Socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&disableNagle), sizeof(int)) < 0) {
-        LOGE_SPINEML << "Unable to set socket options";
-        return false;
-}
-    
-    // Create address structure
-    sockaddr_in destAddress;
-    memset(&destAddress, 0, sizeof(sockaddr_in));
-    destAddress.sin_family = AF_INET;
-    destAddress.sin_port = htons((uint16_t)port);
-    destAddress.sin_addr.s_addr = inet_addr(hostname.c_str());
+        // Disable Nagle algorithm
+        // **THINK** should we?
+        const int disableNagle = 1;
+        if(setsockopt(m_Socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&disableNagle), sizeof(int)) < 0) {
+            LOGE_SPINEML << "Unable to set socket options";
+            return false;
+        }
 
-   // Connect socket
-   if (::connect(m_Socket, reinterpret_cast<sockaddr*>(&destAddress), sizeof(destAddress)) < 0) {
-        LOGE_SPINEML << "Unable to connect to " << hostname << ":" << port;
-        return false;
+        // Create address structure
+        sockaddr_in destAddress;
+        memset(&destAddress, 0, sizeof(sockaddr_in));
+        destAddress.sin_family = AF_INET;
+        destAddress.sin_port = htons((uint16_t)port);
+        destAddress.sin_addr.s_addr = inet_addr(hostname.c_str());
+
+        // Connect socket
+        if (::connect(m_Socket, reinterpret_cast<sockaddr*>(&destAddress), sizeof(destAddress)) < 0) {
+            LOGE_SPINEML << "Unable to connect to " << hostname << ":" << port;
+            return false;
+        }
     }
 
     // Handshake
@@ -109,77 +171,167 @@ bool SpineMLSimulator::NetworkClient::connect(const std::string &hostname, unsig
         return false;
     }
 
+    // If batches of timesteps are requested
+    if(batchTimesteps > 1) {
+        // Send batch request
+        const Request request = Request::Batch;
+        if(!sendAll(reinterpret_cast<const char*>(&request), sizeof(Request))) {
+            LOGE_SPINEML << "Unable to send batch request";
+            return false;
+        }
+
+        // Send batch size
+        Response batchResponse;
+        if(!sendRequestReadResponse(batchTimesteps, batchResponse)) {
+            return false;
+        }
+        // Check remote host has accepted it
+        if(batchResponse != Response::Received) {
+            LOGE_SPINEML << "Remote host does not support batches of " << batchTimesteps << " timesteps";
+            return false;
+        }
+    }
+
+    // Allocate batch
+    m_Size = size;
+    m_Mode = mode;
+    m_BatchTimesteps = std::max(1u, batchTimesteps);
+    m_Batch.resize((size_t)m_Size * m_BatchTimesteps);
+
+    // If client is asynchronous, create ring buffer with space for one batch
+    // to be transferred over the network while the next is filled and start I/O thread
+    if(async) {
+        m_RingBuffer.reset(new FrameRingBuffer(m_Size, 2 * m_BatchTimesteps));
+        m_IOThread = std::thread((mode == Mode::Source) ? &NetworkClient::sourceIOThread : &NetworkClient::targetIOThread, this);
+    }
+
     // Success!
     return true;
 }
 //----------------------------------------------------------------------------
 bool SpineMLSimulator::NetworkClient::receive(std::vector<double> &buffer)
 {
-    // Get buffer size and write pointer as bytes
-    const int bufferSizeBytes = buffer.size() * sizeof(double);
-    char *bufferBytes = reinterpret_cast<char*>(buffer.data());
+    // If client is asynchronous
+    if(m_RingBuffer) {
+        // Wait for I/O thread to receive a frame or fail
+        const double *frame = nullptr;
+        wait([&frame, this](){ return ((frame = m_RingBuffer->getReadFrame()) != nullptr || m_Failed); });
+        if(frame == nullptr) {
+            return false;
+        }
 
-    // get data
-    int totalReceivedBytes = 0;
-    while (totalReceivedBytes < bufferSizeBytes) {
-        const int receivedBytes = ::recv(m_Socket, bufferBytes + totalReceivedBytes, bufferSizeBytes, MSG_WAITALL);
-        if(receivedBytes < 1) {
-            LOGE_SPINEML << "Error reading from socket";
+        // Copy frame into buffer and return it to I/O thread
+        std::copy_n(frame, m_Size, buffer.begin());
+        m_RingBuffer->commitRead();
+        notify();
+    }
+    else {
+        // If all frames in batch have been read, receive new batch
+        if(m_BatchFramesRead == m_BatchFrames) {
+            if(!receiveFrames(m_Batch.data(), m_BatchFrames)) {
+                return false;
+            }
+            m_BatchFramesRead = 0;
+        }
+
+        // Copy next frame from batch into buffer
+        std::copy_n(m_Batch.cbegin() + ((size_t)m_BatchFramesRead * m_Size), m_Size, buffer.begin());
+        m_BatchFramesRead++;
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+bool SpineMLSimulator::NetworkClient::send(const std::vector<double> &buffer)
+{
+    // If client is asynchronous
+    if(m_RingBuffer) {
+        // Wait for space in ring buffer or for I/O thread to fail
+        double *frame = nullptr;
+        wait([&frame, this](){ return ((frame = m_RingBuffer->getWriteFrame()) != nullptr || m_Failed); });
+        if(frame == nullptr) {
             return false;
         }
 
-        totalReceivedBytes += receivedBytes;
+        // Copy buffer into frame and pass it to I/O thread
+        std::copy_n(buffer.cbegin(), m_Size, frame);
+        m_RingBuffer->commitWrite();
+        notify();
+
+        // If I/O thread has failed, no data can be sent
+        return !m_Failed;
     }
+    else {
+        // Copy buffer into next frame of batch
+        std::copy_n(buffer.cbegin(), m_Size, m_Batch.begin() + ((size_t)m_BatchFrames * m_Size));
+        m_BatchFrames++;
 
+        // If batch is full, send it
+        if(m_BatchFrames == m_BatchTimesteps) {
+            m_BatchFrames = 0;
+            return sendFrames(m_Batch.data(), m_BatchTimesteps);
+        }
+        else {
+            return true;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+bool SpineMLSimulator::NetworkClient::sendRequestReadResponse(const std::string &data, Response &response)
+{
     // Start non-blocking send mode and get flags for send (if any)
     const int sendFlags = startNonBlockingSend();
 
-    // Send response
-    const Response response = Response::Received;
-    if (::send(m_Socket, reinterpret_cast<const char*>(&response), sizeof(Response), sendFlags) < 1) {
-        LOGE_SPINEML << "Error writing to socket";
+    // Send string length
+    const int stringLength = data.size();
+    if(::send(m_Socket, reinterpret_cast<const char*>(&stringLength), sizeof(int), sendFlags) < 0) {
+        LOGE_SPINEML << "Unable to send size";
+        return false;
+    }
+
+    // Send string
+    if(::send(m_Socket, data.c_str(), stringLength, sendFlags) < 0) {
+        LOGE_SPINEML << "Unable to send string";
         return false;
     }
 
     // End non-blocking send mode
     endNonBlockingSend();
 
+    // Receive handshake response
+    if(::recv(m_Socket, reinterpret_cast<char*>(&response), sizeof(Response), MSG_WAITALL) < 1) {
+        LOGE_SPINEML << "Unable to receive response";
+        return false;
+    }
+
     return true;
 }
 //----------------------------------------------------------------------------
-bool SpineMLSimulator::NetworkClient::send(const std::vector<double> &buffer)
+bool SpineMLSimulator::NetworkClient::sendFrames(const double *data, unsigned int numFrames)
 {
-    // Start non-blocking send mode and get flags for send (if any)
-    const int sendFlags = startNonBlockingSend();
-
-     // Get buffer size and write pointer as bytes
-    const int bufferSizeBytes = buffer.size() * sizeof(double);
-    const char *bufferBytes = reinterpret_cast<const char*>(buffer.data());
-
-    // send data
-    int totalSentBytes = 0;
-    while (totalSentBytes < bufferSizeBytes) {
-        const int sentBytes = ::send(m_Socket, bufferBytes + totalSentBytes, bufferSizeBytes, sendFlags);
-        if(sentBytes < 1) {
+    // If batches are in use, send number of frames
+    if(m_BatchTimesteps > 1) {
+        const uint32_t numFrames32 = numFrames;
+        if(!sendAll(reinterpret_cast<const char*>(&numFrames32), sizeof(uint32_t))) {
             LOGE_SPINEML << "Error writing to socket";
             return false;
         }
-
-        totalSentBytes += sentBytes;
     }
 
-    // End non-blocking send mode
-    endNonBlockingSend();
+    // Send data
+    if(!sendAll(reinterpret_cast<const char*>(data), sizeof(double) * m_Size * numFrames)) {
+        LOGE_SPINEML << "Error writing to socket";
+        return false;
+    }
 
     // Read response
     Response response;
-    if (::recv(m_Socket, reinterpret_cast<char*>(&response), sizeof(Response), MSG_WAITALL) < 1) {
+    if(!receiveAll(reinterpret_cast<char*>(&response), sizeof(Response))) {
         LOGE_SPINEML << "Unable to receive response";
         return false;
     }
 
     // If response is an abort - error
-    if (response == Response::Abort) {
+    if(response == Response::Abort) {
         LOGE_SPINEML << "Remote host aborted";
         return false;
     }
@@ -189,32 +341,157 @@ bool SpineMLSimulator::NetworkClient::send(const std::vector<double> &buffer)
     }
 }
 //----------------------------------------------------------------------------
-bool SpineMLSimulator::NetworkClient::sendRequestReadResponse(const std::string &data, Response &response)
+bool SpineMLSimulator::NetworkClient::receiveFrames(double *data, unsigned int &numFrames)
 {
-    // Start non-blocking send mode and get flags for send (if any)
-    const int sendFlags = startNonBlockingSend();
+    // If batches are in use, receive number of frames and check it fits in a batch
+    if(m_BatchTimesteps > 1) {
+        uint32_t numFrames32;
+        if(!receiveAll(reinterpret_cast<char*>(&numFrames32), sizeof(uint32_t))) {
+            LOGE_SPINEML << "Error reading from socket";
+            return false;
+        }
+        if(numFrames32 == 0 || numFrames32 > m_BatchTimesteps) {
+            LOGE_SPINEML << "Remote host sent batch of " << numFrames32 << " timesteps";
+            return false;
+        }
+        numFrames = numFrames32;
+    }
+    else {
+        numFrames = 1;
+    }
 
-    // Send string length
-    const int stringLength = data.size();
-    if(::send(m_Socket, reinterpret_cast<const char*>(&stringLength), sizeof(int), sendFlags) < 0) {
-        LOGE_SPINEML << "Unable to send size";
+    // Receive data
+    if(!receiveAll(reinterpret_cast<char*>(data), sizeof(double) * m_Size * numFrames)) {
+        LOGE_SPINEML << "Error reading from socket";
         return false;
     }
 
-    // Send string
-    if(::send(m_Socket, data.c_str(), stringLength, sendFlags) < 0) {
-        LOGE_SPINEML << "Unable to send string";
+    // Send response
+    const Response response = Response::Received;
+    if(!sendAll(reinterpret_cast<const char*>(&response), sizeof(Response))) {
+        LOGE_SPINEML << "Error writing to socket";
         return false;
     }
 
-    // End non-blocking send mode
-    endNonBlockingSend();
+    return true;
+}
+//----------------------------------------------------------------------------
+bool SpineMLSimulator::NetworkClient::sendAll(const char *data, size_t numBytes)
+{
+    size_t totalSentBytes = 0;
+    while(totalSentBytes < numBytes) {
+        const int sentBytes = ::send(m_Socket, data + totalSentBytes, (int)(numBytes - totalSentBytes), noSignalFlag);
+        if(sentBytes < 1) {
+            return false;
+        }
 
-    // Receive handshake response
-    if(::recv(m_Socket, reinterpret_cast<char*>(&response), sizeof(Response), MSG_WAITALL) < 1) {
-        LOGE_SPINEML << "Unable to receive response";
-        return false;
+        totalSentBytes += sentBytes;
     }
+    return true;
+}
+//----------------------------------------------------------------------------
+bool SpineMLSimulator::NetworkClient::receiveAll(char *data, size_t numBytes)
+{
+    size_t totalReceivedBytes = 0;
+    while(totalReceivedBytes < numBytes) {
+        const int receivedBytes = ::recv(m_Socket, data + totalReceivedBytes, (int)(numBytes - totalReceivedBytes), MSG_WAITALL);
+        if(receivedBytes < 1) {
+            return false;
+        }
 
+        totalReceivedBytes += receivedBytes;
+    }
     return true;
 }
+//----------------------------------------------------------------------------
+void SpineMLSimulator::NetworkClient::stopIOThread()
+{
+    if(m_IOThread.joinable()) {
+        m_Quit = true;
+        notify();
+
+        // If I/O thread may be waiting to receive data, shutdown socket to wake it
+        if(m_Mode == Mode::Target) {
+#ifdef _WIN32
+            shutdown(m_Socket, SD_BOTH);
+#else
+            shutdown(m_Socket, SHUT_RDWR);
+#endif
+        }
+
+        m_IOThread.join();
+    }
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::NetworkClient::notify()
+{
+    // Lock and unlock mutex so a thread which has just found its predicate false is
+    // guaranteed to be blocked in wait, rather than about to enter it, when it's notified
+    {
+        std::lock_guard<std::mutex> lock(m_WaitMutex);
+    }
+    m_WaitCondition.notify_all();
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::NetworkClient::sourceIOThread()
+{
+    m_BatchFrames = 0;
+    while(true) {
+        // Read quit flag BEFORE checking for frames so none written before quitting are missed
+        const bool quit = m_Quit;
+
+        // Copy available frames into batch until it's full
+        const double *frame;
+        while(m_BatchFrames < m_BatchTimesteps && (frame = m_RingBuffer->getReadFrame()) != nullptr) {
+            std::copy_n(frame, m_Size, m_Batch.begin() + ((size_t)m_BatchFrames * m_Size));
+            m_RingBuffer->commitRead();
+            m_BatchFrames++;
+            notify();
+        }
+
+        // If batch is full or we're quitting with a partial batch, send it
+        if(m_BatchFrames == m_BatchTimesteps || (quit && m_BatchFrames > 0)) {
+            const unsigned int numFrames = m_BatchFrames;
+            m_BatchFrames = 0;
+            if(!sendFrames(m_Batch.data(), numFrames)) {
+                m_Failed = true;
+                notify();
+                return;
+            }
+        }
+        // Otherwise, if we're quitting, stop
+        else if(quit) {
+            return;
+        }
+        // Otherwise, wait for more frames or to be told to quit
+        else {
+            wait([this](){ return (m_Quit || m_RingBuffer->getReadFrame() != nullptr); });
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SpineMLSimulator::NetworkClient::targetIOThread()
+{
+    while(!m_Quit) {
+        // Receive batch
+        unsigned int numFrames;
+        if(!receiveFrames(m_Batch.data(), numFrames)) {
+            m_Failed = true;
+            notify();
+            return;
+        }
+
+        // Copy frames into ring buffer, waiting for space if required
+        for(unsigned int f = 0; f < numFrames; f++) {
+            double *frame = nullptr;
+            wait([&frame, this](){ return ((frame = m_RingBuffer->getWriteFrame()) != nullptr || m_Quit); });
+            if(frame == nullptr) {
+                return;
+            }
+
+            std::copy_n(m_Batch.cbegin() + ((size_t)f * m_Size), m_Size, frame);
+            m_RingBuffer->commitWrite();
+            notify();
+        }
+    }
+}
@@ -35,6 +35,7 @@ extern "C"
 #include <plog/Appenders/ConsoleAppender.h>
 
 // SpineMLCommon includes
+#include "modelCache.h"
 #include "spineMLLogging.h"
 #include "spineMLUtils.h"
 
@@ -56,7 +57,8 @@ namespace SpineMLSimulator
 {
 Simulator::Simulator(plog::Severity logLevel)
 :   m_ModelLibrary(nullptr), m_StepTime(nullptr), m_SimulationTime(nullptr), m_SimulationTimestep(nullptr),
-    m_DT(0.0), m_DurationMs(0.0), m_InputMs(0.0), m_SimulateMs(0.0), m_LogMs(0.0)
+    m_DT(0.0), m_DurationMs(0.0), m_InputMs(0.0), m_SimulateMs(0.0), m_LogMs(0.0), m_PipelinedLogging(false),
+    m_DefaultLogFormat(LogOutput::FileFormat::Default), m_ModelCacheEnabled(false)
 {
     SpineMLLogging::init(logLevel, &m_ConsoleAppender);
 }
@@ -69,6 +71,9 @@ Simulator::Simulator(const std::string &experimentXML, const std::string &overri
 //----------------------------------------------------------------------------
 Simulator::~Simulator()
 {
+    // Finish writing any pipelined logs before model library is closed
+    m_LogWriter.reset();
+
      // Close model library if loaded successfully
     if(m_ModelLibrary) {
 #ifdef _WIN32
@@ -167,6 +172,14 @@ void Simulator::load(const std::string &experimentXML, const std::string &overri
         initialize();
     }
 
+    // If model cache is enabled, open it and hash experiment which can override network properties
+    std::unique_ptr<ModelCache> modelCache;
+    uint64_t experimentHash = 0;
+    if(m_ModelCacheEnabled) {
+        modelCache.reset(new ModelCache(networkPath.str()));
+        experimentHash = ModelCache::hashFileContents(experimentPath.str());
+    }
+
     // Load network document
     pugi::xml_document networkDoc;
     auto networkResult = networkDoc.load_file(networkPath.str().c_str());
@@ -217,7 +230,7 @@ void Simulator::load(const std::string &experimentXML, const std::string &overri
         // Add neuron population properties to dictionary
         auto geNNPopName = SpineMLUtils::getSafeName(popName);
         addPropertiesAndSizes(basePath, neuron, model, geNNPopName, popSize,
-                              componentSizes);
+                              componentSizes, modelCache.get(), experimentPath.str(), experimentHash);
         addEventPorts(basePath, neuron, componentURLs, componentEventPorts);
     }
 
@@ -251,7 +264,7 @@ void Simulator::load(const std::string &experimentXML, const std::string &overri
             std::vector<unsigned int> remapIndices;
             Connectors::create(input, getDT(), srcPopSize, popSize,
                                 rowLength, ind, delay, maxRowLength,
-                                basePath, remapIndices);
+                                basePath, remapIndices, modelCache.get());
         }
 
         // Loop through outgoing projections
@@ -291,15 +304,16 @@ void Simulator::load(const std::string &experimentXML, const std::string &overri
                 std::vector<unsigned int> remapIndices;
                 const unsigned int synapseVarSize = Connectors::create(synapse, getDT(), popSize, trgPopSize,
                                                                        rowLength, ind, delay, maxRowLength,
-                                                                       basePath, remapIndices);
+                                                                       basePath, remapIndices, modelCache.get());
 
                 // Add postsynapse properties to dictionary
-                addPropertiesAndSizes(basePath, postSynapse, model, geNNSynPopName, trgPopSize, componentSizes);
+                addPropertiesAndSizes(basePath, postSynapse, model, geNNSynPopName, trgPopSize, componentSizes,
+                                      modelCache.get(), experimentPath.str(), experimentHash);
                 addEventPorts(basePath, postSynapse, componentURLs, componentEventPorts);
 
                 // Add weight update properties to dictionary
                 addPropertiesAndSizes(basePath, weightUpdate, model, geNNSynPopName, synapseVarSize, componentSizes,
-                                      remapIndices.empty() ? nullptr : &remapIndices);
+                                      modelCache.get(), experimentPath.str(), experimentHash, remapIndices.empty() ? nullptr : &remapIndices);
                 addEventPorts(basePath, weightUpdate, componentURLs, componentEventPorts);
             }
         }
@@ -361,9 +375,49 @@ void Simulator::stepTime()
     {
         TimerAccumulate t(m_LogMs);
 
-        for(auto &logger : m_Loggers) {
-            logger->record(getDT(), i);
+        // If logging is pipelined
+        if(m_PipelinedLogging) {
+            // Create log writer if it hasn't already been
+            if(!m_LogWriter) {
+                m_LogWriter.reset(new LogWriter(m_Loggers));
+            }
+
+            // Capture snapshots of pipelined logs into alternate buffers each timestep
+            // **NOTE** other buffer may still be being written from previous timestep
+            const unsigned int buffer = (unsigned int)(i % 2);
+            for(auto &logger : m_Loggers) {
+                if(logger->isPipelined()) {
+                    logger->captureSnapshot(getDT(), i, buffer);
+                }
+                else {
+                    logger->record(getDT(), i);
+                }
+            }
+
+            // Write snapshots on logging thread while next timestep is simulated
+            m_LogWriter->submit(buffer);
         }
+        else {
+            for(auto &logger : m_Loggers) {
+                logger->record(getDT(), i);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void Simulator::setPipelinedLogging(bool enabled)
+{
+    // If pipelining is being disabled, finish writing any pipelined logs
+    if(!enabled) {
+        m_LogWriter.reset();
+    }
+    m_PipelinedLogging = enabled;
+}
+//----------------------------------------------------------------------------
+void Simulator::flushLogs()
+{
+    if(m_LogWriter) {
+        m_LogWriter->flush();
     }
 }
 //----------------------------------------------------------------------------
@@ -456,6 +510,7 @@ Simulator::NeuronPopSpikeVars Simulator::getNeuronPopSpikeVars(const std::string
 void Simulator::addPropertiesAndSizes(const filesystem::path &basePath, const pugi::xml_node &node,
                                       const pugi::xml_node &modelNode, const std::string &geNNPopName,
                                       unsigned int popSize, std::map<std::string, unsigned int> &sizes,
+                                      ModelCache *modelCache, const std::string &experimentFilename, uint64_t experimentHash,
                                       const std::vector<unsigned int> *remapIndices)
 {
     // Get SpineML name of component
@@ -512,9 +567,12 @@ void Simulator::addPropertiesAndSizes(const filesystem::path &basePath, const pu
             const std::string valueNamespace = overridenParam ? "UL:" : "";
 
             // Create model property object
+            // **NOTE** overriden properties are read from the experiment so cache entries for them also depend on it
             componentProperties.insert(
                 std::make_pair(paramName, ModelProperty::create(overridenParam ? overridenParam : param, stateVar, popSize,
-                                                                skipGeNNInitialised, basePath, valueNamespace, remapIndices)));
+                                                                skipGeNNInitialised, basePath, valueNamespace, remapIndices, modelCache,
+                                                                overridenParam ? experimentFilename : (modelCache ? modelCache->getNetworkFilename() : ""),
+                                                                overridenParam ? experimentHash : 0)));
         }
     }
 
@@ -682,7 +740,7 @@ std::unique_ptr<LogOutput::Base> Simulator::createLogOutput(const pugi::xml_node
         // Create event logger
         return std::unique_ptr<LogOutput::Base>(new LogOutput::Event(node, getDT(), numTimeSteps, port, targetSize->second,
                                                                      logPath, spikeQueuePtr,
-                                                                     hostSpikeCount, hostSpikes, pullFunc));
+                                                                     hostSpikeCount, hostSpikes, pullFunc, m_DefaultLogFormat));
     }
     // Otherwise we assume it's an analogue send port
     else {
@@ -694,7 +752,7 @@ std::unique_ptr<LogOutput::Base> Simulator::createLogOutput(const pugi::xml_node
             if(portProperty != targetProperties->second.end()) {
                 if(shouldLogToFile) {
                     return std::unique_ptr<LogOutput::Base>(new LogOutput::AnalogueFile(node, getDT(), numTimeSteps, port, targetSize->second,
-                                                                                        logPath, portProperty->second.get()));
+                                                                                        logPath, portProperty->second.get(), m_DefaultLogFormat));
                 }
                 else if(hostName == "0.0.0.0") {
                     // Create logger
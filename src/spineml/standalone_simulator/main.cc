@@ -15,10 +15,16 @@ int main(int argc, char *argv[])
         std::string experimentFilename;
         std::string outputDirectory;
         unsigned int logLevel = plog::info;
+        bool pipelineLogging = false;
+        bool binaryLogs = false;
+        bool modelCache = false;
 
         app.add_option("experiment,-e,--experiment", experimentFilename, "Experiment xml file")->required();
         app.add_option("output,-o,--output", outputDirectory, "Output directory for generated code");
         app.add_flag("--log-error{2},--log-warning{3},--log-info{4},--log-debug{5}", logLevel, "Verbosity of logging to show");
+        app.add_flag("--pipeline-logging", pipelineLogging, "Write logs on a separate thread while the next timestep is simulated");
+        app.add_flag("--binary-logs", binaryLogs, "Write file logs which don't specify a format in binary, using pre-sized memory-mapped files for analogue logs");
+        app.add_flag("--model-cache", modelCache, "Cache connectivity and property values read from the network alongside it and reuse them in subsequent runs");
 
         CLI11_PARSE(app, argc, argv);
 
@@ -32,7 +38,11 @@ int main(int argc, char *argv[])
 #endif  // _WIN32
 
         // Create simulator
-        Simulator simulator(experimentFilename, outputDirectory, (plog::Severity)logLevel);
+        Simulator simulator((plog::Severity)logLevel);
+        simulator.setDefaultLogFormat(binaryLogs ? LogOutput::FileFormat::Binary : LogOutput::FileFormat::Default);
+        simulator.setModelCacheEnabled(modelCache);
+        simulator.load(experimentFilename, outputDirectory);
+        simulator.setPipelinedLogging(pipelineLogging);
 
         const unsigned long long numTimeSteps = simulator.calcNumTimesteps();
         LOGI_SPINEML << "Simulating for " << numTimeSteps << " " << simulator.getDT() << "ms timesteps";
@@ -41,6 +51,7 @@ int main(int argc, char *argv[])
         for(unsigned long long i = 0; i < numTimeSteps; i++) {
             simulator.stepTime();
         }
+        simulator.flushLogs();
 
         LOGI_SPINEML << "Applying input: " << simulator.getInputMs() << "ms, simulating:" << simulator.getSimulateMs() << "ms, logging:" << simulator.getLogMs() << "ms" << std::endl;
 
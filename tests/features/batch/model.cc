@@ -0,0 +1,65 @@
+//--------------------------------------------------------------------------
+/*! \file batch/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Pre
+//----------------------------------------------------------------------------
+//! Neuron which integrates constant input and spikes when it reaches threshold
+class Pre : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Pre, 0, 1);
+
+    SET_SIM_CODE("$(V) += 1.0;\n");
+    SET_THRESHOLD_CONDITION_CODE("$(V) >= 10.0");
+    SET_RESET_CODE("$(V) = 0.0;\n");
+
+    SET_VARS({{"V", "scalar"}});
+};
+IMPLEMENT_MODEL(Pre);
+
+//----------------------------------------------------------------------------
+// Post
+//----------------------------------------------------------------------------
+//! Neuron which accumulates synaptic input
+class Post : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Post, 0, 1);
+
+    SET_SIM_CODE("$(V) += $(Isyn);\n");
+
+    SET_VARS({{"V", "scalar"}});
+};
+IMPLEMENT_MODEL(Post);
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(1.0);
+    model.setName("batch");
+    model.setBatchSize(4);
+
+    InitSparseConnectivitySnippet::FixedProbability::ParamValues fixedProb(0.5);
+    InitVarSnippet::Uniform::ParamValues gDist(0.0, 1.0);
+
+    // Initial state of presynaptic neurons and weights is random so each batch behaves differently
+    model.addNeuronPopulation<Pre>("Pre", 10, {}, Pre::VarValues(initVar<InitVarSnippet::Uniform>({0.0, 10.0})));
+    model.addNeuronPopulation<Post>("Post", 10, {}, Post::VarValues(0.0));
+
+    // Connectivity is shared between batches
+    model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "Syn", SynapseMatrixType::SPARSE_INDIVIDUALG, NO_DELAY, "Pre", "Post",
+        {}, WeightUpdateModels::StaticPulse::VarValues(initVar<InitVarSnippet::Uniform>(gDist)),
+        {}, {},
+        initConnectivity<InitSparseConnectivitySnippet::FixedProbability>(fixedProb));
+
+    model.setPrecision(GENN_FLOAT);
+}
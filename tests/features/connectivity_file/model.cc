@@ -0,0 +1,57 @@
+//--------------------------------------------------------------------------
+/*! \file connectivity_file/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Spiker
+//----------------------------------------------------------------------------
+//! Neuron which spikes every timestep
+class Spiker : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Spiker, 0, 0);
+
+    SET_THRESHOLD_CONDITION_CODE("true");
+    SET_NEEDS_AUTO_REFRACTORY(false);
+};
+IMPLEMENT_MODEL(Spiker);
+
+//----------------------------------------------------------------------------
+// Neuron
+//----------------------------------------------------------------------------
+class Neuron : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Neuron, 0, 1);
+
+    SET_SIM_CODE("$(x)= $(Isyn);\n");
+
+    SET_VARS({{"x", "scalar"}});
+};
+IMPLEMENT_MODEL(Neuron);
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(0.1);
+    model.setName("connectivity_file");
+
+    model.addNeuronPopulation<Spiker>("Pre", 10, {}, {});
+    model.addNeuronPopulation<Neuron>("Post", 10, {}, Neuron::VarValues(0.0));
+
+    // Connectivity is uninitialised so it must be loaded from file
+    WeightUpdateModels::StaticPulse::VarValues staticSynapseInit(1.0);
+    auto *syn = model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "Syn", SynapseMatrixType::SPARSE_GLOBALG, NO_DELAY, "Pre", "Post",
+        {}, staticSynapseInit,
+        {}, {});
+    syn->setMaxConnections(9);
+
+    model.setPrecision(GENN_FLOAT);
+}
@@ -0,0 +1,109 @@
+//--------------------------------------------------------------------------
+/*! \file connectivity_file/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+// Standard C++ includes
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "connectivity_file_CODE/definitions.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+protected:
+    //--------------------------------------------------------------------------
+    // SimulationTest virtuals
+    //--------------------------------------------------------------------------
+    virtual void Init()
+    {
+        // Presynaptic neuron i connects to postsynaptic neurons 0 to i - 1
+        writeConnectivity("connectivity.bin", 10, 9);
+        loadConnectivityFromFile("Syn", "connectivity.bin");
+    }
+
+    //--------------------------------------------------------------------------
+    // Protected methods
+    //--------------------------------------------------------------------------
+    void writeConnectivity(const char *path, uint32_t numPost, uint32_t maxRowLength,
+                           uint32_t row9Length = 9, uint32_t row9Ind = 8) const
+    {
+        std::ofstream os(path, std::ios::binary);
+        const uint32_t header[8] = {0x4E4F4347, 1, 10, numPost, maxRowLength, sizeof(uint32_t), 0, 0};
+        os.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+        std::vector<uint32_t> rowLength(10);
+        std::vector<uint32_t> ind(10 * maxRowLength, 0);
+        for(uint32_t i = 0; i < 10; i++) {
+            rowLength[i] = i;
+            for(uint32_t j = 0; j < i; j++) {
+                ind[(i * maxRowLength) + j] = j;
+            }
+        }
+
+        // Optionally corrupt last row
+        rowLength[9] = row9Length;
+        if(maxRowLength > 8) {
+            ind[(9 * maxRowLength) + 8] = row9Ind;
+        }
+
+        os.write(reinterpret_cast<const char*>(rowLength.data()), sizeof(uint32_t) * rowLength.size());
+        os.write(reinterpret_cast<const char*>(ind.data()), sizeof(uint32_t) * ind.size());
+    }
+};
+
+TEST_F(SimTest, ConnectivityFile)
+{
+    // Check connectivity has been loaded
+    for(unsigned int i = 0; i < 10; i++) {
+        ASSERT_EQ(rowLengthSyn[i], i);
+        for(unsigned int j = 0; j < i; j++) {
+            ASSERT_EQ(indSyn[(i * maxRowLengthSyn) + j], j);
+        }
+    }
+
+    // Each postsynaptic neuron j receives input from presynaptic neurons j + 1 to 9
+    StepGeNN();
+    StepGeNN();
+    for(unsigned int j = 0; j < 10; j++) {
+        ASSERT_FLOAT_EQ(xPost[j], (float)(9 - j));
+    }
+
+    // Loading connectivity with different dimensions or into unknown groups should fail
+    writeConnectivity("wrong_post.bin", 11, 9);
+    writeConnectivity("wrong_row_length.bin", 10, 8);
+    EXPECT_THROW(loadConnectivityFromFile("Syn", "wrong_post.bin"), std::runtime_error);
+    EXPECT_THROW(loadConnectivityFromFile("Syn", "wrong_row_length.bin"), std::runtime_error);
+    EXPECT_THROW(loadConnectivityFromFile("Syn", "missing.bin"), std::runtime_error);
+    EXPECT_THROW(loadConnectivityFromFile("Post", "connectivity.bin"), std::runtime_error);
+
+    // Loading connectivity with row lengths or indices which are out of range should fail unless validation is skipped
+    writeConnectivity("long_row.bin", 10, 9, 10);
+    writeConnectivity("out_of_range_ind.bin", 10, 9, 9, 10);
+    EXPECT_THROW(loadConnectivityFromFile("Syn", "long_row.bin"), std::runtime_error);
+    EXPECT_THROW(loadConnectivityFromFile("Syn", "out_of_range_ind.bin"), std::runtime_error);
+    loadConnectivityFromFile("Syn", "out_of_range_ind.bin", false);
+    ASSERT_EQ(indSyn[(9 * maxRowLengthSyn) + 8], 10u);
+
+    // Check connectivity can be reloaded
+    loadConnectivityFromFile("Syn", "connectivity.bin");
+    ASSERT_EQ(rowLengthSyn[9], 9u);
+    ASSERT_EQ(indSyn[(9 * maxRowLengthSyn) + 8], 8u);
+}
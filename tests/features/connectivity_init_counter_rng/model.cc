@@ -0,0 +1,83 @@
+//--------------------------------------------------------------------------
+/*! \file connectivity_init_counter_rng/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Random
+//----------------------------------------------------------------------------
+class Random : public InitSparseConnectivitySnippet::Base
+{
+public:
+    DECLARE_SNIPPET(Random, 1);
+
+    SET_ROW_BUILD_CODE(
+        "if(j < $(num_post)) {\n"
+        "   if($(gennrand_uniform) < $(prob)) {\n"
+        "       $(addSynapse, j);\n"
+        "   }\n"
+        "   j++;\n"
+        "}\n"
+        "else {\n"
+        "   $(endRow);\n"
+        "}\n");
+    SET_ROW_BUILD_STATE_VARS({{"j", "unsigned int", 0}});
+
+    SET_PARAM_NAMES({"prob"});
+};
+IMPLEMENT_SNIPPET(Random);
+
+//----------------------------------------------------------------------------
+// Neuron
+//----------------------------------------------------------------------------
+class Neuron : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Neuron, 0, 1);
+
+    SET_SIM_CODE("$(x)= $(Isyn);\n");
+
+    SET_VARS({{"x", "scalar"}});
+};
+
+IMPLEMENT_MODEL(Neuron);
+
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(0.1);
+    model.setName("connectivity_init_counter_rng");
+    model.setSeed(1234);
+
+    // Build connectivity using per-row counter-based RNG streams
+    GENN_PREFERENCES.enableCounterBasedRNG = true;
+
+    model.addNeuronPopulation<NeuronModels::SpikeSource>("Pre", 1000, {}, {});
+    model.addNeuronPopulation<Neuron>("Post", 1000, {}, Neuron::VarValues(0.0));
+
+    // Ragged connectivity, gathered target-by-target so postsynaptic remapping is built
+    auto *syn = model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "Syn", SynapseMatrixType::SPARSE_GLOBALG, NO_DELAY, "Pre", "Post",
+        {}, WeightUpdateModels::StaticPulse::VarValues(1.0),
+        {}, {},
+        initConnectivity<Random>({0.1}));
+    syn->setSpanType(SynapseGroup::SpanType::POSTSYNAPTIC);
+    syn->setMaxConnections(1000);
+    syn->setMaxSourceConnections(1000);
+
+    // CSR connectivity
+    auto *synCSR = model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "SynCSR", SynapseMatrixType::CSR_GLOBALG, NO_DELAY, "Pre", "Post",
+        {}, WeightUpdateModels::StaticPulse::VarValues(1.0),
+        {}, {},
+        initConnectivity<Random>({0.1}));
+    synCSR->setMaxConnections(1000);
+
+    model.setPrecision(GENN_FLOAT);
+}
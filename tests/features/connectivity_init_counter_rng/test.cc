@@ -0,0 +1,111 @@
+//--------------------------------------------------------------------------
+/*! \file connectivity_init_counter_rng/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+// Standard C++ includes
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstdint>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "connectivity_init_counter_rng_CODE/definitions.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+//----------------------------------------------------------------------------
+// Anonymous namespace
+//----------------------------------------------------------------------------
+namespace
+{
+// Hash of the postsynaptic targets of each row
+// **NOTE** connectivity only depends on the seed, population and row so this is the
+// same regardless of which CPU backend and how many threads are used to build it
+uint64_t hashRow(uint64_t hash, const unsigned int *ind, unsigned int rowLength)
+{
+    for(unsigned int j = 0; j < rowLength; j++) {
+        hash ^= ind[j];
+        hash *= 1099511628211ull;
+    }
+    hash ^= 0xFFFFFFFF;
+    hash *= 1099511628211ull;
+    return hash;
+}
+
+void checkRow(const unsigned int *ind, unsigned int rowLength)
+{
+    for(unsigned int j = 0; j < rowLength; j++) {
+        ASSERT_LT(ind[j], 1000);
+        if(j > 0) {
+            ASSERT_GT(ind[j], ind[j - 1]);
+        }
+    }
+}
+
+void checkNumSynapses(unsigned int numSynapses)
+{
+    // Number of synapses should be within 5 standard deviations of binomial mean
+    const double mean = 1000.0 * 1000.0 * 0.1;
+    const double sd = std::sqrt(1000.0 * 1000.0 * 0.1 * 0.9);
+    ASSERT_LT(std::fabs((double)numSynapses - mean), 5.0 * sd);
+}
+}
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+};
+
+TEST_F(SimTest, ConnectivityInitCounterRNGRagged)
+{
+    // Check rows are sorted, in range and have the correct number of synapses
+    unsigned int numSynapses = 0;
+    uint64_t hash = 14695981039346656037ull;
+    for(unsigned int i = 0; i < 1000; i++) {
+        checkRow(&indSyn[i * maxRowLengthSyn], rowLengthSyn[i]);
+        hash = hashRow(hash, &indSyn[i * maxRowLengthSyn], rowLengthSyn[i]);
+        numSynapses += rowLengthSyn[i];
+    }
+    checkNumSynapses(numSynapses);
+    EXPECT_EQ(hash, 4915327106766106144ull);
+
+    // Check each column of the postsynaptic remapping contains all synapses targetting
+    // the postsynaptic neuron in row-major order, as if it had been built serially
+    unsigned int numRemapSynapses = 0;
+    for(unsigned int j = 0; j < 1000; j++) {
+        const unsigned int *remap = &remapSyn[j * 1000];
+        for(unsigned int k = 0; k < colLengthSyn[j]; k++) {
+            ASSERT_EQ(indSyn[remap[k]], j);
+            if(k > 0) {
+                ASSERT_GT(remap[k], remap[k - 1]);
+            }
+        }
+        numRemapSynapses += colLengthSyn[j];
+    }
+    ASSERT_EQ(numRemapSynapses, numSynapses);
+}
+
+TEST_F(SimTest, ConnectivityInitCounterRNGCSR)
+{
+    // Check rows are contiguous, sorted, in range and have the correct number of synapses
+    ASSERT_EQ(rowPtrSynCSR[0], 0);
+    uint64_t hash = 14695981039346656037ull;
+    for(unsigned int i = 0; i < 1000; i++) {
+        ASSERT_GE(rowPtrSynCSR[i + 1], rowPtrSynCSR[i]);
+        checkRow(&indSynCSR[rowPtrSynCSR[i]], rowPtrSynCSR[i + 1] - rowPtrSynCSR[i]);
+        hash = hashRow(hash, &indSynCSR[rowPtrSynCSR[i]], rowPtrSynCSR[i + 1] - rowPtrSynCSR[i]);
+    }
+    checkNumSynapses(rowPtrSynCSR[1000]);
+    EXPECT_EQ(hash, 17344629857733409298ull);
+}
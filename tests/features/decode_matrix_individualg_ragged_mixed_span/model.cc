@@ -0,0 +1,54 @@
+//--------------------------------------------------------------------------
+/*! \file decode_matrix_individualg_ragged_mixed_span/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Neuron
+//----------------------------------------------------------------------------
+class Neuron : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Neuron, 0, 1);
+
+    SET_SIM_CODE("$(x)= $(Isyn);\n");
+
+    SET_VARS({{"x", "scalar"}});
+};
+
+IMPLEMENT_MODEL(Neuron);
+
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(0.1);
+    model.setName("decode_matrix_individualg_ragged_mixed_span");
+
+    // Static synapse parameters
+    WeightUpdateModels::StaticPulse::VarValues staticSynapseInit(1.0);    // 0 - Wij (nA)
+
+    model.addNeuronPopulation<NeuronModels::SpikeSource>("Pre", 10, {}, {});
+    model.addNeuronPopulation<Neuron>("PostPre", 4, {}, Neuron::VarValues(0.0));
+    model.addNeuronPopulation<Neuron>("PostPost", 4, {}, Neuron::VarValues(0.0));
+
+    // Identical synapse groups which only differ in span type
+    // **NOTE** only the postsynaptic span group requires a column-major remap so they can't share initialisation code
+    auto *synPre = model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "SynPre", SynapseMatrixType::SPARSE_INDIVIDUALG, NO_DELAY, "Pre", "PostPre",
+        {}, staticSynapseInit,
+        {}, {});
+    synPre->setSpanType(SynapseGroup::SpanType::PRESYNAPTIC);
+
+    auto *synPost = model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "SynPost", SynapseMatrixType::SPARSE_INDIVIDUALG, NO_DELAY, "Pre", "PostPost",
+        {}, staticSynapseInit,
+        {}, {});
+    synPost->setSpanType(SynapseGroup::SpanType::POSTSYNAPTIC);
+    model.setPrecision(GENN_FLOAT);
+}
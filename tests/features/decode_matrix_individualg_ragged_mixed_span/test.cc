@@ -0,0 +1,97 @@
+//--------------------------------------------------------------------------
+/*! \file decode_matrix_individualg_ragged_mixed_span/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+// Standard C includes
+#include <cmath>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "decode_matrix_individualg_ragged_mixed_span_CODE/definitions.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+public:
+    //----------------------------------------------------------------------------
+    // SimulationTest virtuals
+    //----------------------------------------------------------------------------
+    virtual void Init()
+    {
+        initDecoder(rowLengthSynPre, indSynPre);
+        initDecoder(rowLengthSynPost, indSynPost);
+    }
+
+protected:
+    //----------------------------------------------------------------------------
+    // Protected methods
+    //----------------------------------------------------------------------------
+    void initDecoder(unsigned int *rowLength, uint32_t *ind) const
+    {
+        // Loop through presynaptic neurons
+        for(unsigned int i = 0; i < 10; i++)
+        {
+            // Initially zero row length
+            rowLength[i] = 0;
+            for(unsigned int j = 0; j < 4; j++)
+            {
+                // Get value this post synaptic neuron represents
+                const unsigned int j_value = (1 << j);
+
+                // If this postsynaptic neuron should be connected, add index
+                if(((i + 1) & j_value) != 0)
+                {
+                    const unsigned int idx = (i * 4) + rowLength[i]++;
+                    ind[idx] = j;
+                }
+            }
+        }
+    }
+
+    unsigned int decode(const scalar *x) const
+    {
+        // Loop through output neurons
+        unsigned int value = 0;
+        for(unsigned int j = 0; j < 4; j++) {
+            // If this neuron is representing 1 add value it represents to output
+            if(std::fabs(x[j] - 1.0f) < 1E-5) {
+                value += (1 << j);
+            }
+        }
+        return value;
+    }
+};
+
+TEST_F(SimTest, DecodeMatrixIndividualgRaggedMixedSpan)
+{
+    for (int i = 0; i < (int)(10.0f / DT); i++) {
+        // What value should neurons be representing this time step?
+        const unsigned int in_value = (i / 10) + 1;
+
+        // Input spike representing value
+        // **NOTE** neurons start from zero
+        glbSpkCntPre[0] = 1;
+        glbSpkPre[0] = (in_value - 1);
+
+        // Push spikes to device
+        pushPreSpikesToDevice();
+
+        // Step GeNN
+        StepGeNN();
+
+        // Both synapse groups should decode input
+        ASSERT_EQ(decode(xPostPre), in_value);
+        ASSERT_EQ(decode(xPostPost), in_value);
+    }
+}
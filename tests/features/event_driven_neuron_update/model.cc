@@ -0,0 +1,83 @@
+//--------------------------------------------------------------------------
+/*! \file event_driven_neuron_update/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Ramp
+//----------------------------------------------------------------------------
+//! Initialises each neuron's membrane voltage 2mV above the previous so populations start identically
+class Ramp : public InitVarSnippet::Base
+{
+public:
+    DECLARE_SNIPPET(Ramp, 0);
+
+    SET_CODE("$(value) = -70.0 + (2.0 * $(id));");
+};
+IMPLEMENT_SNIPPET(Ramp);
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(1.0);
+    model.setName("event_driven_neuron_update");
+
+    NeuronModels::LIF::ParamValues lifParams(
+        1.0,    // 0 - C
+        20.0,   // 1 - TauM
+        -70.0,  // 2 - Vrest
+        -70.0,  // 3 - Vreset
+        -50.0,  // 4 - Vthresh
+        0.5,    // 5 - Ioffset
+        5.0);   // 6 - TauRefrac
+    NeuronModels::LIF::VarValues lifInit(
+        initVar<Ramp>(),    // 0 - V
+        0.0);               // 1 - RefracTime
+    NeuronModels::SpikeSourceArray::VarValues stimInit(uninitialisedVar(), uninitialisedVar());
+    PostsynapticModels::ExpCurr::ParamValues expCurrParams(5.0);
+
+    // Event-driven spike source drives pairs of event-driven and reference LIF populations
+    auto *stim = model.addNeuronPopulation<NeuronModels::SpikeSourceArray>("Stim", 10, {}, stimInit);
+    auto *deltaEvent = model.addNeuronPopulation<NeuronModels::LIF>("DeltaEvent", 10, lifParams, lifInit);
+    model.addNeuronPopulation<NeuronModels::LIF>("DeltaRef", 10, lifParams, lifInit);
+    auto *expEvent = model.addNeuronPopulation<NeuronModels::LIF>("ExpEvent", 10, lifParams, lifInit);
+    auto *expFlush = model.addNeuronPopulation<NeuronModels::LIF>("ExpFlush", 10, lifParams, lifInit);
+    model.addNeuronPopulation<NeuronModels::LIF>("ExpRef", 10, lifParams, lifInit);
+    auto *delayEvent = model.addNeuronPopulation<NeuronModels::LIF>("DelayEvent", 10, lifParams, lifInit);
+    model.addNeuronPopulation<NeuronModels::LIF>("DelayRef", 10, lifParams, lifInit);
+    stim->setEventDriven(true);
+    deltaEvent->setEventDriven(true);
+    expEvent->setEventDriven(true);
+    expFlush->setEventDriven(true, 1E-6);
+    delayEvent->setEventDriven(true);
+
+    for(const std::string post : {"DeltaEvent", "DeltaRef"}) {
+        model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+            "Stim" + post, SynapseMatrixType::SPARSE_GLOBALG, NO_DELAY, "Stim", post,
+            {}, WeightUpdateModels::StaticPulse::VarValues(12.0),
+            {}, {},
+            initConnectivity<InitSparseConnectivitySnippet::OneToOne>());
+    }
+    for(const std::string post : {"ExpEvent", "ExpFlush", "ExpRef"}) {
+        model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::ExpCurr>(
+            "Stim" + post, SynapseMatrixType::SPARSE_GLOBALG, NO_DELAY, "Stim", post,
+            {}, WeightUpdateModels::StaticPulse::VarValues(3.0),
+            expCurrParams, {},
+            initConnectivity<InitSparseConnectivitySnippet::OneToOne>());
+    }
+    for(const std::string post : {"DelayEvent", "DelayRef"}) {
+        auto *syn = model.addSynapsePopulation<WeightUpdateModels::StaticPulseDendriticDelay, PostsynapticModels::DeltaCurr>(
+            "Stim" + post, SynapseMatrixType::SPARSE_INDIVIDUALG, NO_DELAY, "Stim", post,
+            {}, WeightUpdateModels::StaticPulseDendriticDelay::VarValues(12.0, 3),
+            {}, {},
+            initConnectivity<InitSparseConnectivitySnippet::OneToOne>());
+        syn->setMaxDendriticDelayTimesteps(4);
+    }
+
+    model.setPrecision(GENN_DOUBLE);
+}
@@ -0,0 +1,121 @@
+//--------------------------------------------------------------------------
+/*! \file event_driven_neuron_update/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+// Standard C++ includes
+#include <algorithm>
+#include <vector>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "event_driven_neuron_update_CODE/definitions.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+namespace
+{
+constexpr unsigned int numNeurons = 10;
+constexpr unsigned int numSpikesPerNeuron = 5;
+
+std::vector<unsigned int> getSortedSpikes(const unsigned int *spk, unsigned int spkCnt)
+{
+    std::vector<unsigned int> spikes(spk, spk + spkCnt);
+    std::sort(spikes.begin(), spikes.end());
+    return spikes;
+}
+}
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+protected:
+    //--------------------------------------------------------------------------
+    // SimulationTest virtuals
+    //--------------------------------------------------------------------------
+    virtual void Init()
+    {
+        // Give each stimulus neuron an early spike, a close pair of spikes and two late spikes
+        // **NOTE** the gap before the last spike is longer than the calendar queue used to wake neurons on the CPU
+        allocatespikeTimesStim(numNeurons * numSpikesPerNeuron);
+        for(unsigned int i = 0; i < numNeurons; i++) {
+            startSpikeStim[i] = i * numSpikesPerNeuron;
+            endSpikeStim[i] = (i + 1) * numSpikesPerNeuron;
+
+            scalar *times = &spikeTimesStim[i * numSpikesPerNeuron];
+            times[0] = 2.0 + (3.0 * i);
+            times[1] = 40.0 + (2.0 * i);
+            times[2] = 41.0 + (2.0 * i);
+            times[3] = 100.0;
+            times[4] = 400.0 + i;
+        }
+        pushspikeTimesStimToDevice(numNeurons * numSpikesPerNeuron);
+        pushStimStateToDevice();
+    }
+};
+
+TEST_F(SimTest, EventDrivenNeuronUpdate)
+{
+    std::vector<unsigned int> numStimSpikes(numNeurons, 0);
+    unsigned int numDeltaSpikes = 0;
+    unsigned int numExpSpikes = 0;
+    unsigned int numDelaySpikes = 0;
+    for(unsigned int t = 0; t < 600; t++) {
+        StepGeNN();
+        pullStimCurrentSpikesFromDevice();
+        pullDeltaEventCurrentSpikesFromDevice();
+        pullDeltaRefCurrentSpikesFromDevice();
+        pullExpEventCurrentSpikesFromDevice();
+        pullExpFlushCurrentSpikesFromDevice();
+        pullExpRefCurrentSpikesFromDevice();
+        pullDelayEventCurrentSpikesFromDevice();
+        pullDelayRefCurrentSpikesFromDevice();
+
+        // Check event-driven spike source emits its spikes at the correct times
+        for(unsigned int i : getSortedSpikes(spike_Stim, spikeCount_Stim)) {
+            ASSERT_LT(numStimSpikes[i], numSpikesPerNeuron);
+            ASSERT_DOUBLE_EQ(spikeTimesStim[(i * numSpikesPerNeuron) + numStimSpikes[i]], (double)t);
+            numStimSpikes[i]++;
+        }
+
+        // Check event-driven populations spike at exactly the same times as their references
+        ASSERT_EQ(getSortedSpikes(spike_DeltaEvent, spikeCount_DeltaEvent),
+                  getSortedSpikes(spike_DeltaRef, spikeCount_DeltaRef));
+        ASSERT_EQ(getSortedSpikes(spike_ExpEvent, spikeCount_ExpEvent),
+                  getSortedSpikes(spike_ExpRef, spikeCount_ExpRef));
+        ASSERT_EQ(getSortedSpikes(spike_ExpFlush, spikeCount_ExpFlush),
+                  getSortedSpikes(spike_ExpRef, spikeCount_ExpRef));
+        ASSERT_EQ(getSortedSpikes(spike_DelayEvent, spikeCount_DelayEvent),
+                  getSortedSpikes(spike_DelayRef, spikeCount_DelayRef));
+        numDeltaSpikes += spikeCount_DeltaRef;
+        numExpSpikes += spikeCount_ExpRef;
+        numDelaySpikes += spikeCount_DelayRef;
+    }
+
+    // Check all stimulus spikes were emitted and that they caused spikes in the LIF populations
+    for(unsigned int i = 0; i < numNeurons; i++) {
+        ASSERT_EQ(numStimSpikes[i], numSpikesPerNeuron);
+    }
+    ASSERT_GT(numDeltaSpikes, 0);
+    ASSERT_GT(numExpSpikes, 0);
+    ASSERT_GT(numDelaySpikes, 0);
+
+    // As no input has been received for a long time, event-driven neurons with delta-current input or whose
+    // exponentially-decaying input has been flushed to zero should not have been updated so their state will be stale
+    pullDeltaEventStateFromDevice();
+    pullDeltaRefStateFromDevice();
+    pullExpFlushStateFromDevice();
+    pullExpRefStateFromDevice();
+    for(unsigned int i = 0; i < numNeurons; i++) {
+        ASSERT_NE(VDeltaEvent[i], VDeltaRef[i]);
+        ASSERT_NE(VExpFlush[i], VExpRef[i]);
+    }
+}
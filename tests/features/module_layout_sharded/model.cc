@@ -0,0 +1,95 @@
+//--------------------------------------------------------------------------
+/*! \file module_layout_sharded/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Pre
+//----------------------------------------------------------------------------
+//! Neuron which integrates constant input and spikes when it reaches threshold
+class Pre : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Pre, 0, 1);
+
+    SET_SIM_CODE("$(V) += increment();\n");
+    SET_THRESHOLD_CONDITION_CODE("$(V) >= 10.0");
+    SET_RESET_CODE("$(V) = 0.0;\n");
+    SET_SUPPORT_CODE("SUPPORT_CODE_FUNC scalar increment(){ return 1.0; }\n");
+
+    SET_VARS({{"V", "scalar"}});
+};
+IMPLEMENT_MODEL(Pre);
+
+//----------------------------------------------------------------------------
+// Pre2
+//----------------------------------------------------------------------------
+//! Neuron which integrates constant input twice as quickly using support code with the same name as Pre's
+class Pre2 : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Pre2, 0, 1);
+
+    SET_SIM_CODE("$(V) += increment();\n");
+    SET_THRESHOLD_CONDITION_CODE("$(V) >= 10.0");
+    SET_RESET_CODE("$(V) = 0.0;\n");
+    SET_SUPPORT_CODE("SUPPORT_CODE_FUNC scalar increment(){ return 2.0; }\n");
+
+    SET_VARS({{"V", "scalar"}});
+};
+IMPLEMENT_MODEL(Pre2);
+
+//----------------------------------------------------------------------------
+// Post
+//----------------------------------------------------------------------------
+//! Neuron which accumulates synaptic input
+class Post : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Post, 0, 1);
+
+    SET_SIM_CODE("$(V) += $(Isyn);\n");
+
+    SET_VARS({{"V", "scalar"}});
+};
+IMPLEMENT_MODEL(Post);
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(1.0);
+    model.setName("module_layout_sharded");
+    model.setBatchSize(4);
+
+    // Place code for each merged group in its own module
+    GENN_PREFERENCES.moduleLayout = CodeGenerator::ModuleLayout::SHARDED;
+
+    InitSparseConnectivitySnippet::FixedProbability::ParamValues fixedProb(0.5);
+    InitVarSnippet::Uniform::ParamValues gDist(0.0, 1.0);
+
+    // Initial state of presynaptic neurons and weights is random so each batch behaves differently
+    model.addNeuronPopulation<Pre>("Pre", 10, {}, Pre::VarValues(initVar<InitVarSnippet::Uniform>({0.0, 10.0})));
+    model.addNeuronPopulation<Post>("Post", 10, {}, Post::VarValues(0.0));
+    model.addNeuronPopulation<Pre2>("Pre2", 5, {}, Pre2::VarValues(0.0));
+    model.addNeuronPopulation<Post>("Post2", 20, {}, Post::VarValues(0.0));
+
+    // Connectivity is shared between batches
+    model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "Syn", SynapseMatrixType::SPARSE_INDIVIDUALG, NO_DELAY, "Pre", "Post",
+        {}, WeightUpdateModels::StaticPulse::VarValues(initVar<InitVarSnippet::Uniform>(gDist)),
+        {}, {},
+        initConnectivity<InitSparseConnectivitySnippet::FixedProbability>(fixedProb));
+
+    // Second, independent, network with different connectivity so there are several merged groups of each type
+    model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "Syn2", SynapseMatrixType::DENSE_GLOBALG, NO_DELAY, "Pre2", "Post2",
+        {}, WeightUpdateModels::StaticPulse::VarValues(0.5),
+        {}, {});
+
+    model.setPrecision(GENN_FLOAT);
+}
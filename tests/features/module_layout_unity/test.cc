@@ -0,0 +1,111 @@
+//--------------------------------------------------------------------------
+/*! \file module_layout_unity/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+// Standard C++ includes
+#include <algorithm>
+#include <vector>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "module_layout_unity_CODE/definitions.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+};
+
+TEST_F(SimTest, ModuleLayoutUnity)
+{
+    constexpr unsigned int numBatches = 4;
+    constexpr unsigned int numNeurons = 10;
+
+    // Take copy of initial (per-batch) presynaptic state and weights
+    pullPreStateFromDevice();
+    pullSynStateFromDevice();
+    pullSynConnectivityFromDevice();
+    std::vector<scalar> preV(&VPre[0], &VPre[numBatches * numNeurons]);
+    const std::vector<scalar> g(&gSyn[0], &gSyn[numBatches * numNeurons * maxRowLengthSyn]);
+
+    // Check that batches have been initialised independently
+    EXPECT_FALSE(std::equal(&VPre[0], &VPre[numNeurons], &VPre[numNeurons]));
+
+    std::vector<scalar> postV(numBatches * numNeurons, 0.0f);
+    std::vector<bool> preSpike(numBatches * numNeurons, false);
+
+    // State of second network is the same in every batch and for every neuron
+    scalar pre2V = 0.0f;
+    scalar post2V = 0.0f;
+    bool pre2Spike = false;
+    for(unsigned int t = 0; t < 50; t++) {
+        StepGeNN();
+
+        for(unsigned int b = 0; b < numBatches; b++) {
+            // Deliver last timestep's presynaptic spikes through shared connectivity to this batch's postsynaptic neurons
+            std::vector<scalar> inSyn(numNeurons, 0.0f);
+            for(unsigned int i = 0; i < numNeurons; i++) {
+                if(preSpike[(b * numNeurons) + i]) {
+                    for(unsigned int s = 0; s < rowLengthSyn[i]; s++) {
+                        const unsigned int idx = (i * maxRowLengthSyn) + s;
+                        inSyn[indSyn[idx]] += g[(b * numNeurons * maxRowLengthSyn) + idx];
+                    }
+                }
+            }
+
+            // Update reference neuron state
+            for(unsigned int i = 0; i < numNeurons; i++) {
+                const unsigned int idx = (b * numNeurons) + i;
+                postV[idx] += inSyn[i];
+
+                preV[idx] += 1.0f;
+                preSpike[idx] = (preV[idx] >= 10.0f);
+                if(preSpike[idx]) {
+                    preV[idx] = 0.0f;
+                }
+            }
+
+            // Check number of spikes emitted by each batch matches reference
+            EXPECT_EQ(glbSpkCntPre[b], std::count(preSpike.cbegin() + (b * numNeurons), preSpike.cbegin() + ((b + 1) * numNeurons), true));
+        }
+
+        // Update reference state of second network where every Pre2 neuron is connected to every Post2 neuron
+        post2V += pre2Spike ? (5 * 0.5f) : 0.0f;
+        pre2V += 2.0f;
+        pre2Spike = (pre2V >= 10.0f);
+        if(pre2Spike) {
+            pre2V = 0.0f;
+        }
+
+        // Check state of all batches matches reference
+        for(unsigned int i = 0; i < (numBatches * numNeurons); i++) {
+            ASSERT_FLOAT_EQ(VPre[i], preV[i]);
+            ASSERT_NEAR(VPost[i], postV[i], 1E-4);
+        }
+        for(unsigned int b = 0; b < numBatches; b++) {
+            ASSERT_EQ(glbSpkCntPre2[b], pre2Spike ? 5u : 0u);
+        }
+        for(unsigned int i = 0; i < (numBatches * 5); i++) {
+            ASSERT_FLOAT_EQ(VPre2[i], pre2V);
+        }
+        for(unsigned int i = 0; i < (numBatches * 20); i++) {
+            ASSERT_FLOAT_EQ(VPost2[i], post2V);
+        }
+    }
+
+    // Check that batches have received different input
+    EXPECT_FALSE(std::equal(&VPost[0], &VPost[numNeurons], &VPost[numNeurons]));
+
+    // Check second network has received input
+    EXPECT_GT(post2V, 0.0f);
+}
@@ -0,0 +1,50 @@
+//--------------------------------------------------------------------------
+/*! \file neuron_rng_counter_threads/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Neuron
+//----------------------------------------------------------------------------
+class Neuron : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Neuron, 0, 2);
+
+    SET_SIM_CODE(
+        "$(x)= $(gennrand_uniform);\n"
+        "$(y)= $(gennrand_normal);\n");
+
+    SET_VARS({{"x", "scalar"}, {"y", "scalar"}});
+};
+
+IMPLEMENT_MODEL(Neuron);
+
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(0.1);
+    model.setName("neuron_rng_counter_threads");
+    model.setSeed(1234);
+
+    // Simulate using per-neuron counter-based RNG streams
+    GENN_PREFERENCES.enableCounterBasedRNG = true;
+
+    // **NOTE** threads_N/model.cc define NUM_THREADS and include this
+    // file to build the same model with the multi-threaded backend
+#ifdef NUM_THREADS
+    GENN_PREFERENCES.numThreads = NUM_THREADS;
+#endif
+
+    // **NOTE** population sizes don't divide evenly between threads
+    model.addNeuronPopulation<Neuron>("Pop1", 1003, {}, Neuron::VarValues(0.0, 0.0));
+    model.addNeuronPopulation<Neuron>("Pop2", 17, {}, Neuron::VarValues(0.0, 0.0));
+
+    model.setPrecision(GENN_FLOAT);
+}
@@ -0,0 +1,42 @@
+//--------------------------------------------------------------------------
+/*! \file neuron_rng_counter_threads/record.cc
+
+\brief Records samples generated by the multi-threaded builds of the model
+so test.cc can compare them against those generated by the backend under test
+*/
+//--------------------------------------------------------------------------
+// Standard C++ includes
+#include <fstream>
+#include <iostream>
+
+// Auto-generated simulation code includes
+// **NOTE** angle brackets so the generated code is found in threads_N rather than alongside this file
+#include <neuron_rng_counter_threads_CODE/definitions.h>
+
+int main(int argc, char *argv[])
+{
+    if(argc != 3) {
+        std::cerr << "Expected arguments: num_timesteps output_filename" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    allocateMem();
+    initialize();
+    initializeSparse();
+
+    // Write all variables after each timestep
+    std::ofstream os(argv[2], std::ios::binary);
+    const unsigned long numTimesteps = std::stoul(argv[1]);
+    for(unsigned long t = 0; t < numTimesteps; t++) {
+        stepTime();
+        copyStateFromDevice();
+
+        os.write(reinterpret_cast<const char*>(xPop1), sizeof(scalar) * 1003);
+        os.write(reinterpret_cast<const char*>(yPop1), sizeof(scalar) * 1003);
+        os.write(reinterpret_cast<const char*>(xPop2), sizeof(scalar) * 17);
+        os.write(reinterpret_cast<const char*>(yPop2), sizeof(scalar) * 17);
+    }
+
+    freeMem();
+    return EXIT_SUCCESS;
+}
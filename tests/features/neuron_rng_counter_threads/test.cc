@@ -0,0 +1,65 @@
+//--------------------------------------------------------------------------
+/*! \file neuron_rng_counter_threads/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+// Standard C++ includes
+#include <fstream>
+#include <vector>
+
+// Standard C includes
+#include <cstring>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "neuron_rng_counter_threads_CODE/definitions.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+protected:
+    //--------------------------------------------------------------------------
+    // Protected methods
+    //--------------------------------------------------------------------------
+    void checkSamples(std::istream &is, const scalar *var, unsigned int numNeurons) const
+    {
+        std::vector<scalar> recorded(numNeurons);
+        is.read(reinterpret_cast<char*>(recorded.data()), sizeof(scalar) * numNeurons);
+        ASSERT_TRUE(is.good());
+
+        // Samples should be bit-identical regardless of thread count
+        for(unsigned int i = 0; i < numNeurons; i++) {
+            ASSERT_EQ(std::memcmp(&recorded[i], &var[i], sizeof(scalar)), 0);
+        }
+    }
+};
+
+TEST_F(SimTest, NeuronRngCounterThreads)
+{
+    // **NOTE** samples are recorded from multi-threaded builds by Makefile
+    std::ifstream threads2("threads_2/samples.bin", std::ios::binary);
+    std::ifstream threads3("threads_3/samples.bin", std::ios::binary);
+    ASSERT_TRUE(threads2.good());
+    ASSERT_TRUE(threads3.good());
+
+    for(unsigned int t = 0; t < 10; t++) {
+        StepGeNN();
+
+        for(auto *is : {&threads2, &threads3}) {
+            checkSamples(*is, xPop1, 1003);
+            checkSamples(*is, yPop1, 1003);
+            checkSamples(*is, xPop2, 17);
+            checkSamples(*is, yPop2, 17);
+        }
+    }
+}
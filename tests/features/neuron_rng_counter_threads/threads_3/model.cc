@@ -0,0 +1,9 @@
+//--------------------------------------------------------------------------
+/*! \file neuron_rng_counter_threads/threads_3/model.cc
+
+\brief model definition file which builds the neuron_rng_counter_threads
+model with the multi-threaded CPU backend using 3 threads
+*/
+//--------------------------------------------------------------------------
+#define NUM_THREADS 3
+#include "../model.cc"
@@ -0,0 +1,40 @@
+//--------------------------------------------------------------------------
+/*! \file neuron_rng_normal_counter/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Neuron
+//----------------------------------------------------------------------------
+class Neuron : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Neuron, 0, 1);
+
+    SET_SIM_CODE("$(x)= $(gennrand_normal);\n");
+
+    SET_VARS({{"x", "scalar"}});
+};
+
+IMPLEMENT_MODEL(Neuron);
+
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(0.1);
+    model.setName("neuron_rng_normal_counter");
+
+    // Simulate using per-neuron counter-based RNG streams
+    GENN_PREFERENCES.enableCounterBasedRNG = true;
+    GENN_PREFERENCES.enableSIMDNeuronUpdate = true;
+
+    model.addNeuronPopulation<Neuron>("Pop", 1000, {}, Neuron::VarValues(0.0));
+
+    model.setPrecision(GENN_FLOAT);
+}
@@ -0,0 +1,39 @@
+//--------------------------------------------------------------------------
+/*! \file neuron_rng_uniform_counter/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Neuron
+//----------------------------------------------------------------------------
+class Neuron : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Neuron, 0, 1);
+
+    SET_SIM_CODE("$(x)= $(gennrand_uniform);\n");
+
+    SET_VARS({{"x", "scalar"}});
+};
+
+IMPLEMENT_MODEL(Neuron);
+
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(0.1);
+    model.setName("neuron_rng_uniform_counter");
+
+    // Simulate using per-neuron counter-based RNG streams
+    GENN_PREFERENCES.enableCounterBasedRNG = true;
+
+    model.addNeuronPopulation<Neuron>("Pop", 1000, {}, Neuron::VarValues(0.0));
+
+    model.setPrecision(GENN_FLOAT);
+}
@@ -0,0 +1,69 @@
+//--------------------------------------------------------------------------
+/*! \file performance_counters/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Spiker
+//----------------------------------------------------------------------------
+//! Neuron which spikes every timestep if its ID is less than numSpiking
+class Spiker : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Spiker, 1, 0);
+
+    SET_THRESHOLD_CONDITION_CODE("$(id) < (unsigned int)$(numSpiking)");
+    SET_NEEDS_AUTO_REFRACTORY(false);
+
+    SET_PARAM_NAMES({"numSpiking"});
+};
+IMPLEMENT_MODEL(Spiker);
+
+//----------------------------------------------------------------------------
+// Counter
+//----------------------------------------------------------------------------
+//! Weight update model which counts synapse dynamics updates and postsynaptic spikes
+class Counter : public WeightUpdateModels::Base
+{
+public:
+    DECLARE_WEIGHT_UPDATE_MODEL(Counter, 0, 2, 0, 0);
+
+    SET_VARS({{"numDynamics", "scalar"}, {"numPost", "scalar"}});
+
+    SET_SYNAPSE_DYNAMICS_CODE("$(numDynamics) += 1.0;\n");
+    SET_LEARN_POST_CODE("$(numPost) += 1.0;\n");
+};
+IMPLEMENT_MODEL(Counter);
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(1.0);
+    model.setName("performance_counters");
+    model.setPerformanceCounters(true);
+
+    // 4 presynaptic and 2 postsynaptic neurons spike every timestep
+    model.addNeuronPopulation<Spiker>("Pre", 10, Spiker::ParamValues(4.0), {});
+    model.addNeuronPopulation<Spiker>("Post", 10, Spiker::ParamValues(2.0), {});
+
+    model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "SynDense", SynapseMatrixType::DENSE_INDIVIDUALG, NO_DELAY, "Pre", "Post",
+        {}, WeightUpdateModels::StaticPulse::VarValues(0.0),
+        {}, {});
+    model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "SynSparse", SynapseMatrixType::SPARSE_INDIVIDUALG, NO_DELAY, "Pre", "Post",
+        {}, WeightUpdateModels::StaticPulse::VarValues(0.0),
+        {}, {},
+        initConnectivity<InitSparseConnectivitySnippet::OneToOne>());
+    model.addSynapsePopulation<Counter, PostsynapticModels::DeltaCurr>(
+        "SynCounter", SynapseMatrixType::DENSE_INDIVIDUALG, NO_DELAY, "Pre", "Post",
+        {}, Counter::VarValues(0.0, 0.0),
+        {}, {});
+
+    model.setPrecision(GENN_FLOAT);
+}
@@ -0,0 +1,111 @@
+//--------------------------------------------------------------------------
+/*! \file performance_counters/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+// Standard C++ includes
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <string>
+
+// Standard C includes
+#include <cstring>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "performance_counters_CODE/definitions.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+protected:
+    const PerformanceCounter &getCounter(const char *name, const char *type) const
+    {
+        unsigned int numCounters;
+        const PerformanceCounter *counters = getPerformanceCounters(&numCounters);
+        const PerformanceCounter *counter = std::find_if(counters, counters + numCounters,
+                                                         [name, type](const PerformanceCounter &c)
+                                                         {
+                                                             return (strcmp(c.name, name) == 0 && strcmp(c.type, type) == 0);
+                                                         });
+        EXPECT_NE(counter, counters + numCounters);
+        return *counter;
+    }
+
+    void checkCounter(const char *name, const char *type, unsigned long long numSpikes, unsigned long long numSynapticEvents) const
+    {
+        const PerformanceCounter &counter = getCounter(name, type);
+        EXPECT_EQ(counter.numSpikes, numSpikes) << name << " " << type;
+        EXPECT_EQ(counter.numSynapticEvents, numSynapticEvents) << name << " " << type;
+        EXPECT_GE(counter.time, 0.0);
+    }
+};
+
+TEST_F(SimTest, PerformanceCounters)
+{
+    // Counters for every population's update should be present
+    unsigned int numCounters;
+    getPerformanceCounters(&numCounters);
+    EXPECT_EQ(numCounters, 6);
+
+    // Simulate 10 timesteps
+    for(unsigned int t = 0; t < 10; t++) {
+        StepGeNN();
+    }
+
+    // Neuron updates emit spikes every timestep
+    checkCounter("Pre", "neuronUpdate", 40, 0);
+    checkCounter("Post", "neuronUpdate", 20, 0);
+
+    // Synapse updates process spikes emitted in the previous 9 timesteps
+    checkCounter("SynDense", "presynapticUpdate", 36, 360);
+    checkCounter("SynSparse", "presynapticUpdate", 36, 36);
+    checkCounter("SynCounter", "postsynapticUpdate", 18, 180);
+
+    // Synapse dynamics process every synapse every timestep
+    checkCounter("SynCounter", "synapseDynamics", 0, 1000);
+
+    // Check synaptic events match the work done by the weight update model
+    pullSynCounterStateFromDevice();
+    EXPECT_EQ(std::count(&numDynamicsSynCounter[0], &numDynamicsSynCounter[100], 10.0f), 100);
+    EXPECT_FLOAT_EQ(std::accumulate(&numPostSynCounter[0], &numPostSynCounter[100], 0.0f), 180.0f);
+
+    // Check counters can be reset
+    resetPerformanceCounters();
+    checkCounter("SynDense", "presynapticUpdate", 0, 0);
+    EXPECT_EQ(getCounter("Pre", "neuronUpdate").time, 0.0);
+
+    // Trace two timesteps and write trace
+    setPerformanceTraceEnabled(true);
+    StepGeNN();
+    StepGeNN();
+    setPerformanceTraceEnabled(false);
+    StepGeNN();
+    writePerformanceTrace("performance_counters_trace.json");
+
+    // Read trace back in
+    std::ifstream is("performance_counters_trace.json");
+    ASSERT_TRUE(is.good());
+    const std::string trace{std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+
+    // Check an event was recorded for each population update in each traced timestep
+    size_t numEvents = 0;
+    for(size_t pos = trace.find("\"ph\": \"X\""); pos != std::string::npos; pos = trace.find("\"ph\": \"X\"", pos + 1)) {
+        numEvents++;
+    }
+    EXPECT_EQ(numEvents, 12);
+    EXPECT_NE(trace.find("{\"name\": \"SynSparse\", \"cat\": \"presynapticUpdate\""), std::string::npos);
+    EXPECT_NE(trace.find("\"numSpikes\": 4, \"numSynapticEvents\": 4}"), std::string::npos);
+}
@@ -0,0 +1,72 @@
+//--------------------------------------------------------------------------
+/*! \file procedural_proceduralg/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Pre
+//----------------------------------------------------------------------------
+class Pre : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Pre, 0, 1);
+
+    // Spike every other timestep
+    SET_SIM_CODE("$(v)= 1.0 - $(v);\n");
+    SET_THRESHOLD_CONDITION_CODE("$(v) > 0.5");
+
+    SET_VARS({{"v", "scalar"}});
+};
+
+IMPLEMENT_MODEL(Pre);
+
+//----------------------------------------------------------------------------
+// Post
+//----------------------------------------------------------------------------
+class Post : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Post, 0, 1);
+
+    SET_SIM_CODE("$(x)= $(Isyn);\n");
+
+    SET_VARS({{"x", "scalar"}});
+};
+
+IMPLEMENT_MODEL(Post);
+
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(0.1);
+    model.setName("procedural_proceduralg");
+
+    InitSparseConnectivitySnippet::FixedProbability::ParamValues fixedProb(0.1); // 0 - prob
+    InitVarSnippet::Uniform::ParamValues uniform(0.0, 1.0);                      // 0 - min, 1 - max
+    WeightUpdateModels::StaticPulse::VarValues staticSynapseInit(initVar<InitVarSnippet::Uniform>(uniform));
+
+    model.addNeuronPopulation<Pre>("Pre", 1000, {}, Pre::VarValues(0.0));
+    model.addNeuronPopulation<Post>("Post1", 1000, {}, Post::VarValues(0.0));
+    model.addNeuronPopulation<Post>("Post2", 1000, {}, Post::VarValues(0.0));
+
+    // **NOTE** these synapse groups can be merged so their connectivity and weights
+    // must be generated from different RNG streams to be independent of each other
+    model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "Syn1", SynapseMatrixType::PROCEDURAL_PROCEDURALG, NO_DELAY, "Pre", "Post1",
+        {}, staticSynapseInit,
+        {}, {},
+        initConnectivity<InitSparseConnectivitySnippet::FixedProbability>(fixedProb));
+    model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "Syn2", SynapseMatrixType::PROCEDURAL_PROCEDURALG, NO_DELAY, "Pre", "Post2",
+        {}, staticSynapseInit,
+        {}, {},
+        initConnectivity<InitSparseConnectivitySnippet::FixedProbability>(fixedProb));
+
+    model.setPrecision(GENN_FLOAT);
+}
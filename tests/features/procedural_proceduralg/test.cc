@@ -0,0 +1,54 @@
+//--------------------------------------------------------------------------
+/*! \file procedural_proceduralg/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+// Standard C++ includes
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "procedural_proceduralg_CODE/definitions.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+};
+
+TEST_F(SimTest, ProceduralProceduralg)
+{
+    // Presynaptic neurons spike on odd timesteps so input arrives on even timesteps
+    StepGeNN();
+    StepGeNN();
+    const std::vector<scalar> x1(xPost1, xPost1 + 1000);
+    const std::vector<scalar> x2(xPost2, xPost2 + 1000);
+
+    // Each postsynaptic neuron receives 100 synapses on average with weights averaging 0.5
+    const double mean1 = std::accumulate(x1.cbegin(), x1.cend(), 0.0) / 1000.0;
+    const double mean2 = std::accumulate(x2.cbegin(), x2.cend(), 0.0) / 1000.0;
+    EXPECT_NEAR(mean1, 50.0, 1.0);
+    EXPECT_NEAR(mean2, 50.0, 1.0);
+
+    // Merged synapse groups should be generated from different RNG streams
+    EXPECT_FALSE(std::equal(x1.cbegin(), x1.cend(), x2.cbegin()));
+
+    // Exactly the same connectivity and weights should be regenerated every timestep
+    for(unsigned int t = 0; t < 10; t++) {
+        StepGeNN();
+        StepGeNN();
+        ASSERT_TRUE(std::equal(x1.cbegin(), x1.cend(), xPost1));
+        ASSERT_TRUE(std::equal(x2.cbegin(), x2.cend(), xPost2));
+    }
+}
@@ -0,0 +1,67 @@
+//--------------------------------------------------------------------------
+/*! \file reduced_precision_weights/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Spiker
+//----------------------------------------------------------------------------
+//! Neuron which spikes every timestep
+class Spiker : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Spiker, 0, 0);
+
+    SET_THRESHOLD_CONDITION_CODE("true");
+    SET_NEEDS_AUTO_REFRACTORY(false);
+};
+IMPLEMENT_MODEL(Spiker);
+
+//----------------------------------------------------------------------------
+// Neuron
+//----------------------------------------------------------------------------
+class Neuron : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Neuron, 0, 1);
+
+    SET_SIM_CODE("$(x)= $(Isyn);\n");
+
+    SET_VARS({{"x", "scalar"}});
+};
+IMPLEMENT_MODEL(Neuron);
+
+void addPopulation(ModelSpec &model, const std::string &name, SynapseMatrixType matrixType,
+                   SynapseGroup::VarStorage storage, double scale)
+{
+    InitVarSnippet::Uniform::ParamValues gDist(-1.0, 1.0);
+    model.addNeuronPopulation<Neuron>("Post" + name, 10, {}, Neuron::VarValues(0.0));
+    auto *syn = model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>(
+        "Syn" + name, matrixType, NO_DELAY, "Pre", "Post" + name,
+        {}, WeightUpdateModels::StaticPulse::VarValues(initVar<InitVarSnippet::Uniform>(gDist)),
+        {}, {},
+        initConnectivity<InitSparseConnectivitySnippet::FixedProbability>({0.5}));
+    syn->setWUVarStorage("g", storage, scale);
+}
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(0.1);
+    model.setName("reduced_precision_weights");
+
+    model.addNeuronPopulation<Spiker>("Pre", 10, {}, {});
+
+    addPopulation(model, "Half", SynapseMatrixType::DENSE_INDIVIDUALG, SynapseGroup::VarStorage::HALF, 1.0);
+    addPopulation(model, "BFloat16", SynapseMatrixType::SPARSE_INDIVIDUALG, SynapseGroup::VarStorage::BFLOAT16, 1.0);
+    addPopulation(model, "Fixed8", SynapseMatrixType::DENSE_INDIVIDUALG, SynapseGroup::VarStorage::FIXED8, 1.0 / 64.0);
+    addPopulation(model, "Fixed8Fine", SynapseMatrixType::DENSE_INDIVIDUALG, SynapseGroup::VarStorage::FIXED8, 1.0 / 128.0);
+    addPopulation(model, "Fixed16", SynapseMatrixType::SPARSE_INDIVIDUALG, SynapseGroup::VarStorage::FIXED16, 1.0 / 8192.0);
+
+    model.setPrecision(GENN_FLOAT);
+}
@@ -0,0 +1,97 @@
+//--------------------------------------------------------------------------
+/*! \file reduced_precision_weights/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+// Standard C++ includes
+#include <functional>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "reduced_precision_weights_CODE/definitions.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+protected:
+    // Check input to each postsynaptic neuron matches sum of decoded weights
+    template<typename T>
+    void checkDense(const T *g, const scalar *x, std::function<float(T)> decode) const
+    {
+        for(unsigned int j = 0; j < 10; j++) {
+            float input = 0.0f;
+            for(unsigned int i = 0; i < 10; i++) {
+                input += decode(g[(i * 10) + j]);
+            }
+            EXPECT_NEAR(x[j], input, 1E-5);
+        }
+    }
+
+    template<typename T>
+    void checkSparse(const unsigned int *rowLength, const uint32_t *ind, unsigned int maxRowLength,
+                     const T *g, const scalar *x, std::function<float(T)> decode) const
+    {
+        float input[10] = {};
+        for(unsigned int i = 0; i < 10; i++) {
+            for(unsigned int s = 0; s < rowLength[i]; s++) {
+                const unsigned int idx = (i * maxRowLength) + s;
+                input[ind[idx]] += decode(g[idx]);
+            }
+        }
+        for(unsigned int j = 0; j < 10; j++) {
+            EXPECT_NEAR(x[j], input[j], 1E-5);
+        }
+    }
+};
+
+TEST_F(SimTest, ReducedPrecisionWeights)
+{
+    // Check conversions round to nearest representable value
+    EXPECT_EQ(gennHalfToFloat(gennFloatToHalf(0.3f)), 0.300048828125f);
+    EXPECT_EQ(gennHalfToFloat(gennFloatToHalf(-1.0E-6f)), -1.013278961181640625E-6f);
+    EXPECT_EQ(gennHalfToFloat(gennFloatToHalf(1.0E6f)), INFINITY);
+    EXPECT_EQ(gennBFloat16ToFloat(gennFloatToBFloat16(0.3f)), 0.30078125f);
+    EXPECT_EQ(gennFloatToFixed8(0.3f, 1.0f / 64.0f), 19);
+    EXPECT_EQ(gennFloatToFixed8(4.0f, 1.0f / 64.0f), 127);
+    EXPECT_EQ(gennFloatToFixed16(-0.3f, 1.0f / 8192.0f), -2458);
+
+    // Reduced-precision weights should occupy fewer bytes
+    EXPECT_EQ(sizeof(gSynHalf[0]), 2);
+    EXPECT_EQ(sizeof(gSynFixed8[0]), 1);
+
+    // Simulate a few timesteps so postsynaptic neurons receive input from every presynaptic spike
+    for(unsigned int t = 0; t < 5; t++) {
+        StepGeNN();
+    }
+
+    pullSynHalfStateFromDevice();
+    pullSynBFloat16StateFromDevice();
+    pullSynFixed8StateFromDevice();
+    pullSynFixed8FineStateFromDevice();
+    pullSynFixed16StateFromDevice();
+    pullSynBFloat16ConnectivityFromDevice();
+    pullSynFixed16ConnectivityFromDevice();
+    pullPostHalfStateFromDevice();
+    pullPostBFloat16StateFromDevice();
+    pullPostFixed8StateFromDevice();
+    pullPostFixed8FineStateFromDevice();
+    pullPostFixed16StateFromDevice();
+
+    checkDense<uint16_t>(gSynHalf, xPostHalf, gennHalfToFloat);
+    checkSparse<uint16_t>(rowLengthSynBFloat16, indSynBFloat16, maxRowLengthSynBFloat16,
+                          gSynBFloat16, xPostBFloat16, gennBFloat16ToFloat);
+    checkDense<int8_t>(gSynFixed8, xPostFixed8, [](int8_t g){ return g / 64.0f; });
+    checkDense<int8_t>(gSynFixed8Fine, xPostFixed8Fine, [](int8_t g){ return g / 128.0f; });
+    checkSparse<int16_t>(rowLengthSynFixed16, indSynFixed16, maxRowLengthSynFixed16,
+                         gSynFixed16, xPostFixed16, [](int16_t g){ return g / 8192.0f; });
+}
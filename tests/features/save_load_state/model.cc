@@ -0,0 +1,79 @@
+//--------------------------------------------------------------------------
+/*! \file save_load_state/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Pre
+//----------------------------------------------------------------------------
+//! Neuron which integrates random input and spikes when it reaches threshold
+class Pre : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Pre, 0, 1);
+
+    SET_SIM_CODE("$(V) += $(gennrand_uniform);\n");
+    SET_THRESHOLD_CONDITION_CODE("$(V) >= 5.0");
+    SET_RESET_CODE("$(V) = 0.0;\n");
+
+    SET_VARS({{"V", "scalar"}});
+};
+IMPLEMENT_MODEL(Pre);
+
+//----------------------------------------------------------------------------
+// Post
+//----------------------------------------------------------------------------
+//! Leaky neuron which integrates synaptic input
+class Post : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Post, 0, 1);
+
+    SET_SIM_CODE("$(V) = (0.9 * $(V)) + $(Isyn);\n");
+
+    SET_VARS({{"V", "scalar"}});
+};
+IMPLEMENT_MODEL(Post);
+
+//----------------------------------------------------------------------------
+// WeightUpdateModel
+//----------------------------------------------------------------------------
+//! Weight update model which delivers input to the postsynaptic neuron after a dendritic delay
+class WeightUpdateModel : public WeightUpdateModels::Base
+{
+public:
+    DECLARE_WEIGHT_UPDATE_MODEL(WeightUpdateModel, 0, 1, 0, 0);
+
+    SET_VARS({{"g", "scalar"}});
+
+    SET_SIM_CODE("$(addToInSynDelay, $(g), 3);\n");
+};
+IMPLEMENT_MODEL(WeightUpdateModel);
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(1.0);
+    model.setName("save_load_state");
+
+    InitSparseConnectivitySnippet::FixedProbability::ParamValues fixedProb(0.1);
+    InitVarSnippet::Uniform::ParamValues gDist(0.0, 1.0);
+
+    model.addNeuronPopulation<Pre>("Pre", 100, {}, Pre::VarValues(initVar<InitVarSnippet::Uniform>({0.0, 5.0})));
+    model.addNeuronPopulation<Post>("Post", 100, {}, Post::VarValues(0.0));
+
+    // Use both axonal and dendritic delays so spike queue and dendritic delay pointers are part of state
+    auto *syn = model.addSynapsePopulation<WeightUpdateModel, PostsynapticModels::DeltaCurr>(
+        "Syn", SynapseMatrixType::SPARSE_INDIVIDUALG, 2, "Pre", "Post",
+        {}, WeightUpdateModel::VarValues(initVar<InitVarSnippet::Uniform>(gDist)),
+        {}, {},
+        initConnectivity<InitSparseConnectivitySnippet::FixedProbability>(fixedProb));
+    syn->setMaxDendriticDelayTimesteps(5);
+
+    model.setPrecision(GENN_FLOAT);
+}
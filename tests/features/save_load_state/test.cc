@@ -0,0 +1,71 @@
+//--------------------------------------------------------------------------
+/*! \file save_load_state/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+// Standard C++ includes
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "save_load_state_CODE/definitions.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+};
+
+TEST_F(SimTest, SaveLoadState)
+{
+    // Simulate for a while to fill up delay queues and save state
+    for(unsigned int i = 0; i < 50; i++) {
+        StepGeNN();
+    }
+    saveState("checkpoint.bin");
+
+    // Simulate further, recording postsynaptic state after each timestep
+    std::vector<scalar> referenceV;
+    for(unsigned int i = 0; i < 50; i++) {
+        StepGeNN();
+        pullVPostFromDevice();
+        referenceV.insert(referenceV.end(), &VPost[0], &VPost[100]);
+    }
+
+    // Trash state and connectivity
+    std::fill_n(VPost, 100, 0.0f);
+    std::fill_n(rowLengthSyn, 100, 0);
+    pushVPostToDevice();
+    pushSynConnectivityToDevice();
+
+    // Restore state
+    loadState("checkpoint.bin");
+    EXPECT_EQ(iT, 50);
+    EXPECT_EQ(t, 50.0f);
+
+    // Check simulation exactly reproduces reference
+    for(unsigned int i = 0; i < 50; i++) {
+        StepGeNN();
+        pullVPostFromDevice();
+        for(unsigned int j = 0; j < 100; j++) {
+            ASSERT_EQ(VPost[j], referenceV[(i * 100) + j]);
+        }
+    }
+
+    // Check that postsynaptic neurons have received some input
+    EXPECT_TRUE(std::any_of(&VPost[0], &VPost[100], [](scalar v){ return v != 0.0f; }));
+
+    // Check that missing checkpoints are reported
+    EXPECT_THROW(loadState("missing.bin"), std::runtime_error);
+}
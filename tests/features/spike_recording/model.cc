@@ -0,0 +1,52 @@
+//--------------------------------------------------------------------------
+/*! \file spike_recording/model.cc
+
+\brief model definition file that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+#include "modelSpec.h"
+
+//----------------------------------------------------------------------------
+// Neuron
+//----------------------------------------------------------------------------
+//! Neuron which spikes every 10 timesteps, with phase determined by initial value of x
+class Neuron : public NeuronModels::Base
+{
+public:
+    DECLARE_MODEL(Neuron, 0, 1);
+
+    SET_SIM_CODE("$(x) += 1.0;\n");
+    SET_THRESHOLD_CONDITION_CODE("$(x) >= 10.0");
+    SET_RESET_CODE("$(x) = 0.0;\n");
+
+    SET_VARS({{"x", "scalar"}});
+};
+
+IMPLEMENT_MODEL(Neuron);
+
+//----------------------------------------------------------------------------
+// Phase
+//----------------------------------------------------------------------------
+class Phase : public InitVarSnippet::Base
+{
+public:
+    DECLARE_SNIPPET(Phase, 0);
+
+    SET_CODE("$(value) = (scalar)($(id) % 10);");
+};
+IMPLEMENT_SNIPPET(Phase);
+
+void modelDefinition(ModelSpec &model)
+{
+    model.setDT(1.0);
+    model.setName("spike_recording");
+
+    // Population size deliberately isn't a multiple of 32
+    auto *pop = model.addNeuronPopulation<Neuron>("Pop", 100, {}, Neuron::VarValues(initVar<Phase>()));
+    pop->setSpikeRecordingEnabled(true);
+
+    model.setPrecision(GENN_FLOAT);
+}
@@ -0,0 +1,72 @@
+//--------------------------------------------------------------------------
+/*! \file spike_recording/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "spike_recording_CODE/definitions.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+};
+
+TEST_F(SimTest, SpikeRecording)
+{
+    // Allocate recording buffer which can hold 25 timesteps
+    allocateRecordingBuffers(25);
+    ASSERT_EQ(numRecordingTimesteps, 25);
+
+    const unsigned int numWords = (100 + 31) / 32;
+    for(unsigned int block = 0; block < 4; block++) {
+        // Simulate 25 timesteps and copy recording buffer from device
+        for(unsigned int i = 0; i < 25; i++) {
+            StepGeNN();
+        }
+        pullRecordingBuffersFromDevice();
+
+        // Loop through timesteps recorded in this block
+        for(unsigned int i = 0; i < 25; i++) {
+            const unsigned long long timestep = (block * 25) + i;
+            const uint32_t *bitfield = &recordSpkPop[(timestep % numRecordingTimesteps) * numWords];
+
+            // Neuron n should spike when (timestep + 1 + (n % 10)) is a multiple of 10
+            for(unsigned int n = 0; n < 100; n++) {
+                const bool spiked = (bitfield[n / 32] & (1u << (n % 32))) != 0;
+                EXPECT_EQ(spiked, ((timestep + 1 + (n % 10)) % 10) == 0);
+            }
+
+            // Bits beyond the end of the population should never be set
+            EXPECT_EQ(bitfield[numWords - 1] >> (100 % 32), 0u);
+        }
+    }
+
+    // Reallocate recording buffer to hold a longer window of 50 timesteps
+    allocateRecordingBuffers(50);
+    ASSERT_EQ(numRecordingTimesteps, 50);
+    for(unsigned int i = 0; i < 50; i++) {
+        StepGeNN();
+    }
+    pullRecordingBuffersFromDevice();
+    for(unsigned int i = 0; i < 50; i++) {
+        const unsigned long long timestep = 100 + i;
+        const uint32_t *bitfield = &recordSpkPop[(timestep % numRecordingTimesteps) * numWords];
+        for(unsigned int n = 0; n < 100; n++) {
+            const bool spiked = (bitfield[n / 32] & (1u << (n % 32))) != 0;
+            EXPECT_EQ(spiked, ((timestep + 1 + (n % 10)) % 10) == 0);
+        }
+    }
+}
@@ -0,0 +1,163 @@
+//--------------------------------------------------------------------------
+/*! \file spike_writer_binary/test.cc
+
+\brief Main test code that is part of the feature testing
+suite of minimal models with known analytic outcomes that are used for continuous integration testing.
+*/
+//--------------------------------------------------------------------------
+// Standard C++ includes
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Auto-generated simulation code includess
+#include "spike_writer_binary_CODE/definitions.h"
+
+// Userproject includes
+#include "../../../userproject/include/spikeRecorder.h"
+
+// **NOTE** base-class for simulation tests must be
+// included after auto-generated globals are includes
+#include "../../utils/simulation_test.h"
+
+//----------------------------------------------------------------------------
+// Anonymous namespace
+//----------------------------------------------------------------------------
+namespace
+{
+typedef std::vector<std::pair<uint64_t, unsigned int>> Spikes;
+
+template<typename T>
+T readRaw(const std::vector<uint8_t> &data, size_t &offset)
+{
+    // **NOTE** at() checks the whole value lies within the file
+    data.at(offset + sizeof(T) - 1);
+
+    T value;
+    std::memcpy(&value, &data[offset], sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+
+uint64_t readVarint(const std::vector<uint8_t> &data, size_t &offset)
+{
+    uint64_t value = 0;
+    for(unsigned int shift = 0;; shift += 7) {
+        const uint8_t byte = data.at(offset++);
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if(byte < 0x80) {
+            return value;
+        }
+    }
+}
+
+// Read timesteps and IDs of spikes from file in the format written by SpikeWriterBinary, checking its structure
+// **NOTE** this mirrors userproject/python/spike_binary.py
+Spikes readSpikesBinary(const char *filename, double dt, unsigned int &numBlocks)
+{
+    std::ifstream is(filename, std::ios::binary);
+    const std::vector<uint8_t> data{std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+
+    // Read and check file header
+    size_t offset = 0;
+    EXPECT_EQ(std::string(data.begin(), data.begin() + 4), "GSPK");
+    offset += 4;
+    EXPECT_EQ(readRaw<uint32_t>(data, offset), 1u);
+    EXPECT_EQ(readRaw<double>(data, offset), dt);
+
+    Spikes spikes;
+    numBlocks = 0;
+    while(offset < data.size()) {
+        // Read block header
+        const uint64_t firstTimestep = readRaw<uint64_t>(data, offset);
+        const uint32_t numRecords = readRaw<uint32_t>(data, offset);
+        const uint32_t numSpikes = readRaw<uint32_t>(data, offset);
+        const uint32_t timestepBytes = readRaw<uint32_t>(data, offset);
+        const uint32_t countBytes = readRaw<uint32_t>(data, offset);
+        const uint32_t idBytes = readRaw<uint32_t>(data, offset);
+
+        // Find start and end of each column
+        const size_t timestepEnd = offset + timestepBytes;
+        const size_t countEnd = timestepEnd + countBytes;
+        const size_t idEnd = countEnd + idBytes;
+        size_t timestepOffset = offset;
+        size_t countOffset = timestepEnd;
+        size_t idOffset = countEnd;
+
+        // Decode records
+        uint64_t timestep = firstTimestep;
+        uint32_t numBlockSpikes = 0;
+        for(uint32_t r = 0; r < numRecords; r++) {
+            timestep += readVarint(data, timestepOffset);
+            const uint64_t count = readVarint(data, countOffset);
+            unsigned int id = 0;
+            for(uint64_t s = 0; s < count; s++) {
+                id += (unsigned int)readVarint(data, idOffset);
+                spikes.emplace_back(timestep, id);
+            }
+            numBlockSpikes += (uint32_t)count;
+        }
+
+        // Check exactly all of each column was consumed
+        EXPECT_EQ(timestepOffset, timestepEnd);
+        EXPECT_EQ(countOffset, countEnd);
+        EXPECT_EQ(idOffset, idEnd);
+        EXPECT_EQ(numBlockSpikes, numSpikes);
+        offset = idEnd;
+        numBlocks++;
+    }
+    return spikes;
+}
+}   // Anonymous namespace
+
+//----------------------------------------------------------------------------
+// SimTest
+//----------------------------------------------------------------------------
+class SimTest : public SimulationTest
+{
+};
+
+TEST_F(SimTest, SpikeWriterBinary)
+{
+    Spikes correct;
+    {
+        // Use small blocks so spikes are split across several
+        SpikeRecorder<SpikeWriterBinary> recorder(&getPopCurrentSpikes, &getPopCurrentSpikeCount,
+                                                  "spikes.bin", DT, 256);
+        for(unsigned int i = 0; i < 1000; i++) {
+            StepGeNN();
+
+            // Leave gap in recording so timestep deltas don't all fit in a single varint byte
+            if(i < 300 || i >= 600) {
+                recorder.record(t);
+
+                // Add spikes to list of those expected, with IDs in ascending order
+                const uint64_t timestep = (uint64_t)std::llround(t / DT);
+                Spikes timestepSpikes;
+                for(unsigned int s = 0; s < spikeCount_Pop; s++) {
+                    timestepSpikes.emplace_back(timestep, spike_Pop[s]);
+                }
+                std::sort(timestepSpikes.begin(), timestepSpikes.end());
+                correct.insert(correct.end(), timestepSpikes.cbegin(), timestepSpikes.cend());
+            }
+        }
+    }
+    ASSERT_FALSE(correct.empty());
+
+    // Check spikes read back from file exactly match those recorded
+    unsigned int numBlocks;
+    const Spikes spikes = readSpikesBinary("spikes.bin", DT, numBlocks);
+    EXPECT_GT(numBlocks, 1u);
+    ASSERT_EQ(spikes.size(), correct.size());
+    EXPECT_TRUE(std::equal(spikes.cbegin(), spikes.cend(), correct.cbegin()));
+}
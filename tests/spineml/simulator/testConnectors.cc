@@ -1,3 +1,13 @@
+// Standard C++ includes
+#include <atomic>
+#include <fstream>
+#include <random>
+#include <tuple>
+#include <vector>
+
+// Standard C includes
+#include <cstdio>
+
 // Filesystem includes
 #include "path.h"
 
@@ -7,6 +17,9 @@
 // pugixml includes
 #include "pugixml/pugixml.hpp"
 
+// SpineML common includes
+#include "binaryConnectionFile.h"
+
 // SpineML simulator includes
 #include "connectors.h"
 
@@ -692,3 +705,145 @@ TEST(ConnectionListTest, BinaryFileSparse) {
     // Check number of connections matches XML
     EXPECT_EQ(remapIndices.size(), 294);
 }
+//------------------------------------------------------------------------
+TEST(ConnectionListTest, BinaryFileRandomSparseDelay) {
+    // Write binary file containing random connections with explicit delays
+    const unsigned int numPre = 1000;
+    const unsigned int numPost = 1000;
+    const unsigned int numConnections = 200000;
+    std::vector<std::tuple<uint32_t, uint32_t, float>> connections;
+    {
+        std::mt19937 rng;
+        std::uniform_int_distribution<uint32_t> neuronDist(0, numPre - 1);
+        std::uniform_int_distribution<uint32_t> delayDist(1, 10);
+        std::ofstream output("random_delay.bin", std::ios::binary);
+        for(unsigned int i = 0; i < numConnections; i++) {
+            const uint32_t words[3] = {neuronDist(rng), neuronDist(rng), 0};
+            const float synDelay = (float)delayDist(rng);
+            output.write(reinterpret_cast<const char*>(words), sizeof(uint32_t) * 2);
+            output.write(reinterpret_cast<const char*>(&synDelay), sizeof(float));
+            connections.emplace_back(words[0], words[1], synDelay);
+        }
+    }
+
+    // XML fragment specifying connector
+    const char *connectorXML =
+        "<LL:Synapse>\n"
+        "   <ConnectionList>\n"
+        "       <BinaryFile file_name=\"random_delay.bin\" num_connections=\"200000\" explicit_delay_flag=\"1\" packed_data=\"\"/>\n"
+        "   </ConnectionList>\n"
+        "</LL:Synapse>\n";
+
+    // Load XML and get root LL:Synapse element
+    pugi::xml_document connectorDocument;
+    connectorDocument.load_string(connectorXML);
+    auto synapse = connectorDocument.child("LL:Synapse");
+
+    // Get metadata from file and check maximum row length matches actual data
+    std::vector<unsigned int> referenceRowLength(numPre, 0);
+    for(const auto &c : connections) {
+        referenceRowLength[std::get<0>(c)]++;
+    }
+    const unsigned int referenceMaxRowLength = *std::max_element(referenceRowLength.cbegin(), referenceRowLength.cend());
+    std::remove("random_delay.bin.meta.xml");
+    {
+        SpineMLCommon::BinaryConnectionFile file("random_delay.bin", numConnections, true);
+        const auto metadata = file.getMetadata(numPre);
+        EXPECT_EQ(metadata.maxRowLength, referenceMaxRowLength);
+        EXPECT_TRUE(metadata.heterogeneousDelay);
+        EXPECT_EQ(metadata.maxDelayMs, 10.0f);
+
+        // Check metadata is read identically from sidecar
+        const auto sidecarMetadata = file.getMetadata(numPre);
+        EXPECT_EQ(sidecarMetadata.maxRowLength, metadata.maxRowLength);
+        EXPECT_EQ(sidecarMetadata.heterogeneousDelay, metadata.heterogeneousDelay);
+        EXPECT_EQ(sidecarMetadata.maxDelayMs, metadata.maxDelayMs);
+    }
+    EXPECT_TRUE(filesystem::path("random_delay.bin.meta.xml").exists());
+
+    // Parse XML and create sparse connector
+    filesystem::path basePath;
+    std::vector<unsigned int> remapIndices;
+    const unsigned int maxRowLength = referenceMaxRowLength;
+    std::vector<unsigned int> rowLength(numPre);
+    std::vector<unsigned int> ind(numPre * maxRowLength);
+    std::vector<uint8_t> delay(numPre * maxRowLength);
+    unsigned int *rowLengthPtr = rowLength.data();
+    unsigned int *indPtr = ind.data();
+    uint8_t *delayPtr = delay.data();
+    Connectors::create(synapse, 1.0, numPre, numPost,
+                       &rowLengthPtr, &indPtr, &delayPtr, &maxRowLength,
+                       basePath, remapIndices);
+
+    // Check row lengths match and rows are sorted
+    EXPECT_EQ(rowLength, referenceRowLength);
+    for(unsigned int i = 0; i < numPre; i++) {
+        const auto rowBegin = ind.cbegin() + (i * maxRowLength);
+        EXPECT_TRUE(std::is_sorted(rowBegin, rowBegin + rowLength[i]));
+    }
+
+    // Check each synapse can be found via remap indices
+    ASSERT_EQ(remapIndices.size(), numConnections);
+    for(unsigned int i = 0; i < numConnections; i++) {
+        const unsigned int index = remapIndices[i];
+        ASSERT_EQ(index / maxRowLength, std::get<0>(connections[i]));
+        ASSERT_LT(index % maxRowLength, rowLength[std::get<0>(connections[i])]);
+        ASSERT_EQ(ind[index], std::get<1>(connections[i]));
+        ASSERT_EQ(delay[index], (uint8_t)std::get<2>(connections[i]));
+    }
+
+    // Check no two synapses were remapped to the same location
+    std::sort(remapIndices.begin(), remapIndices.end());
+    EXPECT_TRUE(std::adjacent_find(remapIndices.cbegin(), remapIndices.cend()) == remapIndices.cend());
+
+    std::remove("random_delay.bin");
+    std::remove("random_delay.bin.meta.xml");
+}
+//------------------------------------------------------------------------
+TEST(BinaryConnectionFileTest, ParallelFor) {
+    // Check every connection is processed exactly once when split between threads
+    std::vector<std::atomic<unsigned int>> visits(1001);
+    for(auto &v : visits) {
+        v = 0;
+    }
+    SpineMLCommon::BinaryConnectionFile::parallelFor(4, visits.size(),
+        [&visits](unsigned int, size_t begin, size_t end)
+        {
+            for(size_t i = begin; i < end; i++) {
+                visits[i]++;
+            }
+        });
+
+    for(const auto &v : visits) {
+        EXPECT_EQ(v, 1);
+    }
+}
+//------------------------------------------------------------------------
+TEST(BinaryConnectionFileTest, SidecarStale) {
+    // Write connection list where presynaptic neuron 0 has two connections
+    auto writeConnections = [](const char *filename, const std::vector<uint32_t> &words)
+    {
+        std::ofstream output(filename, std::ios::binary);
+        output.write(reinterpret_cast<const char*>(words.data()), sizeof(uint32_t) * words.size());
+    };
+    writeConnections("sidecar_stale.bin", {0, 0, 0, 1, 1, 0});
+    std::remove("sidecar_stale.bin.meta.xml");
+    {
+        SpineMLCommon::BinaryConnectionFile file("sidecar_stale.bin", 3, false);
+        EXPECT_EQ(file.getMetadata(3).maxRowLength, 2);
+    }
+
+    // Immediately replace it with a file of the same size where every row has one connection
+    // **NOTE** this happens within the same second so size and whole-second modification time are unchanged
+    writeConnections("sidecar_stale_new.bin", {0, 0, 1, 1, 2, 2});
+    std::rename("sidecar_stale_new.bin", "sidecar_stale.bin");
+
+    // Check sidecar written for previous file isn't used
+    {
+        SpineMLCommon::BinaryConnectionFile file("sidecar_stale.bin", 3, false);
+        EXPECT_EQ(file.getMetadata(3).maxRowLength, 1);
+    }
+
+    std::remove("sidecar_stale.bin");
+    std::remove("sidecar_stale.bin.meta.xml");
+}
@@ -0,0 +1,170 @@
+// Standard C++ includes
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// Filesystem includes
+#include "path.h"
+
+// pugixml includes
+#include "pugixml/pugixml.hpp"
+
+// SpineML simulator includes
+#include "logOutput.h"
+#include "mappedFile.h"
+#include "modelProperty.h"
+#include "stateVar.h"
+
+using namespace SpineMLSimulator;
+
+//------------------------------------------------------------------------
+// Anonymous namespace
+//------------------------------------------------------------------------
+namespace
+{
+std::vector<char> readFile(const std::string &filename)
+{
+    std::ifstream is(filename, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+}
+
+scalar hostV[4];
+scalar *hostVPtr = hostV;
+
+void pushPullV()
+{
+}
+
+void *getLibrarySymbol(const char *name, bool)
+{
+    if(strcmp(name, "VTest") == 0) {
+        return &hostVPtr;
+    }
+    else if(strcmp(name, "pushVTestToDevice") == 0 || strcmp(name, "pullVTestFromDevice") == 0) {
+        return reinterpret_cast<void*>(&pushPullV);
+    }
+    else {
+        return nullptr;
+    }
+}
+
+unsigned int hostSpikeCount[1];
+unsigned int hostSpikes[8];
+
+void pullCurrentSpikes()
+{
+}
+}
+
+//------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------
+TEST(MappedFileTest, GrowAndTruncate)
+{
+    {
+        // Create file with space for 4 words and then append 5
+        MappedFile file("test_mapped.bin", sizeof(uint32_t) * 4);
+        for(uint32_t i = 0; i < 5; i++) {
+            memcpy(file.append(sizeof(uint32_t)), &i, sizeof(uint32_t));
+        }
+        ASSERT_GE(file.getCapacityBytes(), sizeof(uint32_t) * 5);
+        ASSERT_EQ(file.getUsedBytes(), sizeof(uint32_t) * 5);
+    }
+
+    // Check file only contains the words which were appended
+    const auto data = readFile("test_mapped.bin");
+    ASSERT_EQ(data.size(), sizeof(uint32_t) * 5);
+    for(uint32_t i = 0; i < 5; i++) {
+        uint32_t word;
+        memcpy(&word, &data[i * sizeof(uint32_t)], sizeof(uint32_t));
+        ASSERT_EQ(word, i);
+    }
+    std::remove("test_mapped.bin");
+}
+//------------------------------------------------------------------------
+TEST(LogOutputTest, AnalogueFileBinary)
+{
+    pugi::xml_document doc;
+    auto node = doc.append_child("LogOutput");
+    node.append_attribute("name").set_value("V");
+    node.append_attribute("target").set_value("Test");
+    node.append_attribute("port").set_value("V");
+    node.append_attribute("indices").set_value("3,0");
+    node.append_attribute("start_time").set_value(1.0);
+
+    {
+        StateVar<scalar> stateVar("VTest", &getLibrarySymbol);
+        ModelProperty::Fixed property(0.0, stateVar, 4);
+
+        // Log for 3 of the 4 experiment timesteps but stop after two frames have been recorded
+        LogOutput::AnalogueFile log(node, 1.0, 4, "V", 4, filesystem::path("."), &property, LogOutput::FileFormat::Binary);
+        ASSERT_FALSE(log.isPipelined());
+        for(unsigned int t = 0; t < 3; t++) {
+            for(unsigned int i = 0; i < 4; i++) {
+                hostV[i] = (scalar)((t * 10) + i);
+            }
+            log.record(1.0, t);
+        }
+    }
+
+    // Check file only contains frames from timesteps 1 and 2 with indexed values in order
+    const auto data = readFile("Test_V_log.bin");
+    const scalar correct[] = {13.0f, 10.0f, 23.0f, 20.0f};
+    ASSERT_EQ(data.size(), sizeof(correct));
+    ASSERT_EQ(memcmp(data.data(), correct, sizeof(correct)), 0);
+    std::remove("Test_V_log.bin");
+    std::remove("Test_V_logrep.xml");
+}
+//------------------------------------------------------------------------
+TEST(LogOutputTest, EventBinaryIndices)
+{
+    pugi::xml_document doc;
+    auto node = doc.append_child("LogOutput");
+    node.append_attribute("name").set_value("Spikes");
+    node.append_attribute("target").set_value("Test");
+    node.append_attribute("port").set_value("spike");
+    node.append_attribute("indices").set_value("5,1,5,6");
+    node.append_attribute("format").set_value("binary");
+
+    {
+        LogOutput::Event log(node, 1.0, 2, "spike", 8, filesystem::path("."), nullptr,
+                             hostSpikeCount, hostSpikes, &pullCurrentSpikes);
+
+        // Emit spikes from every neuron in first timestep and two in second
+        hostSpikeCount[0] = 8;
+        for(unsigned int i = 0; i < 8; i++) {
+            hostSpikes[i] = i;
+        }
+        log.record(1.0, 0);
+
+        hostSpikeCount[0] = 2;
+        hostSpikes[0] = 6;
+        hostSpikes[1] = 7;
+        log.record(1.0, 1);
+    }
+
+    // Check only spikes from the indexed neurons were written
+    const auto data = readFile("Test_spike_log.bin");
+    const size_t recordBytes = sizeof(double) + sizeof(int32_t);
+    const double correctT[] = {0.0, 0.0, 0.0, 1.0};
+    const int32_t correctIndex[] = {1, 5, 6, 6};
+    ASSERT_EQ(data.size(), recordBytes * 4);
+    for(size_t r = 0; r < 4; r++) {
+        double t;
+        int32_t index;
+        memcpy(&t, &data[r * recordBytes], sizeof(double));
+        memcpy(&index, &data[(r * recordBytes) + sizeof(double)], sizeof(int32_t));
+        ASSERT_EQ(t, correctT[r]);
+        ASSERT_EQ(index, correctIndex[r]);
+    }
+    std::remove("Test_spike_log.bin");
+    std::remove("Test_spike_logrep.xml");
+}
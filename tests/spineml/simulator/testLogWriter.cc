@@ -0,0 +1,117 @@
+// Standard C++ includes
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// pugixml includes
+#include "pugixml/pugixml.hpp"
+
+// SpineML simulator includes
+#include "logWriter.h"
+
+using namespace SpineMLSimulator;
+
+//------------------------------------------------------------------------
+// Anonymous namespace
+//------------------------------------------------------------------------
+namespace
+{
+// Logger which records the timesteps whose snapshots get written
+class TestLogger : public LogOutput::Base
+{
+public:
+    TestLogger(const pugi::xml_node &node, std::vector<unsigned long long> &written, bool pipelined = true)
+    :   Base(node, 1.0), m_Written(written), m_Pipelined(pipelined)
+    {
+    }
+
+    virtual void record(double, unsigned long long) override
+    {
+        FAIL();
+    }
+
+    virtual bool isPipelined() const override{ return m_Pipelined; }
+
+    virtual void captureSnapshot(double, unsigned long long timestep, unsigned int buffer) override
+    {
+        m_Snapshots[buffer] = timestep;
+    }
+
+    virtual void writeSnapshot(unsigned int buffer) override
+    {
+        if(m_Snapshots[buffer] == 13) {
+            throw std::runtime_error("Write failed");
+        }
+        m_Written.push_back(m_Snapshots[buffer]);
+    }
+
+private:
+    std::vector<unsigned long long> &m_Written;
+    const bool m_Pipelined;
+    unsigned long long m_Snapshots[2];
+};
+}
+
+//------------------------------------------------------------------------
+// LogWriter tests
+//------------------------------------------------------------------------
+TEST(LogWriterTest, WritesInOrder) {
+    pugi::xml_document logDocument;
+    logDocument.load_string("<LogOutput name=\"Test\"/>\n");
+    const auto node = logDocument.child("LogOutput");
+
+    std::vector<unsigned long long> written;
+    std::vector<unsigned long long> notWritten;
+    std::vector<std::unique_ptr<LogOutput::Base>> loggers;
+    loggers.emplace_back(new TestLogger(node, written));
+    loggers.emplace_back(new TestLogger(node, notWritten, false));
+
+    // Capture and submit alternate buffers as the simulator would
+    {
+        LogWriter writer(loggers);
+        for(unsigned long long t = 0; t < 10; t++) {
+            const unsigned int buffer = (unsigned int)(t % 2);
+            loggers[0]->captureSnapshot(1.0, t, buffer);
+            writer.submit(buffer);
+        }
+        writer.flush();
+        ASSERT_EQ(written.size(), 10);
+
+        // Destroying writer should finish writing pending snapshot
+        loggers[0]->captureSnapshot(1.0, 10, 0);
+        writer.submit(0);
+    }
+
+    ASSERT_EQ(written.size(), 11);
+    for(unsigned long long t = 0; t < 11; t++) {
+        EXPECT_EQ(written[t], t);
+    }
+
+    // Loggers which aren't pipelined should never be written by writer
+    EXPECT_TRUE(notWritten.empty());
+}
+
+TEST(LogWriterTest, RethrowsErrors) {
+    pugi::xml_document logDocument;
+    logDocument.load_string("<LogOutput name=\"Test\"/>\n");
+
+    std::vector<unsigned long long> written;
+    std::vector<std::unique_ptr<LogOutput::Base>> loggers;
+    loggers.emplace_back(new TestLogger(logDocument.child("LogOutput"), written));
+
+    // Exception thrown while writing snapshot should be rethrown on next flush
+    LogWriter writer(loggers);
+    loggers[0]->captureSnapshot(1.0, 13, 1);
+    writer.submit(1);
+    EXPECT_THROW(writer.flush(), std::runtime_error);
+
+    // Writer should continue to work
+    loggers[0]->captureSnapshot(1.0, 14, 0);
+    writer.submit(0);
+    writer.flush();
+    ASSERT_EQ(written.size(), 1);
+    EXPECT_EQ(written[0], 14);
+}
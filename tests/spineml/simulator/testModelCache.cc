@@ -0,0 +1,178 @@
+// Standard C++ includes
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+#include <cstdio>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// SpineML common includes
+#include "modelCache.h"
+
+using namespace SpineMLCommon;
+
+//------------------------------------------------------------------------
+// Anonymous namespace
+//------------------------------------------------------------------------
+namespace
+{
+const char *networkFilename = "test_model_cache.xml";
+
+void writeNetwork(const std::string &contents)
+{
+    std::ofstream os(networkFilename);
+    os << contents;
+}
+
+uint64_t getCacheSize()
+{
+    std::ifstream is(std::string(networkFilename) + ".cache", std::ios::binary | std::ios::ate);
+    return (uint64_t)is.tellg();
+}
+
+void removeFiles()
+{
+    std::remove(networkFilename);
+    std::remove((std::string(networkFilename) + ".cache").c_str());
+}
+}
+
+//------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------
+TEST(ModelCacheTest, RoundTrip)
+{
+    writeNetwork("<SpineML/>");
+    {
+        ModelCache cache(networkFilename);
+        cache.write("Entry", 1234, std::vector<uint32_t>{1, 2, 3});
+    }
+
+    ModelCache cache(networkFilename);
+    std::vector<uint32_t> data;
+    ASSERT_TRUE(cache.read("Entry", 1234, data));
+    ASSERT_EQ(data, std::vector<uint32_t>({1, 2, 3}));
+
+    // Entries with different dependency hashes, names or sizes shouldn't be returned
+    uint32_t fixed[2];
+    ASSERT_FALSE(cache.read("Entry", 4321, data));
+    ASSERT_FALSE(cache.read("Missing", 1234, data));
+    ASSERT_FALSE(cache.read("Entry", 1234, fixed, 2));
+    removeFiles();
+}
+//------------------------------------------------------------------------
+TEST(ModelCacheTest, NetworkChanged)
+{
+    writeNetwork("<SpineML/>");
+    {
+        ModelCache cache(networkFilename);
+        cache.write("Entry", 1234, std::vector<uint32_t>{1, 2, 3});
+    }
+
+    // Changing the network should invalidate all entries
+    writeNetwork("<SpineML></SpineML>");
+    ModelCache cache(networkFilename);
+    std::vector<uint32_t> data;
+    ASSERT_FALSE(cache.read("Entry", 1234, data));
+    removeFiles();
+}
+//------------------------------------------------------------------------
+TEST(ModelCacheTest, AppendEntries)
+{
+    writeNetwork("<SpineML/>");
+    {
+        ModelCache cache(networkFilename);
+        cache.write("A", 1, std::vector<uint32_t>(1000, 1));
+    }
+
+    // Writing a new entry should only append it to the cache
+    const uint64_t sizeA = getCacheSize();
+    {
+        ModelCache cache(networkFilename);
+        cache.write("B", 2, std::vector<uint32_t>{4, 5});
+    }
+    const uint64_t sizeB = getCacheSize();
+    ASSERT_LT(sizeB, sizeA + 100);
+
+    // Both entries should be readable
+    ModelCache cache(networkFilename);
+    std::vector<uint32_t> data;
+    ASSERT_TRUE(cache.read("A", 1, data));
+    ASSERT_EQ(data, std::vector<uint32_t>(1000, 1));
+    ASSERT_TRUE(cache.read("B", 2, data));
+    ASSERT_EQ(data, std::vector<uint32_t>({4, 5}));
+
+    // Replacing an entry many times should eventually compact superseded entries
+    for(uint32_t i = 0; i < 10; i++) {
+        cache.write("A", 3, std::vector<uint32_t>(1000, i));
+    }
+    ASSERT_LT(getCacheSize(), 2 * sizeB);
+    ASSERT_TRUE(cache.read("A", 3, data));
+    ASSERT_EQ(data, std::vector<uint32_t>(1000, 9));
+    ASSERT_TRUE(cache.read("B", 2, data));
+    ASSERT_EQ(data, std::vector<uint32_t>({4, 5}));
+    removeFiles();
+}
+//------------------------------------------------------------------------
+TEST(ModelCacheTest, ConcurrentWriters)
+{
+    writeNetwork("<SpineML/>");
+    ModelCache cache1(networkFilename);
+    ModelCache cache2(networkFilename);
+    cache1.write("A", 1, std::vector<uint32_t>{1});
+    cache2.write("B", 2, std::vector<uint32_t>{2});
+    cache1.write("C", 3, std::vector<uint32_t>{3});
+
+    // Entries written by both should be found in the cache
+    ModelCache cache(networkFilename);
+    std::vector<uint32_t> data;
+    ASSERT_TRUE(cache.read("A", 1, data));
+    ASSERT_TRUE(cache.read("B", 2, data));
+    ASSERT_EQ(data, std::vector<uint32_t>({2}));
+    ASSERT_TRUE(cache.read("C", 3, data));
+    removeFiles();
+}
+//------------------------------------------------------------------------
+TEST(ModelCacheTest, TruncatedEntry)
+{
+    writeNetwork("<SpineML/>");
+    {
+        ModelCache cache(networkFilename);
+        cache.write("A", 1, std::vector<uint32_t>{1, 2, 3});
+        cache.write("B", 2, std::vector<uint32_t>(100, 4));
+    }
+
+    // Chop the end off the last entry as if writing it had failed
+    {
+        std::ifstream is(std::string(networkFilename) + ".cache", std::ios::binary);
+        std::vector<char> contents((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+        contents.resize(contents.size() - 10);
+        std::ofstream os(std::string(networkFilename) + ".cache", std::ios::binary);
+        os.write(contents.data(), contents.size());
+    }
+
+    // Incomplete entry should be ignored but earlier ones still found
+    ModelCache cache(networkFilename);
+    std::vector<uint32_t> data;
+    ASSERT_TRUE(cache.read("A", 1, data));
+    ASSERT_FALSE(cache.read("B", 2, data));
+
+    // Entries written afterwards should replace incomplete entry
+    cache.write("C", 3, std::vector<uint32_t>{5});
+    ModelCache cacheAfter(networkFilename);
+    ASSERT_TRUE(cacheAfter.read("A", 1, data));
+    ASSERT_TRUE(cacheAfter.read("C", 3, data));
+    ASSERT_EQ(data, std::vector<uint32_t>({5}));
+    removeFiles();
+}
+//------------------------------------------------------------------------
+TEST(ModelCacheTest, NodeEntryName)
+{
+    // Nodes at the same offset in different documents should have different names
+    ASSERT_NE(ModelCache::getNodeEntryName("ValueList", "network.xml", 100),
+              ModelCache::getNodeEntryName("ValueList", "experiment.xml", 100));
+}
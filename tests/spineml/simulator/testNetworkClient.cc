@@ -0,0 +1,253 @@
+// Standard C++ includes
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// POSIX includes
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Google test includes
+#include "gtest/gtest.h"
+
+// SpineML simulator includes
+#include "networkClient.h"
+
+using namespace SpineMLSimulator;
+
+//------------------------------------------------------------------------
+// Anonymous namespace
+//------------------------------------------------------------------------
+namespace
+{
+const char *socketPath = "test_network_client.sock";
+
+bool receiveAll(int socket, void *data, size_t numBytes)
+{
+    return (recv(socket, data, numBytes, MSG_WAITALL) == (ssize_t)numBytes);
+}
+
+bool sendResponse(int socket, char response)
+{
+    return (send(socket, &response, 1, 0) == 1);
+}
+
+// Local stand-in for a SpineML network server which accepts a single
+// connection on a Unix domain socket and performs the handshake
+class StandInServer
+{
+public:
+    StandInServer(bool expectBatch, bool acceptBatch, std::function<void(int, unsigned int, unsigned int)> serveFunc)
+    {
+        std::remove(socketPath);
+
+        // Create and bind listening socket before client tries to connect
+        m_ListenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address;
+        memset(&address, 0, sizeof(sockaddr_un));
+        address.sun_family = AF_UNIX;
+        strcpy(address.sun_path, socketPath);
+        if(bind(m_ListenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(m_ListenSocket, 1) != 0) {
+            throw std::runtime_error("Unable to listen");
+        }
+
+        m_Thread = std::thread(
+            [this, expectBatch, acceptBatch, serveFunc]()
+            {
+                const int connection = accept(m_ListenSocket, nullptr, nullptr);
+
+                // Mode, data type, size and connection name
+                char mode;
+                char dataType;
+                uint32_t size;
+                int nameLength;
+                if(!receiveAll(connection, &mode, 1) || !sendResponse(connection, 41)
+                   || !receiveAll(connection, &dataType, 1) || !sendResponse(connection, 42)
+                   || !receiveAll(connection, &size, 4) || !sendResponse(connection, 42)
+                   || !receiveAll(connection, &nameLength, 4))
+                {
+                    close(connection);
+                    return;
+                }
+                std::vector<char> name(nameLength);
+                if(!receiveAll(connection, name.data(), nameLength) || !sendResponse(connection, 42)) {
+                    close(connection);
+                    return;
+                }
+
+                // If client should send a batch request, read batch size and respond
+                unsigned int batchTimesteps = 1;
+                if(expectBatch) {
+                    char request;
+                    if(!receiveAll(connection, &request, 1) || request != 47 || !receiveAll(connection, &batchTimesteps, 4)
+                       || !sendResponse(connection, acceptBatch ? 42 : 43))
+                    {
+                        close(connection);
+                        return;
+                    }
+                }
+
+                if(acceptBatch) {
+                    serveFunc(connection, size, batchTimesteps);
+                }
+                close(connection);
+            });
+    }
+
+    ~StandInServer()
+    {
+        m_Thread.join();
+        close(m_ListenSocket);
+        std::remove(socketPath);
+    }
+
+private:
+    int m_ListenSocket;
+    std::thread m_Thread;
+};
+
+// Receive messages sent by a source client, recording number of timesteps in each
+void receiveBatches(int connection, unsigned int size, unsigned int batchTimesteps,
+                    std::vector<unsigned int> &batchSizes, std::vector<double> &data)
+{
+    while(true) {
+        uint32_t numFrames = 1;
+        if(batchTimesteps > 1 && !receiveAll(connection, &numFrames, 4)) {
+            return;
+        }
+
+        std::vector<double> frames(size * numFrames);
+        if(!receiveAll(connection, frames.data(), frames.size() * sizeof(double)) || !sendResponse(connection, 42)) {
+            return;
+        }
+
+        batchSizes.push_back(numFrames);
+        data.insert(data.end(), frames.cbegin(), frames.cend());
+    }
+}
+
+// Send timesteps to a target client in messages of up to batchTimesteps
+void sendBatches(int connection, unsigned int size, unsigned int batchTimesteps, unsigned int numTimesteps)
+{
+    for(unsigned int t = 0; t < numTimesteps; t += batchTimesteps) {
+        const uint32_t numFrames = std::min(batchTimesteps, numTimesteps - t);
+        std::vector<double> frames;
+        for(unsigned int f = 0; f < numFrames; f++) {
+            for(unsigned int i = 0; i < size; i++) {
+                frames.push_back((double)(((t + f) * 10) + i));
+            }
+        }
+
+        char response;
+        if((batchTimesteps > 1 && send(connection, &numFrames, 4, 0) != 4)
+           || send(connection, frames.data(), frames.size() * sizeof(double), 0) != (ssize_t)(frames.size() * sizeof(double))
+           || !receiveAll(connection, &response, 1))
+        {
+            return;
+        }
+    }
+}
+
+void testSource(unsigned int batchTimesteps, bool async, const std::vector<unsigned int> &correctBatchSizes)
+{
+    std::vector<unsigned int> batchSizes;
+    std::vector<double> data;
+    {
+        StandInServer server(batchTimesteps > 1, true,
+                             [&batchSizes, &data](int connection, unsigned int size, unsigned int serverBatchTimesteps)
+                             {
+                                 receiveBatches(connection, size, serverBatchTimesteps, batchSizes, data);
+                             });
+
+        // Send 10 timesteps of 3 values
+        NetworkClient client(std::string("unix:") + socketPath, 0, 3, NetworkClient::DataType::Analogue,
+                             NetworkClient::Mode::Source, "test", batchTimesteps, async);
+        std::vector<double> buffer(3);
+        for(unsigned int t = 0; t < 10; t++) {
+            for(unsigned int i = 0; i < 3; i++) {
+                buffer[i] = (double)((t * 10) + i);
+            }
+            ASSERT_TRUE(client.send(buffer));
+        }
+    }
+
+    // Check data was batched correctly and all of it arrived in order
+    ASSERT_EQ(batchSizes, correctBatchSizes);
+    ASSERT_EQ(data.size(), 30);
+    for(unsigned int t = 0; t < 10; t++) {
+        for(unsigned int i = 0; i < 3; i++) {
+            ASSERT_EQ(data[(t * 3) + i], (double)((t * 10) + i));
+        }
+    }
+}
+
+void testTarget(unsigned int batchTimesteps, bool async)
+{
+    StandInServer server(batchTimesteps > 1, true,
+                         [](int connection, unsigned int size, unsigned int serverBatchTimesteps)
+                         {
+                             sendBatches(connection, size, serverBatchTimesteps, 10);
+                         });
+
+    // Receive 10 timesteps of 3 values
+    NetworkClient client(std::string("unix:") + socketPath, 0, 3, NetworkClient::DataType::Analogue,
+                         NetworkClient::Mode::Target, "test", batchTimesteps, async);
+    std::vector<double> buffer(3);
+    for(unsigned int t = 0; t < 10; t++) {
+        ASSERT_TRUE(client.receive(buffer));
+        for(unsigned int i = 0; i < 3; i++) {
+            ASSERT_EQ(buffer[i], (double)((t * 10) + i));
+        }
+    }
+}
+}
+
+//------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------
+TEST(NetworkClientTest, Source)
+{
+    testSource(1, false, std::vector<unsigned int>(10, 1));
+}
+//------------------------------------------------------------------------
+TEST(NetworkClientTest, SourceBatched)
+{
+    testSource(4, false, {4, 4, 2});
+}
+//------------------------------------------------------------------------
+TEST(NetworkClientTest, SourceBatchedAsync)
+{
+    testSource(4, true, {4, 4, 2});
+}
+//------------------------------------------------------------------------
+TEST(NetworkClientTest, Target)
+{
+    testTarget(1, false);
+}
+//------------------------------------------------------------------------
+TEST(NetworkClientTest, TargetBatched)
+{
+    testTarget(4, false);
+}
+//------------------------------------------------------------------------
+TEST(NetworkClientTest, TargetBatchedAsync)
+{
+    testTarget(4, true);
+}
+//------------------------------------------------------------------------
+TEST(NetworkClientTest, BatchRejected)
+{
+    StandInServer server(true, false, [](int, unsigned int, unsigned int){});
+
+    NetworkClient client;
+    ASSERT_FALSE(client.connect(std::string("unix:") + socketPath, 0, 3, NetworkClient::DataType::Analogue,
+                                NetworkClient::Mode::Source, "test", 4));
+}
@@ -104,6 +104,34 @@ TEST(NeuronGroup, CompareDifferentParams)
     NeuronGroupInternal *ng0Internal = static_cast<NeuronGroupInternal *>(ng0);
     ASSERT_TRUE(ng0Internal->canBeMerged(*ng1));
     ASSERT_FALSE(ng0Internal->canBeMerged(*ng2));
+
+    // Check that mergeable groups have the same hash digest
+    NeuronGroupInternal *ng1Internal = static_cast<NeuronGroupInternal *>(ng1);
+    NeuronGroupInternal *ng2Internal = static_cast<NeuronGroupInternal *>(ng2);
+    ASSERT_EQ(ng0Internal->getMergeHashDigest(), ng1Internal->getMergeHashDigest());
+    ASSERT_NE(ng0Internal->getMergeHashDigest(), ng2Internal->getMergeHashDigest());
+}
+
+TEST(NeuronGroup, CompareSpikeRecording)
+{
+    ModelSpecInternal model;
+
+    // Add three neuron groups to model, two of which record spikes
+    NeuronModels::Izhikevich::ParamValues paramVals(0.02, 0.2, -65.0, 8.0);
+    NeuronModels::Izhikevich::VarValues varVals(0.0, 0.0);
+    auto *ng0 = model.addNeuronPopulation<NeuronModels::Izhikevich>("Neurons0", 10, paramVals, varVals);
+    auto *ng1 = model.addNeuronPopulation<NeuronModels::Izhikevich>("Neurons1", 10, paramVals, varVals);
+    auto *ng2 = model.addNeuronPopulation<NeuronModels::Izhikevich>("Neurons2", 10, paramVals, varVals);
+    ng0->setSpikeRecordingEnabled(true);
+    ng1->setSpikeRecordingEnabled(true);
+
+    model.finalize();
+
+    // Check that groups which record spikes can only be merged with each other
+    NeuronGroupInternal *ng0Internal = static_cast<NeuronGroupInternal *>(ng0);
+    ASSERT_TRUE(ng0Internal->canBeMerged(*ng1));
+    ASSERT_FALSE(ng0Internal->canBeMerged(*ng2));
+    ASSERT_TRUE(model.isRecordingInUse());
 }
 
 TEST(NeuronGroup, CompareCurrentSources)
@@ -142,6 +170,13 @@ TEST(NeuronGroup, CompareCurrentSources)
     ASSERT_TRUE(ng0Internal->canBeMerged(*ng1));
     ASSERT_TRUE(ng0Internal->canBeMerged(*ng2));
     ASSERT_FALSE(ng0Internal->canBeMerged(*ng3));
+
+    // Check that groups with reordered current sources have the same hash digest
+    NeuronGroupInternal *ng1Internal = static_cast<NeuronGroupInternal *>(ng1);
+    NeuronGroupInternal *ng2Internal = static_cast<NeuronGroupInternal *>(ng2);
+    ASSERT_EQ(ng0Internal->getMergeHashDigest(), ng1Internal->getMergeHashDigest());
+    ASSERT_EQ(ng0Internal->getMergeHashDigest(), ng2Internal->getMergeHashDigest());
+    ASSERT_EQ(ng0Internal->getInitMergeHashDigest(), ng2Internal->getInitMergeHashDigest());
 }
 
 TEST(NeuronGroup, ComparePostsynapticModels)
@@ -42,6 +42,34 @@ public:
     SET_VARS({{"V", "scalar"}, {"RefracTime", "scalar"}});
 
     SET_NEEDS_AUTO_REFRACTORY(false);
+
+    // Without input, finish refractory period and then decay analytically towards steady state
+    SET_CATCH_UP_CODE(
+        "unsigned int remaining = $(elapsed);\n"
+        "while(remaining > 0 && $(RefracTime) > 0.0) {\n"
+        "  $(RefracTime) -= DT;\n"
+        "  remaining--;\n"
+        "}\n"
+        "if(remaining > 0) {\n"
+        "  const scalar alpha = ($(Ioffset) * $(Rmembrane)) + $(Vrest);\n"
+        "  $(V) = alpha - (pow($(ExpTC), (scalar)remaining) * (alpha - $(V)));\n"
+        "}\n");
+
+    // Neuron can't spike during refractory period or, if steady state is below
+    // threshold, ever; otherwise it can't spike until it has decayed past threshold
+    SET_QUIESCENT_STEPS_CODE(
+        "const scalar alpha = ($(Ioffset) * $(Rmembrane)) + $(Vrest);\n"
+        "const scalar refracSteps = ($(RefracTime) > 0.0) ? floor($(RefracTime) / DT) : 0.0;\n"
+        "if($(V) >= $(Vthresh)) {\n"
+        "  $(quiescentSteps) = 0;\n"
+        "}\n"
+        "else if(alpha < $(Vthresh)) {\n"
+        "  $(quiescentSteps) = 1000000000;\n"
+        "}\n"
+        "else {\n"
+        "  const scalar decaySteps = floor(log((alpha - $(Vthresh)) / (alpha - $(V))) / log($(ExpTC))) - 1.0;\n"
+        "  $(quiescentSteps) = (unsigned int)fmin(refracSteps + fmax(decaySteps, 0.0), 1000000000.0);\n"
+        "}\n");
 };
 
 //--------------------------------------------------------------------------
@@ -111,6 +111,10 @@ TEST(SynapseGroup, CompareWUDifferentGlobalG)
     SynapseGroupInternal *sg0Internal = static_cast<SynapseGroupInternal*>(sg0);
     ASSERT_TRUE(sg0Internal->canWUBeMerged(*sg1));
     ASSERT_FALSE(sg0Internal->canWUBeMerged(*sg2));
+
+    // Check that mergeable groups have the same hash digest
+    SynapseGroupInternal *sg1Internal = static_cast<SynapseGroupInternal*>(sg1);
+    ASSERT_EQ(sg0Internal->getWUMergeHashDigest(), sg1Internal->getWUMergeHashDigest());
 }
 
 TEST(SynapseGroup, CompareWUDifferentProceduralConnectivity)
@@ -187,6 +191,67 @@ TEST(SynapseGroup, CompareWUDifferentProceduralVars)
     ASSERT_FALSE(sg0Internal->canWUBeMerged(*sg2));
 }
 
+TEST(SynapseGroup, CompareWUDifferentVarStorage)
+{
+    ModelSpecInternal model;
+
+    // Add two neuron groups to model
+    NeuronModels::Izhikevich::ParamValues paramVals(0.02, 0.2, -65.0, 8.0);
+    NeuronModels::Izhikevich::VarValues varVals(0.0, 0.0);
+    model.addNeuronPopulation<NeuronModels::Izhikevich>("Neurons0", 10, paramVals, varVals);
+    model.addNeuronPopulation<NeuronModels::Izhikevich>("Neurons1", 10, paramVals, varVals);
+
+    WeightUpdateModels::StaticPulse::VarValues staticPulseVarVals(0.1);
+    SynapseGroup *sg[4];
+    for(unsigned int i = 0; i < 4; i++) {
+        sg[i] = model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>("Synapses" + std::to_string(i), SynapseMatrixType::DENSE_INDIVIDUALG, NO_DELAY,
+                                                                                                            "Neurons0", "Neurons1",
+                                                                                                            {}, staticPulseVarVals,
+                                                                                                            {}, {});
+    }
+    sg[0]->setWUVarStorage("g", SynapseGroup::VarStorage::FIXED16, 0.001);
+    sg[1]->setWUVarStorage("g", SynapseGroup::VarStorage::FIXED16, 0.001);
+    sg[2]->setWUVarStorage("g", SynapseGroup::VarStorage::FIXED16, 0.002);
+    sg[3]->setWUVarStorage("g", SynapseGroup::VarStorage::HALF);
+
+    // Reduced-precision storage can only be used for read-only variables of groups with individual weights
+    auto *sgGlobal = model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>("SynapsesGlobal", SynapseMatrixType::DENSE_GLOBALG, NO_DELAY,
+                                                                                                                "Neurons0", "Neurons1",
+                                                                                                                {}, staticPulseVarVals,
+                                                                                                                {}, {});
+    EXPECT_THROW(sgGlobal->setWUVarStorage("g", SynapseGroup::VarStorage::HALF), std::runtime_error);
+
+    STDPAdditive::ParamValues stdpParams(10.0, 10.0, 0.01, 0.01, 0.0, 1.0);
+    auto *sgSTDP = model.addSynapsePopulation<STDPAdditive, PostsynapticModels::DeltaCurr>("SynapsesSTDP", SynapseMatrixType::DENSE_INDIVIDUALG, NO_DELAY,
+                                                                                           "Neurons0", "Neurons1",
+                                                                                           stdpParams, STDPAdditive::VarValues(0.0),
+                                                                                           STDPAdditive::PreVarValues(0.0), STDPAdditive::PostVarValues(0.0),
+                                                                                           {}, {});
+    EXPECT_THROW(sgSTDP->setWUVarStorage("g", SynapseGroup::VarStorage::HALF), std::runtime_error);
+
+    // Finalize model
+    model.finalize();
+
+    // Only groups with matching storage formats can be merged but, as scales are passed
+    // to generated code in merged group structures, groups with different scales can be
+    SynapseGroupInternal *sg0Internal = static_cast<SynapseGroupInternal *>(sg[0]);
+    ASSERT_TRUE(sg0Internal->canWUBeMerged(*sg[1]));
+    ASSERT_TRUE(sg0Internal->canWUBeMerged(*sg[2]));
+    ASSERT_FALSE(sg0Internal->canWUBeMerged(*sg[3]));
+    ASSERT_TRUE(sg0Internal->canWUInitBeMerged(*sg[1]));
+    ASSERT_TRUE(sg0Internal->canWUInitBeMerged(*sg[2]));
+    ASSERT_FALSE(sg0Internal->canWUInitBeMerged(*sg[3]));
+    ASSERT_EQ(sg0Internal->getWUInitMergeHashDigest(), static_cast<SynapseGroupInternal *>(sg[1])->getWUInitMergeHashDigest());
+    ASSERT_EQ(sg0Internal->getWUInitMergeHashDigest(), static_cast<SynapseGroupInternal *>(sg[2])->getWUInitMergeHashDigest());
+    ASSERT_EQ(sg0Internal->getWUMergeHashDigest(), static_cast<SynapseGroupInternal *>(sg[2])->getWUMergeHashDigest());
+    ASSERT_NE(sg0Internal->getWUMergeHashDigest(), static_cast<SynapseGroupInternal *>(sg[3])->getWUMergeHashDigest());
+
+    // Storage type should reflect format
+    ASSERT_EQ(sg0Internal->getWUVarStorageType(0), "int16_t");
+    ASSERT_EQ(static_cast<SynapseGroupInternal *>(sg[3])->getWUVarStorageType(0), "uint16_t");
+    ASSERT_EQ(static_cast<SynapseGroupInternal *>(sgSTDP)->getWUVarStorageType(0), "scalar");
+}
+
 TEST(SynapseGroup, InitCompareWUDifferentVars)
 {
     ModelSpecInternal model;
@@ -226,6 +291,11 @@ TEST(SynapseGroup, InitCompareWUDifferentVars)
     ASSERT_TRUE(sg0Internal->canWUInitBeMerged(*sg1));
     ASSERT_FALSE(sg0Internal->canWUInitBeMerged(*sg2));
 
+    // Check that groups whose initialisation is mergeable have the same hash digests
+    SynapseGroupInternal *sg1Internal = static_cast<SynapseGroupInternal *>(sg1);
+    ASSERT_EQ(sg0Internal->getWUInitMergeHashDigest(), sg1Internal->getWUInitMergeHashDigest());
+    ASSERT_EQ(sg0Internal->getConnectivityInitMergeHashDigest(), sg1Internal->getConnectivityInitMergeHashDigest());
+
     ASSERT_TRUE(sg0Internal->canWUPreInitBeMerged(*sg1));
     ASSERT_TRUE(sg0Internal->canWUPreInitBeMerged(*sg2));
     ASSERT_TRUE(sg0Internal->canWUPostInitBeMerged(*sg1));
@@ -321,3 +391,31 @@ TEST(SynapseGroup, InitCompareWUDifferentPostVars)
     ASSERT_TRUE(sg0Internal->canWUPreInitBeMerged(*sg1));
     ASSERT_TRUE(sg0Internal->canWUPreInitBeMerged(*sg2));
 }
+
+TEST(SynapseGroup, MaxTotalConnectionsOverflow)
+{
+    ModelSpecInternal model;
+
+    // Add two large neuron groups to model
+    NeuronModels::Izhikevich::ParamValues paramVals(0.02, 0.2, -65.0, 8.0);
+    NeuronModels::Izhikevich::VarValues varVals(0.0, 0.0);
+    model.addNeuronPopulation<NeuronModels::Izhikevich>("Neurons0", 100000, paramVals, varVals);
+    model.addNeuronPopulation<NeuronModels::Izhikevich>("Neurons1", 100000, paramVals, varVals);
+
+    WeightUpdateModels::StaticPulse::VarValues staticPulseVarVals(0.1);
+    auto *sg = model.addSynapsePopulation<WeightUpdateModels::StaticPulse, PostsynapticModels::DeltaCurr>("Synapses", SynapseMatrixType::CSR_INDIVIDUALG, NO_DELAY,
+                                                                                                          "Neurons0", "Neurons1",
+                                                                                                          {}, staticPulseVarVals,
+                                                                                                          {}, {});
+
+    // With every source neuron connected to every target neuron, the total is too large to index
+    EXPECT_THROW(sg->getMaxTotalConnections(), std::runtime_error);
+
+    // Reducing maximum row length brings it back in range
+    sg->setMaxConnections(1000);
+    ASSERT_EQ(sg->getMaxTotalConnections(), 100000000u);
+
+    // An explicit maximum is used as-is
+    sg->setMaxTotalConnections(5000);
+    ASSERT_EQ(sg->getMaxTotalConnections(), 5000u);
+}
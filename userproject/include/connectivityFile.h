@@ -0,0 +1,164 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+// ConnectivityFile
+//----------------------------------------------------------------------------
+//! Helpers for reading and writing the binary connectivity files which
+//! generated loadConnectivityFromFile functions map directly as SPARSE connectivity
+namespace ConnectivityFile
+{
+const uint32_t version = 1;
+
+//! Header of connectivity file, followed by uint32 row lengths
+//! and padded, indBytes-wide target indices, laid out exactly as GeNN's host arrays
+struct Header
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t numPre;
+    uint32_t numPost;
+    uint32_t maxRowLength;
+    uint32_t indBytes;
+    uint64_t reserved;
+};
+
+//! Total size in bytes of a connectivity file with these dimensions
+inline uint64_t getFileBytes(uint32_t numPre, uint32_t maxRowLength, uint32_t indBytes)
+{
+    return sizeof(Header) + (sizeof(uint32_t) * (uint64_t)numPre) + ((uint64_t)indBytes * numPre * maxRowLength);
+}
+
+//! Convert lists of presynaptic and postsynaptic indices into a connectivity file
+/*! If maxRowLength is zero, the longest row in the data is used. Synapses within each row keep their order in the input */
+inline void writeFromPairs(const std::string &path, uint32_t numPre, uint32_t numPost, uint32_t maxRowLength, uint32_t indBytes,
+                           const std::vector<uint32_t> &pre, const std::vector<uint32_t> &post)
+{
+    if(pre.size() != post.size()) {
+        throw std::runtime_error("Number of presynaptic and postsynaptic indices differs");
+    }
+    if(indBytes != 1 && indBytes != 2 && indBytes != 4) {
+        throw std::runtime_error("Indices must be 1, 2 or 4 bytes");
+    }
+    if(indBytes < 4 && numPost > (1u << (8 * indBytes))) {
+        throw std::runtime_error(std::to_string(numPost) + " postsynaptic neurons cannot be indexed with " + std::to_string(indBytes) + " byte indices");
+    }
+
+    // Histogram synapses into rows, checking indices as we go
+    std::vector<uint32_t> rowLength(numPre, 0);
+    for(size_t s = 0; s < pre.size(); s++) {
+        if(pre[s] >= numPre || post[s] >= numPost) {
+            throw std::runtime_error("Synapse " + std::to_string(s) + " (" + std::to_string(pre[s]) + ", " + std::to_string(post[s]) + ") out of range");
+        }
+        rowLength[pre[s]]++;
+    }
+
+    // Use longest row if no maximum is specified
+    const uint32_t longestRow = rowLength.empty() ? 0 : *std::max_element(rowLength.cbegin(), rowLength.cend());
+    if(maxRowLength == 0) {
+        maxRowLength = longestRow;
+    }
+    else if(longestRow > maxRowLength) {
+        throw std::runtime_error("Row of length " + std::to_string(longestRow) + " exceeds maximum row length " + std::to_string(maxRowLength));
+    }
+
+    // Scatter postsynaptic indices into padded rows
+    std::vector<uint8_t> ind((size_t)indBytes * numPre * maxRowLength, 0);
+    std::vector<uint32_t> rowFill(numPre, 0);
+    for(size_t s = 0; s < pre.size(); s++) {
+        const size_t idx = ((size_t)pre[s] * maxRowLength) + rowFill[pre[s]]++;
+        if(indBytes == 1) {
+            ind[idx] = (uint8_t)post[s];
+        }
+        else if(indBytes == 2) {
+            const uint16_t p = (uint16_t)post[s];
+            memcpy(&ind[idx * 2], &p, 2);
+        }
+        else {
+            memcpy(&ind[idx * 4], &post[s], 4);
+        }
+    }
+
+    // Write header, row lengths and indices
+    std::ofstream os(path, std::ios::binary);
+    const Header header = {{'G', 'C', 'O', 'N'}, version, numPre, numPost, maxRowLength, indBytes, 0};
+    os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    os.write(reinterpret_cast<const char*>(rowLength.data()), sizeof(uint32_t) * rowLength.size());
+    os.write(reinterpret_cast<const char*>(ind.data()), ind.size());
+    if(!os.good()) {
+        throw std::runtime_error("Error writing connectivity file '" + path + "'");
+    }
+}
+
+//! Check connectivity file is well-formed and, if non-zero dimensions are passed, that it matches them
+/*! Throws std::runtime_error describing the first problem found and returns the file's header otherwise */
+inline Header validate(const std::string &path, uint32_t numPre = 0, uint32_t numPost = 0, uint32_t maxRowLength = 0)
+{
+    std::ifstream is(path, std::ios::binary | std::ios::ate);
+    if(!is.good()) {
+        throw std::runtime_error("Unable to open connectivity file '" + path + "'");
+    }
+    const uint64_t fileBytes = (uint64_t)is.tellg();
+    is.seekg(0);
+
+    // Check header
+    Header header = {};
+    is.read(reinterpret_cast<char*>(&header), sizeof(Header));
+    if(!is.good() || memcmp(header.magic, "GCON", 4) != 0 || header.version != version) {
+        throw std::runtime_error("'" + path + "' is not a version " + std::to_string(version) + " GeNN connectivity file");
+    }
+    if(header.indBytes != 1 && header.indBytes != 2 && header.indBytes != 4) {
+        throw std::runtime_error("Invalid index size " + std::to_string(header.indBytes));
+    }
+    if(fileBytes != getFileBytes(header.numPre, header.maxRowLength, header.indBytes)) {
+        throw std::runtime_error("File is " + std::to_string(fileBytes) + " bytes but header describes "
+                                 + std::to_string(getFileBytes(header.numPre, header.maxRowLength, header.indBytes)) + " bytes");
+    }
+
+    // Check dimensions match those expected
+    if((numPre != 0 && header.numPre != numPre) || (numPost != 0 && header.numPost != numPost)
+       || (maxRowLength != 0 && header.maxRowLength != maxRowLength))
+    {
+        throw std::runtime_error("File contains " + std::to_string(header.numPre) + "x" + std::to_string(header.numPost)
+                                 + " connectivity with maximum row length " + std::to_string(header.maxRowLength));
+    }
+
+    // Check row lengths
+    std::vector<uint32_t> rowLength(header.numPre);
+    is.read(reinterpret_cast<char*>(rowLength.data()), sizeof(uint32_t) * rowLength.size());
+    for(uint32_t i = 0; i < header.numPre; i++) {
+        if(rowLength[i] > header.maxRowLength) {
+            throw std::runtime_error("Row " + std::to_string(i) + " has length " + std::to_string(rowLength[i])
+                                     + " which exceeds maximum row length " + std::to_string(header.maxRowLength));
+        }
+    }
+
+    // Check indices within each row are valid postsynaptic neurons
+    std::vector<uint8_t> row((size_t)header.indBytes * header.maxRowLength);
+    for(uint32_t i = 0; i < header.numPre; i++) {
+        is.read(reinterpret_cast<char*>(row.data()), row.size());
+        for(uint32_t j = 0; j < rowLength[i]; j++) {
+            uint32_t post = 0;
+            memcpy(&post, &row[(size_t)j * header.indBytes], header.indBytes);
+            if(post >= header.numPost) {
+                throw std::runtime_error("Synapse " + std::to_string(j) + " in row " + std::to_string(i)
+                                         + " targets neuron " + std::to_string(post) + " of " + std::to_string(header.numPost));
+            }
+        }
+    }
+    if(!is.good()) {
+        throw std::runtime_error("Error reading connectivity file '" + path + "'");
+    }
+    return header;
+}
+}   // namespace ConnectivityFile
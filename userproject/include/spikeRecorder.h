@@ -2,9 +2,16 @@
 
 // Standard C++ includes
 #include <algorithm>
+#include <condition_variable>
 #include <fstream>
+#include <cmath>
+#include <cstdint>
 #include <iterator>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -128,6 +135,229 @@ private:
     std::list<std::pair<double, std::vector<unsigned int>>> m_Cache;
 };
 
+//----------------------------------------------------------------------------
+// SpikeWriterBinary
+//----------------------------------------------------------------------------
+//! Class to write spikes to compact binary file using a background writer thread
+/*! The file starts with a header containing the magic "GSPK", a uint32 format
+    version and the double-precision timestep. Spikes are then written in
+    self-contained blocks, each with a header containing the uint64 index of the
+    first timestep in the block, the number of timesteps with spikes, the number
+    of spikes and the size in bytes of the three columns which follow. These
+    columns contain timestep deltas, spike counts and sorted, delta-encoded
+    neuron IDs, all stored as LEB128 varints. All values are little-endian.
+    Blocks are filled by the simulation thread and, once full, swapped with a
+    second buffer which is written to disk by the writer thread.
+    userproject/python/spike_binary.py contains a reader for this format. */
+class SpikeWriterBinary
+{
+public:
+    SpikeWriterBinary(const std::string &filename, double dt, size_t blockSize = 1024 * 1024)
+    :   m_State(new State(filename, dt, blockSize))
+    {
+        // Start writer thread
+        m_State->writerThread = std::thread(&State::writeBlocks, m_State.get());
+    }
+
+    SpikeWriterBinary(SpikeWriterBinary&& other) = default;
+
+    ~SpikeWriterBinary()
+    {
+        // If this writer hasn't been moved from, flush remaining spikes and stop thread
+        if(m_State) {
+            flush();
+
+            {
+                std::lock_guard<std::mutex> lock(m_State->mutex);
+                m_State->stop = true;
+            }
+            m_State->condition.notify_all();
+            m_State->writerThread.join();
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Hand current block to writer thread, even if it isn't full
+    void flush()
+    {
+        if(m_State->front.numRecords > 0) {
+            swapBlocks();
+        }
+    }
+
+protected:
+    //----------------------------------------------------------------------------
+    // Protected API
+    //----------------------------------------------------------------------------
+    void recordSpikes(double t, unsigned int spikeCount, const unsigned int *currentSpikes)
+    {
+        // Timesteps without spikes are implicit
+        if(spikeCount == 0) {
+            return;
+        }
+
+        // Convert time to timestep index
+        const uint64_t timestep = (uint64_t)std::llround(t / m_State->dt);
+        Block &block = m_State->front;
+        if(block.numRecords == 0) {
+            block.firstTimestep = timestep;
+            block.prevTimestep = timestep;
+        }
+        else if(timestep < block.prevTimestep) {
+            throw std::runtime_error("SpikeWriterBinary requires spikes to be recorded in time order");
+        }
+
+        // Write timestep delta and spike count
+        writeVarint(block.timesteps, timestep - block.prevTimestep);
+        writeVarint(block.counts, spikeCount);
+        block.prevTimestep = timestep;
+        block.numRecords++;
+        block.numSpikes += spikeCount;
+
+        // Sort spikes so IDs can be delta-encoded
+        m_Spikes.assign(currentSpikes, currentSpikes + spikeCount);
+        std::sort(m_Spikes.begin(), m_Spikes.end());
+
+        // Write first ID and then deltas
+        unsigned int prevID = 0;
+        for(unsigned int id : m_Spikes) {
+            writeVarint(block.ids, id - prevID);
+            prevID = id;
+        }
+
+        // If block is full, hand it to writer thread
+        if((block.timesteps.size() + block.counts.size() + block.ids.size()) >= m_State->blockSize) {
+            swapBlocks();
+        }
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Block
+    //----------------------------------------------------------------------------
+    struct Block
+    {
+        void clear()
+        {
+            firstTimestep = 0;
+            prevTimestep = 0;
+            numRecords = 0;
+            numSpikes = 0;
+            timesteps.clear();
+            counts.clear();
+            ids.clear();
+        }
+
+        uint64_t firstTimestep = 0;
+        uint64_t prevTimestep = 0;
+        uint32_t numRecords = 0;
+        uint32_t numSpikes = 0;
+        std::vector<uint8_t> timesteps;
+        std::vector<uint8_t> counts;
+        std::vector<uint8_t> ids;
+    };
+
+    //----------------------------------------------------------------------------
+    // State
+    //----------------------------------------------------------------------------
+    //! State shared with writer thread - heap allocated so writer can be moved
+    struct State
+    {
+        State(const std::string &filename, double d, size_t b)
+        :   stream(filename, std::ios::binary), dt(d), blockSize(b), backFull(false), stop(false)
+        {
+            // Write file header
+            const uint32_t version = 1;
+            stream.write("GSPK", 4);
+            writeRaw(version);
+            writeRaw(dt);
+        }
+
+        template<typename T>
+        void writeRaw(const T &value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void writeBlocks()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while(true) {
+                // Wait until there's a block to write or we're stopping
+                condition.wait(lock, [this](){ return backFull || stop; });
+                if(!backFull) {
+                    return;
+                }
+
+                // Back block is owned by this thread until backFull is cleared so write without lock
+                lock.unlock();
+                writeRaw(back.firstTimestep);
+                writeRaw(back.numRecords);
+                writeRaw(back.numSpikes);
+                writeRaw((uint32_t)back.timesteps.size());
+                writeRaw((uint32_t)back.counts.size());
+                writeRaw((uint32_t)back.ids.size());
+                stream.write(reinterpret_cast<const char*>(back.timesteps.data()), back.timesteps.size());
+                stream.write(reinterpret_cast<const char*>(back.counts.data()), back.counts.size());
+                stream.write(reinterpret_cast<const char*>(back.ids.data()), back.ids.size());
+                stream.flush();
+                lock.lock();
+
+                backFull = false;
+                condition.notify_all();
+            }
+        }
+
+        std::ofstream stream;
+        const double dt;
+        const size_t blockSize;
+
+        Block front;
+        Block back;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool backFull;
+        bool stop;
+        std::thread writerThread;
+    };
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    void swapBlocks()
+    {
+        {
+            // Wait for writer thread to finish with previous block and swap
+            std::unique_lock<std::mutex> lock(m_State->mutex);
+            m_State->condition.wait(lock, [this](){ return !m_State->backFull; });
+            std::swap(m_State->front, m_State->back);
+            m_State->backFull = true;
+        }
+        m_State->condition.notify_all();
+
+        // Reset front block for re-use
+        m_State->front.clear();
+    }
+
+    static void writeVarint(std::vector<uint8_t> &bytes, uint64_t value)
+    {
+        while(value >= 0x80) {
+            bytes.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back((uint8_t)value);
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    std::unique_ptr<State> m_State;
+    std::vector<unsigned int> m_Spikes;
+};
+
 //----------------------------------------------------------------------------
 // SpikeRecorderBase
 //----------------------------------------------------------------------------
@@ -169,3 +399,62 @@ private:
     GetCurrentSpikeCountFunc m_GetCurrentSpikeCount;
     unsigned int m_Sum;
 };
+
+//----------------------------------------------------------------------------
+// SpikeRecorderBuffer
+//----------------------------------------------------------------------------
+//! Class to read spikes from the spike recording buffers of neuron groups with spike recording enabled
+template<typename Writer = SpikeWriterText>
+class SpikeRecorderBuffer : public Writer
+{
+public:
+    template<typename... WriterArgs>
+    SpikeRecorderBuffer(uint32_t *const &recordingBuffer, unsigned int numNeurons, WriterArgs &&... writerArgs)
+    :   Writer(std::forward<WriterArgs>(writerArgs)...), m_RecordingBuffer(recordingBuffer),
+        m_NumWords((numNeurons + 31) / 32), m_Sum(0)
+    {
+        m_Spikes.reserve(numNeurons);
+    }
+
+    SpikeRecorderBuffer(SpikeRecorderBuffer<Writer>&& other) = default;
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Record numTimesteps of spikes, starting from startTimestep, from a recording
+    //! buffer previously pulled from device with pullRecordingBuffersFromDevice
+    void record(double dt, unsigned long long startTimestep, unsigned int numTimesteps, unsigned int numRecordingTimesteps)
+    {
+        for(unsigned int i = 0; i < numTimesteps; i++) {
+            // Get bitfield for this timestep from ring buffer
+            const unsigned long long timestep = startTimestep + i;
+            const uint32_t *bitfield = &m_RecordingBuffer[(timestep % numRecordingTimesteps) * m_NumWords];
+
+            // Convert set bits to neuron IDs
+            m_Spikes.clear();
+            for(unsigned int w = 0; w < m_NumWords; w++) {
+                for(uint32_t word = bitfield[w]; word != 0; word &= (word - 1)) {
+                    unsigned int bit = 0;
+                    while(!(word & (1u << bit))) {
+                        bit++;
+                    }
+                    m_Spikes.push_back((w * 32) + bit);
+                }
+            }
+
+            m_Sum += (unsigned int)m_Spikes.size();
+            this->recordSpikes(timestep * dt, (unsigned int)m_Spikes.size(), m_Spikes.data());
+        }
+    }
+
+    unsigned int getSum() const{ return m_Sum; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    uint32_t *const &m_RecordingBuffer;
+    const unsigned int m_NumWords;
+    unsigned int m_Sum;
+    std::vector<unsigned int> m_Spikes;
+};
@@ -0,0 +1,68 @@
+import numpy as np
+
+# Dtypes of file and block headers written by SpikeWriterBinary
+_file_header_dtype = np.dtype([("magic", "S4"), ("version", "<u4"), ("dt", "<f8")])
+_block_header_dtype = np.dtype([("first_timestep", "<u8"), ("num_records", "<u4"),
+                                ("num_spikes", "<u4"), ("timestep_bytes", "<u4"),
+                                ("count_bytes", "<u4"), ("id_bytes", "<u4")])
+
+def is_spike_binary(filename):
+    # Check whether file starts with SpikeWriterBinary magic
+    with open(filename, "rb") as f:
+        return f.read(4) == b"GSPK"
+
+def _decode_varints(data):
+    # Bytes without continuation bit terminate each varint
+    ends = np.flatnonzero(data < 0x80)
+    starts = np.concatenate(([0], ends[:-1] + 1))
+
+    # Determine which varint each byte belongs to and its position within it
+    group = np.repeat(np.arange(len(ends)), ends - starts + 1)
+    shift = 7 * (np.arange(len(data)) - starts[group])
+
+    # Sum shifted 7-bit chunks of each varint
+    values = np.zeros(len(ends), dtype=np.uint64)
+    np.add.at(values, group, (data & 0x7F).astype(np.uint64) << shift.astype(np.uint64))
+    return values
+
+def read_spikes_binary(filename):
+    # Read entire file
+    data = np.fromfile(filename, dtype=np.uint8)
+
+    # Read and check file header
+    header = np.frombuffer(data, dtype=_file_header_dtype, count=1)[0]
+    if header["magic"] != b"GSPK" or header["version"] != 1:
+        raise Exception("'%s' is not a version 1 binary spike file" % filename)
+
+    times = []
+    ids = []
+    offset = _file_header_dtype.itemsize
+    while offset < len(data):
+        # Read block header
+        block = np.frombuffer(data, dtype=_block_header_dtype, count=1, offset=offset)[0]
+        offset += _block_header_dtype.itemsize
+
+        # Decode timestep delta column and convert to absolute timesteps
+        timestep_end = offset + int(block["timestep_bytes"])
+        timesteps = np.uint64(block["first_timestep"]) + np.cumsum(_decode_varints(data[offset:timestep_end]))
+
+        # Decode spike count column
+        count_end = timestep_end + int(block["count_bytes"])
+        counts = _decode_varints(data[timestep_end:count_end]).astype(np.int64)
+
+        # Decode neuron ID delta column
+        id_end = count_end + int(block["id_bytes"])
+        id_deltas = _decode_varints(data[count_end:id_end]).astype(np.int64)
+
+        # Undo delta-encoding by subtracting cumulative sum at start of each timestep
+        cum_ids = np.cumsum(id_deltas)
+        record_starts = np.cumsum(counts) - counts
+        times.append(np.repeat(timesteps, counts) * header["dt"])
+        ids.append(cum_ids - np.repeat(cum_ids[record_starts] - id_deltas[record_starts], counts))
+
+        offset = id_end
+
+    if len(times) == 0:
+        return np.empty(0, dtype=float), np.empty(0, dtype=int)
+    else:
+        return np.concatenate(times), np.concatenate(ids)
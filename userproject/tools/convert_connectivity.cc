@@ -0,0 +1,85 @@
+//--------------------------------------------------------------------------
+/*! \file userproject/tools/convert_connectivity.cc
+
+\brief Tool to convert lists of (pre, post) index pairs into the binary connectivity files
+which can be memory-mapped by the generated loadConnectivityFromFile function.
+
+Pairs are read either as whitespace-separated text or, with --binary, as consecutive pairs of little-endian uint32.
+*/
+//--------------------------------------------------------------------------
+
+// Standard C++ includes
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+#include <cstring>
+
+// Userproject includes
+#include "connectivityFile.h"
+
+int main(int argc, char *argv[])
+{
+    // Parse optional flags
+    bool binary = false;
+    uint32_t maxRowLength = 0;
+    uint32_t indBytes = 4;
+    std::vector<const char*> positional;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--binary") == 0) {
+            binary = true;
+        }
+        else if(strcmp(argv[i], "--max-row-length") == 0 && (i + 1) < argc) {
+            maxRowLength = (uint32_t)std::stoul(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--ind-bytes") == 0 && (i + 1) < argc) {
+            indBytes = (uint32_t)std::stoul(argv[++i]);
+        }
+        else {
+            positional.push_back(argv[i]);
+        }
+    }
+
+    if(positional.size() != 4) {
+        std::cerr << "usage: convert_connectivity [--binary] [--max-row-length <n>] [--ind-bytes <1|2|4>] ";
+        std::cerr << "<num pre> <num post> <pairs file> <connectivity file>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const uint32_t numPre = (uint32_t)std::stoul(positional[0]);
+    const uint32_t numPost = (uint32_t)std::stoul(positional[1]);
+
+    try {
+        // Read pairs
+        std::vector<uint32_t> pre;
+        std::vector<uint32_t> post;
+        if(binary) {
+            std::ifstream is(positional[2], std::ios::binary);
+            uint32_t pair[2];
+            while(is.read(reinterpret_cast<char*>(pair), sizeof(pair))) {
+                pre.push_back(pair[0]);
+                post.push_back(pair[1]);
+            }
+        }
+        else {
+            std::ifstream is(positional[2]);
+            uint32_t i;
+            uint32_t j;
+            while(is >> i >> j) {
+                pre.push_back(i);
+                post.push_back(j);
+            }
+        }
+
+        ConnectivityFile::writeFromPairs(positional[3], numPre, numPost, maxRowLength, indBytes, pre, post);
+        std::cout << "Wrote " << pre.size() << " synapses to '" << positional[3] << "'" << std::endl;
+    }
+    catch(const std::exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,41 @@
+//--------------------------------------------------------------------------
+/*! \file userproject/tools/validate_connectivity.cc
+
+\brief Tool to check a binary connectivity file is well-formed and, optionally,
+that it matches the dimensions of the synapse group it will be loaded into.
+*/
+//--------------------------------------------------------------------------
+
+// Standard C++ includes
+#include <iostream>
+#include <string>
+
+// Standard C includes
+#include <cstdlib>
+
+// Userproject includes
+#include "connectivityFile.h"
+
+int main(int argc, char *argv[])
+{
+    if(argc != 2 && argc != 5) {
+        std::cerr << "usage: validate_connectivity <connectivity file> [<num pre> <num post> <max row length>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        // Zero dimensions aren't checked
+        const uint32_t numPre = (argc == 5) ? (uint32_t)std::stoul(argv[2]) : 0;
+        const uint32_t numPost = (argc == 5) ? (uint32_t)std::stoul(argv[3]) : 0;
+        const uint32_t maxRowLength = (argc == 5) ? (uint32_t)std::stoul(argv[4]) : 0;
+        const auto header = ConnectivityFile::validate(argv[1], numPre, numPost, maxRowLength);
+
+        std::cout << "'" << argv[1] << "' is valid: " << header.numPre << "x" << header.numPost << " connectivity, maximum row length ";
+        std::cout << header.maxRowLength << ", " << header.indBytes << " byte indices" << std::endl;
+    }
+    catch(const std::exception &ex) {
+        std::cerr << "Invalid: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}